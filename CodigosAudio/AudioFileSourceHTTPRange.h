@@ -0,0 +1,150 @@
+/****************************************************
+ * Fuente HTTP con Range para ESP8266Audio
+ * - Pide siempre "Range: bytes=N-": si el server
+ *   responde 206, seek() reabre en el byte pedido sin
+ *   bajar de nuevo desde el principio
+ * - HTTP/1.1 keep-alive: el seek reusa el socket
+ * - Si la conexión se cae (pausa larga, ngrok), la
+ *   próxima lectura reconecta en la posición actual
+ * - useHTTP10(true): para respuestas sin largo que el
+ *   server sigue generando (/esp32/audio_flujo). En
+ *   HTTP/1.1 vendrían chunked y getStreamPtr() no lo
+ *   decodifica; en 1.0 el fin es el cierre. read()
+ *   devuelve lo que haya sin esperar a 'len'
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <AudioFileSource.h>
+
+class AudioFileSourceHTTPRange : public AudioFileSource {
+public:
+  AudioFileSourceHTTPRange() {}
+  ~AudioFileSourceHTTPRange() override { close(); }
+
+  // Antes de open()
+  void useHTTP10(bool v) { http10_ = v; }
+
+  bool open(const char* url) override {
+    strlcpy(url_, url, sizeof(url_));
+    size_ = 0;
+    return connect(0);
+  }
+
+  // Bloquea hasta 'len' bytes, EOF o red caída (reintenta en la posición actual).
+  // Sin largo devuelve apenas tiene algo: lo que falta puede estar generándose
+  uint32_t read(void* data, uint32_t len) override {
+    uint8_t* p = (uint8_t*)data;
+    uint32_t got = 0;
+    uint8_t tries = 0;
+    uint32_t tData = millis();
+    while (got < len) {
+      if (size_ && pos_ >= size_) break;                 // EOF
+      WiFiClient* s = stream_;
+      if (!s || (!s->connected() && !s->available())) {
+        if (!size_ && s) break;                          // sin largo: cierre = EOF
+        if (tries++ >= RECONNECT_TRIES || !connect(pos_)) break;
+        tData = millis();
+        continue;
+      }
+      int avail = s->available();
+      if (avail <= 0) {
+        if (got && !size_) break;
+        if (millis() - tData > READ_TIMEOUT_MS) { drop(); continue; }
+        delay(2);
+        continue;
+      }
+      uint32_t want = len - got;
+      if ((uint32_t)avail < want) want = avail;
+      int n = s->read(p + got, want);
+      if (n > 0) { got += n; pos_ += n; tData = millis(); }
+    }
+    return got;
+  }
+
+  uint32_t readNonBlock(void* data, uint32_t len) override {
+    if (!stream_) return 0;
+    int avail = stream_->available();
+    if (avail <= 0) return 0;
+    return read(data, (uint32_t)avail < len ? avail : len);
+  }
+
+  bool seek(int32_t pos, int dir) override {
+    int32_t target = dir == SEEK_SET ? pos : dir == SEEK_CUR ? (int32_t)pos_ + pos : (int32_t)size_ + pos;
+    if (target < 0 || (size_ && (uint32_t)target > size_)) return false;
+    if ((uint32_t)target == pos_) return true;
+    if (!ranges_) return false;
+    return connect(target);
+  }
+
+  bool close() override {
+    http_.end();
+    stream_ = nullptr;
+    return true;
+  }
+
+  bool     isOpen() override  { return stream_ != nullptr; }
+  uint32_t getSize() override { return size_; }
+  uint32_t getPos() override  { return pos_; }
+
+  bool acceptsRanges() const { return ranges_; }
+
+private:
+  static const uint8_t  RECONNECT_TRIES = 3;
+  static const uint32_t READ_TIMEOUT_MS = 5000;
+
+  void drop() {
+    http_.end();
+    stream_ = nullptr;
+  }
+
+  bool connect(uint32_t offset) {
+    static const char* HEADERS[] = { "Content-Range" };
+    http_.end();               // con reuse deja el socket abierto
+    stream_ = nullptr;
+    http_.setReuse(!http10_);
+    http_.useHTTP10(http10_);
+    http_.setTimeout(8000);
+    if (!http_.begin(url_)) return false;
+    http_.collectHeaders(HEADERS, 1);
+    char range[24];
+    snprintf(range, sizeof(range), "bytes=%u-", offset);
+    http_.addHeader("Range", range);
+    int code = http_.GET();
+
+    if (code == HTTP_CODE_PARTIAL_CONTENT) {
+      // "bytes a-b/total"
+      String cr = http_.header("Content-Range");
+      const char* slash = strrchr(cr.c_str(), '/');
+      if (slash && slash[1] != '*') size_ = strtoul(slash + 1, nullptr, 10);
+      ranges_ = true;
+      pos_ = offset;
+    } else if (code == HTTP_CODE_OK) {
+      // El server ignoró el Range: solo sirve si se pedía desde el principio
+      ranges_ = false;
+      int len = http_.getSize();
+      size_ = len > 0 ? len : 0;
+      pos_ = 0;
+      if (offset) {
+        Serial.println("⚠️ Server sin Range, no se puede saltar");
+        http_.end();
+        return false;
+      }
+    } else {
+      Serial.printf("❌ HTTP %d abriendo stream\n", code);
+      http_.end();
+      return false;
+    }
+    stream_ = http_.getStreamPtr();
+    return stream_ != nullptr;
+  }
+
+  HTTPClient  http_;
+  WiFiClient* stream_ = nullptr;
+  char        url_[256];
+  uint32_t    pos_ = 0;
+  uint32_t    size_ = 0;
+  bool        ranges_ = false;
+  bool        http10_ = false;
+};
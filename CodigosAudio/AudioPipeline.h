@@ -0,0 +1,576 @@
+/****************************************************
+ * Pipeline de audio desacoplado red -> DAC
+ * - AudioRingBuffer: buffer circular SPSC (1 productor,
+ *   1 consumidor), sin locks. Compila también en host
+ *   (g++ normal) para medir underruns vs tamaño.
+ * - AudioPipeline (solo ESP32): tarea de red que llena
+ *   el buffer + tarea de audio de alta prioridad en el
+ *   otro core que alimenta el generador/salida.
+ * - Cola sin cortes: mientras suena un ítem, la red ya
+ *   baja el siguiente al mismo buffer (segmentos) y la
+ *   salida queda abierta entre ítems.
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#ifdef ARDUINO
+  #include <Arduino.h>
+  #include <esp_heap_caps.h>
+  #include <AudioFileSource.h>
+  #include <AudioGenerator.h>
+  #include <AudioOutput.h>
+#endif
+
+// ====== Buffer circular SPSC ======
+// write() solo desde el productor, read() solo desde el consumidor.
+// Los índices son contadores que crecen siempre; la capacidad es
+// potencia de 2 para que el wrap de 32 bits no rompa el módulo.
+class AudioRingBuffer {
+public:
+  ~AudioRingBuffer() { end(); }
+
+  // Reserva 'bytes' (redondeado a potencia de 2). En ESP32 intenta PSRAM primero.
+  bool begin(size_t bytes) {
+    end();
+    size_t cap = 1;
+    while (cap < bytes) cap <<= 1;
+#ifdef ARDUINO
+    buf_ = (uint8_t*)heap_caps_malloc(cap, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buf_) buf_ = (uint8_t*)heap_caps_malloc(cap, MALLOC_CAP_8BIT);
+#else
+    buf_ = (uint8_t*)malloc(cap);
+#endif
+    if (!buf_) return false;
+    cap_  = (uint32_t)cap;
+    mask_ = cap_ - 1;
+    reset();
+    return true;
+  }
+
+  void end() {
+    if (buf_) { free(buf_); buf_ = nullptr; }
+    cap_ = mask_ = 0;
+  }
+
+  // Solo con productor y consumidor detenidos
+  void reset() {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    eof_.store(false, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    minFill_.store(cap_, std::memory_order_relaxed);
+    bytesIn_ = bytesOut_ = 0;
+    segW_.store(0, std::memory_order_relaxed);
+    segR_ = 0;
+  }
+
+  uint32_t capacity()  const { return cap_; }
+  uint32_t available() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+  }
+  uint32_t freeSpace() const { return cap_ - available(); }
+
+  // Productor: copia lo que entre, devuelve bytes escritos (puede ser < len)
+  uint32_t write(const uint8_t* data, uint32_t len) {
+    uint32_t h = head_.load(std::memory_order_relaxed);
+    uint32_t t = tail_.load(std::memory_order_acquire);
+    uint32_t room = cap_ - (h - t);
+    if (len > room) len = room;
+    uint32_t i = h & mask_;
+    uint32_t first = cap_ - i;
+    if (first > len) first = len;
+    memcpy(buf_ + i, data, first);
+    memcpy(buf_, data + first, len - first);
+    head_.store(h + len, std::memory_order_release);
+    bytesIn_ += len;
+    return len;
+  }
+
+  // Consumidor: copia lo disponible, devuelve bytes leídos (puede ser < len)
+  uint32_t read(uint8_t* data, uint32_t len) {
+    uint32_t t = tail_.load(std::memory_order_relaxed);
+    uint32_t h = head_.load(std::memory_order_acquire);
+    uint32_t avail = h - t;
+    if (len > avail) len = avail;
+    uint32_t i = t & mask_;
+    uint32_t first = cap_ - i;
+    if (first > len) first = len;
+    memcpy(data, buf_ + i, first);
+    memcpy(data + first, buf_, len - first);
+    tail_.store(t + len, std::memory_order_release);
+    bytesOut_ += len;
+    uint32_t fill = avail - len;
+    if (fill < minFill_.load(std::memory_order_relaxed)) minFill_.store(fill, std::memory_order_relaxed);
+    return len;
+  }
+
+  // Fin de stream (lo marca el productor)
+  void markEof()   { eof_.store(true, std::memory_order_release); }
+  bool eof() const { return eof_.load(std::memory_order_acquire); }
+
+  // ---- Segmentos (un ítem de la cola cada uno) ----
+  // El productor marca dónde termina el ítem actual ANTES de escribir
+  // bytes del siguiente; el consumidor no lee más allá de ese límite
+  // hasta pasar de segmento.
+  void endSegment() {
+    uint32_t n = segW_.load(std::memory_order_relaxed);
+    segEnd_[n & (MAX_SEG - 1)] = head_.load(std::memory_order_relaxed);
+    segW_.store(n + 1, std::memory_order_release);
+  }
+  // Consumidor: bytes que quedan del segmento actual, si ya se conoce su fin.
+  // Llamar después de available() (el orden de las cargas importa).
+  bool segmentLeft(uint32_t& left) const {
+    if (segW_.load(std::memory_order_acquire) == segR_) return false;
+    left = segEnd_[segR_ & (MAX_SEG - 1)] - tail_.load(std::memory_order_relaxed);
+    return true;
+  }
+  void nextSegment() { segR_++; }
+
+  // Estadísticas (las incrementa el consumidor)
+  void     countUnderrun()  { underruns_.fetch_add(1, std::memory_order_relaxed); }
+  uint32_t underruns() const { return underruns_.load(std::memory_order_relaxed); }
+  uint32_t minFill()   const { return minFill_.load(std::memory_order_relaxed); }
+  uint32_t bytesIn()   const { return bytesIn_; }
+  uint32_t bytesOut()  const { return bytesOut_; }
+
+private:
+  uint8_t* buf_  = nullptr;
+  uint32_t cap_  = 0;
+  uint32_t mask_ = 0;
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<bool>     eof_{false};
+  std::atomic<uint32_t> underruns_{0};
+  std::atomic<uint32_t> minFill_{0};
+  uint32_t bytesIn_  = 0;   // solo productor
+  uint32_t bytesOut_ = 0;   // solo consumidor
+
+  static const uint32_t MAX_SEG = 4;   // potencia de 2
+  uint32_t segEnd_[MAX_SEG];
+  std::atomic<uint32_t> segW_{0};      // segmentos cerrados por el productor
+  uint32_t segR_ = 0;                  // segmento que lee el consumidor
+};
+
+#ifdef ARDUINO
+
+// ====== Estadísticas públicas del pipeline ======
+struct AudioPipelineStats {
+  uint32_t underruns;    // veces que el decoder tuvo que esperar datos
+  uint32_t fill;         // bytes en buffer ahora
+  uint32_t minFill;      // mínimo llenado visto durante la reproducción
+  uint32_t capacity;
+  uint32_t bytesIn;
+  uint32_t bytesOut;
+  uint32_t maxStallMs;   // espera más larga del decoder
+  uint32_t stalls;       // ítems cortados por stallTimeoutMs sin datos (red muerta)
+};
+
+// ====== Copia de lo que baja la red ======
+// Opcional en play(): recibe los mismos bytes que el ring buffer
+// (desde la tarea de red) y al final si el stream llegó completo.
+class AudioTee {
+public:
+  virtual ~AudioTee() {}
+  virtual void teeData(const uint8_t* data, uint32_t len) = 0;
+  virtual void teeEnd(bool complete) = 0;
+};
+
+// ====== Salida que queda abierta entre ítems ======
+// Envuelve la salida real: begin() solo la arranca la primera vez y
+// stop() (que llama cada generador al terminar) no hace nada, así no
+// se reinicia el I2S entre un clip y otro. close() la apaga de verdad.
+class AudioOutputKeepOpen : public AudioOutput {
+public:
+  explicit AudioOutputKeepOpen(AudioOutput* real) : real_(real) {}
+
+  bool SetRate(int hz) override {
+    if (hz == rate_) return true;
+    rate_ = hz;
+    return real_->SetRate(hz);
+  }
+  bool SetBitsPerSample(int bits) override { return real_->SetBitsPerSample(bits); }
+  bool SetChannels(int ch) override        { return real_->SetChannels(ch); }
+  bool SetGain(float f) override           { return real_->SetGain(f); }
+  bool begin() override {
+    if (open_) return true;
+    open_ = real_->begin();
+    return open_;
+  }
+  bool ConsumeSample(int16_t sample[2]) override { return real_->ConsumeSample(sample); }
+  uint16_t ConsumeSamples(int16_t* samples, uint16_t count) override {
+    return real_->ConsumeSamples(samples, count);
+  }
+  bool loop() override  { return real_->loop(); }
+  void flush() override { real_->flush(); }
+  bool stop() override  { return true; }
+
+  void close() {
+    if (open_) real_->stop();
+    open_ = false;
+    rate_ = 0;
+  }
+  bool isOpen() const { return open_; }
+
+private:
+  AudioOutput* real_;
+  int  rate_ = 0;
+  bool open_ = false;
+};
+
+// ====== Fuente de audio que lee del buffer circular ======
+// La usa el generador (WAV, etc.) dentro de la tarea de audio.
+// read() bloquea hasta tener datos o fin del segmento (ítem): si
+// tiene que esperar cuenta un underrun.
+class AudioFileSourceRing : public AudioFileSource {
+public:
+  AudioFileSourceRing(AudioRingBuffer& rb) : rb_(rb) {}
+
+  void attach(TaskHandle_t consumer, uint32_t stallTimeoutMs) {
+    consumer_ = consumer;
+    stallTimeoutMs_ = stallTimeoutMs;
+    pos_ = 0;
+    maxStallMs_ = 0;
+    stalls_ = 0;
+    stalled_ = false;
+    open_ = true;
+  }
+  void detach() { open_ = false; }
+  void nextItem() { pos_ = 0; stalled_ = false; open_ = true; }   // el generador anterior la cerró
+
+  uint32_t read(void* data, uint32_t len) override {
+    uint8_t* p = (uint8_t*)data;
+    uint32_t got = readSome(p, len);
+    if (got < len && !segmentDone()) {
+      rb_.countUnderrun();
+      uint32_t t0 = millis();
+      while (got < len && open_) {
+        got += readSome(p + got, len - got);
+        if (got >= len || segmentDone()) break;
+        if (millis() - t0 > stallTimeoutMs_) { stall(); break; }   // red muerta
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5));
+      }
+      uint32_t stall = millis() - t0;
+      if (stall > maxStallMs_) maxStallMs_ = stall;
+    }
+    pos_ += got;
+    return got;
+  }
+
+  uint32_t readNonBlock(void* data, uint32_t len) override {
+    uint32_t got = readSome((uint8_t*)data, len);
+    pos_ += got;
+    return got;
+  }
+
+  // Se terminó el ítem actual (o todo el stream)
+  bool segmentDone() const {
+    uint32_t left;
+    if (rb_.segmentLeft(left)) return left == 0;
+    return rb_.eof() && rb_.available() == 0;
+  }
+
+  bool     seek(int32_t, int) override { return false; }  // stream lineal
+  bool     close() override   { open_ = false; return true; }
+  bool     isOpen() override  { return open_; }
+  uint32_t getSize() override { return 0; }
+  uint32_t getPos() override  { return pos_; }
+
+  uint32_t maxStallMs() const { return maxStallMs_; }
+  uint32_t stalls() const     { return stalls_; }
+  bool     stalled() const    { return stalled_; }   // el ítem actual se cortó por falta de datos
+  void     stall()            { if (!stalled_) { stalled_ = true; stalls_++; } }
+  uint32_t pos() const        { return pos_; }
+
+private:
+  // Lee sin pasar el límite del segmento actual
+  uint32_t readSome(uint8_t* p, uint32_t len) {
+    uint32_t avail = rb_.available();
+    uint32_t left;
+    if (rb_.segmentLeft(left) && avail > left) avail = left;
+    return rb_.read(p, len < avail ? len : avail);
+  }
+
+  AudioRingBuffer& rb_;
+  TaskHandle_t consumer_ = nullptr;
+  uint32_t stallTimeoutMs_ = 3000;
+  uint32_t pos_ = 0;
+  uint32_t maxStallMs_ = 0;
+  uint32_t stalls_ = 0;
+  volatile bool stalled_ = false;
+  volatile bool open_ = false;
+};
+
+// ====== Pipeline productor/consumidor ======
+// - Tarea "audio_net" (core 0, junto al stack WiFi): upstream->read() -> ring
+// - Tarea "audio_out" (core 1, prioridad alta): espera el prebuffer,
+//   gen->begin(ringSource, out) y gen->loop() hasta terminar.
+// - queueNext(): deja listo el ítem siguiente. La red lo empieza a bajar
+//   apenas termina el actual (cada ítem es un segmento del ring) y el
+//   decoder pasa de uno a otro sin vaciar el buffer ni cerrar la salida
+//   (usar AudioOutputKeepOpen como 'out').
+// El pipeline NO es dueño de upstream/gen/out: quien llama a play()
+// los crea; los de un ítem se pueden borrar cuando advances() avanza
+// (ya no es el actual) y todo el resto cuando isBusy() vuelve a false.
+class AudioPipeline {
+public:
+  struct Config {
+    size_t   ringBytes       = 32 * 1024;  // ~1 s de WAV 16 kHz/16 bit mono
+    size_t   prebufferBytes  = 8 * 1024;   // marca de agua antes de arrancar el decoder
+    uint32_t stallTimeoutMs  = 3000;       // sin datos tanto tiempo => fin, sin ok
+    uint32_t tailMaxBytes    = 1024;       // lo que el decoder puede dejar sin leer (chunks después de data)
+    uint16_t netChunk        = 1024;
+    uint8_t  netCore         = 0;
+    uint8_t  audioCore       = 1;
+    UBaseType_t netPrio      = 2;
+    UBaseType_t audioPrio    = configMAX_PRIORITIES - 2;
+    void (*onBegin)()        = nullptr;    // se llama tras gen->begin() OK
+  };
+
+  AudioPipeline() : src_(rb_) {}
+
+  bool begin(const Config& cfg) {
+    cfg_ = cfg;
+    if (!rb_.begin(cfg_.ringBytes)) return false;
+    netBuf_ = (uint8_t*)malloc(cfg_.netChunk);
+    if (!netBuf_) return false;
+    if (xTaskCreatePinnedToCore(netTaskThunk, "audio_net", 6144, this,   // +stack: tee a LittleFS
+                                cfg_.netPrio, &netTask_, cfg_.netCore) != pdPASS) return false;
+    if (xTaskCreatePinnedToCore(audioTaskThunk, "audio_out", 4096, this,
+                                cfg_.audioPrio, &audioTask_, cfg_.audioCore) != pdPASS) return false;
+    return true;
+  }
+
+  // Arranca la reproducción (no bloquea). false si ya hay algo sonando.
+  bool play(AudioFileSource* upstream, AudioGenerator* gen, AudioOutput* out,
+            AudioTee* tee = nullptr) {
+    if (isBusy()) return false;
+    rb_.reset();
+    items_[0] = { upstream, gen, tee };
+    queued_ = 1;
+    audioItem_ = 0;
+    advances_ = 0;
+    out_ = out;
+    ok_ = prevOk_ = false;
+    stopReq_ = false;
+    paused_ = false;
+    netRunning_ = true;
+    audioRunning_ = true;
+    src_.attach(audioTask_, cfg_.stallTimeoutMs);
+    xTaskNotifyGive(netTask_);
+    xTaskNotifyGive(audioTask_);
+    return true;
+  }
+
+  // Encola el ítem que sigue al actual (uno solo a la vez). false si
+  // no hay nada sonando (usar play()) o si ya hay uno esperando.
+  bool queueNext(AudioFileSource* upstream, AudioGenerator* gen, AudioTee* tee = nullptr) {
+    if (!isBusy() || stopReq_ || hasNext()) return false;
+    items_[queued_ & 1] = { upstream, gen, tee };
+    queued_ = queued_ + 1;
+    xTaskNotifyGive(netTask_);
+    return true;
+  }
+  bool hasNext() const { return queued_ > audioItem_ + 1; }
+
+  // Cuántas veces se pasó al ítem siguiente desde play(); prevOk() dice
+  // cómo terminó el último que quedó atrás
+  uint32_t advances() const { return advances_; }
+  bool     prevOk() const   { return prevOk_; }
+  uint32_t itemPos() const  { return src_.pos(); }   // bytes leídos por el decoder del ítem actual
+
+  // Pausa: el decoder deja de consumir y la salida queda en silencio; la red
+  // sigue hasta llenar el buffer y ahí espera, sin cerrar el socket
+  void setPaused(bool p) { paused_ = p; xTaskNotifyGive(audioTask_); }
+  bool paused() const    { return paused_; }
+
+  // Marca de agua del próximo play(): en bytes, así que depende del códec
+  void setPrebuffer(size_t bytes) { if (!isBusy()) cfg_.prebufferBytes = bytes; }
+
+  // Pide cortar y espera a que ambas tareas suelten los objetos
+  // (también descarta el ítem encolado)
+  void stop() {
+    stopReq_ = true;
+    src_.detach();
+    xTaskNotifyGive(netTask_);
+    xTaskNotifyGive(audioTask_);
+    while (isBusy()) vTaskDelay(pdMS_TO_TICKS(2));
+  }
+
+  bool isBusy() const   { return netRunning_ || audioRunning_; }
+  // El último ítem llegó entero y el decoder lo leyó hasta el final. false
+  // si se pidió stop(), si la red no lo bajó completo, si se cortó por
+  // stallTimeoutMs (lastStalled()) o si el decoder paró antes (error)
+  bool lastOk() const      { return ok_; }
+  bool lastStalled() const { return src_.stalled(); }
+  bool started() const  { return started_; }
+
+  AudioPipelineStats stats() const {
+    AudioPipelineStats s;
+    s.underruns  = rb_.underruns();
+    s.fill       = rb_.available();
+    s.minFill    = rb_.minFill();
+    s.capacity   = rb_.capacity();
+    s.bytesIn    = rb_.bytesIn();
+    s.bytesOut   = rb_.bytesOut();
+    s.maxStallMs = src_.maxStallMs();
+    s.stalls     = src_.stalls();
+    return s;
+  }
+
+private:
+  struct Item {
+    AudioFileSource* upstream;
+    AudioGenerator*  gen;
+    AudioTee*        tee;
+  };
+
+  static void netTaskThunk(void* p)   { ((AudioPipeline*)p)->netTask(); }
+  static void audioTaskThunk(void* p) { ((AudioPipeline*)p)->audioTask(); }
+
+  // Baja un ítem entero al ring. true si llegó completo.
+  bool pump(const Item& it) {
+    while (!stopReq_) {
+      uint32_t room = rb_.freeSpace();
+      if (room == 0) { vTaskDelay(pdMS_TO_TICKS(5)); continue; }
+      uint32_t want = room < cfg_.netChunk ? room : cfg_.netChunk;
+      uint32_t n = it.upstream->read(netBuf_, want);   // bloquea/reintenta adentro
+      if (n == 0) {                                     // EOF o red caída
+        uint32_t size = it.upstream->getSize();
+        return size == 0 || it.upstream->getPos() >= size;
+      }
+      rb_.write(netBuf_, n);
+      if (it.tee) it.tee->teeData(netBuf_, n);
+      xTaskNotifyGive(audioTask_);
+    }
+    return false;
+  }
+
+  void netTask() {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      if (!netRunning_) continue;
+      for (uint32_t k = 0; !stopReq_; k++) {
+        const Item& it = items_[k & 1];
+        bool complete = pump(it) && !stopReq_;
+        if (it.tee) it.tee->teeEnd(complete);
+        netOk_[k & 1] = complete;         // lo lee la tarea de audio al ver el fin del segmento
+        rb_.endSegment();                 // antes de escribir bytes del siguiente
+        xTaskNotifyGive(audioTask_);
+        // Esperar a que encolen otro ítem (o a que termine todo)
+        while (!stopReq_ && queued_ <= k + 1) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+      }
+      rb_.markEof();
+      xTaskNotifyGive(audioTask_);
+      netRunning_ = false;
+    }
+  }
+
+  // Prebuffer: no arrancar el decoder hasta la marca de agua (o fin del ítem)
+  void waitPrebuffer() {
+    uint32_t left;
+    while (!stopReq_ && !rb_.eof() && rb_.available() < cfg_.prebufferBytes &&
+           !rb_.segmentLeft(left)) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+  }
+
+  // Descarta lo que el decoder no leyó del ítem (p.ej. chunks al final del
+  // WAV), hasta tailMaxBytes: más que eso es que paró antes de tiempo
+  uint32_t drainSegment() {
+    uint8_t tmp[64];
+    uint32_t t0 = millis(), tail = 0;
+    while (!stopReq_ && !src_.segmentDone() && tail <= cfg_.tailMaxBytes) {
+      uint32_t n = src_.readNonBlock(tmp, sizeof(tmp));
+      tail += n;
+      if (n) continue;
+      if (millis() - t0 > cfg_.stallTimeoutMs) { src_.stall(); break; }
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5));
+    }
+    return tail;
+  }
+
+  // ¿El ítem actual terminó de verdad? Llegó entero, no se cortó por falta
+  // de datos y el decoder lo leyó hasta el final (salvo una cola corta)
+  bool itemEnded() {
+    uint32_t tail = drainSegment();
+    return !stopReq_ && tail <= cfg_.tailMaxBytes && src_.segmentDone() && !src_.stalled() &&
+           netOk_[audioItem_ & 1];
+  }
+
+  void audioTask() {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      if (!audioRunning_) continue;
+      started_ = false;
+      waitPrebuffer();
+
+      for (;;) {
+        AudioGenerator* gen = items_[audioItem_ & 1].gen;
+        bool decoded = false;
+        if (!stopReq_ && gen->begin(&src_, out_)) {
+          started_ = true;
+          if (cfg_.onBegin) cfg_.onBegin();
+          bool silenced = false;
+          while (!stopReq_ && gen->isRunning()) {
+            if (paused_) {
+              if (!silenced) { out_->flush(); silenced = true; }   // DMA en cero, sin zumbido
+              ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+              continue;
+            }
+            silenced = false;
+            if (!gen->loop()) break;
+            vTaskDelay(1);
+          }
+          decoded = !stopReq_;
+        }
+        if (gen->isRunning()) gen->stop();
+        bool ok = decoded && itemEnded();
+        ok_ = ok;
+
+        // ¿Hay otro ítem? Pasar sin soltar la salida ni el buffer
+        if (!ok || !hasNext()) break;
+        rb_.nextSegment();
+        src_.nextItem();
+        prevOk_ = ok;
+        audioItem_ = audioItem_ + 1;
+        advances_ = advances_ + 1;
+      }
+
+      // Si el decoder terminó antes que la red, cortar la descarga
+      stopReq_ = true;
+      src_.detach();
+      xTaskNotifyGive(netTask_);
+      while (netRunning_) vTaskDelay(pdMS_TO_TICKS(2));
+      audioRunning_ = false;
+    }
+  }
+
+  Config cfg_;
+  AudioRingBuffer rb_;
+  AudioFileSourceRing src_;
+  uint8_t* netBuf_ = nullptr;
+  TaskHandle_t netTask_ = nullptr;
+  TaskHandle_t audioTask_ = nullptr;
+
+  Item items_[2];                    // actual y siguiente (índice & 1)
+  AudioOutput* out_ = nullptr;
+  volatile uint32_t queued_ = 0;     // ítems encolados desde play()
+  volatile uint32_t audioItem_ = 0;  // el que está decodificando
+  volatile uint32_t advances_ = 0;
+
+  volatile bool stopReq_ = false;
+  volatile bool paused_ = false;
+  volatile bool netRunning_ = false;
+  volatile bool audioRunning_ = false;
+  volatile bool started_ = false;
+  volatile bool ok_ = false;
+  volatile bool prevOk_ = false;
+  volatile bool netOk_[2] = { false, false };   // el ítem (k & 1) bajó completo
+};
+
+#endif // ARDUINO
@@ -0,0 +1,255 @@
+/****************************************************
+ * Caché LRU de clips de audio en LittleFS
+ * - Clave: clip_id (hash del WAV que manda el server)
+ * - Archivos en /clips/<clip_id>.wav, con presupuesto
+ *   de bytes; al pasarse se borra el menos usado
+ * - Se llena "de paso" mientras se reproduce por red
+ *   (AudioPipeline llama a write/commit desde la tarea
+ *   de red) y con el precalentamiento de frases al boot
+ * - El orden LRU vive en RAM: al reiniciar se arma con
+ *   el orden del directorio
+ * - Un clip abierto para reproducir queda fijado
+ *   (acquire/release) y no se expulsa; una entrada sólo
+ *   se saca si su archivo se pudo borrar
+ * - Un solo escritor a la vez (la red o el prewarm):
+ *   beginWrite() le da un token y write/commit/abort lo
+ *   validan con el mutex. Si la escritura se cortó por
+ *   dentro, el token viejo ya no toca la del siguiente
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+
+class ClipCache {
+public:
+  static const uint8_t MAX_CLIPS = 64;
+  static const uint8_t KEY_LEN   = 33;    // md5 hex + '\0'
+
+  typedef uint32_t Token;                 // 0 = sin escritura
+
+  struct Stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t bytesUsed;
+    uint32_t budget;
+    uint8_t  entries;
+  };
+
+  bool begin(uint32_t budgetBytes) {
+    budget_ = budgetBytes;
+    mutex_ = xSemaphoreCreateMutex();
+    if (!LittleFS.begin(true)) return false;     // formatea si no hay FS
+    if (!LittleFS.exists(DIR)) LittleFS.mkdir(DIR);
+    LittleFS.remove(TMP);                        // escritura cortada por un reset
+
+    File dir = LittleFS.open(DIR);
+    for (File f = dir.openNextFile(); f && count_ < MAX_CLIPS; f = dir.openNextFile()) {
+      const char* name = strrchr(f.name(), '/');
+      name = name ? name + 1 : f.name();
+      const char* dot = strstr(name, ".wav");
+      if (!dot || dot - name >= KEY_LEN) continue;
+      Entry& e = entries_[count_++];
+      memcpy(e.key, name, dot - name);
+      e.key[dot - name] = '\0';
+      e.size = f.size();
+      e.lastUse = ++clock_;
+      e.pins = 0;
+      used_ += e.size;
+    }
+    evictUntil(budget_);
+    return true;
+  }
+
+  // ¿Está el clip? Cuenta hit/miss, lo marca como recién usado y lo
+  // fija hasta release(): mientras suena no se expulsa ni se reemplaza
+  bool acquire(const char* key, char* path, size_t pathLen) {
+    lock();
+    int i = find(key);
+    if (i >= 0) { entries_[i].lastUse = ++clock_; entries_[i].pins++; hits_++; }
+    else        { misses_++; }
+    unlock();
+    if (i < 0) return false;
+    makePath(key, path, pathLen);
+    return true;
+  }
+
+  // Con el archivo ya cerrado
+  void release(const char* key) {
+    lock();
+    int i = find(key);
+    if (i >= 0 && entries_[i].pins) entries_[i].pins--;
+    unlock();
+  }
+
+  bool contains(const char* key) {
+    lock();
+    bool r = find(key) >= 0;
+    unlock();
+    return r;
+  }
+
+  // ---- Escritura (un clip a la vez) ----
+  // expectedSize = 0 si no se conoce (chunked); si se conoce, commit()
+  // exige justo esos bytes. Devuelve 0 si hay otro escribiendo o no hay lugar
+  Token beginWrite(const char* key, uint32_t expectedSize) {
+    if (!key || !*key || strlen(key) >= KEY_LEN || expectedSize > budget_) return 0;
+    lock();
+    // Un solo escritor; sin lugar (lo que sobra está fijado) no vale la pena bajarlo
+    if (token_ || !evictUntil(budget_ - expectedSize)) { unlock(); return 0; }
+    wf_ = LittleFS.open(TMP, "w");
+    Token t = 0;
+    if (wf_) {
+      if (!++tokens_) ++tokens_;
+      t = token_ = tokens_;
+      strlcpy(wkey_, key, KEY_LEN);
+      wsize_ = 0;
+      wexpected_ = expectedSize;
+    }
+    unlock();
+    return t;
+  }
+
+  // false si el token ya no escribe (abortado por dentro): no insistir
+  bool write(Token t, const uint8_t* data, uint32_t len) {
+    lock();
+    bool ok = t && t == token_;
+    if (ok && (wsize_ + len > budget_ || wf_.write(data, len) != len)) {
+      abortLocked();
+      ok = false;
+    }
+    if (ok) wsize_ += len;
+    unlock();
+    return ok;
+  }
+
+  bool commit(Token t) {
+    lock();
+    if (!t || t != token_) { unlock(); return false; }
+    if (wexpected_ && wsize_ != wexpected_) {   // cortado: no se guarda a medias
+      abortLocked();
+      unlock();
+      return false;
+    }
+    wf_.close();
+    token_ = 0;
+    char path[48];
+    makePath(wkey_, path, sizeof(path));
+    int i = find(wkey_);
+    // Reemplazo: no si el de antes está sonando (es el mismo hash, se queda ese)
+    bool ok = i < 0 || (!entries_[i].pins && removeAt(i));
+    ok = ok && evictUntil(budget_ - wsize_) && count_ < MAX_CLIPS && LittleFS.rename(TMP, path);
+    if (ok) {
+      Entry& e = entries_[count_++];
+      strlcpy(e.key, wkey_, KEY_LEN);
+      e.size = wsize_;
+      e.lastUse = ++clock_;
+      e.pins = 0;
+      used_ += wsize_;
+    } else {
+      LittleFS.remove(TMP);
+    }
+    unlock();
+    return ok;
+  }
+
+  void abort(Token t) {
+    lock();
+    if (t && t == token_) abortLocked();
+    unlock();
+  }
+
+  uint32_t freeBudget() const { return used_ < budget_ ? budget_ - used_ : 0; }
+
+  Stats stats() {
+    lock();
+    Stats s = { hits_, misses_, evictions_, used_, budget_, count_ };
+    unlock();
+    return s;
+  }
+
+private:
+  struct Entry {
+    char     key[KEY_LEN];
+    uint32_t size;
+    uint32_t lastUse;
+    uint8_t  pins;      // voces con el archivo abierto
+  };
+
+  static constexpr const char* DIR = "/clips";
+  static constexpr const char* TMP = "/clips/.tmp";
+
+  void lock()   { if (mutex_) xSemaphoreTake(mutex_, portMAX_DELAY); }
+  void unlock() { if (mutex_) xSemaphoreGive(mutex_); }
+
+  // Con el mutex tomado
+  void abortLocked() {
+    wf_.close();
+    LittleFS.remove(TMP);
+    token_ = 0;
+  }
+
+  static void makePath(const char* key, char* path, size_t len) {
+    snprintf(path, len, "%s/%s.wav", DIR, key);
+  }
+
+  int find(const char* key) const {
+    for (uint8_t i = 0; i < count_; i++)
+      if (!strcmp(entries_[i].key, key)) return i;
+    return -1;
+  }
+
+  // Si el archivo no se puede borrar, la entrada se queda: sacarla dejaría
+  // un archivo huérfano que ya no cuenta en used_
+  bool removeAt(int i) {
+    char path[48];
+    makePath(entries_[i].key, path, sizeof(path));
+    if (!LittleFS.remove(path) && LittleFS.exists(path)) return false;
+    used_ -= entries_[i].size;
+    entries_[i] = entries_[--count_];
+    return true;
+  }
+
+  // Borra los menos usados, salteando los fijados, hasta que used_ <= limit
+  // (con el mutex tomado). false si no alcanza
+  bool evictUntil(uint32_t limit) {
+    uint64_t skip = 0;                           // bit por entrada que no se puede borrar
+    while (used_ > limit) {
+      int lru = -1;
+      for (uint8_t i = 0; i < count_; i++) {
+        if (entries_[i].pins || (skip >> i & 1)) continue;
+        if (lru < 0 || entries_[i].lastUse < entries_[lru].lastUse) lru = i;
+      }
+      if (lru < 0) return false;
+      Entry e = entries_[lru];
+      if (!removeAt(lru)) {
+        Serial.printf("⚠️ Caché: no se pudo borrar %s\n", e.key);
+        skip |= 1ULL << lru;
+        continue;
+      }
+      // removeAt movió la última entrada a lru
+      if (skip >> count_ & 1) { skip &= ~(1ULL << count_); skip |= 1ULL << lru; }
+      Serial.printf("🗑️ Caché: expulsa %s (%u B)\n", e.key, e.size);
+      evictions_++;
+    }
+    return true;
+  }
+
+  Entry    entries_[MAX_CLIPS];
+  uint8_t  count_ = 0;
+  uint32_t clock_ = 0;
+  uint32_t used_ = 0;
+  uint32_t budget_ = 0;
+  uint32_t hits_ = 0, misses_ = 0, evictions_ = 0;
+  SemaphoreHandle_t mutex_ = nullptr;
+
+  // Escritura en curso: todo con el mutex tomado
+  File     wf_;
+  char     wkey_[KEY_LEN];
+  uint32_t wsize_ = 0;
+  uint32_t wexpected_ = 0;
+  Token    token_ = 0;                   // el del escritor actual, 0 = nadie
+  Token    tokens_ = 0;                  // el último que se dio
+};
@@ -0,0 +1,295 @@
+/****************************************************
+ * Canal de comandos server -> ESP32
+ * - Una sola conexión HTTP/1.1 keep-alive por device
+ * - Long-poll sobre /esp32/poll/{id}?wait=N: el server
+ *   retiene la respuesta hasta que hay un comando
+ * - Si el server no manda "X-Long-Poll" (server viejo)
+ *   o falla seguido, cae a poll normal cada N ms
+ * - Reconexión con backoff exponencial
+ * - Varios comandos por respuesta (?lote=N, según el
+ *   lugar libre en la cola local), todos en orden
+ * - Corre en su propia tarea (core 0): loop() nunca se
+ *   bloquea esperando al server
+ * - Sin heap propio en régimen: URLs armadas al inicio,
+ *   JSON en documentos estáticos, comandos como char[] en
+ *   la cola, despacho por tabla (CommandRoute) y ningún
+ *   String (los headers se piden una vez). HTTPClient sí
+ *   usa String por dentro para armar el pedido y leer
+ *   los headers. Lo verifica SimuladorHost/pruebas/
+ *   prueba_heap_poll.cpp
+ * - RTT del poll (opcional, Config::rtt): lo que tardó
+ *   el GET menos lo que el server retuvo la respuesta
+ *   ("retenido_ms" en el JSON: leer el header pediría un
+ *   String), o sea red + server
+ * - De cada comando se guardan sólo los campos que usan
+ *   los handlers (Config::campos, filtro de ArduinoJson):
+ *   un texto largo (texto_robot de /control/conversar)
+ *   se salta al parsear, no llena doc_ ni el slot
+ * - Si la respuesta no se puede parsear se lee hasta el
+ *   final contando los comandos (ContadorComandos, como
+ *   PollComandos): el server ya los sacó de la cola, van
+ *   a Stats::lost
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include <Telemetria.h>
+#include <PollComandos.h>   // ContadorComandos
+
+// ====== Despacho de comandos por tabla ======
+// Cada sketch arma un array { "tipo", handler } y routeCommand busca
+// el tipo con strcmp: sin Strings ni cadena de if/else.
+struct CommandRoute {
+  const char* tipo;
+  void (*handler)(JsonObject cmd, uint32_t tRecv);
+};
+
+// false si el tipo no está en la tabla (el sketch decide qué hacer)
+template <size_t N>
+bool routeCommand(const CommandRoute (&routes)[N], JsonObject cmd, uint32_t tRecv) {
+  const char* tipo = cmd["tipo"] | "";
+  for (size_t i = 0; i < N; i++) {
+    if (!strcmp(routes[i].tipo, tipo)) {
+      routes[i].handler(cmd, tRecv);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Campos que guarda CommandChannel si el sketch no da los suyos: los de
+// los handlers de Vocesconwifiperfecto.cpp
+const char* const CMD_CAMPOS[] = { "tipo", "audio_id", "clip_id", "formato", "flujo",
+                                   "modo", "seq", "volume", nullptr };
+
+class CommandChannel {
+public:
+  static const uint8_t MAX_CAMPOS = 16;
+
+  struct Config {
+    const char* baseUrl        = nullptr;
+    const char* deviceId       = nullptr;
+    uint16_t    waitS          = 20;      // long-poll (server limita a 25 s)
+    uint32_t    pollIntervalMs = 200;     // modo fallback
+    uint32_t    backoffMinMs   = 500;
+    uint32_t    backoffMaxMs   = 15000;
+    uint32_t    pushRetryMs    = 60000;   // cada cuánto reintentar long-poll tras caer a poll
+    uint8_t     queueLen       = 8;
+    uint8_t     batchMax       = 4;       // comandos por respuesta (entran en doc_)
+    uint8_t     core           = 0;
+    telemetria::Histograma* rtt = nullptr;   // ms, sin la espera del long-poll
+    const char* const* campos = CMD_CAMPOS;  // hasta MAX_CAMPOS, nullptr al final
+  };
+
+  // Un comando ya recibido, como JSON compacto (sólo Config::campos)
+  static const size_t CMD_JSON_LEN = 512;
+  struct Command {
+    uint32_t tRecv;                      // millis() al llegar al ESP32
+    char     json[CMD_JSON_LEN];
+  };
+
+  struct Stats {
+    uint32_t requests;
+    uint32_t commands;
+    uint32_t errors;
+    uint32_t dropped;                    // cola local llena o comando sin lugar en el slot
+    uint32_t lost;                       // en respuestas que no se pudieron parsear
+    bool     push;                       // true = long-poll activo
+  };
+
+  bool begin(const Config& cfg) {
+    cfg_ = cfg;
+    JsonObject campos = filtro_.createNestedArray("comandos").createNestedObject();
+    for (uint8_t i = 0; cfg_.campos && cfg_.campos[i] && i < MAX_CAMPOS; i++) campos[cfg_.campos[i]] = true;
+    filtro_["retenido_ms"] = true;
+    snprintf(urlPoll_, sizeof(urlPoll_), "%s/esp32/poll/%s", cfg_.baseUrl, cfg_.deviceId);
+    queue_ = xQueueCreate(cfg_.queueLen, sizeof(Command));
+    if (!queue_) return false;
+    return xTaskCreatePinnedToCore(taskThunk, "cmd_chan", 8192, this, 1, &task_, cfg_.core) == pdPASS;
+  }
+
+  // Pide parar: la tarea termina cuando vuelve el pedido en curso (un
+  // long-poll sin comandos tarda hasta waitS). La cola sigue leyéndose
+  void end() { stop_ = true; }
+  bool activo() const { return task_ != nullptr; }
+
+  // Saca el próximo comando (no bloquea salvo que se pida 'wait')
+  bool receive(Command& out, TickType_t wait = 0) {
+    return queue_ && xQueueReceive(queue_, &out, wait) == pdTRUE;
+  }
+
+  Stats stats() const {
+    Stats s;
+    s.requests = requests_;
+    s.commands = commands_;
+    s.errors   = errors_;
+    s.dropped  = dropped_;
+    s.lost     = lost_;
+    s.push     = push_;
+    return s;
+  }
+
+private:
+  // Lo que lee deserializeJson pasa por acá: cuenta bytes y comandos
+  class StreamContado : public Stream {
+  public:
+    void reset(Stream* s) { s_ = s; bytes = 0; cuenta = ContadorComandos(); }
+    int available() override { return s_->available(); }
+    int peek() override { return s_->peek(); }
+    int read() override {
+      int c = s_->read();
+      if (c >= 0) { bytes++; cuenta.ver((char)c); }
+      return c;
+    }
+    size_t write(uint8_t) override { return 0; }
+    size_t           bytes = 0;
+    ContadorComandos cuenta;
+  private:
+    Stream* s_ = nullptr;
+  };
+
+  static void taskThunk(void* p) { ((CommandChannel*)p)->task(); }
+
+  void task() {
+    static const char* HEADERS[] = { "X-Long-Poll" };
+    http_.setReuse(true);
+    http_.collectHeaders(HEADERS, 1);   // una vez: cada llamada hace new[]
+    uint32_t backoff = cfg_.backoffMinMs;
+    uint8_t  pushFails = 0;
+    uint32_t tFallback = 0;
+
+    while (!stop_) {
+      if (WiFi.status() != WL_CONNECTED) { vTaskDelay(pdMS_TO_TICKS(500)); continue; }
+
+      // Volver a probar long-poll un rato después de haber caído a poll
+      if (!push_ && tFallback && millis() - tFallback > cfg_.pushRetryMs) {
+        push_ = true;
+        tFallback = 0;
+      }
+
+      // Pedir solo lo que entra en la cola: lo que sobra queda en el server
+      UBaseType_t room = uxQueueSpacesAvailable(queue_);
+      if (!room) { vTaskDelay(pdMS_TO_TICKS(50)); continue; }
+      uint8_t lote = room < cfg_.batchMax ? room : cfg_.batchMax;
+      if (push_) snprintf(urlReq_, sizeof(urlReq_), "%s?wait=%u&lote=%u", urlPoll_, cfg_.waitS, lote);
+      else       snprintf(urlReq_, sizeof(urlReq_), "%s?lote=%u", urlPoll_, lote);
+
+      uint32_t t0 = millis();
+      http_.setTimeout(push_ ? (cfg_.waitS + 5) * 1000 : 5000);
+      if (!http_.begin(urlReq_)) {
+        errors_++;
+        vTaskDelay(pdMS_TO_TICKS(backoff));
+        backoff = min(backoff * 2, cfg_.backoffMaxMs);
+        continue;
+      }
+      int code = http_.GET();
+      requests_++;
+
+      if (code == HTTP_CODE_OK) {
+        bool serverPush = http_.hasHeader("X-Long-Poll");
+        uint32_t ms = millis() - t0;
+        int len = http_.getSize();
+        leido_.reset(&http_.getStream());
+        leido_.setTimeout(3000);
+        DeserializationError e = deserializeJson(doc_, leido_, DeserializationOption::Filter(filtro_));
+        if (e) drain(len);   // contar lo que falta y no dejar basura en la conexión
+        http_.end();   // con reuse deja la conexión abierta
+        backoff = cfg_.backoffMinMs;
+        pushFails = 0;
+
+        size_t n = 0;
+        if (e) {
+          errors_++;
+          lost_ += leido_.cuenta.n;
+          Serial.printf("JSON poll error: %s, %lu comandos perdidos\n", e.c_str(),
+                        (unsigned long)leido_.cuenta.n);
+        } else {
+          n = dispatch(doc_["comandos"].as<JsonArray>());
+          if (cfg_.rtt) {
+            uint32_t retenido = doc_["retenido_ms"] | 0;
+            cfg_.rtt->registrar(ms > retenido ? ms - retenido : 0);
+          }
+        }
+
+        if (push_ && !serverPush) {
+          Serial.println("ℹ️ Server sin long-poll, usando poll normal");
+          push_ = false;
+          tFallback = millis();
+        }
+        // En long-poll se vuelve a pedir enseguida; en poll se respeta el
+        // intervalo, salvo que el lote vino lleno (quedan más en el server)
+        if (!push_ && n < lote) waitUntil(t0 + cfg_.pollIntervalMs);
+      } else {
+        http_.end();
+        errors_++;
+        Serial.printf("Poll -> %d (reintento en %u ms)\n", code, backoff);
+        if (push_ && ++pushFails >= 3) {
+          Serial.println("⚠️ Long-poll falla seguido, cayendo a poll normal");
+          push_ = false;
+          tFallback = millis();
+        }
+        vTaskDelay(pdMS_TO_TICKS(backoff));
+        backoff = min(backoff * 2, cfg_.backoffMaxMs);
+      }
+    }
+    http_.end();
+    task_ = nullptr;
+    vTaskDelete(nullptr);
+  }
+
+  // Encola los comandos en orden; devuelve cuántos vinieron
+  size_t dispatch(JsonArray cmds) {
+    if (cmds.isNull()) return 0;
+    for (JsonObject c : cmds) {
+      slot_.tRecv = millis();
+      // measureJson no cuenta el '\0': uno de sizeof-1 justo entra
+      if (measureJson(c) >= sizeof(slot_.json)) {
+        Serial.println("⚠️ Comando demasiado largo, descartado");
+        dropped_++;
+        continue;
+      }
+      serializeJson(c, slot_.json, sizeof(slot_.json));
+      if (xQueueSend(queue_, &slot_, 0) != pdTRUE) dropped_++;
+      else commands_++;
+    }
+    return cmds.size();
+  }
+
+  // Lee lo que quedó de la respuesta (hasta Content-Length o hasta que el
+  // server cierra) sólo para contarlo
+  void drain(int len) {
+    uint32_t t0 = millis();
+    while ((len < 0 || leido_.bytes < (size_t)len) && millis() - t0 < 3000) {
+      if (leido_.read() >= 0) continue;
+      if (!http_.connected()) break;
+      vTaskDelay(1);
+    }
+  }
+
+  static void waitUntil(uint32_t t) {
+    int32_t left = (int32_t)(t - millis());
+    if (left > 0) vTaskDelay(pdMS_TO_TICKS(left));
+  }
+
+  Config cfg_;
+  HTTPClient http_;
+  StaticJsonDocument<4096> doc_;         // hasta batchMax comandos, ya filtrados
+  StaticJsonDocument<JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(1) + JSON_OBJECT_SIZE(MAX_CAMPOS)> filtro_;
+  StreamContado leido_;
+  Command slot_;
+  char urlPoll_[160];
+  char urlReq_[192];
+  QueueHandle_t queue_ = nullptr;
+  TaskHandle_t  task_  = nullptr;
+
+  volatile bool     push_     = true;
+  volatile bool     stop_     = false;
+  volatile uint32_t requests_ = 0;
+  volatile uint32_t commands_ = 0;
+  volatile uint32_t errors_   = 0;
+  volatile uint32_t dropped_  = 0;
+  volatile uint32_t lost_     = 0;
+};
@@ -0,0 +1,67 @@
+/****************************************************
+ * Monitor de heap para el ESP32
+ * - Heap libre, mínimo histórico y bloque libre más
+ *   grande (si el bloque se achica con el heap libre
+ *   estable, hay fragmentación)
+ * - Avisa una vez cuando el bloque más grande baja del
+ *   umbral: ahí los new de HTTP/MP3 empiezan a fallar
+ * - Sin heap propio: todo en variables del objeto
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+
+class HeapMonitor {
+public:
+  struct Stats {
+    uint32_t freeNow;
+    uint32_t freeMin;        // mínimo desde el boot (lo lleva el IDF)
+    uint32_t largestBlock;
+    uint32_t largestMin;     // bloque más grande mínimo visto
+    uint8_t  fragPct;        // 100 - bloque / libre
+  };
+
+  explicit HeapMonitor(uint32_t warnBlock = 16 * 1024) : warnBlock_(warnBlock) {}
+
+  void sample() {
+    freeNow_ = ESP.getFreeHeap();
+    largest_ = ESP.getMaxAllocHeap();
+    if (largest_ < largestMin_) largestMin_ = largest_;
+    if (largest_ < warnBlock_ && !warned_) {
+      warned_ = true;
+      Serial.printf("⚠️ Heap fragmentado: bloque máx %u B (libre %u B)\n", largest_, freeNow_);
+    }
+  }
+
+  // true cada 'intervalMs' (muestrea de paso)
+  bool due(uint32_t intervalMs) {
+    if (millis() - tLast_ < intervalMs) return false;
+    tLast_ = millis();
+    sample();
+    return true;
+  }
+
+  Stats stats() const {
+    Stats s;
+    s.freeNow      = freeNow_;
+    s.freeMin      = ESP.getMinFreeHeap();
+    s.largestBlock = largest_;
+    s.largestMin   = largestMin_;
+    s.fragPct      = freeNow_ ? 100 - (uint64_t)largest_ * 100 / freeNow_ : 0;
+    return s;
+  }
+
+  void print() const {
+    Stats s = stats();
+    Serial.printf("🧠 heap %u (min %u) | bloque %u (min %u) | frag %u%%\n",
+                  s.freeNow, s.freeMin, s.largestBlock, s.largestMin, s.fragPct);
+  }
+
+private:
+  uint32_t warnBlock_;
+  uint32_t freeNow_ = 0;
+  uint32_t largest_ = 0;
+  uint32_t largestMin_ = 0xFFFFFFFF;
+  uint32_t tLast_ = 0;
+  bool     warned_ = false;
+};
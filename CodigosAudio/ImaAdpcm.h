@@ -0,0 +1,228 @@
+/****************************************************
+ * IMA-ADPCM (WAV formato 0x11) para el ESP32
+ * - ImaAdpcm: decoder de bloques, sin dependencias;
+ *   compila también en host (g++ normal) para
+ *   compararlo contra el encoder del server
+ * - AudioGeneratorIMA (solo ESP32): generador para
+ *   ESP8266Audio que lee WAV IMA-ADPCM mono (4:1) y
+ *   también WAV PCM 16 bit, así los clips viejos de
+ *   la caché siguen sonando con el mismo generador
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef ARDUINO
+  #include <Arduino.h>
+  #include <AudioGenerator.h>
+#endif
+
+// ====== Tablas estándar (IMA/DVI) ======
+static const int16_t IMA_STEP[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+  12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int8_t IMA_INDEX[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+// ====== Decoder de bloques ======
+// Bloque mono: predictor int16 LE + índice + 1 byte reservado, después
+// 2 muestras por byte (nibble bajo primero). La primera muestra del
+// bloque es el predictor. Mismo algoritmo que wav_a_ima() en el server.
+class ImaAdpcm {
+public:
+  struct State {
+    int32_t pred;
+    int32_t index;
+  };
+
+  static int16_t decodeNibble(State& s, uint8_t n) {
+    int32_t step = IMA_STEP[s.index];
+    int32_t diff = step >> 3;
+    if (n & 4) diff += step;
+    if (n & 2) diff += step >> 1;
+    if (n & 1) diff += step >> 2;
+    s.pred += (n & 8) ? -diff : diff;
+    if (s.pred > 32767)  s.pred = 32767;
+    if (s.pred < -32768) s.pred = -32768;
+    s.index += IMA_INDEX[n & 0x0F];
+    if (s.index < 0)  s.index = 0;
+    if (s.index > 88) s.index = 88;
+    return (int16_t)s.pred;
+  }
+
+  // Decodifica un bloque (el último puede venir más corto). Devuelve muestras.
+  static size_t decodeBlock(const uint8_t* blk, size_t len, int16_t* out) {
+    if (len < 4) return 0;
+    State s;
+    s.pred  = (int16_t)(blk[0] | (blk[1] << 8));
+    s.index = blk[2] > 88 ? 88 : blk[2];
+    size_t n = 0;
+    out[n++] = (int16_t)s.pred;
+    for (size_t i = 4; i < len; i++) {
+      out[n++] = decodeNibble(s, blk[i] & 0x0F);
+      out[n++] = decodeNibble(s, blk[i] >> 4);
+    }
+    return n;
+  }
+};
+
+#ifdef ARDUINO
+
+// ====== Generador WAV (IMA-ADPCM o PCM 16 bit) ======
+// Lee la fuente en forma lineal (sirve con el ring buffer del
+// AudioPipeline, que no tiene seek): header, un bloque por vez,
+// y entrega muestras a la salida igual que AudioGeneratorWAV.
+class AudioGeneratorIMA : public AudioGenerator {
+public:
+  static const uint16_t MAX_BLOCK = 1024;
+
+  ~AudioGeneratorIMA() override { stop(); }
+
+  bool begin(AudioFileSource* src, AudioOutput* out) override {
+    if (!src || !out) return false;
+    file = src;
+    output = out;
+    if (!readHeader()) {
+      Serial.println("❌ WAV: formato no soportado");
+      return false;
+    }
+    output->SetRate(rate_);
+    output->SetBitsPerSample(16);
+    output->SetChannels(channels_);
+    if (!output->begin()) return false;
+    pcmLen_ = pcmPos_ = 0;
+    lastSample[0] = lastSample[1] = 0;
+    running = true;
+    // La primera muestra ya en lastSample: loop() no arranca mandando un
+    // cero (entre clips encolados sería un clic)
+    if (!nextSample()) stop();
+    return true;
+  }
+
+  bool loop() override {
+    if (running && output->ConsumeSample(lastSample)) {
+      do {
+        if (!nextSample()) { stop(); break; }
+      } while (output->ConsumeSample(lastSample));
+    }
+    file->loop();
+    output->loop();
+    return running;
+  }
+
+  bool stop() override {
+    if (!running) return true;
+    running = false;
+    output->stop();
+    return file->close();
+  }
+
+  bool isRunning() override { return running; }
+
+  bool isAdpcm() const { return ima_; }
+
+private:
+  uint32_t readFully(void* buf, uint32_t len) {
+    uint8_t* p = (uint8_t*)buf;
+    uint32_t got = 0;
+    while (got < len) {
+      uint32_t n = file->read(p + got, len - got);
+      if (n == 0) break;
+      got += n;
+    }
+    return got;
+  }
+
+  bool skip(uint32_t len) {
+    while (len) {
+      uint32_t n = len < sizeof(block_) ? len : sizeof(block_);
+      if (readFully(block_, n) != n) return false;
+      len -= n;
+    }
+    return true;
+  }
+
+  static uint16_t u16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+  static uint32_t u32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+  bool readHeader() {
+    uint8_t h[20];
+    if (readFully(h, 12) != 12 || memcmp(h, "RIFF", 4) || memcmp(h + 8, "WAVE", 4)) return false;
+    bool fmtOk = false;
+    samplesLeft_ = 0xFFFFFFFF;
+    for (;;) {
+      if (readFully(h, 8) != 8) return false;
+      uint32_t size = u32(h + 4);
+      uint32_t pad = size & 1;
+      if (!memcmp(h, "fmt ", 4)) {
+        uint32_t n = size < sizeof(h) ? size : sizeof(h);
+        if (n < 16 || readFully(h, n) != n || !skip(size - n + pad)) return false;
+        uint16_t format = u16(h);
+        channels_   = u16(h + 2);
+        rate_       = u32(h + 4);
+        blockAlign_ = u16(h + 12);
+        uint16_t bits = u16(h + 14);
+        ima_ = format == 0x11;
+        if (ima_) {
+          if (bits != 4 || channels_ != 1 || blockAlign_ < 5 || blockAlign_ > MAX_BLOCK) return false;
+        } else {
+          if (format != 1 || bits != 16 || channels_ < 1 || channels_ > 2) return false;
+          blockAlign_ = sizeof(block_) & ~3u;   // PCM: se lee de a bloques arbitrarios
+        }
+        fmtOk = true;
+      } else if (!memcmp(h, "fact", 4) && size >= 4) {
+        if (readFully(h, 4) != 4 || !skip(size - 4 + pad)) return false;
+        samplesLeft_ = u32(h);
+      } else if (!memcmp(h, "data", 4)) {
+        dataLeft_ = size;
+        return fmtOk;
+      } else if (!skip(size + pad)) {
+        return false;
+      }
+    }
+  }
+
+  // Rellena pcm_ con el próximo bloque. false al terminar los datos.
+  bool refill() {
+    uint32_t want = dataLeft_ < blockAlign_ ? dataLeft_ : blockAlign_;
+    uint32_t got = readFully(block_, want);
+    dataLeft_ -= got;
+    if (ima_) {
+      pcmLen_ = ImaAdpcm::decodeBlock(block_, got, pcm_);
+      if (pcmLen_ > samplesLeft_) pcmLen_ = samplesLeft_;   // relleno del último bloque
+      samplesLeft_ -= pcmLen_;
+    } else {
+      pcmLen_ = got / 2;
+      for (uint32_t i = 0; i < pcmLen_; i++) pcm_[i] = (int16_t)u16(block_ + 2 * i);
+      pcmLen_ -= pcmLen_ % channels_;
+    }
+    pcmPos_ = 0;
+    return pcmLen_ > 0;
+  }
+
+  bool nextSample() {
+    if (pcmPos_ >= pcmLen_ && !refill()) return false;
+    lastSample[AudioOutput::LEFTCHANNEL] = pcm_[pcmPos_++];
+    lastSample[AudioOutput::RIGHTCHANNEL] =
+        channels_ == 2 ? pcm_[pcmPos_++] : lastSample[AudioOutput::LEFTCHANNEL];
+    return true;
+  }
+
+  uint8_t  block_[MAX_BLOCK];
+  int16_t  pcm_[1 + (MAX_BLOCK - 4) * 2];
+  uint32_t pcmLen_ = 0, pcmPos_ = 0;
+  uint32_t dataLeft_ = 0;
+  uint32_t samplesLeft_ = 0;
+  uint32_t rate_ = 16000;
+  uint16_t channels_ = 1;
+  uint16_t blockAlign_ = 256;
+  bool     ima_ = false;
+};
+
+#endif // ARDUINO
@@ -1,12 +1,37 @@
 /*
- * ESP32 - Test de Comunicación con Servidor (SIN AUDIO)
+ * ESP32 - Música Audius por streaming (MP3)
  * Basado en código que funciona con ngrok
+ * Comandos por long-poll (CommandChannel.h), con fallback a poll cada 2 s
+ * - MP3 desde /music/audius/stream/{track_id}: red -> buffer -> DAC
+ *   en tareas separadas (AudioPipeline.h)
+ * - Seek con HTTP Range (AudioFileSourceHTTPRange.h), sin volver a
+ *   bajar desde el principio
+ * - Pausa sin cerrar el socket ni vaciar el buffer
+ * - Volumen en la ganancia de la salida (inmediato)
+ * - Posición y buffer se reportan a /control/musica_estado/{id}
+ * - Cola de tracks ("modo": "cola"): el siguiente se abre y se baja
+ *   mientras suena el actual, y la salida no se cierra entre tracks
+ * - Comandos sin heap: URLs en buffers fijos, JSON estático,
+ *   campos como char[] y despacho por tabla (HeapMonitor.h vigila)
+ * - Salida por DAC interno: GPIO25 (L) y GPIO26 (R)
  */
 
 #include <Arduino.h>
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include "CommandChannel.h"
+#include "HeapMonitor.h"
+
+// ===== Audio (ESP8266Audio) =====
+#include <AudioGeneratorMP3.h>
+#include <AudioOutputI2SNoDAC.h>          // DAC interno ESP32 (GPIO25/26)
+#include "AudioPipeline.h"                 // ring buffer + tareas red/audio
+#include "AudioFileSourceHTTPRange.h"      // stream con seek por Range
+
+extern "C" {
+  #include "driver/i2s.h"
+}
 
 // ========== CONFIGURACIÓN WIFI ==========
 const char* WIFI_SSID = "Juanma";
@@ -17,26 +42,136 @@ const char* BASE_URL = "http://choreal-kalel-directed.ngrok-free.dev";
 const char* DEVICE_ID = "esp32-01";
 
 // ========== VARIABLES GLOBALES ==========
-unsigned long tPoll = 0;
-const unsigned long POLL_INTERVAL = 2000; // Polling cada 2 segundos
+const unsigned long POLL_INTERVAL = 2000; // Polling cada 2 segundos (solo si no hay long-poll)
+const unsigned long HEAP_INTERVAL = 30000; // log de heap
+CommandChannel channel;
+StaticJsonDocument<768> cmdDoc;
+HeapMonitor heap;
 
-String currentTrackId = "";
-String currentTitle = "";
-String currentArtist = "";
-String currentStreamUrl = "";
 bool isPlaying = false;
+bool isPaused = false;
 int currentVolume = 80;
 
+// ========== AUDIO ==========
+// MP3 de Audius ~128-320 kbps (16-40 KB/s)
+const size_t MUSIC_RING_BYTES      = 48 * 1024;  // ~3 s a 128 kbps (usa PSRAM si hay)
+const size_t MUSIC_PREBUFFER_BYTES = 16 * 1024;  // ~1 s antes de sonar
+const float  MAX_GAIN = 0.6;                     // menor ganancia = menos clip/ruido
+const unsigned long ESTADO_INTERVAL = 2000;      // reporte al server mientras suena
+
+AudioOutputI2SNoDAC*      dac = nullptr;   // salida real, se crea una vez
+AudioOutputKeepOpen*      out = nullptr;   // abierta entre tracks de la cola
+AudioPipeline             pipeline;
+uint32_t seekBaseBytes = 0;       // byte del stream donde arrancó el decoder del track
+unsigned long tEstado = 0;
+
+float currentGain() { return MAX_GAIN * currentVolume / 100.0f; }
+
+// Mira lo que baja la red (tee del pipeline) y saca el bitrate del primer
+// frame MP3, salteando el tag ID3v2. Con eso se pasa de ms a bytes para el
+// seek y de bytes a ms para la posición (exacto en CBR, aproximado en VBR).
+class Mp3Sniffer : public AudioTee {
+public:
+  void reset() { seen_ = skip_ = win_ = kbps_ = audioStart_ = 0; }
+
+  void teeData(const uint8_t* d, uint32_t len) override {
+    for (uint32_t i = 0; i < len && !kbps_; i++, seen_++) {
+      if (seen_ < sizeof(id3_)) id3_[seen_] = d[i];
+      if (seen_ == sizeof(id3_) - 1 && !memcmp(id3_, "ID3", 3)) {
+        skip_ = 10 + ((id3_[6] & 0x7F) << 21 | (id3_[7] & 0x7F) << 14 |
+                      (id3_[8] & 0x7F) << 7  | (id3_[9] & 0x7F));
+      }
+      if (seen_ < skip_) continue;
+      win_ = (win_ << 8) | d[i];
+      if (seen_ >= skip_ + 2) parseHeader(win_ & 0xFFFFFF);
+    }
+  }
+  void teeEnd(bool) override {}
+
+  uint32_t kbps() const       { return kbps_ ? kbps_ : 128; }   // default razonable
+  uint32_t audioStart() const { return audioStart_; }
+
+private:
+  void parseHeader(uint32_t h) {
+    static const uint16_t BR_V1[16] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0 };
+    static const uint16_t BR_V2[16] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0 };
+    uint8_t b0 = h >> 16, b1 = h >> 8, b2 = h;
+    if (b0 != 0xFF || (b1 & 0xE0) != 0xE0) return;   // sync
+    uint8_t ver = (b1 >> 3) & 3, layer = (b1 >> 1) & 3;
+    uint8_t bri = b2 >> 4, sri = (b2 >> 2) & 3;
+    if (ver == 1 || layer != 1 || sri == 3) return;    // solo Layer III válido
+    uint16_t br = ver == 3 ? BR_V1[bri] : BR_V2[bri];
+    if (!br) return;
+    kbps_ = br;
+    audioStart_ = seen_ - 2;
+    Serial.printf("🎼 MP3 %u kbps, audio desde byte %u\n", kbps_, audioStart_);
+  }
+
+  uint8_t  id3_[10];
+  uint32_t seen_ = 0, skip_ = 0, win_ = 0;
+  uint32_t kbps_ = 0, audioStart_ = 0;
+};
+
+// Tracks pendientes (los pide el server con "modo": "cola").
+// Todo en char[]: copiar un Track no toca el heap.
+struct Track {
+  char url[192];
+  char titulo[64];
+  char artista[48];
+  char trackId[24];
+};
+const uint8_t TRACK_QUEUE_LEN = 4;
+Track   trackQueue[TRACK_QUEUE_LEN];
+uint8_t trackHead = 0, trackCount = 0;
+
+// Un track abierto. decks[cur] suena y decks[cur ^ 1] es el
+// siguiente, ya encolado en el pipeline (se baja en el hueco).
+struct Deck {
+  Track                     track;
+  AudioFileSourceHTTPRange* src = nullptr;
+  AudioGeneratorMP3*        mp3 = nullptr;
+  Mp3Sniffer                sniffer;
+};
+Deck     decks[2];
+uint8_t  cur = 0;
+bool     nextReady = false;
+uint32_t seenAdvances = 0;
+
 // ========== DECLARACIONES DE FUNCIONES ==========
-void handlePlayMusic(JsonObject cmd);
-void handleStop();
-void handlePause();
-void handleResume();
-void handleVolume(JsonObject cmd);
-void handleSeek(JsonObject cmd);
-void handleFrase(JsonObject cmd);
-void handleConversacion(JsonObject cmd);
-void handleLoro(JsonObject cmd);
+void handlePlayMusic(JsonObject cmd, uint32_t tRecv);
+void handleStop(JsonObject cmd, uint32_t tRecv);
+void handlePause(JsonObject cmd, uint32_t tRecv);
+void handleResume(JsonObject cmd, uint32_t tRecv);
+void handleVolume(JsonObject cmd, uint32_t tRecv);
+void handleSeek(JsonObject cmd, uint32_t tRecv);
+void handleNext(JsonObject cmd, uint32_t tRecv);
+void handleFrase(JsonObject cmd, uint32_t tRecv);
+void handleConversacion(JsonObject cmd, uint32_t tRecv);
+void handleLoro(JsonObject cmd, uint32_t tRecv);
+bool trackPop(Track& t);
+
+// tipo -> handler (ver CommandRoute en CommandChannel.h)
+const CommandRoute ROUTES[] = {
+  { "reproducir_musica",       handlePlayMusic    },
+  { "musica_detener",          handleStop         },
+  { "musica_pausa",            handlePause        },
+  { "musica_continuar",        handleResume       },
+  { "musica_volumen",          handleVolume       },
+  { "musica_seek",             handleSeek         },
+  { "siguiente",               handleNext         },
+  { "reproducir_frase",        handleFrase        },
+  { "reproducir_conversacion", handleConversacion },
+  { "reproducir_loro",         handleLoro         },
+};
+// Lo que leen los handlers: el canal descarta el resto al parsear. Sin
+// texto_usuario ni texto_robot (la respuesta de Gemini no tiene tope)
+const char* const CAMPOS[] = { "tipo", "url", "titulo", "artista", "track_id", "modo", "volume",
+                               "position_ms", "nombre", "audio_id", "texto", "efecto", nullptr };
+void stopMusic();
+bool startMusic(const Track& t);
+void prefetchNext();
+void onAdvance();
+void reportEstado(const char* status);
 
 // ========== SETUP ==========
 void setup() {
@@ -44,7 +179,7 @@ void setup() {
   delay(1000);
   
   Serial.println("\n\n======================================");
-  Serial.println("ESP32 - Test Servidor (Sin Audio)");
+  Serial.println("ESP32 - Música Audius (MP3 streaming)");
   Serial.println("======================================\n");
 
   // --- WiFi ---
@@ -62,21 +197,35 @@ void setup() {
                 WiFi.localIP().toString().c_str(), 
                 WiFi.RSSI());
 
+  // --- Pipeline de audio (red en core 0, DAC en core 1) ---
+  AudioPipeline::Config acfg;
+  acfg.ringBytes      = MUSIC_RING_BYTES;
+  acfg.prebufferBytes = MUSIC_PREBUFFER_BYTES;
+  acfg.onBegin        = []() { i2s_set_dac_mode(I2S_DAC_CHANNEL_BOTH_EN); };
+  if (!pipeline.begin(acfg)) {
+    Serial.println("❌ No se pudo iniciar el pipeline de audio");
+  }
+  dac = new AudioOutputI2SNoDAC();
+  dac->SetOutputModeMono(true);
+  dac->SetGain(currentGain());
+  out = new AudioOutputKeepOpen(dac);
+
   // --- Registro de dispositivo ---
   {
     HTTPClient http;
     http.setReuse(true);
     http.setTimeout(8000);
-    String url = String(BASE_URL) + "/esp32/register";
+    char url[160];
+    snprintf(url, sizeof(url), "%s/esp32/register", BASE_URL);
     
     if (http.begin(url)) {
       http.addHeader("Content-Type", "application/x-www-form-urlencoded");
       
-      String postData = "device_id=" + String(DEVICE_ID) + 
-                       "&nombre=ESP32-Test" +
-                       "&ubicacion=Lab";
+      char postData[96];
+      int n = snprintf(postData, sizeof(postData),
+                       "device_id=%s&nombre=ESP32-Test&ubicacion=Lab", DEVICE_ID);
       
-      int code = http.POST(postData);
+      int code = http.POST((uint8_t*)postData, n);
       String resp = http.getString();
       http.end();
       
@@ -86,8 +235,18 @@ void setup() {
     }
   }
 
+  // --- Canal de comandos ---
+  CommandChannel::Config ccfg;
+  ccfg.baseUrl        = BASE_URL;
+  ccfg.deviceId       = DEVICE_ID;
+  ccfg.pollIntervalMs = POLL_INTERVAL;
+  ccfg.campos         = CAMPOS;
+  if (!channel.begin(ccfg)) {
+    Serial.println("❌ No se pudo iniciar el canal de comandos");
+  }
+
   Serial.println("\n📱 Sistema listo. Esperando comandos...\n");
-  Serial.println("💡 TIP: Ahora podés enviar comandos desde Flutter o Postman");
+  Serial.println("💡 TIP: Podés enviar comandos desde Flutter o Postman");
   Serial.println("    Ejemplo: POST /control/musica_buscar");
   Serial.println("             POST /control/musica_reproducir\n");
 }
@@ -102,173 +261,315 @@ void loop() {
     return;
   }
 
-  // Poll cada 2 segundos
-  if (millis() - tPoll > POLL_INTERVAL) {
-    tPoll = millis();
+  // Comandos recibidos por la tarea del canal (zero-copy: los const char*
+  // del documento apuntan a c.json, que vive hasta el próximo receive)
+  static CommandChannel::Command c;
+  while (channel.receive(c)) {
+    DeserializationError e = deserializeJson(cmdDoc, c.json);
+    if (e) {
+      Serial.printf("❌ JSON cmd error: %s\n", e.c_str());
+      continue;
+    }
+    JsonObject cmd = cmdDoc.as<JsonObject>();
 
-    HTTPClient http;
-    http.setReuse(true);          // keep-alive
-    http.setTimeout(5000);
-    String url = String(BASE_URL) + "/esp32/poll/" + String(DEVICE_ID);
+    Serial.println("\n==================================================");
+    Serial.printf("🎯 Tipo: %s\n", cmd["tipo"] | "");
 
-    if (!http.begin(url)) {
-      Serial.println("⚠️ Poll: begin() falló");
-      return;
+    if (!routeCommand(ROUTES, cmd, c.tRecv)) {
+      Serial.printf("⚠️ Comando desconocido: %s\n", cmd["tipo"] | "");
     }
-
-    int code = http.GET();
     
-    if (code == HTTP_CODE_OK) {
-      // Parseo directo desde el stream (maneja chunked)
-      DynamicJsonDocument doc(4096);
-      DeserializationError e = deserializeJson(doc, http.getStream());
-      http.end();
+    Serial.println("--------------------------------------------------");
+  }
 
-      if (e) {
-        Serial.printf("❌ JSON poll error: %s\n", e.c_str());
-      } else {
-        JsonArray comandos = doc["comandos"].as<JsonArray>();
-        
-        if (!comandos.isNull() && comandos.size() > 0) {
-          Serial.println("\n==================================================");
-          Serial.printf("📨 Recibidos %d comandos nuevos\n", comandos.size());
-          Serial.println("==================================================");
-          
-          for (JsonObject cmd : comandos) {
-            String tipo = cmd["tipo"].as<String>();
-            
-            Serial.println("\n🎯 Tipo: " + tipo);
-            
-            if (tipo == "reproducir_musica") {
-              handlePlayMusic(cmd);
-            } 
-            else if (tipo == "musica_detener") {
-              handleStop();
-            }
-            else if (tipo == "musica_pausa") {
-              handlePause();
-            }
-            else if (tipo == "musica_continuar") {
-              handleResume();
-            }
-            else if (tipo == "musica_volumen") {
-              handleVolume(cmd);
-            }
-            else if (tipo == "musica_seek") {
-              handleSeek(cmd);
-            }
-            else if (tipo == "reproducir_frase") {
-              handleFrase(cmd);
-            }
-            else if (tipo == "reproducir_conversacion") {
-              handleConversacion(cmd);
-            }
-            else if (tipo == "reproducir_loro") {
-              handleLoro(cmd);
-            }
-            else {
-              Serial.println("⚠️ Comando desconocido: " + tipo);
-            }
-            
-            Serial.println("--------------------------------------------------");
-          }
-        }
-      }
-    } else if (code > 0) {
-      Serial.printf("⚠️ Poll -> %d\n", code);
-      http.end();
+  // Cambio de track sin corte, y precarga del que sigue
+  if (isPlaying && pipeline.advances() != seenAdvances) onAdvance();
+  if (isPlaying && pipeline.started()) prefetchNext();
+
+  // Fin del track (o stream caído)
+  if (isPlaying && !pipeline.isBusy()) {
+    Serial.println(pipeline.lastOk()        ? "✅ Track terminado"
+                   : pipeline.lastStalled() ? "❌ Stream cortado (sin datos)"
+                                            : "❌ Track incompleto");
+    stopMusic();
+    static Track t;
+    if (trackPop(t)) {
+      startMusic(t);
     } else {
-      Serial.printf("⚠️ Poll error: %d\n", code);
-      http.end();
+      out->close();   // cola vacía: apagar la salida
     }
+    reportEstado(isPlaying ? "playing" : "stopped");
+  }
+
+  // Posición y salud del buffer al server
+  if (isPlaying && millis() - tEstado > ESTADO_INTERVAL) {
+    reportEstado(isPaused ? "paused" : "playing");
   }
 
+  if (heap.due(HEAP_INTERVAL)) heap.print();
+
   delay(10);
 }
 
+// ========== MOTOR DE MÚSICA ==========
+
+bool trackPush(const Track& t, bool front) {
+  if (trackCount >= TRACK_QUEUE_LEN) return false;
+  uint8_t idx;
+  if (front) { trackHead = (trackHead + TRACK_QUEUE_LEN - 1) % TRACK_QUEUE_LEN; idx = trackHead; }
+  else       { idx = (trackHead + trackCount) % TRACK_QUEUE_LEN; }
+  trackQueue[idx] = t;
+  trackCount++;
+  return true;
+}
+
+bool trackPop(Track& t) {
+  if (!trackCount) return false;
+  t = trackQueue[trackHead];
+  trackHead = (trackHead + 1) % TRACK_QUEUE_LEN;
+  trackCount--;
+  return true;
+}
+
+void releaseDeck(Deck& d) {
+  if (d.mp3) { d.mp3->stop(); delete d.mp3; d.mp3 = nullptr; }
+  if (d.src) { delete d.src; d.src = nullptr; }
+}
+
+// Abre el stream del track; el decoder se crea al encolarlo
+bool openDeck(Deck& d, const Track& t) {
+  d.track = t;
+  d.sniffer.reset();
+  d.src = new AudioFileSourceHTTPRange();
+  if (!d.src->open(t.url)) {
+    Serial.println("❌ No se pudo abrir el stream");
+    releaseDeck(d);
+    return false;
+  }
+  Serial.printf("🔗 %u bytes, Range %s\n", d.src->getSize(), d.src->acceptsRanges() ? "sí" : "no");
+  return true;
+}
+
+// Corta todo; el track precargado vuelve al frente de la cola
+void stopMusic() {
+  pipeline.stop();   // las tareas sueltan los objetos antes de borrarlos
+  if (nextReady) trackPush(decks[cur ^ 1].track, true);
+  nextReady = false;
+  seenAdvances = 0;
+  releaseDeck(decks[0]);
+  releaseDeck(decks[1]);
+  isPlaying = false;
+  isPaused = false;
+}
+
+// Posición de lo que ya pasó por el decoder (no lo que bajó la red)
+uint32_t positionMs() {
+  const Deck& d = decks[cur];
+  if (!d.src) return 0;
+  uint32_t bytePos = seekBaseBytes + pipeline.itemPos();
+  if (bytePos <= d.sniffer.audioStart()) return 0;
+  return (uint64_t)(bytePos - d.sniffer.audioStart()) * 8 / d.sniffer.kbps();
+}
+
+// Arranca decoder + pipeline sobre el track actual en su posición actual
+bool startDecoder() {
+  Deck& d = decks[cur];
+  seekBaseBytes = d.src->getPos();
+  d.mp3 = new AudioGeneratorMP3();
+  if (!pipeline.play(d.src, d.mp3, out, &d.sniffer)) {
+    Serial.println("❌ Pipeline ocupado");
+    return false;
+  }
+  return true;
+}
+
+bool startMusic(const Track& t) {
+  stopMusic();
+  if (!openDeck(decks[cur], t)) return false;
+  if (!startDecoder()) { stopMusic(); return false; }
+  isPlaying = true;
+  return true;
+}
+
+// Mientras suena un track, abrir el siguiente y encolarlo en el pipeline:
+// la red lo empieza a bajar apenas termina de bajar el actual
+void prefetchNext() {
+  if (nextReady || pipeline.hasNext()) return;
+  Deck& d = decks[cur ^ 1];
+  if (!trackPop(d.track)) return;
+  if (!openDeck(d, d.track)) return;      // stream caído: se saltea
+  d.mp3 = new AudioGeneratorMP3();
+  if (pipeline.queueNext(d.src, d.mp3, &d.sniffer)) {
+    nextReady = true;
+    Serial.printf("⏭️ Precargado: %s\n", d.track.titulo);
+  } else {
+    releaseDeck(d);
+    trackPush(d.track, true);
+  }
+}
+
+// El pipeline pasó al track precargado sin cortar
+void onAdvance() {
+  seenAdvances++;
+  releaseDeck(decks[cur]);
+  cur ^= 1;
+  nextReady = false;
+  seekBaseBytes = 0;
+  Serial.printf("🎵 Sigue sin corte: %s\n", decks[cur].track.titulo);
+  reportEstado(isPaused ? "paused" : "playing");
+}
+
+// Salta a position_ms: corta el decoder, reabre la fuente con Range en el
+// byte equivalente y vuelve a arrancar; el socket y la salida se reusan.
+// El precargado se suelta (vuelve a la cola y se reabre después).
+bool seekMusic(uint32_t ms) {
+  Deck& d = decks[cur];
+  if (!d.src) return false;
+  bool wasPaused = isPaused;
+  pipeline.stop();
+  if (nextReady) {
+    trackPush(decks[cur ^ 1].track, true);
+    releaseDeck(decks[cur ^ 1]);
+    nextReady = false;
+  }
+  seenAdvances = 0;
+  if (d.mp3) { d.mp3->stop(); delete d.mp3; d.mp3 = nullptr; }
+
+  uint32_t target = d.sniffer.audioStart() + (uint64_t)ms * d.sniffer.kbps() / 8;
+  if (d.src->getSize() && target >= d.src->getSize()) target = d.src->getSize() - 1;
+  bool ok = d.src->seek(target, SEEK_SET);
+  if (!ok) Serial.println("⚠️ Seek no soportado, sigue desde donde estaba");
+
+  if (!startDecoder()) { stopMusic(); return false; }
+  if (wasPaused) pipeline.setPaused(true);
+  return ok;
+}
+
+void reportEstado(const char* status) {
+  tEstado = millis();
+  HTTPClient http;
+  http.setTimeout(3000);
+  static char url[160];
+  if (!*url) snprintf(url, sizeof(url), "%s/control/musica_estado/%s", BASE_URL, DEVICE_ID);
+  if (!http.begin(url)) return;
+  http.addHeader("Content-Type", "application/x-www-form-urlencoded");
+  AudioPipelineStats st = pipeline.stats();
+  HeapMonitor::Stats hs = heap.stats();
+  char body[288];
+  int n = snprintf(body, sizeof(body),
+                   "status=%s&position_ms=%u&buffer_fill=%u&buffer_cap=%u&underruns=%u&kbps=%u&volume=%d&track_id=%s"
+                   "&heap_min=%u&heap_bloque=%u",
+                   status, positionMs(), st.fill, st.capacity, st.underruns,
+                   decks[cur].sniffer.kbps(), currentVolume, decks[cur].track.trackId,
+                   hs.freeMin, hs.largestMin);
+  int code = http.POST((uint8_t*)body, n);
+  http.end();
+  if (code < 200 || code >= 300) Serial.printf("⚠️ Estado -> %d\n", code);
+}
+
 // ========== HANDLERS DE COMANDOS ==========
 
-void handlePlayMusic(JsonObject cmd) {
-  currentStreamUrl = cmd["url"].as<String>();
-  currentTitle = cmd["titulo"].as<String>();
-  currentArtist = cmd["artista"].as<String>();
+void handlePlayMusic(JsonObject cmd, uint32_t) {
+  static Track t;
+  strlcpy(t.url,     cmd["url"]      | "", sizeof(t.url));
+  strlcpy(t.titulo,  cmd["titulo"]   | "", sizeof(t.titulo));
+  strlcpy(t.artista, cmd["artista"]  | "", sizeof(t.artista));
+  strlcpy(t.trackId, cmd["track_id"] | "", sizeof(t.trackId));
+  const char* modo = cmd["modo"] | "ya";   // "ya" reemplaza, "cola" va después
   
   Serial.println("🎵 REPRODUCIR MÚSICA:");
-  Serial.println("   📝 Título: " + currentTitle);
-  Serial.println("   🎤 Artista: " + currentArtist);
-  Serial.println("   🔗 URL: " + currentStreamUrl);
-  
-  isPlaying = true;
+  Serial.printf("   📝 Título: %s\n", t.titulo);
+  Serial.printf("   🎤 Artista: %s\n", t.artista);
+  Serial.printf("   🔗 URL: %s\n", t.url);
+  Serial.printf("   📋 Modo: %s\n", modo);
+
+  if (!strcmp(modo, "cola") && isPlaying) {
+    if (trackPush(t, false)) Serial.printf("✅ En cola (%u pendientes)\n", trackCount);
+    else Serial.println("⚠️ Cola llena, track descartado");
+    return;
+  }
   
-  Serial.println("✅ [SIMULADO] Reproducción iniciada");
-  Serial.println("💡 Cuando agregues la librería de audio, aquí se reproducirá realmente");
+  if (startMusic(t)) {
+    Serial.println("✅ Reproducción iniciada");
+    reportEstado("playing");
+  } else {
+    reportEstado("error");
+  }
 }
 
-void handleStop() {
+void handleStop(JsonObject, uint32_t) {
   Serial.println("⏹️ DETENER REPRODUCCIÓN");
-  isPlaying = false;
-  currentTitle = "";
-  currentArtist = "";
-  currentStreamUrl = "";
-  Serial.println("✅ [SIMULADO] Reproducción detenida");
+  stopMusic();
+  trackCount = 0;   // también la cola
+  out->close();
+  memset(&decks[cur].track, 0, sizeof(Track));
+  reportEstado("stopped");
+  Serial.println("✅ Reproducción detenida");
 }
 
-void handlePause() {
+void handlePause(JsonObject, uint32_t) {
   Serial.println("⏸️ PAUSAR REPRODUCCIÓN");
-  Serial.println("✅ [SIMULADO] Reproducción pausada");
+  if (!isPlaying) { Serial.println("⚠️ No hay nada sonando"); return; }
+  pipeline.setPaused(true);   // el socket y el buffer siguen vivos
+  isPaused = true;
+  reportEstado("paused");
+  Serial.println("✅ Reproducción pausada");
 }
 
-void handleResume() {
+void handleResume(JsonObject, uint32_t) {
   Serial.println("▶️ REANUDAR REPRODUCCIÓN");
-  Serial.println("✅ [SIMULADO] Reproducción reanudada");
+  if (!isPlaying) { Serial.println("⚠️ No hay nada pausado"); return; }
+  pipeline.setPaused(false);
+  isPaused = false;
+  reportEstado("playing");
+  Serial.println("✅ Reproducción reanudada");
 }
 
-void handleVolume(JsonObject cmd) {
-  int volume = cmd["volume"].as<int>();
-  currentVolume = volume;
+void handleVolume(JsonObject cmd, uint32_t) {
+  int volume = cmd["volume"] | currentVolume;
+  currentVolume = constrain(volume, 0, 100);
   
-  Serial.printf("🔊 AJUSTAR VOLUMEN: %d%%\n", volume);
-  Serial.println("✅ [SIMULADO] Volumen ajustado");
+  Serial.printf("🔊 AJUSTAR VOLUMEN: %d%%\n", currentVolume);
+  if (out) out->SetGain(currentGain());   // en la etapa de salida, sin re-bufferizar
+  Serial.println("✅ Volumen ajustado");
 }
 
-void handleSeek(JsonObject cmd) {
-  int position_ms = cmd["position_ms"].as<int>();
+void handleSeek(JsonObject cmd, uint32_t) {
+  int position_ms = cmd["position_ms"] | 0;
   int position_sec = position_ms / 1000;
   
   Serial.printf("⏩ BUSCAR POSICIÓN: %d segundos\n", position_sec);
-  Serial.println("✅ [SIMULADO] Posición ajustada");
+  if (!isPlaying) { Serial.println("⚠️ No hay nada sonando"); return; }
+  if (seekMusic(max(position_ms, 0))) Serial.println("✅ Posición ajustada");
+  reportEstado(isPaused ? "paused" : "playing");
 }
 
-void handleFrase(JsonObject cmd) {
-  String audio_id = cmd["audio_id"].as<String>();
-  String nombre = cmd["nombre"].as<String>();
-  
+void handleNext(JsonObject, uint32_t) {
+  Serial.println("⏭️ SIGUIENTE TRACK");
+  if (!trackCount && !nextReady) { Serial.println("⚠️ Cola vacía"); return; }
+  stopMusic();   // el precargado vuelve al frente de la cola
+  static Track t;
+  trackPop(t);
+  reportEstado(startMusic(t) ? "playing" : "error");
+}
+
+void handleFrase(JsonObject cmd, uint32_t) {
   Serial.println("💬 REPRODUCIR FRASE:");
-  Serial.println("   📝 Nombre: " + nombre);
-  Serial.println("   🆔 Audio ID: " + audio_id);
+  Serial.printf("   📝 Nombre: %s\n", cmd["nombre"] | "");
+  Serial.printf("   🆔 Audio ID: %s\n", cmd["audio_id"] | "");
   Serial.println("✅ [SIMULADO] Frase reproducida");
 }
 
-void handleConversacion(JsonObject cmd) {
-  String audio_id = cmd["audio_id"].as<String>();
-  String texto_usuario = cmd["texto_usuario"].as<String>();
-  String texto_robot = cmd["texto_robot"].as<String>();
-  
+void handleConversacion(JsonObject cmd, uint32_t) {
   Serial.println("🤖 CONVERSACIÓN:");
-  Serial.println("   👤 Usuario dijo: " + texto_usuario);
-  Serial.println("   🤖 Robot responde: " + texto_robot);
-  Serial.println("   🆔 Audio ID: " + audio_id);
+  Serial.printf("   🆔 Audio ID: %s\n", cmd["audio_id"] | "");
   Serial.println("✅ [SIMULADO] Respuesta reproducida");
 }
 
-void handleLoro(JsonObject cmd) {
-  String audio_id = cmd["audio_id"].as<String>();
-  String texto = cmd["texto"].as<String>();
-  String efecto = cmd["efecto"].as<String>();
-  
+void handleLoro(JsonObject cmd, uint32_t) {
   Serial.println("🦜 MODO LORO:");
-  Serial.println("   📝 Texto: " + texto);
-  Serial.println("   🎚️ Efecto: " + efecto);
-  Serial.println("   🆔 Audio ID: " + audio_id);
+  Serial.printf("   📝 Texto: %s\n", cmd["texto"] | "");
+  Serial.printf("   🎚️ Efecto: %s\n", cmd["efecto"] | "");
+  Serial.printf("   🆔 Audio ID: %s\n", cmd["audio_id"] | "");
   Serial.println("✅ [SIMULADO] Texto repetido con efecto");
-}
\ No newline at end of file
+}
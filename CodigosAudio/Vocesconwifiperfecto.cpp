@@ -1,7 +1,29 @@
 /****************************************************
  * Robot NAO - Cliente ESP32 (WAV por streaming)
- * - Poll de comandos (200 ms, HTTP/1.1 keep-alive)
- * - Reproduce /esp32/audio_raw/{id} directo por red
+ * - Comandos por long-poll en una tarea aparte (cae a
+ *   poll de 200 ms si el server no lo soporta), sigue
+ *   corriendo mientras suena el audio
+ * - Máquina de estados: IDLE / PREBUFFERING / PLAYING /
+ *   CONFIRMING, con cola de clips y preempción
+ * - Confirmaciones por lote (/esp32/confirmar_lote) con el
+ *   seq de cada comando; cae a /confirmar si el server
+ *   es viejo
+ * - Sin cortes entre clips: mientras suena uno ya se abre
+ *   y se baja el siguiente, y la salida queda abierta
+ * - Audio en IMA-ADPCM 4:1 (se negocia en el registro,
+ *   ver ImaAdpcm.h); acepta también WAV PCM
+ * - Reproduce /esp32/audio_raw/{id} directo por red, o
+ *   desde la caché LRU en LittleFS si el clip_id ya
+ *   está (ver ClipCache.h); al boot precalienta las
+ *   frases de /frases/lista
+ * - Respuestas de conversar en flujo: empieza a sonar
+ *   la primera frase mientras el server sintetiza el
+ *   resto (/esp32/audio_flujo, HTTP/1.0 sin largo)
+ * - Red -> buffer circular -> DAC en tareas separadas
+ *   (ver AudioPipeline.h)
+ * - Camino de comandos sin heap: URLs en buffers fijos,
+ *   JSON estático y despacho por tabla; el heap se
+ *   vigila con HeapMonitor.h
  * - Salida por DAC interno: GPIO25 (L) y GPIO26 (R)
  ****************************************************/
 #include <Arduino.h>
@@ -12,8 +34,15 @@
 // ===== Audio (ESP8266Audio) =====
 #include <AudioFileSourceHTTPStream.h>   // streaming HTTP
 // #include <AudioFileSourceHTTPSStream.h> // si alguna vez usás https
-#include <AudioGeneratorWAV.h>
+#include <AudioFileSourceFS.h>           // clips cacheados en LittleFS
 #include <AudioOutputI2SNoDAC.h>         // DAC interno ESP32 (GPIO25/26)
+#include "AudioFileSourceHTTPRange.h"     // respuestas en flujo (HTTP/1.0)
+#include "AudioPipeline.h"                // ring buffer + tareas red/audio
+#include "ImaAdpcm.h"                     // generador WAV IMA-ADPCM / PCM
+#include "CommandChannel.h"               // long-poll con fallback a poll
+#include "ClipCache.h"                    // caché LRU de clips en flash
+#include "HeapMonitor.h"                  // heap libre / fragmentación
+#include <Telemetria.h>                   // contadores/histogramas -> /admin/metrics
 
 // Para habilitar ambos DAC internos (25 y 26)
 extern "C" {
@@ -27,18 +56,165 @@ const char* WIFI_PASS = "38814831";  // <- comillas cerradas
 const char* BASE_URL  = "http://choreal-kalel-directed.ngrok-free.dev";
 const char* DEVICE_ID = "esp32_1";
 
+// ====== Buffer de audio ======
+// WAV 16 kHz / 16 bit / mono = 32 KB/s; en IMA-ADPCM ~8 KB/s
+const size_t AUDIO_RING_BYTES      = 64 * 1024;  // ~2 s PCM, ~8 s IMA (usa PSRAM si hay)
+const size_t AUDIO_PREBUFFER_BYTES = 12 * 1024;  // ~375 ms antes de sonar (PCM)
+const size_t AUDIO_PREBUFFER_IMA   = 3 * 1024;   // ~375 ms en IMA
+const char*  AUDIO_FORMATOS        = "ima,wav";  // lo que decodifica AudioGeneratorIMA
+const bool   AUDIO_FLUJO           = true;       // conversar frase por frase (/esp32/audio_flujo)
+
+// ====== Caché de clips ======
+const uint32_t CLIP_CACHE_BYTES = 1024 * 1024;   // ~32 s de WAV 16 kHz en flash
+
 // ====== Audio objects ======
-AudioGeneratorWAV*          wav       = nullptr;
-AudioFileSourceHTTPStream*  file_http = nullptr;
+AudioOutputI2SNoDAC*        dac       = nullptr;   // salida real, se crea una vez
+AudioOutputKeepOpen*        out       = nullptr;   // abierta entre clips de la cola
 // AudioFileSourceHTTPSStream* file_https = nullptr; // si usás https
-AudioOutputI2SNoDAC*        out       = nullptr;
+AudioPipeline               pipeline;
+CommandChannel              channel;
+ClipCache                   cache;
+HeapMonitor                 heap;
+
+// ====== Telemetría (se manda cada 30 s, ver Telemetria.h) ======
+telemetria::Registro        tele;
+telemetria::Histograma      telePollRtt(tele, "poll_rtt_ms", telemetria::CUBETAS_MS);
+telemetria::Histograma      telePrimerAudio(tele, "primer_audio_ms", telemetria::CUBETAS_MS);
+telemetria::Contador        teleClips(tele, "clips");
+telemetria::Contador        teleUnderruns(tele, "underruns");
+telemetria::Medidor         teleHeapLibre(tele, "heap_libre");
+telemetria::Medidor         teleHeapBloque(tele, "heap_bloque");
+telemetria::Medidor         teleRssi(tele, "wifi_rssi");
+telemetria::Medidor         teleCmdPerdidos(tele, "cmd_perdidos");   // en respuestas del poll ilegibles
+telemetria::EnvioTelemetria teleEnvio(tele);
+
+// Lo que baja la red se va guardando en la caché; solo queda
+// si el clip llegó entero (si se corta, se descarta). La escritura
+// arranca con el primer byte: el clip precargado espera su turno.
+class CacheTee : public AudioTee {
+public:
+  void arm(const char* clip_id, uint32_t size) {
+    strlcpy(key_, clip_id, sizeof(key_));
+    size_ = size;
+    token_ = 0;
+  }
+  // Si la caché cortó la escritura por dentro, el token deja de valer y
+  // no se toca la que haya empezado el prewarm
+  void teeData(const uint8_t* data, uint32_t len) override {
+    if (!token_ && *key_) {
+      token_ = cache.beginWrite(key_, size_);
+      *key_ = '\0';
+    }
+    if (token_ && !cache.write(token_, data, len)) token_ = 0;
+  }
+  void teeEnd(bool complete) override {
+    if (!token_) return;
+    if (complete && cache.commit(token_)) Serial.println("💾 Clip guardado en caché");
+    else cache.abort(token_);
+    token_ = 0;
+  }
+
+private:
+  char             key_[ClipCache::KEY_LEN] = "";
+  uint32_t         size_ = 0;
+  ClipCache::Token token_ = 0;
+};
+
+// ====== Volumen ======
+const float MAX_GAIN = 0.6;      // menor ganancia = menos clip/ruido
+int currentVolume = 100;         // 0..100 (musica_volumen)
+
+float currentGain() { return MAX_GAIN * currentVolume / 100.0f; }
+
+// ====== Estado del cliente ======
+enum ClientState { ST_IDLE, ST_PREBUFFERING, ST_PLAYING, ST_CONFIRMING };
+const char* stateName(ClientState s) {
+  switch (s) {
+    case ST_IDLE:         return "IDLE";
+    case ST_PREBUFFERING: return "PREBUFFERING";
+    case ST_PLAYING:      return "PLAYING";
+    case ST_CONFIRMING:   return "CONFIRMING";
+  }
+  return "?";
+}
+ClientState state = ST_IDLE;
+
+// Cola de clips pendientes (FIFO chica, sin heap)
+const uint8_t CLIP_QUEUE_LEN = 8;
+const size_t  AUDIO_ID_LEN   = 48;
+struct Clip {
+  char audio_id[AUDIO_ID_LEN];
+  char clip_id[ClipCache::KEY_LEN];   // hash del WAV ("" si el server no lo manda)
+  bool ima;                           // el server lo manda en IMA-ADPCM
+  bool flujo;                         // se sigue sintetizando: /esp32/audio_flujo
+  uint32_t seq;                       // seq del comando (0 = server viejo)
+};
+Clip    clipQueue[CLIP_QUEUE_LEN];
+uint8_t clipHead = 0, clipCount = 0;
+
+// Un clip armado (fuente + decoder). voices[cur] suena y
+// voices[cur ^ 1] es el siguiente, ya encolado en el pipeline.
+struct Voice {
+  Clip               clip;
+  AudioFileSource*   src = nullptr;   // HTTP o LittleFS
+  AudioGeneratorIMA* gen = nullptr;
+  CacheTee           tee;
+  bool               useTee = false;
+  bool               cached = false;  // src es el archivo de la caché, fijado
+};
+Voice    voices[2];
+uint8_t  cur = 0;
+bool     nextReady = false;       // voices[cur ^ 1] encolado en el pipeline
+uint32_t seenAdvances = 0;        // pipeline.advances() ya procesados
+
+unsigned long tClipStart = 0;
+unsigned long tStats = 0;
+const unsigned long HEAP_INTERVAL = 30000;   // log de heap
+Clip pendingConfirm;              // terminó y falta avisar al server
+const char* pendingStatus = nullptr;
+
+void setState(ClientState s) {
+  if (s == state) return;
+  Serial.printf("⚙️ %s -> %s\n", stateName(state), stateName(s));
+  state = s;
+}
+
+bool queuePush(const Clip& c, bool front) {
+  if (clipCount >= CLIP_QUEUE_LEN) return false;
+  uint8_t idx;
+  if (front) { clipHead = (clipHead + CLIP_QUEUE_LEN - 1) % CLIP_QUEUE_LEN; idx = clipHead; }
+  else       { idx = (clipHead + clipCount) % CLIP_QUEUE_LEN; }
+  clipQueue[idx] = c;
+  clipCount++;
+  return true;
+}
+
+bool queuePop(Clip& c) {
+  if (!clipCount) return false;
+  c = clipQueue[clipHead];
+  clipHead = (clipHead + 1) % CLIP_QUEUE_LEN;
+  clipCount--;
+  return true;
+}
 
 // ====== Helpers ======
+void releaseVoice(Voice& v) {
+  if (v.gen) { v.gen->stop(); delete v.gen; v.gen = nullptr; }
+  if (v.src) { delete v.src; v.src = nullptr; }
+  if (v.cached) { cache.release(v.clip.clip_id); v.cached = false; }
+  v.useTee = false;
+}
+
+// Corta todo; el clip precargado vuelve al frente de la cola
 void stopAudio() {
-  if (wav)        { wav->stop(); delete wav; wav = nullptr; }
-  if (file_http)  { delete file_http; file_http = nullptr; }
-  // if (file_https) { delete file_https; file_https = nullptr; }
-  if (out)        { delete out; out = nullptr; }
+  teleUnderruns.sumar(pipeline.stats().underruns);   // el pipeline los cuenta por reproducción
+  pipeline.stop();   // las tareas sueltan los objetos antes de borrarlos
+  if (nextReady) {
+    queuePush(voices[cur ^ 1].clip, true);
+    nextReady = false;
+  }
+  releaseVoice(voices[0]);
+  releaseVoice(voices[1]);
 }
 
 // Fuerza ambos canales del DAC interno (25 y 26)
@@ -46,57 +222,269 @@ static inline void enableBothDACChannels() {
   i2s_set_dac_mode(I2S_DAC_CHANNEL_BOTH_EN);
 }
 
-// Reproduce WAV por streaming HTTP -> DAC interno
-bool playWavStream(const String& url) {
-  stopAudio();
-
-  // Fuente HTTP con reconexión (HTTP/1.1 por defecto, keep-alive)
-  file_http = new AudioFileSourceHTTPStream(url.c_str());
-  // NO llamar useHTTP10(); // eso forzaría HTTP/1.0
-  file_http->SetReconnect(3, 200);  // tries=3, delay=200ms
-
-  // Salida por DAC interno, duplicando a L/R
-  out = new AudioOutputI2SNoDAC();
-  out->SetOutputModeMono(true);   // mono a ambos canales
-  out->SetGain(0.6);              // menor ganancia = menos clip/ruido
-
-  // Decodificador WAV
-  wav = new AudioGeneratorWAV();
-  if (!wav->begin(file_http, out)) {
-    Serial.println("❌ WAV begin (stream) falló");
-    stopAudio();
-    return false;
-  }
+void printAudioStats() {
+  AudioPipelineStats st = pipeline.stats();
+  Serial.printf("🎚️ buffer %u/%u (min %u) | underruns %u | stall max %u ms | cortes %u | in %u out %u\n",
+                st.fill, st.capacity, st.minFill, st.underruns, st.maxStallMs, st.stalls,
+                st.bytesIn, st.bytesOut);
+}
 
-  // Asegurar ambos DAC habilitados
-  enableBothDACChannels();
+void printCacheStats() {
+  ClipCache::Stats cs = cache.stats();
+  Serial.printf("💾 caché hits %u | misses %u | expulsados %u | %u clips, %u/%u B\n",
+                cs.hits, cs.misses, cs.evictions, cs.entries, cs.bytesUsed, cs.budget);
+}
 
-  Serial.println("▶️ Streaming audio...");
-  while (wav->isRunning()) {
-    if (!wav->loop()) break;
-    delay(1);
+// Abre la fuente del clip (caché en LittleFS o streaming HTTP) y crea
+// su decoder. No toca el pipeline: sirve para el actual y el siguiente.
+void prepareVoice(Voice& v, const Clip& c) {
+  v.clip = c;
+  char path[48];
+  if (*c.clip_id && cache.acquire(c.clip_id, path, sizeof(path))) {
+    AudioFileSourceFS* f = new AudioFileSourceFS(LittleFS, path);
+    if (f->isOpen()) {
+      v.src = f;
+      v.cached = true;
+      Serial.printf("📂 Desde caché: %s\n", path);
+    } else {
+      delete f;
+      cache.release(c.clip_id);
+    }
   }
-  Serial.println("✅ Fin de reproducción (stream)");
+  if (!v.src && c.flujo) {
+    // Sin largo y creciendo: HTTP/1.0 (sin chunked), el fin es el cierre.
+    // Entre frases espera sin reconectar; no va a la caché (sin clip_id)
+    char url[192];
+    snprintf(url, sizeof(url), "%s/esp32/audio_flujo/%s", BASE_URL, c.audio_id);
+    AudioFileSourceHTTPRange* h = new AudioFileSourceHTTPRange();
+    h->useHTTP10(true);
+    h->open(url);
+    v.src = h;
+  }
+  if (!v.src) {
+    // Fuente HTTP con reconexión (HTTP/1.1 por defecto, keep-alive)
+    char url[192];
+    snprintf(url, sizeof(url), "%s/esp32/audio_raw/%s%s", BASE_URL, c.audio_id, c.ima ? "?fmt=ima" : "");
+    AudioFileSourceHTTPStream* h = new AudioFileSourceHTTPStream(url);
+    // NO llamar useHTTP10(); // eso forzaría HTTP/1.0
+    h->SetReconnect(3, 200);  // tries=3, delay=200ms
+    v.src = h;
+    // Con clip_id, lo que baja se guarda en la caché al mismo tiempo
+    v.useTee = *c.clip_id;
+    if (v.useTee) v.tee.arm(c.clip_id, h->getSize());
+  }
+  // Decodificador WAV (corre en la tarea de audio, lee del ring buffer)
+  v.gen = new AudioGeneratorIMA();
+}
 
-  stopAudio();
+// Arranca el clip desde cero (pipeline parado): prebuffer según códec
+bool playVoice(Voice& v) {
+  pipeline.setPrebuffer(v.clip.ima ? AUDIO_PREBUFFER_IMA : AUDIO_PREBUFFER_BYTES);
+  if (!pipeline.play(v.src, v.gen, out, v.useTee ? &v.tee : nullptr)) {
+    Serial.println("❌ Pipeline ocupado");
+    return false;
+  }
+  Serial.println("▶️ Reproduciendo...");
   return true;
 }
 
-bool confirmPlayback(const String& audio_id, const String& status) {
+// Precarga el próximo clip de la cola mientras suena el actual
+void prefetchNext() {
+  if (nextReady || !clipCount || pipeline.hasNext()) return;
+  Clip c;
+  queuePop(c);
+  Voice& v = voices[cur ^ 1];
+  prepareVoice(v, c);
+  if (pipeline.queueNext(v.src, v.gen, v.useTee ? &v.tee : nullptr)) {
+    nextReady = true;
+    Serial.printf("⏭️ Precargado %s\n", c.audio_id);
+  } else {
+    releaseVoice(v);
+    queuePush(c, true);   // se reintenta después
+  }
+}
+
+bool confirmPlayback(const char* audio_id, const char* status) {
+  static char url[160];
+  if (!*url) snprintf(url, sizeof(url), "%s/esp32/confirmar/%s", BASE_URL, DEVICE_ID);
   HTTPClient http;
   http.setReuse(true);
   http.setTimeout(8000);
-  String url = String(BASE_URL) + "/esp32/confirmar/" + DEVICE_ID;
 
   if (!http.begin(url)) return false;
   http.addHeader("Content-Type", "application/x-www-form-urlencoded");
-  String body = "audio_id=" + audio_id + "&status=" + status;
-  int code = http.POST(body);
+  ClipCache::Stats cs = cache.stats();
+  HeapMonitor::Stats hs = heap.stats();
+  char body[224];
+  int n = snprintf(body, sizeof(body),
+                   "audio_id=%s&status=%s&cache_hits=%u&cache_misses=%u&cache_evict=%u"
+                   "&heap_min=%u&heap_bloque=%u",
+                   audio_id, status, cs.hits, cs.misses, cs.evictions, hs.freeMin, hs.largestMin);
+  int code = http.POST((uint8_t*)body, n);
   http.end();
-  Serial.printf("Confirmar %s -> %d\n", status.c_str(), code);
+  Serial.printf("Confirmar %s -> %d\n", status, code);
   return (code >= 200 && code < 300);
 }
 
+// ====== Confirmaciones por lote ======
+// Las confirmaciones se juntan y salen en un solo POST JSON cuando el
+// player queda libre, cuando hay varias o cuando la más vieja pasa
+// CONFIRM_MAX_DELAY. Cada una lleva el seq de su comando: si un lote se
+// reintenta, el server descarta lo que ya procesó.
+const uint8_t       CONFIRM_LEN       = 8;
+const unsigned long CONFIRM_MAX_DELAY = 1000;
+const unsigned long CONFIRM_RETRY_MS  = 2000;
+struct Confirm {
+  char        audio_id[AUDIO_ID_LEN];
+  uint32_t    seq;
+  const char* status;
+};
+Confirm       confirms[CONFIRM_LEN];
+uint8_t       confirmCount = 0;
+unsigned long tConfirmOldest = 0;
+unsigned long tConfirmRetry = 0;
+bool          batchConfirm = true;   // false: el server no tiene /confirmar_lote
+
+void confirmShift(uint8_t n) {
+  confirmCount -= n;
+  memmove(confirms, confirms + n, confirmCount * sizeof(Confirm));
+}
+
+// true si todo lo pendiente quedó confirmado
+bool flushConfirms() {
+  if (!confirmCount) return true;
+  if (!batchConfirm) {   // server viejo: de a uno
+    while (confirmCount && confirmPlayback(confirms[0].audio_id, confirms[0].status)) confirmShift(1);
+    if (confirmCount) tConfirmRetry = millis();
+    return !confirmCount;
+  }
+
+  static char url[160];
+  if (!*url) snprintf(url, sizeof(url), "%s/esp32/confirmar_lote/%s", BASE_URL, DEVICE_ID);
+  static StaticJsonDocument<1536> doc;
+  static char body[1024];
+  doc.clear();
+  JsonArray arr = doc.createNestedArray("confirmaciones");
+  for (uint8_t i = 0; i < confirmCount; i++) {
+    JsonObject o = arr.createNestedObject();
+    o["seq"]      = confirms[i].seq;
+    o["audio_id"] = (const char*)confirms[i].audio_id;   // sin copia: vive hasta el POST
+    o["status"]   = confirms[i].status;
+  }
+  ClipCache::Stats cs = cache.stats();
+  HeapMonitor::Stats hs = heap.stats();
+  doc["cache_hits"]   = cs.hits;
+  doc["cache_misses"] = cs.misses;
+  doc["cache_evict"]  = cs.evictions;
+  doc["heap_min"]     = hs.freeMin;
+  doc["heap_bloque"]  = hs.largestMin;
+  size_t n = serializeJson(doc, body, sizeof(body));
+
+  HTTPClient http;
+  http.setReuse(true);
+  http.setTimeout(8000);
+  if (!http.begin(url)) { tConfirmRetry = millis(); return false; }
+  http.addHeader("Content-Type", "application/json");
+  int code = http.POST((uint8_t*)body, n);
+  http.end();
+  Serial.printf("Confirmar lote de %u -> %d\n", confirmCount, code);
+
+  if (code >= 200 && code < 300) { confirmCount = 0; return true; }
+  if (code == HTTP_CODE_NOT_FOUND) {
+    Serial.println("ℹ️ Server sin /confirmar_lote, confirmando de a uno");
+    batchConfirm = false;
+    return flushConfirms();
+  }
+  tConfirmRetry = millis();
+  return false;
+}
+
+void queueConfirm(const Clip& c, const char* status) {
+  if (confirmCount >= CONFIRM_LEN && !flushConfirms()) {
+    Serial.printf("⚠️ Confirmación de %s descartada (server no responde)\n", confirms[0].audio_id);
+    confirmShift(1);
+  }
+  if (!confirmCount) tConfirmOldest = millis();
+  Confirm& k = confirms[confirmCount++];
+  strlcpy(k.audio_id, c.audio_id, AUDIO_ID_LEN);
+  k.seq = c.seq;
+  k.status = status;
+}
+
+void serviceConfirms() {
+  if (!confirmCount) return;
+  if (tConfirmRetry && millis() - tConfirmRetry < CONFIRM_RETRY_MS) return;
+  if (state == ST_IDLE || confirmCount >= CONFIRM_LEN / 2 ||
+      millis() - tConfirmOldest > CONFIRM_MAX_DELAY) {
+    tConfirmRetry = 0;
+    flushConfirms();
+  }
+}
+
+// ====== Precalentamiento de la caché ======
+// Tarea de una sola pasada: baja las frases de /frases/lista que
+// no estén cacheadas mientras entren en el presupuesto. Cede el paso
+// si hay un clip sonando (no compite con el streaming).
+bool prewarmClip(HTTPClient& http, const char* nombre, const char* clip_id) {
+  char url[192];
+  snprintf(url, sizeof(url), "%s/esp32/frase_raw/%s?fmt=ima", BASE_URL, nombre);
+  if (!http.begin(url)) return false;
+  int code = http.GET();
+  int32_t size = http.getSize();
+  ClipCache::Token w = 0;
+  bool ok = code == HTTP_CODE_OK && size > 0 && (uint32_t)size <= cache.freeBudget() &&
+            (w = cache.beginWrite(clip_id, size));
+  if (ok) {
+    static uint8_t buf[1024];
+    WiFiClient* s = http.getStreamPtr();
+    int32_t left = size;
+    uint32_t tLast = millis();
+    while (left > 0 && http.connected() && millis() - tLast < 5000) {
+      int n = s->read(buf, min((int32_t)sizeof(buf), left));
+      if (n <= 0) { vTaskDelay(1); continue; }
+      if (!cache.write(w, buf, n)) break;
+      left -= n;
+      tLast = millis();
+    }
+    ok = left == 0 && cache.commit(w);
+    if (!ok) cache.abort(w);
+  }
+  http.end();
+  return ok;
+}
+
+void prewarmTask(void*) {
+  StaticJsonDocument<256> filter;
+  filter["frases"][0]["id"] = true;
+  filter["frases"][0]["clip_id"] = true;
+  DynamicJsonDocument doc(8192);
+
+  HTTPClient http;
+  http.setReuse(true);
+  http.setTimeout(8000);
+  char url[160];
+  snprintf(url, sizeof(url), "%s/frases/lista", BASE_URL);
+  if (http.begin(url) && http.GET() == HTTP_CODE_OK &&
+      !deserializeJson(doc, http.getStream(), DeserializationOption::Filter(filter))) {
+    http.end();
+    uint8_t nuevos = 0;
+    for (JsonObject f : doc["frases"].as<JsonArray>()) {
+      const char* nombre  = f["id"]      | "";
+      const char* clip_id = f["clip_id"] | "";
+      if (!*nombre || !*clip_id || cache.contains(clip_id)) continue;
+      while (pipeline.isBusy()) vTaskDelay(pdMS_TO_TICKS(200));
+      if (cache.freeBudget() < 16 * 1024) break;
+      if (prewarmClip(http, nombre, clip_id)) nuevos++;
+    }
+    Serial.printf("💾 Precalentamiento: %u frases nuevas\n", nuevos);
+    printCacheStats();
+  } else {
+    http.end();
+    Serial.println("⚠️ Precalentamiento: no se pudo leer /frases/lista");
+  }
+  vTaskDelete(nullptr);
+}
+
 void setup() {
   Serial.begin(115200);
   Serial.println("\nRobot NAO - Cliente ESP32 (Streaming + DAC interno L=GPIO25 / R=GPIO26)");
@@ -109,15 +497,38 @@ void setup() {
   while (WiFi.status() != WL_CONNECTED) { delay(250); Serial.print("."); }
   Serial.printf(" ✅ IP: %s  RSSI: %d dBm\n", WiFi.localIP().toString().c_str(), WiFi.RSSI());
 
+  // --- Pipeline de audio (red en core 0, DAC en core 1) ---
+  AudioPipeline::Config acfg;
+  acfg.ringBytes      = AUDIO_RING_BYTES;
+  acfg.prebufferBytes = AUDIO_PREBUFFER_BYTES;
+  acfg.onBegin        = enableBothDACChannels;  // asegurar ambos DAC tras out->begin()
+  if (!pipeline.begin(acfg)) {
+    Serial.println("❌ No se pudo iniciar el pipeline de audio");
+  }
+
+  // Salida por DAC interno, duplicando a L/R; queda abierta entre clips
+  dac = new AudioOutputI2SNoDAC();
+  dac->SetOutputModeMono(true);   // mono a ambos canales
+  dac->SetGain(currentGain());    // menor ganancia = menos clip/ruido
+  out = new AudioOutputKeepOpen(dac);
+
+  // --- Caché de clips en LittleFS ---
+  if (cache.begin(CLIP_CACHE_BYTES)) printCacheStats();
+  else Serial.println("❌ No se pudo montar LittleFS (sin caché)");
+
   // --- Registro de dispositivo ---
   {
     HTTPClient http;
     http.setReuse(true);
     http.setTimeout(8000);
-    String url = String(BASE_URL) + "/esp32/register";
+    char url[160];
+    snprintf(url, sizeof(url), "%s/esp32/register", BASE_URL);
     if (http.begin(url)) {
       http.addHeader("Content-Type", "application/x-www-form-urlencoded");
-      int code = http.POST(String("device_id=") + DEVICE_ID);
+      char body[112];
+      int n = snprintf(body, sizeof(body), "device_id=%s&formatos=%s&flujo=%d", DEVICE_ID, AUDIO_FORMATOS,
+                       AUDIO_FLUJO);
+      int code = http.POST((uint8_t*)body, n);
       String resp = http.getString();
       http.end();
       Serial.printf("Registro -> %d %s\n", code, resp.c_str());
@@ -125,64 +536,215 @@ void setup() {
       Serial.println("No se pudo iniciar HTTP para registro");
     }
   }
+
+  // --- Canal de comandos (long-poll, fallback a poll cada 200 ms) ---
+  CommandChannel::Config ccfg;
+  ccfg.baseUrl        = BASE_URL;
+  ccfg.deviceId       = DEVICE_ID;
+  ccfg.pollIntervalMs = 200;
+  ccfg.rtt            = &telePollRtt;
+  if (!channel.begin(ccfg)) {
+    Serial.println("❌ No se pudo iniciar el canal de comandos");
+  }
+
+  // --- Precalentar frases en segundo plano (core 0, baja prioridad) ---
+  xTaskCreatePinnedToCore(prewarmTask, "prewarm", 8192, nullptr, 1, nullptr, 0);
+
+  // --- Telemetría al server (core 0, baja prioridad) ---
+  if (!teleEnvio.begin(BASE_URL, DEVICE_ID)) Serial.println("❌ No se pudo iniciar la telemetría");
 }
 
-unsigned long tPoll = 0;
+// ====== Reproducción (no bloqueante) ======
 
-void loop() {
-  // Poll cada 200 ms para baja latencia
-  if (millis() - tPoll > 200) {
-    tPoll = millis();
+void startNextClip() {
+  Clip c;
+  if (!queuePop(c)) { setState(ST_IDLE); return; }
+  tClipStart = millis();
+  teleClips.sumar();
+  Voice& v = voices[cur];
+  prepareVoice(v, c);
+  if (playVoice(v)) {
+    setState(ST_PREBUFFERING);
+  } else {
+    releaseVoice(v);
+    pendingConfirm = c;
+    pendingStatus = "error";
+    setState(ST_CONFIRMING);
+  }
+}
 
-    HTTPClient http;
-    http.setReuse(true);          // intentar keep-alive
-    http.setTimeout(5000);        // poll rápido
-    String url = String(BASE_URL) + "/esp32/poll/" + DEVICE_ID;
+// Corta el clip actual y lo deja para confirmar con 'status'
+void abortCurrentClip(const char* status) {
+  if (state != ST_PREBUFFERING && state != ST_PLAYING) return;
+  pendingConfirm = voices[cur].clip;
+  stopAudio();
+  pendingStatus = status;
+  setState(ST_CONFIRMING);
+}
 
-    if (!http.begin(url)) {
-      Serial.println("Poll: begin() falló");
-      return;
-    }
+void sendPendingConfirm() {
+  if (!pendingStatus) return;
+  queueConfirm(pendingConfirm, pendingStatus);   // sale en el próximo lote
+  pendingStatus = nullptr;
+}
 
-    int code = http.GET();
-    if (code == HTTP_CODE_OK) {
-      // Parseo directo desde el stream (maneja chunked)
-      DynamicJsonDocument doc(2048);
-      DeserializationError e = deserializeJson(doc, http.getStream());
-      http.end();
+// El pipeline pasó al clip precargado sin cortar: confirmar el anterior
+void onAdvance() {
+  seenAdvances++;
+  Voice& done = voices[cur];
+  Serial.printf("✅ Fin de %s, sigue el precargado sin corte\n", done.clip.audio_id);
+  teleClips.sumar();
+  pendingConfirm = done.clip;
+  pendingStatus = pipeline.prevOk() ? "success" : "error";
+  releaseVoice(done);
+  cur ^= 1;
+  nextReady = false;
+  tClipStart = millis();
+  sendPendingConfirm();
+}
+
+void stepPlayer() {
+  switch (state) {
+    case ST_IDLE:
+      if (clipCount) startNextClip();
+      break;
+
+    case ST_PREBUFFERING:
+      if (pipeline.started()) {
+        Serial.printf("🔊 Primer audio en %lu ms\n", millis() - tClipStart);
+        telePrimerAudio.registrar(millis() - tClipStart);
+        setState(ST_PLAYING);
+      }
+      // fallthrough: el clip puede terminar sin llegar a sonar
+
+    case ST_PLAYING:
+      if (millis() - tStats > 1000) {
+        tStats = millis();
+        printAudioStats();
+      }
+      if (pipeline.advances() != seenAdvances) onAdvance();
+      if (pipeline.started()) prefetchNext();
+      if (!pipeline.isBusy()) {
+        bool ok = pipeline.started() && pipeline.lastOk();
+        if (!pipeline.started()) Serial.println("❌ WAV begin (stream) falló");
+        else Serial.printf("🎵 Formato: %s\n", voices[cur].gen->isAdpcm() ? "IMA-ADPCM" : "PCM");
+        if (ok) Serial.println("✅ Fin de reproducción (stream)");
+        else if (pipeline.started()) Serial.println(pipeline.lastStalled() ? "❌ Clip cortado: la red dejó de mandar"
+                                                                           : "❌ Clip incompleto");
+        printAudioStats();
+        printCacheStats();
+        pendingConfirm = voices[cur].clip;
+        pendingStatus = ok ? "success" : "error";
+        stopAudio();   // si el precargado no llegó a entrar, vuelve a la cola
+        seenAdvances = 0;
+        setState(ST_CONFIRMING);
+      }
+      break;
 
-      if (e) {
-        Serial.printf("JSON poll error: %s\n", e.c_str());
+    case ST_CONFIRMING:
+      // Arrancar el siguiente antes de confirmar: el POST se solapa con el prebuffer
+      if (clipCount) {
+        startNextClip();
       } else {
-        JsonArray cmds = doc["comandos"].as<JsonArray>();
-        if (!cmds.isNull() && cmds.size() > 0) {
-          JsonObject c = cmds[0];
-          const char* tipo     = c["tipo"]     | "";
-          const char* audio_id = c["audio_id"] | "";
+        out->close();   // nada más en la cola: apagar la salida
+        setState(ST_IDLE);
+      }
+      sendPendingConfirm();
+      break;
+  }
+}
 
-          Serial.printf("CMD: %s audio_id=%s\n", tipo, audio_id);
+// ====== Comandos ======
+// Los campos se leen como const char* directo del documento (vive hasta
+// el próximo comando); lo que tiene que durar se copia a char[] (Clip).
 
-          if (audio_id && *audio_id) {
-            String wavURL = String(BASE_URL) + "/esp32/audio_raw/" + audio_id;
+void cmdDetener(JsonObject c, uint32_t) {
+  abortCurrentClip("cancelado");
+  // Los de la cola (también el precargado, que volvió al frente) se
+  // confirman cancelados: si no, el server nunca cierra su seq
+  Clip clip;
+  while (queuePop(clip)) queueConfirm(clip, "cancelado");
+}
 
-            bool played = playWavStream(wavURL);
+void cmdSiguiente(JsonObject c, uint32_t) {
+  abortCurrentClip("saltado");                  // arranca el próximo de la cola
+}
 
-            // Confirmar al server (success/error)
-            confirmPlayback(audio_id, played ? "success" : "error");
-          }
-        }
-      }
-    } else {
-      Serial.printf("Poll -> %d\n", code);
-      http.end();
-    }
+void cmdVolumen(JsonObject c, uint32_t) {
+  currentVolume = constrain((int)(c["volume"] | currentVolume), 0, 100);
+  if (out) out->SetGain(currentGain());   // aplica en caliente
+  Serial.printf("🔊 Volumen %d%%\n", currentVolume);
+}
+
+void cmdClip(JsonObject c, uint32_t) {
+  const char* audio_id = c["audio_id"] | "";
+  const char* clip_id  = c["clip_id"]  | "";       // hash del WAV (caché)
+  const char* modo     = c["modo"]     | "cola";   // "cola" | "ya"
+  const char* formato  = c["formato"]  | "wav";    // "ima" | "wav"
+  if (!*audio_id) return;
+  Clip clip;
+  strlcpy(clip.audio_id, audio_id, AUDIO_ID_LEN);
+  strlcpy(clip.clip_id, clip_id, ClipCache::KEY_LEN);
+  clip.ima = !strcmp(formato, "ima");
+  clip.flujo = c["flujo"] | false;
+  clip.seq = c["seq"] | 0;
+  bool now = !strcmp(modo, "ya");
+  if (now) abortCurrentClip("interrumpido");   // el precargado vuelve a la cola...
+  if (!queuePush(clip, now)) {                 // ...detrás del nuevo
+    Serial.println("⚠️ Cola llena, clip descartado");
+    queueConfirm(clip, "error");
   }
+}
+
+const CommandRoute ROUTES[] = {
+  { "detener",                 cmdDetener   },
+  { "musica_detener",          cmdDetener   },
+  { "siguiente",               cmdSiguiente },
+  { "musica_volumen",          cmdVolumen   },
+  { "reproducir_frase",        cmdClip      },
+  { "reproducir_conversacion", cmdClip      },
+  { "reproducir_loro",         cmdClip      },
+};
+
+void handleCommand(JsonObject c, uint32_t tRecv) {
+  const char* tipo     = c["tipo"]     | "";
+  const char* audio_id = c["audio_id"] | "";
+  Serial.printf("CMD: %s audio_id=%s [%s]\n", tipo, audio_id, stateName(state));
+
+  // Tipos nuevos con audio_id se tratan como clip (compatibilidad)
+  if (!routeCommand(ROUTES, c, tRecv) && *audio_id) cmdClip(c, tRecv);
+  Serial.printf("⏱️ Comando aplicado en %lu ms\n", millis() - tRecv);
+}
 
-  // Mantener audio corriendo si algo quedó en background (seguro)
-  if (wav && wav->isRunning()) {
-    if (!wav->loop()) {
-      stopAudio();
+StaticJsonDocument<768> cmdDoc;   // un comando por vez (ver CommandChannel)
+
+void processCommands() {
+  static CommandChannel::Command cmd;   // 516 B: fuera del stack de loop()
+  while (channel.receive(cmd)) {
+    DeserializationError e = deserializeJson(cmdDoc, cmd.json);
+    if (e) {
+      Serial.printf("JSON cmd error: %s\n", e.c_str());
+      continue;
     }
+    handleCommand(cmdDoc.as<JsonObject>(), cmd.tRecv);
+  }
+}
+
+void loop() {
+  // Los comandos llegan por la tarea del canal (long-poll), acá solo se consumen
+  processCommands();
+
+  stepPlayer();
+
+  serviceConfirms();
+
+  if (heap.due(HEAP_INTERVAL)) {
+    heap.print();
+    HeapMonitor::Stats hs = heap.stats();
+    teleHeapLibre.fijar(hs.freeNow);
+    teleHeapBloque.fijar(hs.largestBlock);
+    teleRssi.fijar(WiFi.RSSI());
+    teleCmdPerdidos.fijar(channel.stats().lost);
   }
 
   delay(1);
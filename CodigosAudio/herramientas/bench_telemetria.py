@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+Cuánto cuesta cada muestra de Telemetria.h, medido en la PC.
+
+Compila Telemetria.h en host dos veces (TELEMETRIA 1 y 0) con un arnés que
+registra N muestras por operación y muestra ns por muestra, descontando el
+mismo loop sin telemetría:
+  contador     Contador::sumar()
+  medidor      Medidor::fijar()
+  histograma   Histograma::registrar() con valores repartidos en las cubetas
+  cronometro   un Cronometro por scope (dos lecturas de reloj + registrar)
+  2 hilos      histograma compartido desde dos hilos (los dos cores del ESP32)
+  foto json    Registro::json() con las métricas de Vocesconwifiperfecto
+Antes verifica que la foto sea JSON válido y que cada valor caiga en su
+cubeta (el límite va incluido).
+
+Es la PC, no el ESP32: sirve para comparar opciones y ver que con
+TELEMETRIA 0 no queda nada, no para sacar microsegundos del Xtensa.
+
+Uso:
+    python3 bench_telemetria.py
+    python3 bench_telemetria.py -n 20000000 --cxx clang++
+"""
+import argparse
+import json
+import os
+import subprocess
+import tempfile
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+LIBRERIA = os.path.join(AQUI, "..", "..", "libraries", "Telemetria")
+
+ARNES = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include "Telemetria.h"
+using namespace telemetria;
+
+Registro   reg;
+Histograma rtt(reg, "poll_rtt_ms", CUBETAS_MS);
+Histograma primer(reg, "primer_audio_ms", CUBETAS_MS);
+Histograma redibujo(reg, "redibujo_us", CUBETAS_US);
+Contador   clips(reg, "clips");
+Contador   underruns(reg, "underruns");
+Medidor    heapLibre(reg, "heap_libre");
+Medidor    heapBloque(reg, "heap_bloque");
+Medidor    rssi(reg, "wifi_rssi");
+
+#define BARRERA() asm volatile("" ::: "memory")
+static inline uint32_t valor(uint32_t i) { return (i * 2654435761u) >> 19; }   // 0..8191
+
+template <typename F>
+double ns(uint32_t n, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) { f(i); BARRERA(); }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+int main(int argc, char** argv) {
+  uint32_t n = atoi(argv[1]);
+  if (!strcmp(argv[2], "foto")) {
+    // Valores conocidos: límites exactos, uno de más y uno por encima de todo
+    static const uint32_t VALORES[] = { 0, 5, 6, 10, 5000, 5001 };
+    for (uint32_t v : VALORES) rtt.registrar(v);
+    clips.sumar(3);
+    heapLibre.fijar(-7);
+    static char buf[3072];
+    reg.json(buf, sizeof(buf), "bench", 42);
+    printf("%s\n", buf);
+    static char chico[40];
+    printf("%zu\n", reg.json(chico, sizeof(chico), "bench", 42));
+    return 0;
+  }
+  volatile uint32_t sumidero = 0;
+  double base = ns(n, [&](uint32_t i) { sumidero = valor(i); });
+  printf("base %.3f\n", base);
+  printf("contador %.3f\n", ns(n, [&](uint32_t i) { clips.sumar(); }) - base);
+  printf("medidor %.3f\n", ns(n, [&](uint32_t i) { rssi.fijar(valor(i)); }) - base);
+  printf("histograma %.3f\n", ns(n, [&](uint32_t i) { redibujo.registrar(valor(i) * 12); }) - base);
+  printf("cronometro %.3f\n", ns(n, [&](uint32_t i) { Cronometro c(redibujo); sumidero = valor(i); }) - base);
+  double dos = 0;
+  std::thread otro([&] { ns(n, [&](uint32_t i) { primer.registrar(valor(i)); }); });
+  dos = ns(n, [&](uint32_t i) { primer.registrar(valor(i)); }) - base;
+  otro.join();
+  printf("2 hilos %.3f\n", dos);
+  static char buf[3072];
+  uint32_t m = n / 1000 + 1;
+  printf("foto json %.3f\n", ns(m, [&](uint32_t i) { sumidero = reg.json(buf, sizeof(buf), "bench", i); }));
+  return 0;
+}
+"""
+
+
+def compilar(cxx, tmp, activa):
+    fuente = os.path.join(tmp, "arnes.cpp")
+    exe = os.path.join(tmp, f"arnes{activa}")
+    with open(fuente, "w") as f:
+        f.write(ARNES)
+    subprocess.run([cxx, "-std=c++11", "-O2", "-Wall", "-pthread", f"-DTELEMETRIA={activa}",
+                    "-I", LIBRERIA, fuente, "-o", exe], check=True)
+    return exe
+
+
+def verificar_foto(exe):
+    salida = subprocess.run([exe, "1", "foto"], capture_output=True, text=True, check=True).stdout.split("\n")
+    foto = json.loads(salida[0])
+    h = foto["histogramas"]["poll_rtt_ms"]
+    casos = [
+        ("JSON válido con las 3 secciones", all(k in foto for k in ("contadores", "medidores", "histogramas"))),
+        ("límite incluido en su cubeta", h["cuentas"][:3] == [2, 2, 0]),
+        ("por encima del último a +Inf", h["cuentas"][-2:] == [1, 1]),
+        ("n / suma / max", (h["n"], h["suma"], h["max"]) == (6, 10022, 5001)),
+        ("contador y medidor", (foto["contadores"]["clips"], foto["medidores"]["heap_libre"]) == (3, -7)),
+        ("sin lugar devuelve 0", salida[1] == "0"),
+    ]
+    ok = True
+    for nombre, bien in casos:
+        ok &= bien
+        print(f"  {'ok ' if bien else 'MAL'} {nombre}")
+    return ok
+
+
+def correr(exe, n):
+    salida = subprocess.run([exe, str(n), "bench"], capture_output=True, text=True, check=True).stdout
+    return dict((l.rsplit(" ", 1)[0], float(l.rsplit(" ", 1)[1])) for l in salida.strip().split("\n"))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-n", type=int, default=10_000_000, help="muestras por operación")
+    ap.add_argument("--cxx", default="c++")
+    a = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        con, sin = compilar(a.cxx, tmp, 1), compilar(a.cxx, tmp, 0)
+        print("Foto:")
+        if not verificar_foto(con):
+            raise SystemExit(1)
+        r1, r0 = correr(con, a.n), correr(sin, a.n)
+
+    print(f"\nns por muestra ({a.n} muestras, sin el loop base de {r1['base']:.2f} ns)")
+    print(f"{'operación':<12} {'TELEMETRIA 1':>13} {'TELEMETRIA 0':>13}")
+    for k in r1:
+        if k == "base":
+            continue
+        unidad = " (por foto)" if k == "foto json" else ""
+        print(f"{k:<12} {r1[k]:>13.2f} {r0[k]:>13.2f}{unidad}")
+
+
+if __name__ == "__main__":
+    main()
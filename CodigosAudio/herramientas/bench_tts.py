@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+"""
+Pedido -> primer byte de audio con el almacén TTS del server, frases frías
+contra tibias, con varios devices a la vez.
+
+Sin --url toma del notebook (RobotNao.ipynb) las secciones del IMA, del
+almacén y de los flujos tal cual, con un TTS de mentira que tarda --tts-ms
+más --tts-rtf por ms de audio, y mide lo mismo que hace el server: el
+control que asegura el audio (WAV y, si el device es IMA, la conversión) y
+el primer byte que saldría por /esp32/audio_raw. Casos:
+  frío             cada pedido es un texto nuevo (TTS + conversión)
+  frío, misma      --devices piden el mismo texto nuevo a la vez (una síntesis)
+  disco            server reiniciado: los textos de "frío" salen del disco
+  memoria          los mismos otra vez, del LRU
+  catálogo         frases prerenderizadas al arrancar
+  conv. entera     /control/conversar con una respuesta de varias frases
+                   sintetizada de una vez
+  conv. flujo      la misma, frase por frase: primer byte de /esp32/audio_flujo
+Antes verifica el parseo de Range (206/416) contra casos de la RFC.
+
+Con --url mide contra un server corriendo: /control/repetir con textos
+nuevos (frío) y otra vez los mismos (tibio), /control/frase con el
+catálogo, y el primer byte de /esp32/audio_raw con "Range: bytes=0-".
+
+Uso:
+    python3 bench_tts.py
+    python3 bench_tts.py --devices 16 --tts-ms 1500 --fmt wav
+    python3 bench_tts.py --tts-ms 300 --tts-rtf 0.5 --respuestas 3
+    python3 bench_tts.py --url http://localhost:8000 --devices 4
+"""
+import argparse
+import asyncio
+import hashlib
+import io
+import json
+import logging
+import math
+import os
+import re
+import struct
+import tempfile
+import threading
+import time
+import urllib.parse
+import urllib.request
+import uuid
+import wave
+from collections import OrderedDict, deque
+from concurrent.futures import ThreadPoolExecutor
+from typing import Optional
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+NOTEBOOK = os.path.join(AQUI, "..", "..", "RobotNao.ipynb")
+
+INICIO = "# ===== IMA-ADPCM"
+FIN = "# ===== FUNCIONES PARA IMÁGENES"
+VOZ = "es-MX-JorgeNeural"
+MS_POR_LETRA = 70
+
+
+def cargar_almacen():
+    """Las secciones IMA + almacén + flujos del server, ejecutadas aparte"""
+    with open(NOTEBOOK, encoding="utf-8") as f:
+        nb = json.load(f)
+    for celda in nb["cells"]:
+        src = "".join(celda["source"])
+        if "class AlmacenAudio" in src:
+            break
+    else:
+        raise SystemExit("No está AlmacenAudio en el notebook")
+    seccion = src[src.index(INICIO):src.index(FIN)]
+    ns = {"io": io, "os": os, "re": re, "time": time, "hashlib": hashlib, "asyncio": asyncio, "wave": wave,
+          "struct": struct, "OrderedDict": OrderedDict, "deque": deque, "Optional": Optional,
+          "AudioSegment": None, "logger": logging.getLogger("bench_tts")}
+    exec(compile(seccion, "RobotNao.ipynb (almacén)", "exec"), ns)
+    return ns
+
+
+def wav_voz(texto: str, rate: int = 16000) -> bytes:
+    """~70 ms por letra, como una voz de edge-tts"""
+    n = rate * MS_POR_LETRA * max(1, len(texto)) // 1000
+    m = [int(8000 * math.sin(2 * math.pi * 180 * i / rate) * (0.5 + 0.5 * math.sin(2 * math.pi * 4 * i / rate)))
+         for i in range(n)]
+    out = io.BytesIO()
+    with wave.open(out, "wb") as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(rate)
+        w.writeframes(struct.pack(f"<{n}h", *m))
+    return out.getvalue()
+
+
+def verificar_rangos(rango_http):
+    casos = [("bytes=0-", (0, 99)), ("bytes=10-19", (10, 19)), ("bytes=-5", (95, 99)),
+             ("bytes=90-500", (90, 99)), ("bytes=-500", (0, 99)), (None, None),
+             ("bytes=5-2", None), ("items=0-1", None), ("bytes=0-1,5-6", None), ("bytes=x-", None),
+             ("bytes=100-", ValueError), ("bytes=-0", ValueError)]
+    for cab, esperado in casos:
+        try:
+            r = rango_http(cab, 100)
+        except ValueError:
+            r = ValueError
+        if r != esperado:
+            raise SystemExit(f"Range {cab!r}: {r}, se esperaba {esperado}")
+    print(f"Range: {len(casos)} casos ok (206 con a-b, sufijo y abierto; 416 fuera; se ignora lo malformado)")
+
+
+def resumen(nombre, ms, sintesis):
+    ms = sorted(ms)
+    pct = lambda p: ms[min(len(ms) - 1, int(p * len(ms)))]
+    print(f"{nombre:<14} {len(ms):7} {sintesis:8} {pct(0.5):9.1f} {pct(0.95):9.1f} {ms[-1]:9.1f}")
+
+
+def cabecera(titulo):
+    print(titulo)
+    print(f"{'caso':<14} {'pedidos':>7} {'síntesis':>8} {'p50_ms':>9} {'p95_ms':>9} {'máx_ms':>9}")
+
+
+# ====== En proceso, con el código del notebook ======
+async def en_proceso(args):
+    ns = cargar_almacen()
+    verificar_rangos(ns["rango_http"])
+    tts_clave, AlmacenAudio, FlujoAudio = ns["tts_clave"], ns["AlmacenAudio"], ns["FlujoAudio"]
+
+    async def tts(texto, voz, efecto):
+        await asyncio.sleep((args.tts_ms + args.tts_rtf * MS_POR_LETRA * len(texto)) / 1000)
+        return wav_voz(texto)
+
+    async def pedido(alm, texto):
+        """Como /control/repetir + el primer byte del GET del device"""
+        t0 = time.perf_counter()
+        clave = tts_clave(texto, VOZ, "normal")
+        await alm.obtener(clave, "wav", (texto, VOZ, "normal"))
+        if args.fmt != "wav":
+            await alm.obtener(clave, args.fmt)
+        datos = alm.en_memoria(clave, args.fmt)
+        if datos is None:
+            with open(alm.ruta(clave, args.fmt), "rb") as f:
+                datos = f.read(64 * 1024)
+        assert datos[:4] == b"RIFF"
+        return (time.perf_counter() - t0) * 1000
+
+    async def en_flujo(alm, texto):
+        """/control/conversar frase por frase: el primer byte de /esp32/audio_flujo.
+        Después baja el resto, como el ESP32 (las otras frases siguen ocupando el TTS)"""
+        t0 = time.perf_counter()
+        trozos = FlujoAudio(alm, texto, VOZ, args.fmt).trozos()
+        assert (await trozos.__anext__())[:4] == b"RIFF"
+        ms = (time.perf_counter() - t0) * 1000
+        async for _ in trozos: pass
+        return ms
+
+    async def devices(alm, textos_de, pedir=pedido):
+        """textos_de(d) = los textos que pide el device d, en orden"""
+        async def uno(d):
+            return [await pedir(alm, t) for t in textos_de(d)]
+        return [ms for lista in await asyncio.gather(*(uno(d) for d in range(args.devices))) for ms in lista]
+
+    with tempfile.TemporaryDirectory() as carpeta:
+        alm = AlmacenAudio(carpeta, tts)
+        cabecera(f"== Almacén TTS: {args.devices} devices x {args.pedidos} pedidos, TTS {args.tts_ms} ms + "
+                 f"{args.tts_rtf} x audio, fmt {args.fmt} ==")
+        textos = lambda d: [f"frase fría {d} {i} del robot" for i in range(args.pedidos)]
+
+        s0 = alm.stats["sintesis"]
+        resumen("frío", await devices(alm, textos), alm.stats["sintesis"] - s0)
+
+        s0 = alm.stats["sintesis"]
+        ms = []
+        for i in range(args.pedidos):
+            ms += await asyncio.gather(*(pedido(alm, f"todos piden esta {i}") for _ in range(args.devices)))
+        resumen("frío, misma", ms, alm.stats["sintesis"] - s0)
+        esperas = alm.stats["esperas"]
+
+        alm = AlmacenAudio(carpeta, tts)   # reinicio: solo queda el disco
+        s0 = alm.stats["sintesis"]
+        resumen("disco", await devices(alm, textos), alm.stats["sintesis"] - s0)
+        s0 = alm.stats["sintesis"]
+        resumen("memoria", await devices(alm, textos), alm.stats["sintesis"] - s0)
+
+        catalogo = [f"frase del catálogo número {i}" for i in range(args.catalogo)]
+        t0 = time.perf_counter()
+        await asyncio.gather(*(pedido(alm, t) for t in catalogo))
+        prerender = time.perf_counter() - t0
+        s0 = alm.stats["sintesis"]
+        elegir = lambda d: [catalogo[(d * 7 + i * 13) % len(catalogo)] for i in range(args.pedidos)]
+        resumen("catálogo", await devices(alm, elegir), alm.stats["sintesis"] - s0)
+
+        # Respuestas de Gemini: una frase corta y varias largas
+        respuesta = lambda modo: lambda d: [
+            f"¡Hola! Soy Nao {d}. " + " ".join(f"Te cuento la parte {k} de la respuesta {i} {modo}, que sigue "
+                                              f"un rato más." for k in range(4)) for i in range(args.respuestas)]
+        alm.stats["esperas"] = 0
+        s0 = alm.stats["sintesis"]
+        resumen("conv. entera", await devices(alm, respuesta("entera")), alm.stats["sintesis"] - s0)
+        s0 = alm.stats["sintesis"]
+        resumen("conv. flujo", await devices(alm, respuesta("en flujo"), en_flujo), alm.stats["sintesis"] - s0)
+        audio_s = MS_POR_LETRA * len(respuesta("")(0)[0]) / 1000
+
+        r = alm.resumen()
+        print(f"Prerender de {len(catalogo)} frases: {prerender:.1f} s; en memoria {r['memoria_archivos']} "
+              f"archivos ({r['memoria_bytes'] / 1024:.0f} KB), en disco {r['disco_archivos']}; "
+              f"{esperas} pedidos esperaron una síntesis en curso en vez de repetirla")
+        print(f"Cada respuesta: ~{audio_s:.1f} s de audio; en flujo el primer byte espera solo a la primera frase")
+
+
+# ====== Contra un server corriendo ======
+def contra_server(args):
+    base = args.url.rstrip("/")
+
+    def post(ruta, campos):
+        datos = urllib.parse.urlencode(campos).encode()
+        with urllib.request.urlopen(urllib.request.Request(base + ruta, data=datos), timeout=120) as r:
+            return json.load(r)
+
+    def primer_byte(audio_id):
+        url = f"{base}/esp32/audio_raw/{audio_id}" + ("?fmt=ima" if args.fmt == "ima" else "")
+        req = urllib.request.Request(url, headers={"Range": "bytes=0-"})
+        with urllib.request.urlopen(req, timeout=120) as r:
+            r.read(1)
+            return r.status
+
+    def medir(nombre, trabajo):
+        ms, lock = [], threading.Lock()
+
+        def device(d):
+            for i in range(args.pedidos):
+                t0 = time.perf_counter()
+                audio_id = trabajo(d, i)
+                primer_byte(audio_id)
+                with lock:
+                    ms.append((time.perf_counter() - t0) * 1000)
+
+        antes = json.load(urllib.request.urlopen(base + "/admin/tts", timeout=10))["sintesis"]
+        with ThreadPoolExecutor(args.devices) as ex:
+            list(ex.map(device, range(args.devices)))
+        despues = json.load(urllib.request.urlopen(base + "/admin/tts", timeout=10))["sintesis"]
+        resumen(nombre, ms, despues - antes)
+
+    # Los comandos quedan en la cola de devices que nadie lee
+    marca = uuid.uuid4().hex[:8]
+    texto = lambda d, i: f"prueba {marca} del device {d} número {i}"
+    loro = lambda d, i: post("/control/repetir", {"device_id": f"bench-{d}", "texto": texto(d, i)})["audio_id"]
+    frases = [f["id"] for f in json.load(urllib.request.urlopen(base + "/frases/lista", timeout=10))["frases"]]
+
+    cabecera(f"== {base}: {args.devices} devices x {args.pedidos} pedidos, fmt {args.fmt} "
+             f"(el device bench-N anuncia 'wav') ==")
+    medir("frío", loro)
+    medir("tibio", loro)
+    if frases:
+        medir("catálogo", lambda d, i: post("/control/frase", {"device_id": f"bench-{d}",
+                                                                "nombre_frase": frases[(d + i) % len(frases)]})["audio_id"])
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--devices", type=int, default=8)
+    ap.add_argument("--pedidos", type=int, default=5, help="pedidos por device en cada caso")
+    ap.add_argument("--tts-ms", type=int, default=800, help="lo que tarda el TTS de mentira, fijo por pedido")
+    ap.add_argument("--tts-rtf", type=float, default=0.25, help="y por cada ms de audio")
+    ap.add_argument("--respuestas", type=int, default=2, help="respuestas de conversar por device")
+    ap.add_argument("--catalogo", type=int, default=30)
+    ap.add_argument("--fmt", choices=("wav", "ima"), default="ima")
+    ap.add_argument("--url", help="server corriendo (si no, en proceso)")
+    args = ap.parse_args()
+    if args.url:
+        contra_server(args)
+    else:
+        asyncio.run(en_proceso(args))
+
+
+if __name__ == "__main__":
+    main()
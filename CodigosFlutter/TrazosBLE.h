@@ -0,0 +1,176 @@
+/****************************************************
+ * Trazos por BLE (app de dibujo -> ILI9341)
+ * - Paquete OP_TRAZO: cabecera de 10 bytes + deltas
+ *   [0x10, seq, flags, n, color565, x0, y0] (LE)
+ *   flags: F_INICIO = el primer punto empieza trazo
+ *   (si no, se une con el último del paquete anterior),
+ *   F_FIN = el trazo termina en el último punto
+ * - Deltas: un byte por punto con dx/dy en nibbles con
+ *   signo (-8..7); ESCAPE (0x88) + dx, dy en int8 para
+ *   saltos más largos
+ * - OP_BORRAR: [0x11, seq]
+ * - El ESP32 contesta por notify [0x90, seq, créditos]:
+ *   último paquete aplicado y lugares libres en su cola
+ *   (la app no manda más de eso sin ack)
+ * - Tramos: pasa las líneas a rectángulos por fila (un
+ *   fillRect por tramo en vez de un píxel por vez)
+ * - Sin Arduino.h: compila también en la PC
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace trazos {
+
+static const uint8_t  OP_TRAZO  = 0x10;
+static const uint8_t  OP_BORRAR = 0x11;
+static const uint8_t  OP_ACK    = 0x90;
+static const uint8_t  F_INICIO  = 0x01;
+static const uint8_t  F_FIN     = 0x02;
+static const uint8_t  ESCAPE    = 0x88;      // nibbles (-8, -8): no se usa como delta
+static const uint8_t  CABECERA  = 10;
+static const uint16_t MAX_PAQUETE = 244;     // MTU 247 - 3 de ATT
+
+struct Cabecera {
+  uint8_t  seq;
+  uint8_t  flags;
+  uint8_t  n;
+  uint16_t color;
+  int16_t  x0, y0;
+};
+
+inline int8_t nibble(uint8_t v) { return (int8_t)(v << 4) >> 4; }
+
+// Llama a punto(x, y, nuevo) por cada punto (nuevo = empieza trazo).
+// Devuelve false si el paquete está cortado o mal armado.
+template <typename F>
+bool decodificar(const uint8_t* p, size_t len, Cabecera& c, F punto) {
+  if (len < CABECERA || p[0] != OP_TRAZO || p[3] == 0) return false;
+  c.seq = p[1];
+  c.flags = p[2];
+  c.n = p[3];
+  c.color = p[4] | (uint16_t)p[5] << 8;
+  c.x0 = (int16_t)(p[6] | (uint16_t)p[7] << 8);
+  c.y0 = (int16_t)(p[8] | (uint16_t)p[9] << 8);
+  int16_t x = c.x0, y = c.y0;
+  punto(x, y, (c.flags & F_INICIO) != 0);
+  size_t i = CABECERA;
+  for (uint8_t k = 1; k < c.n; k++) {
+    if (i >= len) return false;
+    uint8_t b = p[i++];
+    if (b == ESCAPE) {
+      if (i + 2 > len) return false;
+      x += (int8_t)p[i];
+      y += (int8_t)p[i + 1];
+      i += 2;
+    } else {
+      x += nibble(b >> 4);
+      y += nibble(b);
+    }
+    punto(x, y, false);
+  }
+  return i == len;
+}
+
+// Arma paquetes de hasta 'max' bytes (el mismo formato que trazos_ble.dart)
+class Codificador {
+public:
+  explicit Codificador(uint16_t max = MAX_PAQUETE) : max_(max < CABECERA + 3 ? CABECERA + 3 : max) {}
+
+  // Agrega un punto; si el paquete no tiene lugar devuelve false (mandar y reintentar)
+  bool punto(int16_t x, int16_t y, bool nuevo, uint16_t color) {
+    if (nuevo && len_) return false;          // un trazo nuevo arranca paquete
+    if (!len_) {
+      buf_[0] = OP_TRAZO; buf_[1] = seq_; buf_[2] = nuevo ? F_INICIO : 0; buf_[3] = 1;
+      buf_[4] = (uint8_t)color; buf_[5] = (uint8_t)(color >> 8);
+      buf_[6] = (uint8_t)x; buf_[7] = (uint8_t)(x >> 8);
+      buf_[8] = (uint8_t)y; buf_[9] = (uint8_t)(y >> 8);
+      len_ = CABECERA;
+      ux_ = x; uy_ = y;
+      return true;
+    }
+    int16_t dx = x - ux_, dy = y - uy_;
+    bool corto = dx >= -8 && dx <= 7 && dy >= -8 && dy <= 7 && !(dx == -8 && dy == -8);
+    if (!corto && (dx < -128 || dx > 127 || dy < -128 || dy > 127)) {
+      // Salto muy largo: un punto intermedio y después el resto
+      if (!punto(ux_ + dx / 2, uy_ + dy / 2, false, color)) return false;
+      return punto(x, y, false, color);
+    }
+    if (buf_[3] == 255 || len_ + (corto ? 1 : 3) > max_) return false;
+    if (corto) {
+      buf_[len_++] = (uint8_t)((dx & 0x0F) << 4 | (dy & 0x0F));
+    } else {
+      buf_[len_++] = ESCAPE;
+      buf_[len_++] = (uint8_t)(int8_t)dx;
+      buf_[len_++] = (uint8_t)(int8_t)dy;
+    }
+    buf_[3]++;
+    ux_ = x; uy_ = y;
+    return true;
+  }
+
+  void finTrazo() { if (len_) buf_[2] |= F_FIN; }
+
+  // Paquete listo (o nullptr); después de mandarlo, cerrar()
+  const uint8_t* paquete(size_t& len) const { len = len_; return len_ ? buf_ : nullptr; }
+  void cerrar() { if (len_) { len_ = 0; seq_++; } }
+
+private:
+  uint16_t max_;
+  uint8_t  buf_[MAX_PAQUETE];
+  size_t   len_ = 0;
+  uint8_t  seq_ = 0;
+  int16_t  ux_ = 0, uy_ = 0;
+};
+
+// Líneas de ANCHO px a rectángulos por fila. rect(x, y, w, h) se llama una
+// vez por tramo: los píxeles seguidos de una misma fila van juntos.
+template <typename F>
+class Tramos {
+public:
+  static const uint8_t ANCHO = 2;     // como el strokeWidth de la app
+
+  explicit Tramos(F rect) : rect_(rect) {}
+
+  void linea(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int16_t dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x0 < x1 ? 1 : -1;
+    int16_t dy = y1 > y0 ? y0 - y1 : y1 - y0, sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+    for (;;) {
+      pixel(x0, y0);
+      if (x0 == x1 && y0 == y1) break;
+      int16_t e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+
+  void pixel(int16_t x, int16_t y) {
+    if (abierto_ && y == y_ && x >= lo_ - 1 && x <= hi_ + 1) {
+      if (x < lo_) lo_ = x;
+      if (x > hi_) hi_ = x;
+      return;
+    }
+    vaciar();
+    abierto_ = true;
+    y_ = y; lo_ = hi_ = x;
+  }
+
+  void vaciar() {
+    if (!abierto_) return;
+    rect_(lo_, y_, hi_ - lo_ + ANCHO, ANCHO);
+    abierto_ = false;
+    tramos_++;
+  }
+
+  uint32_t tramos() const { return tramos_; }
+
+private:
+  F        rect_;
+  bool     abierto_ = false;
+  int16_t  y_ = 0, lo_ = 0, hi_ = 0;
+  uint32_t tramos_ = 0;
+};
+
+}  // namespace trazos
@@ -0,0 +1,376 @@
+#!/usr/bin/env python3
+"""
+Trazos por BLE: verificación del formato y cuánto se banca el enlace.
+
+Arma los paquetes igual que trazos_ble.dart / TrazosBLE.h (cabecera de 10
+bytes + deltas de 1 byte, ESCAPE + 2 bytes para saltos largos) y revisa la
+vuelta: dibujo -> paquetes -> puntos. Con --cxx compila TrazosBLE.h en la
+PC y compara byte a byte el codificador y punto a punto el decodificador.
+
+Después simula el camino completo para cada MTU e intervalo de conexión:
+  app        eventos de touch a --touch-hz, paquete cerrado al llenarse o a
+             los --lote-ms del primer punto
+  enlace     hasta --por-evento paquetes por evento de conexión, y nunca
+             más en vuelo que los créditos que anunció el ESP32
+  ESP32      cola de --cola paquetes; cada uno cuesta --paquete-us más los
+             tramos por SPI (fillRect de 2 px de alto a --spi-mhz)
+y muestra puntos/s sostenidos (dibujando sin parar lo más rápido posible) y
+el retraso touch -> píxeles (p50/p95) dibujando a --velocidad px/s.
+
+Uso:
+    python3 trazos_ble.py
+    python3 trazos_ble.py --cxx
+    python3 trazos_ble.py --mtu 23 185 247 --ci 7.5 15 30 --velocidad 1200
+"""
+import argparse
+import math
+import os
+import random
+import subprocess
+import tempfile
+
+OP_TRAZO, OP_BORRAR, OP_ACK = 0x10, 0x11, 0x90
+F_INICIO, F_FIN = 0x01, 0x02
+ESCAPE, CABECERA = 0x88, 10
+ANCHO, ALTO = 240, 320
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+
+
+class Codificador:
+    """El de trazos_ble.dart, línea por línea"""
+
+    def __init__(self, maximo):
+        self.max = max(maximo, CABECERA + 3)
+        self.buf, self.seq, self.u = bytearray(), 0, (0, 0)
+
+    def punto(self, x, y, nuevo, color=0x001F):
+        if nuevo and self.buf:
+            return False
+        if not self.buf:
+            self.buf = bytearray([OP_TRAZO, self.seq, F_INICIO if nuevo else 0, 1,
+                                  color & 0xFF, color >> 8, x & 0xFF, (x >> 8) & 0xFF, y & 0xFF, (y >> 8) & 0xFF])
+            self.u = (x, y)
+            return True
+        dx, dy = x - self.u[0], y - self.u[1]
+        corto = -8 <= dx <= 7 and -8 <= dy <= 7 and not (dx == -8 and dy == -8)
+        if not corto and not (-128 <= dx <= 127 and -128 <= dy <= 127):
+            if not self.punto(self.u[0] + int(dx / 2), self.u[1] + int(dy / 2), False, color):
+                return False
+            return self.punto(x, y, False, color)
+        if self.buf[3] == 255 or len(self.buf) + (1 if corto else 3) > self.max:
+            return False
+        self.buf += bytes([(dx & 0x0F) << 4 | (dy & 0x0F)]) if corto else bytes([ESCAPE, dx & 0xFF, dy & 0xFF])
+        self.buf[3] += 1
+        self.u = (x, y)
+        return True
+
+    def fin_trazo(self):
+        if self.buf:
+            self.buf[2] |= F_FIN
+
+    def cerrar(self):
+        if not self.buf:
+            return None
+        p, self.buf = bytes(self.buf), bytearray()
+        self.seq = (self.seq + 1) & 0xFF
+        return p
+
+
+def s8(b):
+    return b - 256 if b > 127 else b
+
+
+def s4(n):
+    return n - 16 if n > 7 else n
+
+
+def decodificar(p):
+    """-> [(x, y, nuevo)] o None si está mal (igual que trazos::decodificar)"""
+    if len(p) < CABECERA or p[0] != OP_TRAZO or p[3] == 0:
+        return None
+    x, y = int.from_bytes(p[6:8], "little", signed=True), int.from_bytes(p[8:10], "little", signed=True)
+    pts, i = [(x, y, bool(p[2] & F_INICIO))], CABECERA
+    for _ in range(1, p[3]):
+        if i >= len(p):
+            return None
+        if p[i] == ESCAPE:
+            if i + 3 > len(p):
+                return None
+            x, y, i = x + s8(p[i + 1]), y + s8(p[i + 2]), i + 3
+        else:
+            x, y, i = x + s4(p[i] >> 4), y + s4(p[i] & 0x0F), i + 1
+        pts.append((x, y, False))
+    return pts if i == len(p) else None
+
+
+def codificar(trazos, maximo):
+    """trazos: [[(x, y)]] -> paquetes (uno nuevo cada vez que no entra)"""
+    cod, paquetes = Codificador(maximo), []
+    for t in trazos:
+        for k, (x, y) in enumerate(t):
+            if not cod.punto(x, y, k == 0):
+                paquetes.append(cod.cerrar())
+                assert cod.punto(x, y, k == 0)
+        cod.fin_trazo()
+        paquetes.append(cod.cerrar())
+    return [p for p in paquetes if p]
+
+
+def dibujo(rnd, n_trazos, velocidad, touch_hz, largo=(20, 120)):
+    """Trazos tipo dedo: curvas suaves muestreadas a touch_hz"""
+    trazos = []
+    for _ in range(n_trazos):
+        x, y = rnd.uniform(20, ANCHO - 20), rnd.uniform(20, ALTO - 20)
+        ang, pts = rnd.uniform(0, 2 * math.pi), []
+        for _ in range(rnd.randint(*largo)):
+            pts.append((round(x), round(y)))
+            ang += rnd.gauss(0, 0.25)
+            paso = velocidad / touch_hz * rnd.uniform(0.7, 1.3)
+            x = min(max(x + paso * math.cos(ang), 0), ANCHO - 1)
+            y = min(max(y + paso * math.sin(ang), 0), ALTO - 1)
+        trazos.append(pts)
+    return trazos
+
+
+def verificar(rnd):
+    ok = True
+    for maximo in (20, 61, 182, 244):
+        for velocidad in (200, 1500, 20000):       # el último fuerza ESCAPE y saltos partidos
+            trazos = dibujo(rnd, 20, velocidad, 120)
+            paquetes = codificar(trazos, maximo)
+            vuelta = [pt for p in paquetes for pt in decodificar(p)]
+            # Los saltos largos agregan puntos intermedios: se comparan los del dibujo en orden
+            it, bien = iter(vuelta), True
+            for t in trazos:
+                for k, pt in enumerate(t):
+                    bien &= any((x, y) == pt for x, y, _ in it)
+            bien &= sum(nuevo for _, _, nuevo in vuelta) == len(trazos)
+            bien &= all(len(p) <= maximo for p in paquetes)
+            ok &= bien
+            if not bien:
+                print(f"  MAL vuelta con paquetes de {maximo} B a {velocidad} px/s")
+    print(f"  {'ok ' if ok else 'MAL'} dibujo -> paquetes -> puntos (4 tamaños x 3 velocidades)")
+    return ok
+
+
+ARNES = r"""
+#include <stdio.h>
+#include <string.h>
+#include "TrazosBLE.h"
+int main() {
+  char op; unsigned n, max;
+  while (scanf(" %c", &op) == 1) {
+    if (op == 'd') {                 // d <len> <bytes...> -> puntos
+      uint8_t p[300]; scanf("%u", &n);
+      for (unsigned i = 0; i < n; i++) { unsigned b; scanf("%u", &b); p[i] = b; }
+      trazos::Cabecera c;
+      bool ok = trazos::decodificar(p, n, c, [](int16_t x, int16_t y, bool nuevo) { printf("%d,%d,%d ", x, y, nuevo); });
+      printf("%s\n", ok ? "ok" : "mal");
+    }
+    if (op == 'c') {                 // c <max> <n> (x y nuevo)... -> paquetes en hex
+      scanf("%u %u", &max, &n);
+      trazos::Codificador cod(max);
+      for (unsigned i = 0; i < n; i++) {
+        int x, y, nuevo; scanf("%d %d %d", &x, &y, &nuevo);
+        if (nuevo && i) cod.finTrazo();
+        while (!cod.punto(x, y, nuevo, 0x001F)) {
+          size_t len; const uint8_t* b = cod.paquete(len);
+          for (size_t k = 0; k < len; k++) printf("%02X", b[k]);
+          printf(" "); cod.cerrar();
+        }
+      }
+      cod.finTrazo();
+      size_t len; const uint8_t* b = cod.paquete(len);
+      for (size_t k = 0; k < len; k++) printf("%02X", b[k]);
+      printf("\n");
+    }
+  }
+}
+"""
+
+
+def verificar_cxx(rnd):
+    entrada, esperado = [], []
+    for maximo in (20, 61, 244):
+        for velocidad in (300, 3000, 20000):
+            trazos = dibujo(rnd, 6, velocidad, 120)
+            paquetes = codificar(trazos, maximo)
+            for p in paquetes:
+                entrada.append(f"d {len(p)} " + " ".join(map(str, p)))
+                esperado.append(" ".join(f"{x},{y},{int(n)}" for x, y, n in decodificar(p)) + " ok")
+            # Un paquete cortado tiene que dar error
+            p = paquetes[0][:-1]
+            entrada.append(f"d {len(p)} " + " ".join(map(str, p)))
+            esperado.append(None)
+            pts = [(x, y, int(k == 0)) for t in trazos for k, (x, y) in enumerate(t)]
+            entrada.append(f"c {maximo} {len(pts)} " + " ".join(f"{x} {y} {n}" for x, y, n in pts))
+            esperado.append(" ".join(p.hex().upper() for p in paquetes))
+
+    with tempfile.TemporaryDirectory() as tmp:
+        fuente, exe = os.path.join(tmp, "arnes.cpp"), os.path.join(tmp, "arnes")
+        with open(fuente, "w") as f:
+            f.write(ARNES)
+        subprocess.run(["c++", "-std=c++11", "-Wall", "-I", os.path.join(AQUI, ".."), fuente, "-o", exe], check=True)
+        salida = subprocess.run([exe], input="\n".join(entrada), capture_output=True, text=True, check=True).stdout.split("\n")
+    malos = 0
+    for e, s, o in zip(entrada, esperado, salida):
+        bien = o.endswith("mal") if s is None else o.strip() == s
+        if not bien:
+            malos += 1
+            if malos <= 3:
+                print(f"  MAL {e[:60]}...\n      esperado {str(s)[:80]}\n      obtenido {o[:80]}")
+    print(f"  {len(entrada) - malos}/{len(entrada)} iguales entre TrazosBLE.h y este script")
+    return malos == 0
+
+
+def tramos_de(pts, anterior):
+    """Tramos que arma trazos::Tramos para estos puntos (para el costo SPI)"""
+    tramos, abierto = [], None
+
+    def pixel(x, y):
+        nonlocal abierto
+        if abierto and y == abierto[0] and abierto[1] - 1 <= x <= abierto[2] + 1:
+            abierto = (y, min(x, abierto[1]), max(x, abierto[2]))
+            return
+        if abierto:
+            tramos.append(abierto[2] - abierto[1] + 2)
+        abierto = (y, x, x)
+
+    u = anterior
+    for x, y, nuevo in pts:
+        if nuevo or u is None:
+            pixel(x, y)
+        else:
+            x0, y0 = u
+            dx, sx = abs(x - x0), 1 if x0 < x else -1
+            dy, sy = -abs(y - y0), 1 if y0 < y else -1
+            err = dx + dy
+            while True:
+                pixel(x0, y0)
+                if (x0, y0) == (x, y):
+                    break
+                e2 = 2 * err
+                if e2 >= dy:
+                    err, x0 = err + dy, x0 + sx
+                if e2 <= dx:
+                    err, y0 = err + dx, y0 + sy
+        u = (x, y)
+    if abierto:
+        tramos.append(abierto[2] - abierto[1] + 2)
+    return tramos, u
+
+
+def simular(trazos, mtu, ci_ms, a):
+    """-> (puntos/s dibujados, retrasos touch -> píxeles en ms)"""
+    # Puntos con su hora de touch: los trazos uno atrás del otro, con una pausa
+    eventos, t = [], 0.0
+    for tr in trazos:
+        for k, (x, y) in enumerate(tr):
+            eventos.append((t, x, y, k == 0, k == len(tr) - 1))
+            t += 1 / a.touch_hz
+        t += a.pausa_ms / 1000
+
+    # App: paquetes con la hora en que quedan listos
+    cod, listos, horas, abierto = Codificador(mtu - 3), [], [], None
+
+    def cerrar(cuando):
+        nonlocal horas, abierto
+        p = cod.cerrar()
+        if p:
+            listos.append((cuando, p, horas))
+        horas, abierto = [], None
+
+    for (t, x, y, nuevo, fin) in eventos:
+        if abierto is not None and t >= abierto + a.lote_ms / 1000:
+            cerrar(abierto + a.lote_ms / 1000)
+        if not cod.punto(x, y, nuevo):
+            cerrar(t)
+            cod.punto(x, y, nuevo)
+        if abierto is None:
+            abierto = t
+        horas.append(t)
+        if fin:
+            cod.fin_trazo()
+            cerrar(t)
+
+    # Enlace + ESP32, evento de conexión por evento de conexión
+    ci = ci_ms / 1000
+    spi_byte = 8 / (a.spi_mhz * 1e6)
+    retrasos, dibujados, creditos, en_vuelo = [], 0, a.cola, 0
+    libre, acks, anterior, i, t_fin = 0.0, [], None, 0, 0.0
+    k = 0
+    while i < len(listos) or en_vuelo:
+        ev = k * ci
+        k += 1
+        # Acks que ya salieron del ESP32 llegan en este evento
+        for hecho, cred in [x for x in acks if x[0] <= ev]:
+            en_vuelo -= 1
+            creditos = cred
+        acks = [x for x in acks if x[0] > ev]
+        mandados = 0
+        while i < len(listos) and listos[i][0] <= ev and mandados < a.por_evento and en_vuelo < max(creditos, 1):
+            _, p, horas = listos[i]
+            i += 1
+            mandados += 1
+            en_vuelo += 1
+            llegada = ev + len(p) * 8 / 1e6            # ~1 Mbps en el aire
+            pts = decodificar(p)
+            tramos, anterior = tramos_de(pts, None if p[2] & F_INICIO else anterior)
+            costo = a.paquete_us / 1e6 + sum(11 + w * 2 * 2 for w in tramos) * spi_byte
+            inicio = max(llegada, libre)
+            libre = inicio + costo
+            cola_ocupada = sum(1 for h, _ in acks if h > inicio)
+            acks.append((libre, a.cola - cola_ocupada))
+            retrasos += [(libre - h) * 1000 for h in horas]
+            dibujados += len(horas)
+            t_fin = libre
+    return dibujados / max(t_fin, 1e-9), retrasos
+
+
+def percentil(v, p):
+    v = sorted(v)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--mtu", type=int, nargs="+", default=[23, 64, 185, 247])
+    ap.add_argument("--ci", type=float, nargs="+", default=[7.5, 15, 30], help="intervalo de conexión (ms)")
+    ap.add_argument("--touch-hz", type=float, default=120)
+    ap.add_argument("--velocidad", type=float, default=800, help="px/s del dedo para medir el retraso")
+    ap.add_argument("--lote-ms", type=float, default=15, help="= EmisorTrazos.periodoLote")
+    ap.add_argument("--por-evento", type=int, default=4, help="paquetes por evento de conexión")
+    ap.add_argument("--cola", type=int, default=8, help="= COLA_PAQUETES del ESP32")
+    ap.add_argument("--paquete-us", type=float, default=150, help="costo fijo por paquete en el ESP32")
+    ap.add_argument("--spi-mhz", type=float, default=40)
+    ap.add_argument("--pausa-ms", type=float, default=200, help="entre trazos")
+    ap.add_argument("--cxx", action="store_true", help="compilar TrazosBLE.h y comparar")
+    a = ap.parse_args()
+
+    rnd = random.Random(1)
+    print("Formato:")
+    ok = verificar(rnd)
+    if a.cxx:
+        print("TrazosBLE.h:")
+        ok &= verificar_cxx(rnd)
+    if not ok:
+        raise SystemExit(1)
+
+    normal = dibujo(random.Random(2), 30, a.velocidad, a.touch_hz)
+    # Saturado: todos los puntos disponibles de entrada, para ver el techo
+    pausa, hz = a.pausa_ms, a.touch_hz
+    print(f"\nDibujando a {a.velocidad:g} px/s con touch a {a.touch_hz:g} Hz, lote {a.lote_ms:g} ms, "
+          f"{a.por_evento} paquetes por evento")
+    print(f"{'MTU':>4} {'CI ms':>6} {'techo pts/s':>12} {'retraso p50':>12} {'p95':>8}")
+    for mtu in a.mtu:
+        for ci in a.ci:
+            a.pausa_ms, a.touch_hz = 0, 1e6
+            techo, _ = simular(dibujo(random.Random(3), 40, 5e6, 1e6, (300, 600)), mtu, ci, a)
+            a.pausa_ms, a.touch_hz = pausa, hz
+            _, retrasos = simular(normal, mtu, ci, a)
+            print(f"{mtu:>4} {ci:>6g} {techo:>12.0f} {percentil(retrasos, .5):>9.1f} ms {percentil(retrasos, .95):>5.1f} ms")
+
+
+if __name__ == "__main__":
+    main()
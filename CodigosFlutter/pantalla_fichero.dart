@@ -1,7 +1,11 @@
 import 'package:flutter/material.dart';
+import 'trazos_ble.dart';
 
 class DrawingPage extends StatefulWidget {
-  const DrawingPage({super.key});
+  const DrawingPage({super.key, this.emisor});
+
+  /// Con conexión BLE los trazos salen en vivo a la pantalla del ESP32
+  final EmisorTrazos? emisor;
 
   @override
   State<DrawingPage> createState() => _DrawingPageState();
@@ -15,12 +19,20 @@ class _DrawingPageState extends State<DrawingPage> {
         localPosition.dx <= 240 &&
         localPosition.dy >= 0 &&
         localPosition.dy <= 320) {
+      final nuevo = points.isEmpty || points.last == null;
       setState(() => points.add(localPosition));
+      widget.emisor?.punto(localPosition.dx.round(), localPosition.dy.round(), nuevo: nuevo);
     }
   }
 
+  void _endStroke() {
+    setState(() => points.add(null));
+    widget.emisor?.finTrazo();
+  }
+
   void _clearDrawing() {
     setState(() => points.clear());
+    widget.emisor?.borrar();
   }
 
   @override
@@ -34,8 +46,9 @@ class _DrawingPageState extends State<DrawingPage> {
           width: 240,
           height: 320,
           child: Listener(
+            onPointerDown: (event) => _addPoint(event.localPosition),
             onPointerMove: (event) => _addPoint(event.localPosition),
-            onPointerUp: (_) => setState(() => points.add(null)),
+            onPointerUp: (_) => _endStroke(),
             child: CustomPaint(
               painter: FreeDrawPainter(points),
               size: const Size(240, 320),
@@ -0,0 +1,195 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:typed_data';
+import 'package:flutter_reactive_ble/flutter_reactive_ble.dart';
+
+// Trazos en vivo por BLE hacia el ILI9341 del ESP32.
+// Mismo formato que TrazosBLE.h (ver la cabecera de ese archivo):
+// [0x10, seq, flags, n, color565, x0, y0] + un byte por punto.
+
+class CodificadorTrazos {
+  static const int opTrazo = 0x10;
+  static const int opBorrar = 0x11;
+  static const int opAck = 0x90;
+  static const int fInicio = 0x01;
+  static const int fFin = 0x02;
+  static const int escape = 0x88;
+  static const int cabecera = 10;
+
+  CodificadorTrazos(int maximo)
+      : _max = maximo < cabecera + 3 ? cabecera + 3 : maximo,
+        _buf = Uint8List(maximo < cabecera + 3 ? cabecera + 3 : maximo);
+
+  final int _max;
+  final Uint8List _buf;
+  int _len = 0;
+  int _seq = 0;
+  int _ux = 0, _uy = 0;
+
+  bool get vacio => _len == 0;
+
+  /// Agrega un punto. false = no entra: cerrar() y volver a intentar.
+  bool punto(int x, int y, bool nuevo, int color) {
+    if (nuevo && _len > 0) return false; // un trazo nuevo arranca paquete
+    if (_len == 0) {
+      _buf
+        ..[0] = opTrazo
+        ..[1] = _seq
+        ..[2] = nuevo ? fInicio : 0
+        ..[3] = 1
+        ..[4] = color & 0xFF
+        ..[5] = (color >> 8) & 0xFF
+        ..[6] = x & 0xFF
+        ..[7] = (x >> 8) & 0xFF
+        ..[8] = y & 0xFF
+        ..[9] = (y >> 8) & 0xFF;
+      _len = cabecera;
+      _ux = x;
+      _uy = y;
+      return true;
+    }
+    final dx = x - _ux, dy = y - _uy;
+    final corto = dx >= -8 && dx <= 7 && dy >= -8 && dy <= 7 && !(dx == -8 && dy == -8);
+    if (!corto && (dx < -128 || dx > 127 || dy < -128 || dy > 127)) {
+      // Salto muy largo: un punto intermedio y después el resto
+      if (!punto(_ux + dx ~/ 2, _uy + dy ~/ 2, false, color)) return false;
+      return punto(x, y, false, color);
+    }
+    if (_buf[3] == 255 || _len + (corto ? 1 : 3) > _max) return false;
+    if (corto) {
+      _buf[_len++] = ((dx & 0x0F) << 4) | (dy & 0x0F);
+    } else {
+      _buf[_len++] = escape;
+      _buf[_len++] = dx & 0xFF;
+      _buf[_len++] = dy & 0xFF;
+    }
+    _buf[3]++;
+    _ux = x;
+    _uy = y;
+    return true;
+  }
+
+  void finTrazo() {
+    if (_len > 0) _buf[2] |= fFin;
+  }
+
+  /// Paquete listo para mandar (null si no hay nada)
+  Uint8List? cerrar() {
+    if (_len == 0) return null;
+    final p = Uint8List.fromList(_buf.sublist(0, _len));
+    _len = 0;
+    _seq = (_seq + 1) & 0xFF;
+    return p;
+  }
+
+  Uint8List borrar() {
+    final p = Uint8List.fromList([opBorrar, _seq]);
+    _seq = (_seq + 1) & 0xFF;
+    return p;
+  }
+}
+
+/// Manda los trazos mientras se dibuja: paquetes cerrados cada [periodoLote]
+/// (o al llenarse), WRITE sin respuesta y nunca más en vuelo que los créditos
+/// que anuncia el ESP32 por notify.
+class EmisorTrazos {
+  static const int mtuPedido = 247;
+  static const Duration periodoLote = Duration(milliseconds: 15);
+
+  EmisorTrazos(this._ble, this._char, {this.color = 0x001F});
+
+  final FlutterReactiveBle _ble;
+  final QualifiedCharacteristic _char;
+  final int color; // RGB565 (azul, como el painter)
+
+  CodificadorTrazos _cod = CodificadorTrazos(20);
+  final Queue<Uint8List> _pendientes = Queue();
+  final Map<int, int> _enviadoUs = {};
+  final Stopwatch _reloj = Stopwatch()..start();
+  StreamSubscription<List<int>>? _acks;
+  Timer? _lote;
+
+  int _creditos = 4; // hasta el primer ack
+  int _ultimoEnviado = -1;
+  int _ultimoAck = -1;
+
+  // Métricas
+  int mtu = 23;
+  int puntos = 0, paquetes = 0, bytes = 0;
+  int rttUltimoUs = 0, rttMaxUs = 0;
+
+  int get _enVuelo => _ultimoEnviado < 0 || _ultimoAck == _ultimoEnviado
+      ? 0
+      : (_ultimoEnviado - _ultimoAck) & 0xFF;
+
+  /// Después de conectar: MTU grande, intervalo corto y acks
+  Future<void> iniciar() async {
+    mtu = await _ble.requestMtu(deviceId: _char.deviceId, mtu: mtuPedido);
+    await _ble.requestConnectionPriority(
+        deviceId: _char.deviceId, priority: ConnectionPriority.highPerformance);
+    _cod = CodificadorTrazos(mtu - 3);
+    _acks = _ble.subscribeToCharacteristic(_char).listen(_alAck);
+  }
+
+  void dispose() {
+    _lote?.cancel();
+    _acks?.cancel();
+  }
+
+  void punto(int x, int y, {bool nuevo = false}) {
+    puntos++;
+    if (!_cod.punto(x, y, nuevo, color)) {
+      _cerrarPaquete();
+      _cod.punto(x, y, nuevo, color);
+    }
+    _lote ??= Timer(periodoLote, _cerrarPaquete);
+  }
+
+  void finTrazo() {
+    _cod.finTrazo();
+    _cerrarPaquete();
+  }
+
+  void borrar() {
+    _cerrarPaquete();
+    _encolar(_cod.borrar());
+  }
+
+  void _cerrarPaquete() {
+    _lote?.cancel();
+    _lote = null;
+    final p = _cod.cerrar();
+    if (p != null) _encolar(p);
+  }
+
+  void _encolar(Uint8List p) {
+    _pendientes.add(p);
+    _bombear();
+  }
+
+  void _bombear() {
+    // Con 0 créditos y nada en vuelo no llegaría ningún ack: se manda uno igual
+    while (_pendientes.isNotEmpty && _enVuelo < (_creditos > 0 ? _creditos : 1)) {
+      final p = _pendientes.removeFirst();
+      _ultimoEnviado = p[1];
+      _enviadoUs[p[1]] = _reloj.elapsedMicroseconds;
+      paquetes++;
+      bytes += p.length;
+      _ble.writeCharacteristicWithoutResponse(_char, value: p).catchError((e) {
+        // Se pierde el paquete: el ESP32 lo ve por el salto de seq
+      });
+    }
+  }
+
+  void _alAck(List<int> v) {
+    if (v.length < 3 || v[0] != CodificadorTrazos.opAck) return;
+    _ultimoAck = v[1];
+    _creditos = v[2];
+    final t = _enviadoUs.remove(v[1]);
+    if (t != null) {
+      rttUltimoUs = _reloj.elapsedMicroseconds - t;
+      if (rttUltimoUs > rttMaxUs) rttMaxUs = rttUltimoUs;
+    }
+    _bombear();
+  }
+}
@@ -1,26 +1,91 @@
+#include <WiFi.h>
 #include <Dynamixel2Arduino.h>
+#include "ControlMovimiento.h"   // SYNC_WRITE / BULK_READ a 100 Hz con interpolación
+#include "PosesRemotas.h"        // poses clave mandadas por el server (comando "pose")
 
-// Define el baudrate para la comunicación
-#define DYNAMIXEL_BAUDRATE 9600
+// ====== Bus Dynamixel ======
+// Serial queda para el monitor; el bus va por Serial2 (RX 16, TX 17)
+#define DXL_SERIAL      Serial2
+#define DXL_DIR_PIN     2         // pin de dirección del half duplex
+#define DXL_BAUD_FABRICA 9600     // con el que vienen configurados
+#define DXL_BAUD        1000000   // con el que trabaja el control
 
-// Instancia un objeto para controlar el motor
-Dynamixel2Arduino dxl(Serial, 2);  // Usamos Serial para el puerto y 2 como pin de dirección
+// Articulaciones: id, límites y posición de reposo (0..1023 en AX)
+static const Articulacion ARTICULACIONES[] = {
+  { "cabeza",   47, 200, 824, 512 },
+  // { "hombro_i", 1, 200, 824, 512 },
+  // { "hombro_d", 2, 200, 824, 512 },
+};
+static const uint8_t N_ART = sizeof(ARTICULACIONES) / sizeof(ARTICULACIONES[0]);
+
+// AX-12 no tiene BULK_READ: se lee una por tick. Con MX, BULK.
+#define LECTURA ControlMovimiento::UNA_POR_TICK
+
+// ====== WiFi / servidor (poses mandadas desde RobotNao.ipynb) ======
+const char* WIFI_SSID = "Juanma";
+const char* WIFI_PASS = "38814831";
+const char* BASE_URL  = "http://choreal-kalel-directed.ngrok-free.dev";
+const char* DEVICE_ID = "cuerpo_1";
+
+// Instancia un objeto para la configuración inicial de los motores
+Dynamixel2Arduino dxl(DXL_SERIAL, DXL_DIR_PIN);
+ControlMovimiento control;
+PosesRemotas remotas(control);
+
+// Pasa cada motor a DXL_BAUD (si todavía estaba a DXL_BAUD_FABRICA) y lo deja
+// en control de posición, con torque y contestando sin demora
+void prepararMotores() {
+  dxl.setPortProtocolVersion(1.0);
+  for (uint8_t i = 0; i < N_ART; i++) {
+    uint8_t id = ARTICULACIONES[i].id;
+    dxl.begin(DXL_BAUD);
+    if (!dxl.ping(id)) {
+      dxl.begin(DXL_BAUD_FABRICA);
+      if (!dxl.ping(id) || !dxl.setBaudrate(id, DXL_BAUD)) {
+        Serial.printf("Motor %u (%s): no contesta\n", id, ARTICULACIONES[i].nombre);
+        continue;
+      }
+      dxl.begin(DXL_BAUD);
+      Serial.printf("Motor %u: %u -> %u baud\n", id, DXL_BAUD_FABRICA, DXL_BAUD);
+    }
+    dxl.writeControlTableItem(ControlTableItem::RETURN_DELAY_TIME, id, 0);
+    dxl.setOperatingMode(id, OP_POSITION);
+    dxl.torqueOn(id);
+  }
+  dxl.begin(DXL_BAUD);
+}
 
-// ID del motor (en este caso, 1)
-#define MOTOR_ID 47
 void setup() {
-  // Inicia la comunicación con los motores Dynamixel
-  dxl.begin(DYNAMIXEL_BAUDRATE);
+  Serial.begin(115200);
+  prepararMotores();
 
-  // Establece el modo de operación del motor en "Position Control"
-  dxl.setOperatingMode(MOTOR_ID, 3);  // Usamos 3 para "Position Control"
+  if (!control.begin(DXL_SERIAL, DXL_DIR_PIN, ARTICULACIONES, N_ART, LECTURA)) {
+    Serial.println("ControlMovimiento: sin memoria o sin tarea");
+  }
 
-  // Mueve el motor a una posición específica (valor entre 0 y 1023)
-  int position = 512;  // El valor central del rango de movimiento
-  dxl.writeControlTableItem(MOTOR_ID, 30, position);  // 30 es el registro para "Goal Position"
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(WIFI_SSID, WIFI_PASS);   // conecta en segundo plano; la tarea de red espera
+  if (!remotas.begin(BASE_URL, DEVICE_ID)) Serial.println("PosesRemotas: sin tarea");
 }
 
 void loop() {
-  // El motor se mueve a la posición indicada solo una vez durante el inicio
-  delay(1000);  // Pausa para observar el movimiento del motor
+  // Métricas cada 5 s: ritmo real del control y uso del bus
+  static uint32_t tStats = 0;
+  if (millis() - tStats >= 5000) {
+    tStats = millis();
+    ControlMovimiento::Stats s = control.stats();
+    PosesRemotas::Stats r = remotas.stats();
+    Serial.printf("Control: %lu ticks, %lu perdidos, tick máx %lu us, bus máx %lu us, %lu escrituras, "
+                  "%lu lecturas / %lu fallas, error máx %u\n",
+                  s.ticks, s.perdidos, s.maxTickUs, s.maxBusUs, s.escrituras, s.lecturas, s.fallas, s.maxError);
+    Serial.printf("Poses: %lu comandos, %lu cuadros, %lu descartados, %u en cola\n",
+                  r.comandos, r.cuadros, r.descartados, control.pendientes());
+    PollComandos::Stats p = remotas.red();
+    Serial.printf("Poll: %lu pedidos, %lu errores, %lu grandes, %lu cortadas, %lu comandos perdidos\n",
+                  p.pedidos, p.errores, p.grandes, p.cortadas, p.perdidos);
+    for (uint8_t i = 0; i < N_ART; i++) {
+      Serial.printf("  %-10s objetivo %4u  presente %4u\n", ARTICULACIONES[i].nombre, control.objetivo(i), control.presente(i));
+    }
+  }
+  delay(50);
 }
@@ -0,0 +1,242 @@
+/****************************************************
+ * Control de varios Dynamixel a ritmo fijo
+ * - Tarea propia a HZ (vTaskDelayUntil); cuenta ticks
+ *   perdidos y los que se pasan del periodo
+ * - Poses clave (posición de cada articulación + ms
+ *   para llegar) por una cola; entre pose y pose se
+ *   interpola con arranque y frenado suaves
+ * - Un SYNC_WRITE por tick con el objetivo de todas
+ *   las articulaciones (solo si alguna cambió)
+ * - Posición presente: BULK_READ de todas (MX) o READ
+ *   de una por tick, rotando (AX: no tienen BULK_READ)
+ * - Half duplex con pin de dirección: TX en alto
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include "PaqueteDXL.h"
+
+struct Articulacion {
+  const char* nombre;
+  uint8_t     id;
+  uint16_t    min, max;     // límites mecánicos (AX: 0..1023)
+  uint16_t    reposo;
+};
+
+class ControlMovimiento {
+public:
+  static const uint8_t  MAX_ART = 12;
+  static const uint8_t  HZ = 100;
+  static const uint32_t PERIODO_MS = 1000 / HZ;
+  static const uint16_t SIN_CAMBIO = 0xFFFF;   // en PoseClave: la articulación sigue como va
+  static const uint8_t  MAX_COLA = 16;
+  static const uint16_t ESPERA_RESPUESTA_US = 600;   // por servo, con return delay 0
+
+  enum Lectura : uint8_t { BULK, UNA_POR_TICK, SIN_LECTURA };
+
+  struct PoseClave {
+    uint16_t ms;                 // tiempo para llegar desde la pose anterior
+    uint16_t pos[MAX_ART];       // en el orden de las articulaciones
+  };
+
+  struct Stats {
+    uint32_t ticks;
+    uint32_t perdidos;           // ticks que no llegaron a su hora
+    uint32_t maxTickUs;
+    uint32_t maxBusUs;           // escritura + lectura en un tick
+    uint32_t escrituras;         // SYNC_WRITE mandados
+    uint32_t txBytes;
+    uint32_t lecturas;           // respuestas buenas
+    uint32_t fallas;             // sin respuesta o checksum mal
+    uint16_t maxError;           // |objetivo - presente| más grande visto
+  };
+
+  bool begin(HardwareSerial& port, int8_t dirPin, const Articulacion* art, uint8_t n, Lectura lectura,
+             uint8_t core = 1, UBaseType_t prio = 3) {
+    if (n == 0 || n > MAX_ART) return false;
+    port_ = &port;
+    dir_ = dirPin;
+    art_ = art;
+    n_ = n;
+    lectura_ = lectura;
+    if (dir_ >= 0) { pinMode(dir_, OUTPUT); digitalWrite(dir_, LOW); }
+    for (uint8_t i = 0; i < n_; i++) {
+      ids_[i] = art_[i].id;
+      desde_[i] = hacia_[i] = objetivo_[i] = presente_[i] = art_[i].reposo;
+      enviado_[i] = SIN_CAMBIO;
+    }
+    cola_ = xQueueCreate(MAX_COLA, sizeof(PoseClave));
+    if (!cola_) return false;
+    return xTaskCreatePinnedToCore(tareaThunk, "movimiento", 4096, this, prio, nullptr, core) == pdPASS;
+  }
+
+  // ---- Desde cualquier tarea, no bloquean ----
+  bool encolar(const PoseClave& p) { return cola_ && xQueueSend(cola_, &p, 0) == pdTRUE; }
+  // Corta las poses pendientes y se queda donde está
+  void detener() {
+    if (cola_) xQueueReset(cola_);
+    detener_ = true;
+  }
+  uint8_t pendientes() const { return cola_ ? uxQueueMessagesWaiting(cola_) : 0; }
+
+  uint8_t  cantidad() const { return n_; }
+  uint16_t presente(uint8_t i) const { return presente_[i]; }
+  uint16_t objetivo(uint8_t i) const { return objetivo_[i]; }
+  Stats stats() const { return stats_; }
+
+  // Un tick de control: avanza la interpolación, escribe y lee
+  void tick() {
+    if (detener_) {
+      detener_ = false;
+      for (uint8_t i = 0; i < n_; i++) desde_[i] = hacia_[i] = objetivo_[i];
+      paso_ = pasos_ = 0;
+    }
+    if (paso_ >= pasos_) siguientePose();
+    if (paso_ < pasos_) {
+      paso_++;
+      float u = (float)paso_ / pasos_;
+      float s = u * u * (3 - 2 * u);           // smoothstep: velocidad 0 al llegar y al salir
+      for (uint8_t i = 0; i < n_; i++) {
+        objetivo_[i] = desde_[i] + (int16_t)lroundf(((int32_t)hacia_[i] - desde_[i]) * s);
+      }
+    }
+
+    uint32_t t0 = micros();
+    escribir();
+    leer();
+    uint32_t us = micros() - t0;
+    if (us > stats_.maxBusUs) stats_.maxBusUs = us;
+  }
+
+private:
+  static void tareaThunk(void* p) { ((ControlMovimiento*)p)->tarea(); }
+
+  void tarea() {
+    const TickType_t periodo = pdMS_TO_TICKS(PERIODO_MS);
+    TickType_t ultimo = xTaskGetTickCount();
+    for (;;) {
+      uint32_t t0 = micros();
+      tick();
+      uint32_t us = micros() - t0;
+      stats_.ticks++;
+      if (us > stats_.maxTickUs) stats_.maxTickUs = us;
+
+      // Si el bus se comió uno o más periodos, se saltean (no se acumulan)
+      TickType_t ahora = xTaskGetTickCount();
+      if (ahora - ultimo >= periodo) {
+        uint32_t atraso = (ahora - ultimo) / periodo;
+        stats_.perdidos += atraso;
+        ultimo += atraso * periodo;
+      }
+      vTaskDelayUntil(&ultimo, periodo);
+    }
+  }
+
+  void siguientePose() {
+    PoseClave p;
+    if (xQueueReceive(cola_, &p, 0) != pdTRUE) return;
+    for (uint8_t i = 0; i < n_; i++) {
+      desde_[i] = objetivo_[i];
+      if (p.pos[i] != SIN_CAMBIO) hacia_[i] = constrain(p.pos[i], art_[i].min, art_[i].max);
+    }
+    paso_ = 0;
+    pasos_ = max<uint32_t>(1, (p.ms + PERIODO_MS / 2) / PERIODO_MS);
+  }
+
+  void escribir() {
+    bool cambio = false;
+    for (uint8_t i = 0; i < n_; i++) cambio |= objetivo_[i] != enviado_[i];
+    if (!cambio) return;
+    size_t len = dxl1::syncWrite16(buf_, sizeof(buf_), dxl1::REG_GOAL_POS, ids_, objetivo_, n_);
+    if (!len) return;
+    enviar(len);
+    memcpy(enviado_, objetivo_, sizeof(objetivo_[0]) * n_);
+    stats_.escrituras++;
+  }
+
+  void leer() {
+    size_t len;
+    uint8_t esperadas;
+    switch (lectura_) {
+      case BULK:
+        len = dxl1::bulkRead(buf_, sizeof(buf_), dxl1::REG_PRESENT_POS, 2, ids_, n_);
+        esperadas = n_;
+        break;
+      case UNA_POR_TICK:
+        len = dxl1::leer(buf_, sizeof(buf_), ids_[rr_], dxl1::REG_PRESENT_POS, 2);
+        rr_ = (rr_ + 1) % n_;
+        esperadas = 1;
+        break;
+      default:
+        return;
+    }
+    if (!len) return;
+    enviar(len);
+    uint8_t ok = recibir(esperadas, (uint32_t)ESPERA_RESPUESTA_US * esperadas);
+    stats_.lecturas += ok;
+    stats_.fallas += esperadas - ok;
+  }
+
+  void enviar(size_t len) {
+    while (port_->available()) port_->read();     // restos de respuestas viejas
+    if (dir_ >= 0) digitalWrite(dir_, HIGH);
+    port_->write(buf_, len);
+    port_->flush();                                // hasta que sale el último bit
+    if (dir_ >= 0) digitalWrite(dir_, LOW);
+    stats_.txBytes += len;
+  }
+
+  // Junta hasta 'esperadas' respuestas de posición; devuelve cuántas llegaron bien.
+  // readBytes() del core espera en el driver de la UART: la tarea duerme
+  // hasta que llegan los bytes o vence el timeout (en ms, redondeado para
+  // arriba) y mientras tanto corre loop(); nada de girar sobre available()
+  uint8_t recibir(uint8_t esperadas, uint32_t timeoutUs) {
+    const size_t RESPUESTA = dxl1::CABECERA + 2;    // FF FF id largo error pos_l pos_h checksum
+    uint8_t rx[RESPUESTA * 4];
+    lector_.reset();
+    uint8_t ok = 0;
+    uint32_t t0 = micros();
+    while (ok < esperadas) {
+      uint32_t pasado = micros() - t0;
+      if (pasado >= timeoutUs) break;
+      port_->setTimeout((timeoutUs - pasado + 999) / 1000);
+      size_t n = port_->readBytes(rx, min(sizeof(rx), (esperadas - ok) * RESPUESTA));
+      if (n == 0) break;                             // venció: alguno no contestó
+      for (size_t k = 0; k < n; k++) {
+        if (lector_.byte(rx[k]) != dxl1::LectorEstado::LISTO) continue;
+        if (lector_.nDatos() < 2) continue;
+        int8_t i = indice(lector_.id());
+        if (i < 0) continue;
+        presente_[i] = lector_.dato16();
+        uint16_t err = abs((int32_t)objetivo_[i] - presente_[i]);
+        if (err > stats_.maxError) stats_.maxError = err;
+        ok++;
+      }
+    }
+    return ok;
+  }
+
+  int8_t indice(uint8_t id) const {
+    for (uint8_t i = 0; i < n_; i++) if (ids_[i] == id) return i;
+    return -1;
+  }
+
+  HardwareSerial*     port_ = nullptr;
+  int8_t              dir_ = -1;
+  const Articulacion* art_ = nullptr;
+  uint8_t             n_ = 0;
+  Lectura             lectura_ = SIN_LECTURA;
+  QueueHandle_t       cola_ = nullptr;
+  volatile bool       detener_ = false;
+
+  uint8_t             ids_[MAX_ART];
+  uint16_t            desde_[MAX_ART], hacia_[MAX_ART];
+  uint16_t            objetivo_[MAX_ART], enviado_[MAX_ART];
+  volatile uint16_t   presente_[MAX_ART];
+  uint32_t            paso_ = 0, pasos_ = 0;
+  uint8_t             rr_ = 0;
+
+  uint8_t             buf_[dxl1::CABECERA + 2 + 3 * MAX_ART];
+  dxl1::LectorEstado  lector_;
+  Stats               stats_ = {};
+};
@@ -0,0 +1,181 @@
+/****************************************************
+ * Paquetes Dynamixel protocolo 1.0 (AX / MX)
+ * - FF FF id largo instrucción parámetros checksum;
+ *   largo = parámetros + 2, checksum = ~(id + largo +
+ *   instrucción + parámetros)
+ * - SYNC_WRITE: el mismo registro de N servos en un
+ *   solo paquete (sin respuesta)
+ * - BULK_READ: pide un registro a N servos; contestan
+ *   en orden, uno atrás del otro (solo MX; en los AX
+ *   se usa READ de a uno)
+ * - syncWrite()/bulkRead() generales (largo o registro
+ *   por servo) arman los ejemplos del e-manual; el
+ *   control usa syncWrite16() y el bulkRead() de un
+ *   solo registro
+ * - Sin Arduino.h: compila también en la PC
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace dxl1 {
+
+static const uint8_t BROADCAST  = 0xFE;
+static const uint8_t INST_READ  = 0x02;
+static const uint8_t INST_WRITE = 0x03;
+static const uint8_t INST_SYNC_WRITE = 0x83;
+static const uint8_t INST_BULK_READ  = 0x92;
+
+// Tabla de control AX-12 / MX (protocolo 1.0)
+static const uint8_t REG_BAUD         = 4;    // 1 = 1 Mbps
+static const uint8_t REG_RETURN_DELAY = 5;    // x2 us; 0 = contesta ya
+static const uint8_t REG_TORQUE       = 24;
+static const uint8_t REG_GOAL_POS     = 30;
+static const uint8_t REG_PRESENT_POS  = 36;
+
+static const uint8_t CABECERA = 6;            // FF FF id largo inst + checksum
+
+inline uint8_t checksum(const uint8_t* p, size_t n) {   // p apunta al id
+  uint8_t s = 0;
+  for (size_t i = 0; i < n; i++) s += p[i];
+  return ~s;
+}
+
+// Arma un paquete en buf; devuelve el largo total (0 si no entra)
+inline size_t paquete(uint8_t* buf, size_t cap, uint8_t id, uint8_t inst, const uint8_t* params, size_t n) {
+  if (n + CABECERA > cap || n + 2 > 255) return 0;
+  buf[0] = 0xFF;
+  buf[1] = 0xFF;
+  buf[2] = id;
+  buf[3] = (uint8_t)(n + 2);
+  buf[4] = inst;
+  for (size_t i = 0; i < n; i++) buf[5 + i] = params[i];
+  buf[5 + n] = checksum(buf + 2, n + 3);
+  return n + CABECERA;
+}
+
+inline size_t leer(uint8_t* buf, size_t cap, uint8_t id, uint8_t reg, uint8_t len) {
+  uint8_t p[2] = { reg, len };
+  return paquete(buf, cap, id, INST_READ, p, 2);
+}
+
+inline size_t escribir16(uint8_t* buf, size_t cap, uint8_t id, uint8_t reg, uint16_t v) {
+  uint8_t p[3] = { reg, (uint8_t)v, (uint8_t)(v >> 8) };
+  return paquete(buf, cap, id, INST_WRITE, p, 3);
+}
+
+// largo bytes desde reg para n servos; datos tiene n x largo, en el orden de ids
+inline size_t syncWrite(uint8_t* buf, size_t cap, uint8_t reg, uint8_t largo, const uint8_t* ids,
+                        const uint8_t* datos, uint8_t n) {
+  size_t np = 2 + (1 + (size_t)largo) * n;
+  if (np + CABECERA > cap || np + 2 > 255) return 0;
+  uint8_t* p = buf + 5;
+  *p++ = reg;
+  *p++ = largo;
+  for (uint8_t i = 0; i < n; i++) {
+    *p++ = ids[i];
+    for (uint8_t j = 0; j < largo; j++) *p++ = *datos++;
+  }
+  buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = BROADCAST; buf[3] = (uint8_t)(np + 2); buf[4] = INST_SYNC_WRITE;
+  buf[5 + np] = checksum(buf + 2, np + 3);
+  return np + CABECERA;
+}
+
+// Un registro de 16 bits (little endian) para n servos
+inline size_t syncWrite16(uint8_t* buf, size_t cap, uint8_t reg, const uint8_t* ids, const uint16_t* v, uint8_t n) {
+  size_t np = 2 + 3 * (size_t)n;
+  if (np + CABECERA > cap || np + 2 > 255) return 0;
+  uint8_t* p = buf + 5;
+  *p++ = reg;
+  *p++ = 2;
+  for (uint8_t i = 0; i < n; i++) {
+    *p++ = ids[i];
+    *p++ = (uint8_t)v[i];
+    *p++ = (uint8_t)(v[i] >> 8);
+  }
+  buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = BROADCAST; buf[3] = (uint8_t)(np + 2); buf[4] = INST_SYNC_WRITE;
+  buf[5 + np] = checksum(buf + 2, np + 3);
+  return np + CABECERA;
+}
+
+// len bytes desde reg a cada uno de los n servos
+inline size_t bulkRead(uint8_t* buf, size_t cap, uint8_t reg, uint8_t len, const uint8_t* ids, uint8_t n) {
+  size_t np = 1 + 3 * (size_t)n;
+  if (np + CABECERA > cap || np + 2 > 255) return 0;
+  uint8_t* p = buf + 5;
+  *p++ = 0x00;
+  for (uint8_t i = 0; i < n; i++) {
+    *p++ = len;
+    *p++ = ids[i];
+    *p++ = reg;
+  }
+  buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = BROADCAST; buf[3] = (uint8_t)(np + 2); buf[4] = INST_BULK_READ;
+  buf[5 + np] = checksum(buf + 2, np + 3);
+  return np + CABECERA;
+}
+
+// Un servo de un BULK_READ: cada uno con su registro y largo
+struct PedidoBulk {
+  uint8_t largo;
+  uint8_t id;
+  uint8_t reg;
+};
+
+inline size_t bulkRead(uint8_t* buf, size_t cap, const PedidoBulk* pedidos, uint8_t n) {
+  size_t np = 1 + 3 * (size_t)n;
+  if (np + CABECERA > cap || np + 2 > 255) return 0;
+  uint8_t* p = buf + 5;
+  *p++ = 0x00;
+  for (uint8_t i = 0; i < n; i++) {
+    *p++ = pedidos[i].largo;
+    *p++ = pedidos[i].id;
+    *p++ = pedidos[i].reg;
+  }
+  buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = BROADCAST; buf[3] = (uint8_t)(np + 2); buf[4] = INST_BULK_READ;
+  buf[5 + np] = checksum(buf + 2, np + 3);
+  return np + CABECERA;
+}
+
+// Respuesta de estado, byte a byte: FF FF id largo error datos checksum
+class LectorEstado {
+public:
+  enum Resultado : uint8_t { SIGUE, LISTO, MAL_CHECKSUM };
+
+  static const uint8_t MAX_DATOS = 8;
+
+  void reset() { fase_ = 0; }
+
+  Resultado byte(uint8_t b) {
+    switch (fase_) {
+      case 0: fase_ = b == 0xFF ? 1 : 0; return SIGUE;
+      case 1: fase_ = b == 0xFF ? 2 : 0; return SIGUE;
+      case 2:
+        if (b == 0xFF) return SIGUE;                  // más FF de relleno
+        id_ = b; suma_ = b; fase_ = 3; return SIGUE;
+      case 3:
+        if (b < 2 || b - 2 > MAX_DATOS) { fase_ = 0; return SIGUE; }
+        largo_ = b; suma_ += b; n_ = 0; fase_ = 4; return SIGUE;
+      case 4:
+        error_ = b; suma_ += b; fase_ = largo_ > 2 ? 5 : 6; return SIGUE;
+      case 5:
+        datos_[n_++] = b; suma_ += b;
+        if (n_ >= largo_ - 2) fase_ = 6;
+        return SIGUE;
+      default:
+        fase_ = 0;
+        return (uint8_t)~suma_ == b ? LISTO : MAL_CHECKSUM;
+    }
+  }
+
+  uint8_t id() const { return id_; }
+  uint8_t error() const { return error_; }
+  uint8_t nDatos() const { return n_; }
+  uint16_t dato16(uint8_t i = 0) const { return datos_[i] | (uint16_t)datos_[i + 1] << 8; }
+
+private:
+  uint8_t fase_ = 0, id_ = 0, largo_ = 0, error_ = 0, n_ = 0, suma_ = 0;
+  uint8_t datos_[MAX_DATOS];
+};
+
+}  // namespace dxl1
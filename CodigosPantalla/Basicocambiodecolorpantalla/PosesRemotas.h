@@ -0,0 +1,99 @@
+/****************************************************
+ * Poses mandadas por el server (comando "pose")
+ * - Tarea de red propia (core 0): long-poll a
+ *   /esp32/poll/<id> con PollComandos y pasa los
+ *   comandos tipo "pose" a ControlMovimiento
+ * - "cuadros": [{"ms": 400, "pos": [512, null, ...]}]
+ *   en el orden de las articulaciones del sketch;
+ *   null = esa articulación sigue como va
+ * - "reemplazar": corta lo que se estaba moviendo
+ *   antes de encolar (si no, va a continuación)
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ArduinoJson.h>
+#include <PollComandos.h>
+#include "ControlMovimiento.h"
+
+class PosesRemotas {
+public:
+  static const uint8_t POLL_WAIT_S = 20;
+  static const uint8_t POLL_LOTE   = 2;
+
+  // Un comando pose lleno (MAX_COLA cuadros de MAX_ART), con tipo, seq,
+  // reemplazar y timestamp; los strings no se copian (zero-copy en body_)
+  static const size_t JSON_POSE = JSON_OBJECT_SIZE(6) + JSON_ARRAY_SIZE(ControlMovimiento::MAX_COLA) +
+      ControlMovimiento::MAX_COLA * (JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(ControlMovimiento::MAX_ART));
+  static const size_t JSON_POLL = JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(POLL_LOTE) + POLL_LOTE * JSON_POSE;
+
+  struct Stats {
+    uint32_t comandos;
+    uint32_t cuadros;      // poses encoladas
+    uint32_t descartados;  // cola llena, cuadro mal armado o respuesta que no se pudo leer
+  };
+
+  explicit PosesRemotas(ControlMovimiento& control) : control_(control) {}
+
+  bool begin(const char* baseUrl, const char* deviceId, uint8_t core = 0) {
+    baseUrl_ = baseUrl;
+    deviceId_ = deviceId;
+    return xTaskCreatePinnedToCore(tareaThunk, "poses_red", 8192, this, 1, nullptr, core) == pdPASS;
+  }
+
+  Stats stats() const { return stats_; }
+  PollComandos::Stats red() const { return poll_.stats(); }
+
+private:
+  static void tareaThunk(void* p) { ((PosesRemotas*)p)->tarea(); }
+
+  void tarea() {
+    poll_.begin(baseUrl_, deviceId_, POLL_WAIT_S, POLL_LOTE);
+    for (;;) {
+      if (WiFi.status() != WL_CONNECTED) { vTaskDelay(pdMS_TO_TICKS(500)); continue; }
+      if (!poll()) vTaskDelay(pdMS_TO_TICKS(2000));
+    }
+  }
+
+  bool poll() {
+    uint32_t ms, enviados;
+    PollComandos::Resultado r = poll_.pedir(body_, sizeof(body_), ms, enviados);
+    if (r != PollComandos::COMANDOS) return r != PollComandos::ERROR_RED;
+    if (deserializeJson(doc_, body_)) {     // zero-copy sobre body_
+      stats_.descartados += enviados;       // el server ya los sacó de la cola
+      return false;
+    }
+    for (JsonObject c : doc_["comandos"].as<JsonArray>()) {
+      const char* tipo = c["tipo"] | "";
+      if (!strcmp(tipo, "pose")) aplicar(c);
+    }
+    return true;
+  }
+
+  void aplicar(JsonObject c) {
+    stats_.comandos++;
+    if (c["reemplazar"] | false) control_.detener();
+    for (JsonObject q : c["cuadros"].as<JsonArray>()) {
+      ControlMovimiento::PoseClave p;
+      p.ms = q["ms"] | 0;
+      JsonArray pos = q["pos"];
+      if (pos.isNull() || pos.size() > control_.cantidad()) { stats_.descartados++; continue; }
+      for (uint8_t i = 0; i < ControlMovimiento::MAX_ART; i++) {
+        p.pos[i] = (i < pos.size() && pos[i].is<int>()) ? pos[i].as<uint16_t>() : ControlMovimiento::SIN_CAMBIO;
+      }
+      if (control_.encolar(p)) stats_.cuadros++;
+      else stats_.descartados++;
+    }
+  }
+
+  ControlMovimiento& control_;
+  const char*        baseUrl_ = "";
+  const char*        deviceId_ = "";
+  PollComandos       poll_;
+
+  char               body_[4096];
+  StaticJsonDocument<JSON_POLL> doc_;
+
+  Stats              stats_ = {};
+};
@@ -1,12 +1,34 @@
 #include <SPI.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_ILI9341.h>
+#include <XPT2046_Touchscreen.h>
+#include "Widgets.h"   // árbol de widgets, zonas sucias y render por bandas
 
 #define TFT_CS   5
 #define TFT_DC   21
 #define TFT_RST  4
 Adafruit_ILI9341 tft(TFT_CS, TFT_DC, TFT_RST);
 
+// ====== Touch XPT2046 ======
+#define TOUCH_CS  2
+XPT2046_Touchscreen ts(TOUCH_CS);
+
+#define TS_MINX 200
+#define TS_MINY 200
+#define TS_MAXX 3800
+#define TS_MAXY 3800
+#define TS_Z_MIN 400            // presión mínima para contar como toque
+const uint16_t TOUCH_PERIOD_MS = 15;
+const uint8_t  TOUCH_RELEASE_N = 3;   // lecturas seguidas sin dedo = soltó
+
+// ====== Config WiFi / servidor (los botones mandan órdenes al robot) ======
+const char* WIFI_SSID = "Juanma";
+const char* WIFI_PASS = "38814831";
+const char* BASE_URL  = "http://choreal-kalel-directed.ngrok-free.dev";
+const char* ROBOT_ID  = "esp32_1";   // el ESP32 de audio que recibe los comandos
+
 int16_t w, h;
 // 'rem', 240x320px
 const unsigned char epd_bitmap_rem [] PROGMEM = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -497,16 +519,97 @@ const unsigned char* epd_bitmap_allArray[1] = {
 	epd_bitmap_rem
 };
 
+// ====== Órdenes de los botones ======
+// Cada botón es un POST a la API de control, igual que desde la app
+struct Orden {
+  const char* nombre;
+  const char* ruta;
+  const char* extra;   // campos además de device_id
+};
+
+static const Orden ORDENES[] = {
+  { "hola",      "/control/frase",       "nombre_frase=hola" },
+  { "siguiente", "/control/siguiente",   "" },
+  { "detener",   "/control/musica_detener", "" },
+};
+static const uint8_t N_ORDENES = sizeof(ORDENES) / sizeof(ORDENES[0]);
+
+QueueHandle_t ordenes = nullptr;
+uint32_t ordenesPerdidas = 0;
+
+// Desde la UI: no bloquea, la red va en su propia tarea
+void enviarOrden(uint8_t id) {
+  if (id >= N_ORDENES) return;
+  Serial.printf("Botón %s\n", ORDENES[id].nombre);
+  if (!ordenes || xQueueSend(ordenes, &id, 0) != pdTRUE) ordenesPerdidas++;
+}
+
+void ordenesTask(void*) {
+  static char url[160];
+  static char body[96];
+  uint8_t id;
+  for (;;) {
+    if (xQueueReceive(ordenes, &id, portMAX_DELAY) != pdTRUE) continue;
+    if (WiFi.status() != WL_CONNECTED) {
+      Serial.printf("Orden %s descartada: sin WiFi\n", ORDENES[id].nombre);
+      continue;
+    }
+    const Orden& o = ORDENES[id];
+    snprintf(url, sizeof(url), "%s%s", BASE_URL, o.ruta);
+    snprintf(body, sizeof(body), "device_id=%s%s%s", ROBOT_ID, *o.extra ? "&" : "", o.extra);
+    uint32_t t0 = millis();
+    HTTPClient http;
+    http.begin(url);
+    http.addHeader("Content-Type", "application/x-www-form-urlencoded");
+    int code = http.POST((uint8_t*)body, strlen(body));
+    http.end();
+    Serial.printf("Orden %s -> HTTP %d (%lu ms)\n", o.nombre, code, (unsigned long)(millis() - t0));
+  }
+}
+
+// ====== UI ======
+PanelUI ui(tft, ILI9341_ORANGE);
+
+// Touch sin esperas: se lee cada TOUCH_PERIOD_MS desde loop()
+void serviceTouch() {
+  static uint32_t last = 0;
+  static uint8_t sinDedo = 0;
+  static bool abajo = false;
+  if (millis() - last < TOUCH_PERIOD_MS) return;
+  last = millis();
+
+  TS_Point p = ts.getPoint();
+  if (p.z >= TS_Z_MIN) {
+    sinDedo = 0;
+    abajo = true;
+    int16_t x = constrain(map(p.x, TS_MINX, TS_MAXX, 0, w - 1), 0L, (long)w - 1);
+    int16_t y = constrain(map(p.y, TS_MINY, TS_MAXY, 0, h - 1), 0L, (long)h - 1);
+    ui.tocar(true, x, y);
+  } else if (abajo && ++sinDedo >= TOUCH_RELEASE_N) {
+    abajo = false;
+    ui.tocar(false, 0, 0);
+  }
+}
+
+void printStats() {
+  const PanelUI::Stats& st = ui.stats();
+  Serial.printf("UI: %lu renders, último %u zonas %lu B %lu us, max %lu us, total %lu B, órdenes perdidas %lu\n",
+                (unsigned long)st.renders, st.zonas, (unsigned long)st.bytes, (unsigned long)st.us,
+                (unsigned long)st.maxUs, (unsigned long)st.bytesTotal, (unsigned long)ordenesPerdidas);
+}
+
 void setup() {
+  Serial.begin(115200);
   tft.begin();
   tft.setRotation(3);
+  ts.begin();
+  ts.setRotation(3);
 
   w = tft.width();
   h = tft.height();
 
-  // Fondo negro + franja derecha azul marino
-  tft.fillScreen(ILI9341_ORANGE);
-  tft.fillRect(w - 70, 0, 70, h, ILI9341_NAVY);  
+  // Fondo naranja (el de PanelUI) + franja derecha azul marino
+  static Rectangulo franja(w - 70, 0, 70, h, ILI9341_NAVY);
 
   // --- Círculos ---
   int r  = 30;                   // radio
@@ -517,12 +620,32 @@ void setup() {
   int y2 = y1 + 2*r + espacio;
   int y3 = y2 + 2*r + espacio;
 
-  tft.fillCircle(cx, y1, r, ILI9341_GREEN);
-  tft.fillCircle(cx, y2, r, ILI9341_GREENYELLOW);
-  tft.fillCircle(cx, y3, r, ILI9341_YELLOW);
-  tft.drawBitmap(0, 0, epd_bitmap_rem, 250, 240, ILI9341_BLACK);
+  static BotonCirculo b1(0, cx, y1, r, ILI9341_GREEN,       ILI9341_DARKGREEN, enviarOrden);
+  static BotonCirculo b2(1, cx, y2, r, ILI9341_GREENYELLOW, ILI9341_OLIVE,     enviarOrden);
+  static BotonCirculo b3(2, cx, y3, r, ILI9341_YELLOW,      ILI9341_ORANGE,    enviarOrden);
+  static Imagen1b imagen(0, 0, epd_bitmap_rem, 250, 240, ILI9341_BLACK);
+
+  ui.raiz().agregar(&franja);
+  franja.agregar(&b1);
+  franja.agregar(&b2);
+  franja.agregar(&b3);
+  ui.raiz().agregar(&imagen);
+  ui.begin();                    // primer render: pantalla entera por bandas
+  printStats();
 
+  ordenes = xQueueCreate(4, sizeof(uint8_t));
+  xTaskCreatePinnedToCore(ordenesTask, "ordenes", 6144, nullptr, 1, nullptr, 0);
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(WIFI_SSID, WIFI_PASS);   // conecta en segundo plano
 }
 
 void loop() {
+  static uint32_t lastStats = 0;
+  serviceTouch();
+  if (ui.pendiente()) ui.render();   // solo lo que cambió (botones apretados)
+  if (millis() - lastStats > 10000) {
+    lastStats = millis();
+    printStats();
+  }
+  delay(1);
 }
@@ -0,0 +1,304 @@
+/****************************************************
+ * Widgets retenidos para el panel (ILI9341)
+ * - Árbol de widgets con caja (x, y, w, h); los hijos
+ *   se pintan encima del padre, en orden de agregado
+ * - invalidar() anota la caja como sucia; render()
+ *   repinta solo esas zonas
+ * - Cada zona se arma por bandas de BANDA_FILAS filas
+ *   en un GFXcanvas16 chico (10 KB) y se manda con una
+ *   ventana por banda: sin framebuffer de 150 KB y sin
+ *   parpadeo aunque los widgets se superpongan
+ * - tocar(abajo, x, y): hit test, estado apretado y
+ *   acción al soltar sobre el mismo botón
+ * - Mide cada render: zonas, bytes SPI, us
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_ILI9341.h>
+
+struct Caja {
+  int16_t x, y, w, h;
+
+  bool vacia() const { return w <= 0 || h <= 0; }
+  bool contiene(int16_t px, int16_t py) const {
+    return px >= x && py >= y && px < x + w && py < y + h;
+  }
+  bool toca(const Caja& o) const {
+    return x < o.x + o.w && o.x < x + w && y < o.y + o.h && o.y < y + h;
+  }
+  Caja unir(const Caja& o) const {
+    int16_t x0 = min(x, o.x), y0 = min(y, o.y);
+    return { x0, y0, (int16_t)(max(x + w, o.x + o.w) - x0), (int16_t)(max(y + h, o.y + o.h) - y0) };
+  }
+  Caja recortar(const Caja& o) const {
+    int16_t x0 = max(x, o.x), y0 = max(y, o.y);
+    return { x0, y0, (int16_t)(min(x + w, o.x + o.w) - x0), (int16_t)(min(y + h, o.y + o.h) - y0) };
+  }
+};
+
+class PanelUI;
+
+// ====== Widget base ======
+class Widget {
+public:
+  Widget(int16_t x, int16_t y, int16_t w, int16_t h) : caja_{ x, y, w, h } {}
+  virtual ~Widget() {}
+
+  void agregar(Widget* w) {
+    w->padre_ = this;
+    w->hermano_ = nullptr;
+    if (!hijo_) { hijo_ = w; return; }
+    Widget* u = hijo_;
+    while (u->hermano_) u = u->hermano_;
+    u->hermano_ = w;
+  }
+
+  void invalidar();
+  void mostrar(bool v) {
+    if (v == visible_) return;
+    visible_ = v;
+    invalidar();
+  }
+
+  const Caja& caja() const { return caja_; }
+  bool visible() const { return visible_; }
+
+  // Pinta en g con origen (ox, oy): la pantalla (x, y) va a (x - ox, y - oy).
+  // g recorta solo, así que basta con pintar lo que caiga en la banda.
+  virtual void pintar(Adafruit_GFX& g, int16_t ox, int16_t oy) {}
+  virtual bool interactivo() const { return false; }
+  virtual bool contiene(int16_t x, int16_t y) const { return caja_.contiene(x, y); }
+  virtual void apretar(bool on) {}
+  virtual void activar() {}
+
+protected:
+  Caja     caja_;
+  bool     visible_ = true;
+  Widget*  padre_ = nullptr;
+  Widget*  hijo_ = nullptr;
+  Widget*  hermano_ = nullptr;
+  PanelUI* ui_ = nullptr;
+
+  friend class PanelUI;
+};
+
+// ====== Widgets concretos ======
+class Rectangulo : public Widget {
+public:
+  Rectangulo(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    : Widget(x, y, w, h), color_(color) {}
+
+  void pintar(Adafruit_GFX& g, int16_t ox, int16_t oy) override {
+    g.fillRect(caja_.x - ox, caja_.y - oy, caja_.w, caja_.h, color_);
+  }
+
+  void color(uint16_t c) {
+    if (c == color_) return;
+    color_ = c;
+    invalidar();
+  }
+
+private:
+  uint16_t color_;
+};
+
+// Bitmap de 1 bit (formato drawBitmap), fondo transparente.
+// Solo recorre las filas que caen en la banda.
+class Imagen1b : public Widget {
+public:
+  Imagen1b(int16_t x, int16_t y, const uint8_t* bmp, int16_t w, int16_t h, uint16_t color)
+    : Widget(x, y, w, h), bmp_(bmp), color_(color) {}
+
+  void pintar(Adafruit_GFX& g, int16_t ox, int16_t oy) override {
+    int16_t stride = (caja_.w + 7) / 8;
+    int16_t f0 = max(0, oy - caja_.y);
+    int16_t f1 = min((int)caja_.h, oy + g.height() - caja_.y);
+    for (int16_t f = f0; f < f1; f++) {
+      const uint8_t* fila = bmp_ + f * stride;
+      int16_t gy = caja_.y + f - oy;
+      for (int16_t x = 0; x < caja_.w; x++) {
+        if (pgm_read_byte(fila + (x >> 3)) & (0x80 >> (x & 7))) g.drawPixel(caja_.x + x - ox, gy, color_);
+      }
+    }
+  }
+
+private:
+  const uint8_t* bmp_;
+  uint16_t       color_;
+};
+
+// Botón circular: color propio, más oscuro y con aro mientras está apretado
+class BotonCirculo : public Widget {
+public:
+  typedef void (*Accion)(uint8_t id);
+
+  BotonCirculo(uint8_t id, int16_t cx, int16_t cy, int16_t r, uint16_t color, uint16_t colorApretado,
+               Accion accion)
+    : Widget(cx - r, cy - r, 2 * r + 1, 2 * r + 1), id_(id), cx_(cx), cy_(cy), r_(r),
+      color_(color), colorApretado_(colorApretado), accion_(accion) {}
+
+  void pintar(Adafruit_GFX& g, int16_t ox, int16_t oy) override {
+    g.fillCircle(cx_ - ox, cy_ - oy, r_, apretado_ ? colorApretado_ : color_);
+    if (apretado_) g.drawCircle(cx_ - ox, cy_ - oy, r_ - 3, ILI9341_WHITE);
+  }
+
+  bool interactivo() const override { return true; }
+  bool contiene(int16_t x, int16_t y) const override {
+    int32_t dx = x - cx_, dy = y - cy_;
+    return dx * dx + dy * dy <= (int32_t)r_ * r_;
+  }
+  void apretar(bool on) override {
+    if (on == apretado_) return;
+    apretado_ = on;
+    invalidar();
+  }
+  void activar() override {
+    if (accion_) accion_(id_);
+  }
+
+private:
+  uint8_t  id_;
+  int16_t  cx_, cy_, r_;
+  uint16_t color_, colorApretado_;
+  Accion   accion_;
+  bool     apretado_ = false;
+};
+
+// ====== Panel: zonas sucias, render por bandas y touch ======
+class PanelUI {
+public:
+  static const uint16_t MAX_W = 320;
+  static const uint8_t  BANDA_FILAS = 16;     // 320 x 16 x 2 = 10 KB
+  static const uint8_t  MAX_SUCIAS = 8;
+  static const uint8_t  VENTANA_CMD_BYTES = 11;   // CASET + PASET + RAMWR
+
+  struct Stats {
+    uint32_t renders;     // render() que pintaron algo
+    uint16_t zonas;       // del último render
+    uint32_t bytes;       // del último render
+    uint32_t us;          // del último render
+    uint32_t maxUs;
+    uint32_t bytesTotal;
+  };
+
+  PanelUI(Adafruit_ILI9341& tft, uint16_t fondo)
+    : tft_(tft), fondo_(fondo), banda_(MAX_W, BANDA_FILAS), raiz_(0, 0, 0, 0) {}
+
+  Widget& raiz() { return raiz_; }
+
+  // Después de armar el árbol: conecta los widgets y pinta todo
+  void begin() {
+    raiz_.caja_ = { 0, 0, tft_.width(), tft_.height() };
+    conectar(&raiz_);
+    invalidar(raiz_.caja_);
+    render();
+  }
+
+  void invalidar(const Caja& c) {
+    Caja z = c.recortar(raiz_.caja_);
+    if (z.vacia()) return;
+    // Si toca una zona anotada se une con ella (y esa puede tocar otras)
+    for (uint8_t i = 0; i < nSucias_;) {
+      if (sucias_[i].toca(z)) {
+        z = z.unir(sucias_[i]);
+        sucias_[i] = sucias_[--nSucias_];
+        i = 0;
+      } else {
+        i++;
+      }
+    }
+    if (nSucias_ < MAX_SUCIAS) { sucias_[nSucias_++] = z; return; }
+    sucias_[0] = sucias_[0].unir(z);       // sin lugar: se agranda la primera
+  }
+
+  bool pendiente() const { return nSucias_ > 0; }
+
+  // Repinta las zonas sucias; devuelve los bytes mandados por SPI
+  uint32_t render() {
+    if (!nSucias_ || !banda_.getBuffer()) return 0;
+    uint32_t t0 = micros();
+    stats_.zonas = nSucias_;
+    stats_.bytes = 0;
+    uint16_t* buf = banda_.getBuffer();
+    tft_.startWrite();
+    for (uint8_t i = 0; i < nSucias_; i++) {
+      const Caja& z = sucias_[i];
+      for (int16_t y = z.y; y < z.y + z.h; y += BANDA_FILAS) {
+        int16_t filas = min((int)BANDA_FILAS, z.y + z.h - y);
+        Caja b = { z.x, y, z.w, filas };
+        banda_.fillRect(0, 0, z.w, filas, fondo_);
+        pintarArbol(&raiz_, b);
+        tft_.setAddrWindow(z.x, y, z.w, filas);
+        for (int16_t f = 0; f < filas; f++) tft_.writePixels(buf + f * MAX_W, z.w);
+        stats_.bytes += VENTANA_CMD_BYTES + (uint32_t)z.w * filas * 2;
+      }
+    }
+    tft_.endWrite();
+    nSucias_ = 0;
+    stats_.us = micros() - t0;
+    if (stats_.us > stats_.maxUs) stats_.maxUs = stats_.us;
+    stats_.renders++;
+    stats_.bytesTotal += stats_.bytes;
+    return stats_.bytes;
+  }
+
+  // Touch ya mapeado a pantalla. Apretado = dedo sobre el botón; la
+  // acción sale al soltar, solo si se suelta encima del mismo botón.
+  void tocar(bool abajo, int16_t x, int16_t y) {
+    if (abajo) {
+      if (!activo_) activo_ = buscar(&raiz_, x, y);
+      if (activo_) activo_->apretar(activo_->contiene(x, y));
+      ultX_ = x;
+      ultY_ = y;
+      return;
+    }
+    if (!activo_) return;
+    bool encima = activo_->contiene(ultX_, ultY_);
+    activo_->apretar(false);
+    if (encima) activo_->activar();
+    activo_ = nullptr;
+  }
+
+  const Stats& stats() const { return stats_; }
+
+private:
+  void conectar(Widget* w) {
+    w->ui_ = this;
+    for (Widget* h = w->hijo_; h; h = h->hermano_) conectar(h);
+  }
+
+  void pintarArbol(Widget* w, const Caja& b) {
+    if (!w->visible_) return;
+    if (w->caja_.toca(b)) w->pintar(banda_, b.x, b.y);
+    for (Widget* h = w->hijo_; h; h = h->hermano_) pintarArbol(h, b);
+  }
+
+  // El interactivo de más arriba bajo (x, y): los últimos hijos tapan a los primeros
+  Widget* buscar(Widget* w, int16_t x, int16_t y) {
+    if (!w->visible_) return nullptr;
+    Widget* hit = (w->interactivo() && w->contiene(x, y)) ? w : nullptr;
+    for (Widget* h = w->hijo_; h; h = h->hermano_) {
+      Widget* r = buscar(h, x, y);
+      if (r) hit = r;
+    }
+    return hit;
+  }
+
+  Adafruit_ILI9341& tft_;
+  uint16_t    fondo_;
+  GFXcanvas16 banda_;
+  Widget      raiz_;
+
+  Caja        sucias_[MAX_SUCIAS];
+  uint8_t     nSucias_ = 0;
+
+  Widget*     activo_ = nullptr;
+  int16_t     ultX_ = 0, ultY_ = 0;
+  Stats       stats_ = {};
+};
+
+inline void Widget::invalidar() {
+  if (ui_) ui_->invalidar(caja_);
+}
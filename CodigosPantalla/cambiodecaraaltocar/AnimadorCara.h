@@ -0,0 +1,254 @@
+/****************************************************
+ * Animación de la cara (sobre CaraDelta)
+ * - Secuencias de cuadros clave: cara + cuánto dura +
+ *   transición (0 = corte, si no wipe repartido en los
+ *   cuadros que entren en ese tiempo)
+ * - Base: reposo (una cara fija con parpadeo al azar) o
+ *   hablar (loop de boca mientras suena el audio);
+ *   encima se pueden tirar secuencias de una pasada
+ * - Tarea propia a FPS fijos (vTaskDelayUntil); cuenta
+ *   cuadros perdidos y los que se pasan del presupuesto
+ * - Los pedidos llegan por una cola: loop() (touch) no
+ *   espera nunca al render
+ * - tick(ms) no depende de la tarea: con beginManual()
+ *   se llama a mano con un reloj propio (las pruebas)
+ * - medir(h): tiempo de cada cuadro que dibujó algo (us)
+ *   a un histograma de Telemetria.h
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include "CaraDelta.h"
+#include <Telemetria.h>
+
+struct Cuadro {
+  uint8_t  cara;
+  uint16_t ms;          // cuánto se queda (después de la transición)
+  uint16_t transMs;     // 0 = cambio en un cuadro
+};
+
+struct Secuencia {
+  const char*   nombre;
+  const Cuadro* cuadros;
+  uint8_t       n;
+  bool          loop;
+};
+
+class AnimadorCara {
+public:
+  static const uint8_t  FPS = 30;
+  static const uint32_t PERIODO_MS = 1000 / FPS;
+  static const uint32_t PRESUPUESTO_US = PERIODO_MS * 1000 * 3 / 4;   // margen para el touch
+
+  struct Stats {
+    uint32_t cuadros;       // ticks ejecutados
+    uint32_t dibujados;     // ticks que mandaron algo por SPI
+    uint32_t perdidos;      // ticks que no llegaron a su hora
+    uint32_t excedidos;     // render más largo que el presupuesto
+    uint32_t maxUs;
+    uint32_t spiBytes;
+  };
+
+  explicit AnimadorCara(CaraDelta& delta) : delta_(delta) {}
+
+  bool begin(uint8_t caraReposo, uint8_t core = 1, UBaseType_t prio = 2) {
+    if (!beginManual(caraReposo)) return false;
+    return xTaskCreatePinnedToCore(tareaThunk, "cara_anim", 4096, this, prio, &tarea_, core) == pdPASS;
+  }
+
+  // Sin tarea: quien lo llama hace tick() a su ritmo. perdidos,
+  // excedidos y maxUs quedan en 0 (los mide la tarea)
+  bool beginManual(uint8_t caraReposo) {
+    reposo_ = caraReposo;
+    if (!cola_) cola_ = xQueueCreate(8, sizeof(Pedido));
+    return cola_ != nullptr;
+  }
+
+  // ---- Pedidos (desde cualquier tarea, no bloquean) ----
+  // Devuelven un número de pedido (0 = cola llena); aplicado() dice
+  // hasta cuál ya se dibujó el primer cuadro
+  uint32_t reposo(uint8_t cara)             { return pedir(P_REPOSO, nullptr, cara, 0); }
+  uint32_t reproducir(const Secuencia* s)   { return pedir(P_UNA_VEZ, s, 0, 0); }
+  // nullptr = dejar de hablar; con duracionMs se deja sola al pasar ese tiempo
+  uint32_t hablar(const Secuencia* s, uint32_t duracionMs = 0) { return pedir(P_HABLAR, s, 0, duracionMs); }
+  void parpadeo(const Secuencia* s, uint16_t minMs, uint16_t maxMs) {
+    parpadeo_ = s;
+    parpMin_ = minMs;
+    parpMax_ = maxMs;
+  }
+
+  Stats stats() const { return stats_; }
+  uint32_t aplicado() const { return aplicado_; }
+  void medir(telemetria::Histograma* redibujo) { redibujo_ = redibujo; }
+
+  // Un cuadro de animación a la hora 'ahora' (ms)
+  void tick(uint32_t ahora) {
+    Pedido p;
+    uint32_t ultimo = 0;
+    dibujo_ = false;
+    while (cola_ && xQueueReceive(cola_, &p, 0) == pdTRUE) {
+      aplicar(p, ahora);
+      ultimo = p.id;
+    }
+    if (!dibujo_) avanzar(ahora);             // un pedido que dibujó ya usó el cuadro
+    if (dibujo_) stats_.dibujados++;
+    if (ultimo) aplicado_ = ultimo;
+  }
+
+private:
+  enum TipoPedido : uint8_t { P_REPOSO, P_UNA_VEZ, P_HABLAR };
+  struct Pedido {
+    TipoPedido       tipo;
+    const Secuencia* sec;
+    uint8_t          cara;
+    uint32_t         ms;
+    uint32_t         id;
+  };
+
+  void avanzar(uint32_t ahora) {
+    if (hablar_ && hablarHasta_ && (int32_t)(ahora - hablarHasta_) >= 0) {
+      if (sec_ == hablar_) sec_ = nullptr;
+      hablar_ = nullptr;
+    }
+    if (delta_.wiping()) {                    // transición en curso
+      delta_.step(filasPorCuadro_);
+      contar();
+      return;
+    }
+    if (!sec_) {
+      if (hablar_) { empezar(hablar_, ahora); return; }
+      if (parpadeo_ && (int32_t)(ahora - tParpadeo_) >= 0) {
+        programarParpadeo(ahora);
+        empezar(parpadeo_, ahora);
+        return;
+      }
+      if (delta_.current() != reposo_) { delta_.show(reposo_); contar(); }
+      return;
+    }
+    if ((int32_t)(ahora - tFin_) < 0) return;
+    if (++idx_ >= sec_->n) {
+      if (!sec_->loop) { sec_ = nullptr; avanzar(ahora); return; }
+      idx_ = 0;
+    }
+    entrar(ahora);
+  }
+
+  uint32_t pedir(TipoPedido t, const Secuencia* s, uint8_t cara, uint32_t ms) {
+    if (!cola_) return 0;
+    Pedido p = { t, s, cara, ms, 0 };
+    portENTER_CRITICAL(&mux_);
+    p.id = ++pedidos_;
+    portEXIT_CRITICAL(&mux_);
+    return xQueueSend(cola_, &p, 0) == pdTRUE ? p.id : 0;
+  }
+
+  void aplicar(const Pedido& p, uint32_t ahora) {
+    switch (p.tipo) {
+      case P_REPOSO:
+        reposo_ = p.cara;                  // se ve al terminar lo que esté sonando
+        break;
+      case P_UNA_VEZ:
+        empezar(p.sec, ahora);
+        break;
+      case P_HABLAR:
+        hablar_ = p.sec;
+        hablarHasta_ = p.ms ? ahora + p.ms : 0;
+        if (hablar_) empezar(hablar_, ahora);
+        else if (sec_ && sec_->loop) sec_ = nullptr;   // vuelve al reposo
+        break;
+    }
+  }
+
+  void empezar(const Secuencia* s, uint32_t ahora) {
+    if (!s || !s->n) return;
+    sec_ = s;
+    idx_ = 0;
+    entrar(ahora);
+  }
+
+  // Entra al cuadro idx_: corte directo o wipe repartido en transMs
+  void entrar(uint32_t ahora) {
+    const Cuadro& c = sec_->cuadros[idx_];
+    tFin_ = ahora + c.transMs + c.ms;
+    if (c.transMs >= PERIODO_MS) {
+      // Un wipe a medias (pedido en el medio) se termina acá y se cuenta:
+      // wipe() lo completaría por dentro y step() pisa sus stats
+      if (delta_.wiping()) {
+        delta_.step(delta_.height());
+        contar();
+      }
+      uint16_t n = c.transMs / PERIODO_MS;
+      filasPorCuadro_ = (delta_.height() + n - 1) / n;
+      bool nueva = delta_.current() >= delta_.count();   // wipe() hace drawFull
+      delta_.wipe(c.cara);
+      if (delta_.wiping()) delta_.step(filasPorCuadro_);
+      else if (!nueva) return;                           // ya estaba esa cara
+    } else {
+      delta_.show(c.cara);
+    }
+    contar();
+  }
+
+  void programarParpadeo(uint32_t ahora) {
+    tParpadeo_ = ahora + parpMin_ + (parpMax_ > parpMin_ ? random(parpMax_ - parpMin_) : 0);
+  }
+
+  void contar() {
+    const CaraDelta::Stats& st = delta_.lastStats();
+    if (st.spans) {
+      dibujo_ = true;
+      stats_.spiBytes += st.spiBytes;
+    }
+  }
+
+  static void tareaThunk(void* p) { ((AnimadorCara*)p)->tarea(); }
+
+  void tarea() {
+    const TickType_t periodo = pdMS_TO_TICKS(PERIODO_MS);
+    TickType_t ultimo = xTaskGetTickCount();
+    programarParpadeo(millis());
+    for (;;) {
+      uint32_t t0 = micros();
+      uint32_t dibujados = stats_.dibujados;
+      tick(millis());
+      uint32_t us = micros() - t0;
+      stats_.cuadros++;
+      if (redibujo_ && stats_.dibujados != dibujados) redibujo_->registrar(us);
+      if (us > stats_.maxUs) stats_.maxUs = us;
+      if (us > PRESUPUESTO_US) stats_.excedidos++;
+
+      // Si el render se comió uno o más periodos, se saltean (no se acumulan)
+      TickType_t ahora = xTaskGetTickCount();
+      if (ahora - ultimo >= periodo) {
+        uint32_t atraso = (ahora - ultimo) / periodo;
+        stats_.perdidos += atraso;
+        ultimo += atraso * periodo;
+      }
+      vTaskDelayUntil(&ultimo, periodo);
+    }
+  }
+
+  CaraDelta&       delta_;
+  telemetria::Histograma* redibujo_ = nullptr;
+  QueueHandle_t    cola_ = nullptr;
+  TaskHandle_t     tarea_ = nullptr;
+
+  uint8_t          reposo_ = 0;
+  const Secuencia* sec_ = nullptr;      // secuencia activa (nullptr = reposo)
+  const Secuencia* hablar_ = nullptr;   // loop de boca mientras se habla
+  uint32_t         hablarHasta_ = 0;    // 0 = hasta que se pida parar
+  uint8_t          idx_ = 0;
+  uint32_t         tFin_ = 0;
+  uint16_t         filasPorCuadro_ = 0;
+  bool             dibujo_ = false;     // este tick mandó algo por SPI
+
+  const Secuencia* parpadeo_ = nullptr;
+  uint16_t         parpMin_ = 2000, parpMax_ = 6000;
+  uint32_t         tParpadeo_ = 0;
+
+  uint32_t         pedidos_ = 0;
+  volatile uint32_t aplicado_ = 0;      // último pedido ya en pantalla
+  portMUX_TYPE     mux_ = portMUX_INITIALIZER_UNLOCKED;
+
+  Stats            stats_ = {};
+};
@@ -0,0 +1,98 @@
+/****************************************************
+ * Arbitraje del bus SPI compartido (TFT + XPT2046)
+ * - Un mutex (con herencia de prioridad) por encima
+ *   del lock interno de SPI: quien lo tiene puede
+ *   hacer varias transacciones seguidas
+ * - El TFT dibuja por tramos de ~TRAMO_BYTES y entre
+ *   tramo y tramo llama a ceder(): si el touch está
+ *   esperando, suelta el bus, el touch lee (su tarea
+ *   tiene más prioridad) y el TFT lo vuelve a tomar
+ * - Así la espera del touch queda acotada a un tramo
+ *   (~1 ms a 40 MHz) aunque se redibuje toda la
+ *   pantalla
+ * - Métricas por dispositivo: usos, ocupación y
+ *   espera (total y máxima, en us)
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+
+class BusSPI {
+public:
+  enum Dispositivo : uint8_t { TFT, TACTIL, N_DISPOSITIVOS };
+
+  static const uint16_t TRAMO_BYTES = 4096;   // ~0.8 ms de SPI a 40 MHz
+
+  struct Stats {
+    uint32_t usos;
+    uint32_t cedidas;        // veces que soltó el bus a pedido de otro
+    uint64_t ocupadoUs;
+    uint32_t maxOcupadoUs;   // uso continuo más largo
+    uint64_t esperaUs;
+    uint32_t maxEsperaUs;
+  };
+
+  bool begin() {
+    mutex_ = xSemaphoreCreateMutex();
+    return mutex_ != nullptr;
+  }
+
+  void tomar(Dispositivo d) {
+    uint32_t t0 = micros();
+    esperando_[d]++;
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    esperando_[d]--;
+    uint32_t espera = micros() - t0;
+    tUso_ = micros();
+    Stats& s = stats_[d];
+    s.usos++;
+    s.esperaUs += espera;
+    if (espera > s.maxEsperaUs) s.maxEsperaUs = espera;
+  }
+
+  void soltar(Dispositivo d) {
+    uint32_t uso = micros() - tUso_;
+    Stats& s = stats_[d];
+    s.ocupadoUs += uso;
+    if (uso > s.maxOcupadoUs) s.maxOcupadoUs = uso;
+    xSemaphoreGive(mutex_);
+  }
+
+  // ¿Hay otro dispositivo esperando el bus?
+  bool pedido(Dispositivo d) const {
+    for (uint8_t i = 0; i < N_DISPOSITIVOS; i++) {
+      if (i != d && esperando_[i]) return true;
+    }
+    return false;
+  }
+
+  // Punto de corte del que tiene el bus: si alguien espera, se lo pasa.
+  // Devuelve true si soltó (la transacción del que llama se cortó).
+  bool ceder(Dispositivo d) {
+    if (!pedido(d)) return false;
+    stats_[d].cedidas++;
+    soltar(d);
+    taskYIELD();              // por si el que espera está en el otro core
+    tomar(d);
+    return true;
+  }
+
+  Stats stats(Dispositivo d) const { return stats_[d]; }
+
+private:
+  SemaphoreHandle_t     mutex_ = nullptr;
+  volatile uint8_t      esperando_[N_DISPOSITIVOS] = {};
+  uint32_t              tUso_ = 0;
+  Stats                 stats_[N_DISPOSITIVOS] = {};
+};
+
+// Uso del bus por alcance: se toma al crear y se suelta al salir
+class UsoBus {
+public:
+  UsoBus(BusSPI* bus, BusSPI::Dispositivo d) : bus_(bus), d_(d) { if (bus_) bus_->tomar(d_); }
+  ~UsoBus() { if (bus_) bus_->soltar(d_); }
+
+private:
+  BusSPI*             bus_;
+  BusSPI::Dispositivo d_;
+};
@@ -0,0 +1,299 @@
+/****************************************************
+ * Cambio de cara por diferencias (ILI9341)
+ * - Las caras vienen comprimidas por filas (CaraRLE.h,
+ *   generadas con herramientas/compilar_caras.py); se
+ *   decodifican de a una fila, nunca el frame entero
+ * - Al inicio se calcula el XOR entre cada par de caras
+ *   y se guardan los tramos de cada fila que cambian
+ * - show() pinta solo esos tramos: setAddrWindow + un
+ *   writePixels por tramo, sin fillScreen (sin parpadeo)
+ * - Huecos chicos entre tramos se pintan igual: sale
+ *   más barato que otro setAddrWindow
+ * - wipe() + step(): el cambio se reparte en varios
+ *   cuadros, de arriba hacia abajo (párpado, transición)
+ * - Mide cada cambio (tramos, píxeles, bytes SPI, us);
+ *   la misma cuenta la hace herramientas/delta_caras.py
+ * - Con usarBus() toma el bus SPI compartido y lo cede
+ *   al touch cada ~BusSPI::TRAMO_BYTES (BusSPI.h)
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>
+#include "CaraRLE.h"
+#include "BusSPI.h"
+
+class CaraDelta {
+public:
+  static const uint8_t  MAX_CARAS = 24;
+  static const uint16_t MAX_SPANS = 2048;   // 8 KB; los pares que no entran van al vuelo
+  static const uint16_t MAX_W     = 320;
+  static const uint8_t  GAP_BYTES = 2;      // huecos de hasta 16 px se unen
+  static const uint8_t  SPAN_CMD_BYTES = 11;  // CASET + PASET + RAMWR con parámetros
+
+  struct Stats {
+    uint16_t spans;
+    uint32_t pixels;
+    uint32_t spiBytes;
+    uint32_t us;
+  };
+
+  CaraDelta(Adafruit_ILI9341& tft, uint16_t fg, uint16_t bg)
+    : tft_(tft), fg_(fg), bg_(bg) {}
+
+  // Devuelve el índice de la cara o -1 si no hay lugar (todas del mismo tamaño).
+  // Se puede llamar después de begin() (caras bajadas del server): sus pares
+  // no tienen tabla y se calculan al vuelo.
+  int8_t add(const CaraRLE* cara) {
+    if (count_ >= MAX_CARAS || cara->w > MAX_W) return -1;
+    if (!count_) {
+      w_ = cara->w;
+      h_ = cara->h;
+      stride_ = (w_ + 7) / 8;
+    } else if (cara->w != (uint16_t)w_ || cara->h != (uint16_t)h_) {
+      return -1;
+    }
+    caras_[count_] = cara;
+    for (uint8_t i = 0; i < count_; i++) len_[i][count_] = NO_TABLE;
+    return count_++;
+  }
+
+  // Precalcula los tramos de cada par (el XOR es simétrico: A->B = B->A).
+  // Si el pool no alcanza, ese par se calcula al vuelo en show().
+  void begin() {
+    used_ = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+      for (uint8_t j = i + 1; j < count_; j++) {
+        uint16_t off = used_;
+        bool fits = true;
+        scan(caras_[i], caras_[j], 0, h_, [&](uint16_t y, uint8_t b0, uint8_t b1) {
+          if (!fits) return;
+          if (used_ >= MAX_SPANS) { fits = false; return; }
+          spans_[used_++] = { y, b0, b1 };
+        });
+        if (fits) {
+          off_[i][j] = off;
+          len_[i][j] = used_ - off;
+        } else {
+          used_ = off;
+          len_[i][j] = NO_TABLE;
+        }
+      }
+    }
+  }
+
+  void usarBus(BusSPI* bus) { bus_ = bus; }
+
+  // Pinta la cara entera (primera vez): una ventana, un writeColor por tramo RLE
+  void drawFull(uint8_t cara) {
+    if (cara >= count_) return;
+    uint32_t t0 = micros();
+    int16_t w = min(w_, tft_.width()), h = min(h_, tft_.height());
+    if (bus_) bus_->tomar(BusSPI::TFT);
+    tramo_ = 0;
+    dibujarRLE(tft_, caras_[cara], 0, 0, fg_, bg_, [&] { return corte((uint32_t)w * 2); });
+    if (bus_) bus_->soltar(BusSPI::TFT);
+    cur_ = cara;
+    wiping_ = false;
+    stats_.spans = 1;
+    stats_.pixels = (uint32_t)w * h;
+    stats_.spiBytes = SPAN_CMD_BYTES + stats_.pixels * 2;
+    stats_.us = micros() - t0;
+  }
+
+  // Pasa de la cara actual a 'cara' pintando solo lo que cambia. Si había
+  // un wipe a medias, arriba de split_ está next_ y abajo cur_.
+  void show(uint8_t cara) {
+    if (cara >= count_) return;
+    if (cur_ >= count_) { drawFull(cara); return; }
+    beginStats();
+    abrir();
+    if (wiping_) {
+      drawRange(next_, cara, 0, split_);
+      drawRange(cur_, cara, split_, h_);
+    } else {
+      drawRange(cur_, cara, 0, h_);
+    }
+    cerrar();
+    cur_ = cara;
+    wiping_ = false;
+    endStats();
+  }
+
+  // Empieza un cambio repartido en cuadros: cada step() pinta las
+  // próximas 'rows' filas. Un wipe a medias se completa primero.
+  void wipe(uint8_t cara) {
+    if (cara >= count_) return;
+    if (cur_ >= count_) { drawFull(cara); return; }
+    if (wiping_) show(next_);
+    if (cara == cur_) return;
+    next_ = cara;
+    split_ = 0;
+    wiping_ = true;
+  }
+
+  // true cuando el wipe terminó (o no había)
+  bool step(uint16_t rows) {
+    if (!wiping_) return true;
+    beginStats();
+    uint16_t y1 = min((uint16_t)(split_ + rows), (uint16_t)h_);
+    abrir();
+    drawRange(cur_, next_, split_, y1);
+    cerrar();
+    split_ = y1;
+    if (split_ >= h_) {
+      cur_ = next_;
+      wiping_ = false;
+    }
+    endStats();
+    return !wiping_;
+  }
+
+  bool wiping() const { return wiping_; }
+  int16_t height() const { return h_; }
+  uint8_t current() const { return cur_; }
+  uint8_t count() const { return count_; }
+  const CaraRLE* cara(uint8_t i) const { return i < count_ ? caras_[i] : nullptr; }
+  const Stats& lastStats() const { return stats_; }
+  uint16_t spansUsed() const { return used_; }
+
+private:
+  struct Span {
+    uint16_t y;
+    uint8_t  b0, b1;   // bytes b0..b1 de la fila (8 px cada uno)
+  };
+  static const uint16_t NO_TABLE = 0xFFFF;
+
+  void beginStats() {
+    t0_ = micros();
+    stats_.spans = 0;
+    stats_.pixels = 0;
+  }
+
+  void endStats() {
+    stats_.spiBytes = (uint32_t)stats_.spans * SPAN_CMD_BYTES + stats_.pixels * 2;
+    stats_.us = micros() - t0_;
+  }
+
+  void abrir() {
+    if (bus_) bus_->tomar(BusSPI::TFT);
+    tft_.startWrite();
+    tramo_ = 0;
+  }
+
+  void cerrar() {
+    tft_.endWrite();
+    if (bus_) bus_->soltar(BusSPI::TFT);
+  }
+
+  // Después de cada tramo o fila: pasado un tramo de bus, si el touch
+  // espera se corta la transacción y se le cede. true = se cortó.
+  bool corte(uint32_t bytes) {
+    tramo_ += bytes;
+    if (!bus_ || tramo_ < BusSPI::TRAMO_BYTES) return false;
+    tramo_ = 0;
+    if (!bus_->pedido(BusSPI::TFT)) return false;
+    tft_.endWrite();
+    bus_->ceder(BusSPI::TFT);
+    tft_.startWrite();
+    return true;
+  }
+
+  // Pinta, en las filas [y0, y1), los tramos que cambian entre las caras
+  // 'from' y 'to' (lo que queda en pantalla es 'to'). Dentro de startWrite.
+  void drawRange(uint8_t from, uint8_t to, uint16_t y0, uint16_t y1) {
+    if (from == to || y0 >= y1) return;
+    uint8_t i = min(from, to), j = max(from, to);
+    lector_.begin(caras_[to]);
+    rowY_ = 0xFFFF;
+    if (len_[i][j] != NO_TABLE) {
+      const Span* s = spans_ + off_[i][j];
+      uint16_t lo = 0, hi = len_[i][j];
+      while (lo < hi) {                       // primer tramo con y >= y0
+        uint16_t mid = (lo + hi) / 2;
+        if (s[mid].y < y0) lo = mid + 1; else hi = mid;
+      }
+      for (uint16_t k = lo; k < len_[i][j] && s[k].y < y1; k++) drawSpan(s[k].y, s[k].b0, s[k].b1);
+    } else {
+      scan(caras_[i], caras_[j], y0, y1, [&](uint16_t y, uint8_t b0, uint8_t b1) { drawSpan(y, b0, b1); });
+    }
+  }
+
+  // Recorre las filas de a XOR b y emite (y, b0, b1) por cada tramo con
+  // cambios. Decodifica de a una fila de cada cara (usa rowA_/rowB_).
+  template <class F>
+  void scan(const CaraRLE* a, const CaraRLE* b, uint16_t y0, uint16_t y1, F emit) {
+    LectorRLE la, lb;
+    la.begin(a);
+    lb.begin(b);
+    for (uint16_t y = y0; y < y1; y++) {
+      la.bits(y, rowA_);
+      lb.bits(y, rowB_);
+      int16_t x = 0;
+      while (x < stride_) {
+        if (!(rowA_[x] ^ rowB_[x])) { x++; continue; }
+        int16_t b0 = x, b1 = x;
+        uint8_t gap = 0;
+        for (x++; x < stride_; x++) {
+          if (rowA_[x] ^ rowB_[x]) { b1 = x; gap = 0; }
+          else if (++gap > GAP_BYTES) break;
+        }
+        emit(y, b0, b1);
+        x = b1 + 1;
+      }
+    }
+  }
+
+  // Bits de la fila -> RGB565 en line_
+  void expand(const uint8_t* row, int16_t x0, int16_t n) {
+    for (int16_t k = 0; k < n; k++) {
+      int16_t x = x0 + k;
+      line_[k] = (row[x >> 3] & (0x80 >> (x & 7))) ? fg_ : bg_;
+    }
+  }
+
+  // Tramo de la cara destino (lector_); los tramos vienen ordenados por
+  // fila, así que cada fila se decodifica una sola vez
+  void drawSpan(uint16_t y, uint8_t b0, uint8_t b1) {
+    if ((int16_t)y >= tft_.height()) return;   // recorte según rotación
+    int16_t x0 = b0 * 8;
+    int16_t x1 = min((int16_t)(b1 * 8 + 7), (int16_t)(min(w_, tft_.width()) - 1));
+    if (x1 < x0) return;
+    int16_t n = x1 - x0 + 1;
+    if (y != rowY_) {
+      lector_.bits(y, rowT_);
+      rowY_ = y;
+    }
+    expand(rowT_, x0, n);
+    tft_.setAddrWindow(x0, y, n, 1);
+    tft_.writePixels(line_, n);
+    stats_.spans++;
+    stats_.pixels += n;
+    corte(SPAN_CMD_BYTES + (uint32_t)n * 2);   // cada tramo trae su ventana: no hay que rearmar
+  }
+
+  Adafruit_ILI9341& tft_;
+  int16_t  w_ = 0, h_ = 0, stride_ = 0;
+  uint16_t fg_, bg_;
+
+  const CaraRLE* caras_[MAX_CARAS];
+  uint8_t  count_ = 0;
+  uint8_t  cur_ = 0xFF;   // ninguna pintada todavía
+  uint8_t  next_ = 0;     // destino del wipe en curso
+  uint16_t split_ = 0;    // filas [0, split_) ya muestran next_
+  bool     wiping_ = false;
+  uint32_t t0_ = 0;
+  BusSPI*  bus_ = nullptr;
+  uint32_t tramo_ = 0;    // bytes desde el último punto de corte
+
+  Span     spans_[MAX_SPANS];
+  uint16_t used_ = 0;
+  uint16_t off_[MAX_CARAS][MAX_CARAS];
+  uint16_t len_[MAX_CARAS][MAX_CARAS];
+
+  uint16_t line_[MAX_W];
+  uint8_t  rowA_[MAX_W / 8], rowB_[MAX_W / 8], rowT_[MAX_W / 8];
+  LectorRLE lector_;
+  uint16_t rowY_ = 0xFFFF;
+  Stats    stats_ = {};
+};
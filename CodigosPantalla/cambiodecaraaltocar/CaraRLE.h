@@ -0,0 +1,146 @@
+/****************************************************
+ * Caras comprimidas por filas (RLE) para el ILI9341
+ * Formato (lo genera herramientas/compilar_caras.py):
+ * - Cada fila: largos de tramos alternando fondo y
+ *   figura, empezando por fondo (puede ser 0); la
+ *   suma de la fila es el ancho
+ * - Largo < 128: 1 byte; si no, 2 bytes (0x80 | alto,
+ *   bajo)
+ * - Índice: offset (uint16) de cada FILAS_INDICE filas,
+ *   para saltar a una fila sin decodificar las de antes
+ * - LectorRLE compila también en host (g++ normal) para
+ *   comparar contra el compilador; dibujarRLE (solo
+ *   ESP32) pinta desde flash sin frame en RAM
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef ARDUINO
+  #include <Arduino.h>
+  #include <Adafruit_ILI9341.h>
+#else
+  #define PROGMEM
+  #define pgm_read_byte(p) (*(const uint8_t*)(p))
+  #define pgm_read_word(p) (*(const uint16_t*)(p))
+#endif
+
+static const uint8_t FILAS_INDICE = 16;
+
+struct CaraRLE {
+  const char*     nombre;
+  uint16_t        w, h;
+  const uint8_t*  datos;    // filas RLE (PROGMEM)
+  const uint16_t* indice;   // offset de la fila i * FILAS_INDICE (PROGMEM)
+};
+
+// ====== Lector de filas ======
+// Secuencial por defecto (lo normal al dibujar o comparar caras);
+// si se pide una fila hacia atrás o lejos, salta con el índice.
+class LectorRLE {
+public:
+  void begin(const CaraRLE* c) {
+    cara_ = c;
+    saltar(0);
+  }
+
+  // Deja el lector al principio de la fila y
+  void fila(uint16_t y) {
+    if (empezada_) cerrarFila();
+    if (y < y_ || y / FILAS_INDICE > y_ / FILAS_INDICE) saltar(y);
+    while (y_ < y) cerrarFila();
+  }
+
+  // Próximo tramo de la fila actual; false cuando la fila ya terminó
+  bool tramo(uint16_t& largo, bool& figura) {
+    if (x_ >= cara_->w) return false;
+    uint8_t b = pgm_read_byte(p_++);
+    largo = b & 0x80 ? ((b & 0x7F) << 8) | pgm_read_byte(p_++) : b;
+    figura = figura_;
+    figura_ = !figura_;
+    x_ += largo;
+    empezada_ = true;
+    return true;
+  }
+
+  // Fila y en bits (formato drawBitmap: MSB primero, 1 = figura)
+  void bits(uint16_t y, uint8_t* out) {
+    fila(y);
+    memset(out, 0, (cara_->w + 7) / 8);
+    uint16_t x = 0, largo;
+    bool figura;
+    while (tramo(largo, figura)) {
+      if (figura) for (uint16_t k = x; k < x + largo; k++) out[k >> 3] |= 0x80 >> (k & 7);
+      x += largo;
+    }
+  }
+
+  const CaraRLE* cara() const { return cara_; }
+
+private:
+  void saltar(uint16_t y) {
+    uint16_t i = y / FILAS_INDICE;
+    p_ = cara_->datos + pgm_read_word(cara_->indice + i);
+    y_ = i * FILAS_INDICE;
+    x_ = 0;
+    figura_ = false;
+    empezada_ = false;
+  }
+
+  // Consume lo que falte de la fila actual y pasa a la siguiente
+  void cerrarFila() {
+    uint16_t largo;
+    bool figura;
+    while (tramo(largo, figura)) {}
+    y_++;
+    x_ = 0;
+    figura_ = false;
+    empezada_ = false;
+  }
+
+  const CaraRLE* cara_ = nullptr;
+  const uint8_t* p_ = nullptr;
+  uint16_t y_ = 0;          // fila a la que apunta p_
+  uint16_t x_ = 0;          // píxeles ya leídos de esa fila
+  bool     figura_ = false;   // color del próximo tramo
+  bool     empezada_ = false; // ya se leyó algo de la fila y_
+};
+
+#ifdef ARDUINO
+
+// ====== Dibujo directo desde flash ======
+// Una sola ventana y un writeColor por tramo: ni frame ni fila en RAM.
+// Recorta a la pantalla según la rotación actual. finFila() se llama al
+// terminar cada fila; si devuelve true es que la transacción se cortó
+// (bus cedido) y se vuelve a abrir la ventana desde la fila siguiente.
+template <class F>
+inline void dibujarRLE(Adafruit_ILI9341& tft, const CaraRLE* c, int16_t x0, int16_t y0,
+                       uint16_t fg, uint16_t bg, F finFila) {
+  int16_t w = min((int16_t)c->w, (int16_t)(tft.width() - x0));
+  int16_t h = min((int16_t)c->h, (int16_t)(tft.height() - y0));
+  if (w <= 0 || h <= 0) return;
+  LectorRLE lr;
+  lr.begin(c);
+  tft.startWrite();
+  tft.setAddrWindow(x0, y0, w, h);
+  uint16_t largo;
+  bool figura;
+  for (int16_t y = 0; y < h; y++) {
+    lr.fila(y);
+    int16_t x = 0;
+    while (lr.tramo(largo, figura)) {
+      if (x < w && largo) tft.writeColor(figura ? fg : bg, min((int16_t)largo, (int16_t)(w - x)));
+      x += largo;
+    }
+    if (y + 1 < h && finFila()) tft.setAddrWindow(x0, y0 + y + 1, w, h - y - 1);
+  }
+  tft.endWrite();
+}
+
+inline void dibujarRLE(Adafruit_ILI9341& tft, const CaraRLE* c, int16_t x0, int16_t y0,
+                       uint16_t fg, uint16_t bg) {
+  dibujarRLE(tft, c, x0, y0, fg, bg, [] { return false; });
+}
+
+#endif // ARDUINO
@@ -0,0 +1,265 @@
+/****************************************************
+ * Caras mandadas por el server (comando "cara")
+ * - Tarea de red propia (core 0): long-poll a
+ *   /esp32/poll/<id> con PollComandos y aplica los
+ *   comandos tipo "cara"
+ * - "cara": nombre de una cara del sketch (CARAS[])
+ * - "hash" + "url": cara comprimida (CaraRLE con
+ *   cabecera "CRL1"); se guarda en LittleFS como
+ *   /caras/<md5>.rle y se verifica el md5, así que
+ *   cada cara viaja una sola vez
+ * - "animacion": hablar (con duracion_ms), parpadeo,
+ *   reposo
+ * - Los cambios van por la cola de AnimadorCara (solo
+ *   se pintan las diferencias); al verse el primer
+ *   cuadro se confirma a /esp32/cara_ok/<id> y el
+ *   server mide evento -> píxeles
+ * - medir(rtt, cara): RTT del poll sin la espera del
+ *   long-poll ("retenido_ms" del JSON) y comando ->
+ *   primer cuadro, a histogramas de Telemetria.h
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include <PollComandos.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <MD5Builder.h>
+#include "AnimadorCara.h"
+#include <Telemetria.h>
+
+class CaraRemota {
+public:
+  static const uint8_t  MAX_BAJADAS = 8;        // caras del server en RAM
+  static const uint16_t MAX_BYTES   = 12288;    // tope por cara (RLE + índice)
+  static const uint8_t  HASH_LEN    = 33;       // md5 hex + '\0'
+  static const uint8_t  POLL_WAIT_S = 20;
+  static const uint8_t  POLL_LOTE   = 4;
+  static const uint16_t ESPERA_PIXELES_MS = 1000;
+
+  struct Stats {
+    uint32_t comandos;
+    uint32_t aplicados;
+    uint32_t bajadas;      // caras que vinieron por la red
+    uint32_t deFlash;      // caras que ya estaban en LittleFS
+    uint32_t errores;      // incluye los comandos de una respuesta que no se pudo leer
+    uint32_t ultimaMs;     // comando -> primer cuadro, en el ESP32
+  };
+
+  CaraRemota(CaraDelta& delta, AnimadorCara& anim, const Secuencia* hablar, const Secuencia* parpadeo)
+    : delta_(delta), anim_(anim), hablar_(hablar), parpadeo_(parpadeo) {}
+
+  bool begin(const char* baseUrl, const char* deviceId, uint8_t core = 0) {
+    baseUrl_ = baseUrl;
+    deviceId_ = deviceId;
+    if (!LittleFS.begin(true)) return false;
+    if (!LittleFS.exists(DIR)) LittleFS.mkdir(DIR);
+    LittleFS.remove(TMP);
+    return xTaskCreatePinnedToCore(tareaThunk, "cara_red", 8192, this, 1, nullptr, core) == pdPASS;
+  }
+
+  Stats stats() const { return stats_; }
+  PollComandos::Stats red() const { return poll_.stats(); }
+  void medir(telemetria::Histograma* rtt, telemetria::Histograma* cara) {
+    rtt_ = rtt;
+    cara_ = cara;
+  }
+
+private:
+  static constexpr const char* DIR = "/caras";
+  static constexpr const char* TMP = "/caras/bajando.tmp";
+
+  struct Bajada {
+    char     hash[HASH_LEN];
+    uint8_t* buf;
+    CaraRLE  cara;
+    int8_t   idx;
+  };
+
+  static void tareaThunk(void* p) { ((CaraRemota*)p)->tarea(); }
+
+  void tarea() {
+    poll_.begin(baseUrl_, deviceId_, POLL_WAIT_S, POLL_LOTE);
+    for (;;) {
+      if (WiFi.status() != WL_CONNECTED) { vTaskDelay(pdMS_TO_TICKS(500)); continue; }
+      if (!poll()) vTaskDelay(pdMS_TO_TICKS(2000));
+    }
+  }
+
+  bool poll() {
+    uint32_t ms, enviados;
+    PollComandos::Resultado r = poll_.pedir(body_, sizeof(body_), ms, enviados);
+    if (r != PollComandos::COMANDOS) return r != PollComandos::ERROR_RED;
+    if (deserializeJson(doc_, body_)) {     // zero-copy sobre body_
+      stats_.errores += enviados;           // el server ya los sacó de la cola
+      return false;
+    }
+    if (rtt_) {
+      uint32_t retenido = doc_["retenido_ms"] | 0;
+      rtt_->registrar(ms > retenido ? ms - retenido : 0);
+    }
+    for (JsonObject c : doc_["comandos"].as<JsonArray>()) {
+      const char* tipo = c["tipo"] | "";
+      if (!strcmp(tipo, "cara")) aplicar(c);
+    }
+    return true;
+  }
+
+  void aplicar(JsonObject c) {
+    uint32_t t0 = millis();
+    uint32_t seq = c["seq"] | 0;
+    const char* hash = c["hash"] | "";
+    const char* nombre = c["cara"] | "";
+    const char* animacion = c["animacion"] | "";
+    bool bajada = false;
+    uint32_t pedido = 0;
+    stats_.comandos++;
+
+    if (*hash || *nombre) {
+      int8_t idx = *hash ? cargar(hash, c["url"] | "", bajada) : buscar(nombre);
+      if (idx < 0) {
+        stats_.errores++;
+        confirmar(seq, "desconocida", millis() - t0, bajada);
+        return;
+      }
+      pedido = anim_.reposo(idx);
+    }
+    if (!strcmp(animacion, "hablar"))        pedido = anim_.hablar(hablar_, c["duracion_ms"] | 0);
+    else if (!strcmp(animacion, "parpadeo")) pedido = anim_.reproducir(parpadeo_);
+    else if (!strcmp(animacion, "reposo"))   pedido = anim_.hablar(nullptr);
+
+    // Hasta que el animador dibuje el primer cuadro del pedido
+    while (pedido && (int32_t)(anim_.aplicado() - pedido) < 0 && millis() - t0 < ESPERA_PIXELES_MS) {
+      vTaskDelay(pdMS_TO_TICKS(2));
+    }
+    bool ok = pedido && (int32_t)(anim_.aplicado() - pedido) >= 0;
+    stats_.ultimaMs = millis() - t0;
+    if (cara_) cara_->registrar(stats_.ultimaMs);
+    if (ok) stats_.aplicados++; else stats_.errores++;
+    confirmar(seq, ok ? "ok" : "sin_dibujar", stats_.ultimaMs, bajada);
+  }
+
+  int8_t buscar(const char* nombre) {
+    for (uint8_t i = 0; i < delta_.count(); i++) {
+      const CaraRLE* c = delta_.cara(i);
+      if (c && c->nombre && !strcmp(c->nombre, nombre)) return i;
+    }
+    return -1;
+  }
+
+  // Cara por hash: RAM -> LittleFS -> red. Devuelve el índice en CaraDelta.
+  int8_t cargar(const char* hash, const char* url, bool& bajada) {
+    if (strlen(hash) >= HASH_LEN) return -1;
+    for (uint8_t i = 0; i < nBajadas_; i++) {
+      if (!strcmp(bajadas_[i].hash, hash)) return bajadas_[i].idx;
+    }
+    if (nBajadas_ >= MAX_BAJADAS) return -1;
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%s.rle", DIR, hash);
+    if (LittleFS.exists(path)) {
+      stats_.deFlash++;
+    } else {
+      if (!*url || !bajar(url, hash, path)) return -1;
+      bajada = true;
+      stats_.bajadas++;
+    }
+    return registrar(hash, path);
+  }
+
+  // Baja a TMP calculando el md5; solo si coincide pasa a 'path'
+  bool bajar(const char* url, const char* hash, const char* path) {
+    HTTPClient http;
+    if (!http.begin(url)) return false;
+    if (http.GET() != HTTP_CODE_OK) { http.end(); return false; }
+    int len = http.getSize();
+    if (len <= 0 || len > MAX_BYTES) { http.end(); return false; }
+    File f = LittleFS.open(TMP, "w");
+    if (!f) { http.end(); return false; }
+    MD5Builder md5;
+    md5.begin();
+    WiFiClient* s = http.getStreamPtr();
+    uint8_t chunk[512];
+    int got = 0;
+    uint32_t t0 = millis();
+    while (got < len && millis() - t0 < 5000) {
+      int n = s->readBytes(chunk, min((int)sizeof(chunk), len - got));
+      if (n <= 0) { vTaskDelay(1); continue; }
+      md5.add(chunk, n);
+      f.write(chunk, n);
+      got += n;
+    }
+    f.close();
+    http.end();
+    char calc[HASH_LEN];
+    md5.calculate();
+    md5.getChars(calc);
+    if (got != len || strcmp(calc, hash)) {
+      LittleFS.remove(TMP);
+      Serial.printf("CaraRemota: %s llegó mal (%d/%d B)\n", hash, got, len);
+      return false;
+    }
+    return LittleFS.rename(TMP, path);
+  }
+
+  // Archivo -> RAM -> CaraDelta. Cabecera: "CRL1", w, h, nIndice (uint16 LE)
+  int8_t registrar(const char* hash, const char* path) {
+    File f = LittleFS.open(path, "r");
+    if (!f) return -1;
+    size_t n = f.size();
+    if (n < 10 || n > MAX_BYTES) { f.close(); return -1; }
+    uint8_t* buf = (uint8_t*)malloc(n);      // una vez por cara, queda para siempre
+    if (!buf) { f.close(); return -1; }
+    bool leido = f.read(buf, n) == (int)n;
+    f.close();
+    uint16_t w, h, nIdx;
+    memcpy(&w, buf + 4, 2);
+    memcpy(&h, buf + 6, 2);
+    memcpy(&nIdx, buf + 8, 2);
+    if (!leido || memcmp(buf, "CRL1", 4) || 10u + 2u * nIdx > n || nIdx != (h + FILAS_INDICE - 1) / FILAS_INDICE) {
+      free(buf);
+      LittleFS.remove(path);                 // corrupta: la próxima vez se baja de nuevo
+      return -1;
+    }
+    Bajada& b = bajadas_[nBajadas_];
+    strlcpy(b.hash, hash, sizeof(b.hash));
+    b.buf = buf;
+    b.cara = { b.hash, w, h, buf + 10 + 2 * nIdx, (const uint16_t*)(buf + 10) };
+    b.idx = delta_.add(&b.cara);
+    if (b.idx < 0) { free(buf); return -1; }
+    nBajadas_++;
+    return b.idx;
+  }
+
+  void confirmar(uint32_t seq, const char* estado, uint32_t ms, bool bajada) {
+    char url[160], body[96];
+    snprintf(url, sizeof(url), "%s/esp32/cara_ok/%s", baseUrl_, deviceId_);
+    int n = snprintf(body, sizeof(body), "seq=%lu&estado=%s&ms_local=%lu&descarga=%d",
+                     (unsigned long)seq, estado, (unsigned long)ms, bajada ? 1 : 0);
+    HTTPClient http;
+    if (!http.begin(url)) return;
+    http.addHeader("Content-Type", "application/x-www-form-urlencoded");
+    http.POST((uint8_t*)body, n);
+    http.end();
+  }
+
+  CaraDelta&       delta_;
+  AnimadorCara&    anim_;
+  const Secuencia* hablar_;
+  const Secuencia* parpadeo_;
+  telemetria::Histograma* rtt_ = nullptr;
+  telemetria::Histograma* cara_ = nullptr;
+  const char*      baseUrl_ = "";
+  const char*      deviceId_ = "";
+  PollComandos     poll_;
+
+  char             body_[2048];
+  StaticJsonDocument<2048> doc_;
+
+  Bajada           bajadas_[MAX_BAJADAS];
+  uint8_t          nBajadas_ = 0;
+  Stats            stats_ = {};
+};
@@ -0,0 +1,175 @@
+/****************************************************
+ * Gestos táctiles a partir de muestras crudas
+ * - Entrada: muestras (ms, x, y, z) ya en píxeles de
+ *   pantalla; z es la presión del XPT2046
+ * - Presión con histéresis: apoya con z >= zApoyo y
+ *   sigue apoyado mientras z >= zSuelta
+ * - Soltar con anti-rebote: hace falta soltarMs sin
+ *   presión para dar el toque por terminado
+ * - Posición filtrada con mediana de las últimas 5
+ * - Emite TOQUE, LARGO (una vez, estando apoyado) y
+ *   DESLIZ con dirección
+ * - Sin Arduino: compila en host (g++) para pasarle
+ *   trazas grabadas con TactilIRQ::registrar()
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+enum TipoGesto : uint8_t { G_NINGUNO, G_TOQUE, G_LARGO, G_DESLIZ };
+enum DireccionGesto : uint8_t { D_NINGUNA, D_IZQ, D_DER, D_ARRIBA, D_ABAJO };
+
+struct MuestraTactil {
+  uint32_t ms;
+  int16_t  x, y;
+  uint16_t z;
+};
+
+struct Gesto {
+  TipoGesto      tipo;
+  DireccionGesto dir;
+  int16_t        x, y;     // donde empezó (filtrado)
+  int16_t        dx, dy;   // recorrido total
+  uint16_t       duracion; // ms apoyado
+  uint32_t       ms;       // cuándo se reconoció
+};
+
+struct ConfigGestos {
+  uint16_t zApoyo    = 400;
+  uint16_t zSuelta   = 250;
+  uint16_t soltarMs  = 40;    // sin presión este tiempo = suelto
+  uint16_t toqueMaxMs = 350;
+  uint16_t largoMs   = 600;
+  uint16_t quietoPx  = 12;    // más que esto ya no es toque ni largo
+  uint16_t deslizPx  = 40;
+  uint16_t deslizMaxMs = 800;
+};
+
+class ClasificadorGestos {
+public:
+  static const uint8_t MEDIANA = 5;
+
+  explicit ClasificadorGestos(const ConfigGestos& cfg = ConfigGestos()) : cfg_(cfg) {}
+
+  // Procesa una muestra; true si con ella se reconoció un gesto
+  bool procesar(const MuestraTactil& m, Gesto& g) {
+    bool presion = m.z >= (apoyado_ ? cfg_.zSuelta : cfg_.zApoyo);
+
+    if (!apoyado_) {
+      if (!presion) return false;
+      apoyado_ = true;
+      largo_ = false;
+      n_ = 0;
+      tApoyo_ = tUltima_ = m.ms;
+      filtrar(m);
+      x0_ = x_;
+      y0_ = y_;
+      return false;
+    }
+
+    if (presion) {
+      tUltima_ = m.ms;
+      filtrar(m);
+      if (!largo_ && m.ms - tApoyo_ >= cfg_.largoMs && quieto()) {
+        largo_ = true;
+        armar(g, G_LARGO, m.ms);
+        return true;
+      }
+      return false;
+    }
+
+    // Sin presión: recién cuenta como suelto después de soltarMs
+    if (m.ms - tUltima_ < cfg_.soltarMs) return false;
+    apoyado_ = false;
+    return alSoltar(g, m.ms);
+  }
+
+  // Hay un toque en curso (o esperando el anti-rebote de soltar)
+  bool activo() const { return apoyado_; }
+
+  void reset() { apoyado_ = false; }
+
+private:
+  bool alSoltar(Gesto& g, uint32_t ahora) {
+    if (largo_) return false;               // ya se avisó como LARGO
+    uint16_t dur = tUltima_ - tApoyo_;
+    int16_t dx = x_ - x0_, dy = y_ - y0_;
+    if ((abs(dx) >= cfg_.deslizPx || abs(dy) >= cfg_.deslizPx) && dur <= cfg_.deslizMaxMs) {
+      armar(g, G_DESLIZ, ahora);
+      if (abs(dx) >= abs(dy)) g.dir = dx > 0 ? D_DER : D_IZQ;
+      else g.dir = dy > 0 ? D_ABAJO : D_ARRIBA;
+      return true;
+    }
+    if (quieto() && dur <= cfg_.toqueMaxMs) {
+      armar(g, G_TOQUE, ahora);
+      return true;
+    }
+    return false;                           // ni toque ni desliz: se descarta
+  }
+
+  void armar(Gesto& g, TipoGesto tipo, uint32_t ahora) {
+    g.tipo = tipo;
+    g.dir = D_NINGUNA;
+    g.x = x0_;
+    g.y = y0_;
+    g.dx = x_ - x0_;
+    g.dy = y_ - y0_;
+    g.duracion = tUltima_ - tApoyo_;
+    g.ms = ahora;
+  }
+
+  bool quieto() const {
+    return abs(x_ - x0_) <= cfg_.quietoPx && abs(y_ - y0_) <= cfg_.quietoPx;
+  }
+
+  // Mediana de las últimas MEDIANA posiciones (menos mientras se llena)
+  void filtrar(const MuestraTactil& m) {
+    hx_[i_] = m.x;
+    hy_[i_] = m.y;
+    i_ = (i_ + 1) % MEDIANA;
+    if (n_ < MEDIANA) n_++;
+    x_ = mediana(hx_);
+    y_ = mediana(hy_);
+  }
+
+  int16_t mediana(const int16_t* h) const {
+    int16_t v[MEDIANA];
+    // Los n_ más recientes, terminando en i_ - 1
+    for (uint8_t k = 0; k < n_; k++) v[k] = h[(i_ + MEDIANA - 1 - k) % MEDIANA];
+    for (uint8_t a = 1; a < n_; a++) {
+      int16_t t = v[a];
+      int8_t b = a - 1;
+      while (b >= 0 && v[b] > t) { v[b + 1] = v[b]; b--; }
+      v[b + 1] = t;
+    }
+    return v[n_ / 2];
+  }
+
+  ConfigGestos cfg_;
+  bool     apoyado_ = false;
+  bool     largo_ = false;
+  uint32_t tApoyo_ = 0, tUltima_ = 0;
+  int16_t  x0_ = 0, y0_ = 0, x_ = 0, y_ = 0;
+  int16_t  hx_[MEDIANA], hy_[MEDIANA];
+  uint8_t  i_ = 0, n_ = 0;
+};
+
+inline const char* nombreGesto(TipoGesto t) {
+  switch (t) {
+    case G_TOQUE:  return "toque";
+    case G_LARGO:  return "largo";
+    case G_DESLIZ: return "desliz";
+    default:       return "-";
+  }
+}
+
+inline const char* nombreDireccion(DireccionGesto d) {
+  switch (d) {
+    case D_IZQ:    return "izq";
+    case D_DER:    return "der";
+    case D_ARRIBA: return "arriba";
+    case D_ABAJO:  return "abajo";
+    default:       return "-";
+  }
+}
@@ -0,0 +1,148 @@
+/****************************************************
+ * Touch XPT2046 por interrupción (ESP32)
+ * - PENIRQ (activo en bajo) despierta una tarea; sin
+ *   dedo no se toca el bus SPI
+ * - Mientras hay toque se muestrea a periodo fijo
+ *   (vTaskDelayUntil), se mapea a píxeles y se pasa
+ *   por ClasificadorGestos (Gestos.h)
+ * - Los gestos salen por una cola: loop(), pantalla y
+ *   red los leen sin esperar nunca al touch
+ * - Sin pin de IRQ (-1) cae a sondeo lento desde la
+ *   misma tarea
+ * - Con usarBus() cada lectura toma el bus SPI
+ *   compartido (BusSPI.h): el TFT se lo cede entre
+ *   tramos, así que no espera un redibujado entero
+ * - medir(h): latencia IRQ -> primera muestra (us) a un
+ *   histograma de Telemetria.h
+ * - registrar(true) imprime cada muestra por Serial
+ *   ("T,ms,x,y,z") para grabar trazas y probar los
+ *   gestos en host
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <XPT2046_Touchscreen.h>
+#include "Gestos.h"
+#include "BusSPI.h"
+#include <Telemetria.h>
+
+// Tarea a despertar desde la ISR (un solo touch por placa) y cuándo fue
+static TaskHandle_t tactilTarea = nullptr;
+static volatile uint32_t tactilIrqUs = 0;
+
+struct CalTactil {
+  int16_t minX, minY, maxX, maxY;   // crudo del XPT2046
+  int16_t w, h;                     // pantalla
+};
+
+class TactilIRQ {
+public:
+  static const uint8_t  PERIODO_MS = 10;     // muestreo con dedo apoyado
+  static const uint8_t  SONDEO_MS  = 30;     // sin pin de IRQ
+  static const uint8_t  COLA       = 8;
+
+  struct Stats {
+    uint32_t despertares;
+    uint32_t muestras;
+    uint32_t gestos;
+    uint32_t perdidos;    // cola llena
+    uint32_t lecturaMaxUs;    // getPoint() con la espera del bus
+    uint32_t latenciaMaxUs;   // IRQ -> primera muestra leída
+  };
+
+  TactilIRQ(XPT2046_Touchscreen& ts, int8_t pinIrq, const CalTactil& cal,
+            const ConfigGestos& cfg = ConfigGestos())
+    : ts_(ts), pin_(pinIrq), cal_(cal), clasif_(cfg) {}
+
+  bool begin(uint8_t core = 1, UBaseType_t prio = 3) {
+    cola_ = xQueueCreate(COLA, sizeof(Gesto));
+    if (!cola_) return false;
+    if (xTaskCreatePinnedToCore(tareaThunk, "tactil", 3072, this, prio, &tarea_, core) != pdPASS) return false;
+    if (pin_ >= 0) {
+      tactilTarea = tarea_;
+      pinMode(pin_, INPUT_PULLUP);
+      attachInterrupt(digitalPinToInterrupt(pin_), isr, FALLING);
+    }
+    return true;
+  }
+
+  // Próximo gesto, sin esperar
+  bool leer(Gesto& g) { return cola_ && xQueueReceive(cola_, &g, 0) == pdTRUE; }
+
+  void usarBus(BusSPI* bus) { bus_ = bus; }
+  void medir(telemetria::Histograma* latencia) { latencia_ = latencia; }
+  void registrar(bool on) { registrar_ = on; }
+  Stats stats() const { return stats_; }
+
+private:
+  static void IRAM_ATTR isr() {
+    BaseType_t woken = pdFALSE;
+    tactilIrqUs = micros();
+    if (tactilTarea) vTaskNotifyGiveFromISR(tactilTarea, &woken);
+    if (woken) portYIELD_FROM_ISR();
+  }
+
+  static void tareaThunk(void* p) { ((TactilIRQ*)p)->tarea(); }
+
+  bool apoyadoIrq() const { return pin_ >= 0 && digitalRead(pin_) == LOW; }
+
+  void tarea() {
+    const TickType_t periodo = pdMS_TO_TICKS(PERIODO_MS);
+    for (;;) {
+      // Sin IRQ: despierta cada SONDEO_MS y mira igual
+      ulTaskNotifyTake(pdTRUE, pin_ >= 0 ? portMAX_DELAY : pdMS_TO_TICKS(SONDEO_MS));
+      stats_.despertares++;
+
+      TickType_t ultimo = xTaskGetTickCount();
+      muestrear();
+      if (pin_ >= 0) {
+        uint32_t lat = micros() - tactilIrqUs;
+        if (lat > stats_.latenciaMaxUs) stats_.latenciaMaxUs = lat;
+        if (latencia_) latencia_->registrar(lat);
+      }
+      vTaskDelayUntil(&ultimo, periodo);
+      while (clasif_.activo() || apoyadoIrq()) {
+        muestrear();
+        vTaskDelayUntil(&ultimo, periodo);
+      }
+
+      // Las lecturas SPI hacen saltar PENIRQ: esas notificaciones no valen
+      ulTaskNotifyTake(pdTRUE, 0);
+    }
+  }
+
+  void muestrear() {
+    uint32_t t0 = micros();
+    TS_Point p;
+    {
+      UsoBus uso(bus_, BusSPI::TACTIL);
+      p = ts_.getPoint();
+    }
+    uint32_t us = micros() - t0;
+    if (us > stats_.lecturaMaxUs) stats_.lecturaMaxUs = us;
+    MuestraTactil m;
+    m.ms = millis();
+    m.x = constrain(map(p.x, cal_.minX, cal_.maxX, 0, cal_.w - 1), 0L, (long)cal_.w - 1);
+    m.y = constrain(map(p.y, cal_.minY, cal_.maxY, 0, cal_.h - 1), 0L, (long)cal_.h - 1);
+    m.z = p.z > 0 ? p.z : 0;
+    stats_.muestras++;
+    if (registrar_) Serial.printf("T,%lu,%d,%d,%u\n", (unsigned long)m.ms, m.x, m.y, m.z);
+
+    Gesto g;
+    if (clasif_.procesar(m, g)) {
+      stats_.gestos++;
+      if (xQueueSend(cola_, &g, 0) != pdTRUE) stats_.perdidos++;
+    }
+  }
+
+  XPT2046_Touchscreen& ts_;
+  int8_t             pin_;
+  CalTactil          cal_;
+  ClasificadorGestos clasif_;
+  QueueHandle_t      cola_ = nullptr;
+  TaskHandle_t       tarea_ = nullptr;
+  BusSPI*            bus_ = nullptr;
+  telemetria::Histograma* latencia_ = nullptr;
+  volatile bool      registrar_ = false;
+  Stats              stats_ = {};
+};
@@ -0,0 +1,248 @@
+// Generado por herramientas/compilar_caras.py: no editar a mano.
+// 2 caras de 240x320, 3632 bytes en flash
+#pragma once
+
+#include "CaraRLE.h"
+
+static const uint8_t CARAS_DATOS[3552] PROGMEM = {
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x79, 0x07, 0x70, 0x6f, 0x1c, 0x65, 0x6c, 0x21, 0x63, 0x67, 0x2b, 0x5e, 0x64, 0x31, 0x5b, 0x62,
+  0x35, 0x59, 0x5f, 0x3b, 0x56, 0x5d, 0x3f, 0x54, 0x5b, 0x43, 0x52, 0x59, 0x47, 0x50, 0x57, 0x4b,
+  0x4e, 0x55, 0x1f, 0x11, 0x1f, 0x4c, 0x54, 0x1d, 0x17, 0x1d, 0x4b, 0x52, 0x19, 0x24, 0x18, 0x49,
+  0x51, 0x17, 0x29, 0x17, 0x48, 0x50, 0x16, 0x2e, 0x15, 0x47, 0x4e, 0x14, 0x35, 0x14, 0x45, 0x4d,
+  0x13, 0x39, 0x13, 0x44, 0x4b, 0x13, 0x3d, 0x13, 0x42, 0x4a, 0x12, 0x41, 0x12, 0x41, 0x49, 0x12,
+  0x43, 0x12, 0x40, 0x48, 0x11, 0x48, 0x10, 0x3f, 0x47, 0x10, 0x4b, 0x10, 0x3e, 0x46, 0x10, 0x4e,
+  0x0f, 0x3d, 0x45, 0x0f, 0x51, 0x10, 0x3b, 0x44, 0x0f, 0x53, 0x0f, 0x3b, 0x43, 0x0f, 0x56, 0x0e,
+  0x3a, 0x42, 0x0e, 0x59, 0x0e, 0x39, 0x41, 0x0e, 0x5b, 0x0e, 0x38, 0x40, 0x0e, 0x5d, 0x0e, 0x37,
+  0x3f, 0x0e, 0x5f, 0x0e, 0x36, 0x3e, 0x0d, 0x62, 0x0e, 0x35, 0x3d, 0x0e, 0x63, 0x0e, 0x34, 0x3d,
+  0x0d, 0x66, 0x0d, 0x33, 0x3c, 0x0d, 0x68, 0x0c, 0x33, 0x3b, 0x0d, 0x69, 0x0d, 0x32, 0x3a, 0x0d,
+  0x6c, 0x0c, 0x31, 0x39, 0x0d, 0x6d, 0x0d, 0x30, 0x39, 0x0c, 0x6f, 0x0c, 0x30, 0x38, 0x0c, 0x71,
+  0x0c, 0x2f, 0x37, 0x0c, 0x73, 0x0c, 0x2e, 0x37, 0x0b, 0x75, 0x0c, 0x2d, 0x36, 0x0b, 0x76, 0x0c,
+  0x2d, 0x35, 0x0c, 0x77, 0x0c, 0x2c, 0x35, 0x0b, 0x79, 0x0b, 0x2c, 0x34, 0x0b, 0x7b, 0x0b, 0x2b,
+  0x34, 0x0b, 0x7c, 0x0b, 0x2a, 0x33, 0x0b, 0x7d, 0x0b, 0x2a, 0x32, 0x0b, 0x7f, 0x0b, 0x29, 0x32,
+  0x0b, 0x80, 0x80, 0x0a, 0x29, 0x31, 0x0b, 0x80, 0x81, 0x0b, 0x28, 0x31, 0x0a, 0x80, 0x83, 0x0b,
+  0x27, 0x30, 0x0b, 0x80, 0x84, 0x0a, 0x27, 0x2f, 0x0b, 0x80, 0x85, 0x0b, 0x26, 0x2f, 0x0a, 0x80,
+  0x87, 0x0a, 0x26, 0x2f, 0x0a, 0x80, 0x87, 0x0b, 0x25, 0x2e, 0x0a, 0x80, 0x89, 0x0a, 0x25, 0x2d,
+  0x0b, 0x80, 0x89, 0x0b, 0x24, 0x2d, 0x0a, 0x80, 0x8b, 0x0a, 0x24, 0x2d, 0x0a, 0x80, 0x8c, 0x09,
+  0x24, 0x2c, 0x0a, 0x2c, 0x02, 0x30, 0x03, 0x2c, 0x0a, 0x23, 0x2c, 0x0a, 0x2a, 0x07, 0x2b, 0x07,
+  0x2a, 0x0a, 0x23, 0x2b, 0x0a, 0x2a, 0x09, 0x29, 0x0a, 0x29, 0x0a, 0x22, 0x2b, 0x0a, 0x29, 0x0b,
+  0x27, 0x0b, 0x2a, 0x09, 0x22, 0x2b, 0x09, 0x29, 0x0d, 0x25, 0x0d, 0x29, 0x0a, 0x21, 0x2a, 0x0a,
+  0x28, 0x0f, 0x23, 0x0f, 0x28, 0x0a, 0x21, 0x2a, 0x09, 0x29, 0x0f, 0x23, 0x0f, 0x29, 0x09, 0x21,
+  0x29, 0x0a, 0x28, 0x11, 0x21, 0x11, 0x28, 0x0a, 0x20, 0x29, 0x0a, 0x28, 0x11, 0x21, 0x11, 0x29,
+  0x09, 0x20, 0x29, 0x09, 0x28, 0x13, 0x1f, 0x13, 0x28, 0x0a, 0x1f, 0x28, 0x0a, 0x28, 0x13, 0x1f,
+  0x13, 0x28, 0x0a, 0x1f, 0x28, 0x09, 0x29, 0x14, 0x1e, 0x13, 0x29, 0x09, 0x1f, 0x28, 0x09, 0x28,
+  0x15, 0x1e, 0x14, 0x28, 0x0a, 0x1e, 0x27, 0x0a, 0x28, 0x15, 0x1d, 0x15, 0x29, 0x09, 0x1e, 0x27,
+  0x09, 0x29, 0x15, 0x1d, 0x15, 0x29, 0x09, 0x1e, 0x27, 0x09, 0x29, 0x15, 0x1d, 0x16, 0x28, 0x09,
+  0x1e, 0x26, 0x09, 0x2a, 0x15, 0x1c, 0x17, 0x29, 0x09, 0x1d, 0x26, 0x09, 0x2a, 0x16, 0x1b, 0x17,
+  0x29, 0x09, 0x1d, 0x26, 0x09, 0x29, 0x17, 0x1b, 0x17, 0x2a, 0x08, 0x1d, 0x26, 0x09, 0x29, 0x17,
+  0x1b, 0x17, 0x2a, 0x09, 0x1c, 0x25, 0x09, 0x2a, 0x17, 0x1b, 0x17, 0x2a, 0x09, 0x1c, 0x25, 0x09,
+  0x2a, 0x17, 0x1b, 0x17, 0x2a, 0x09, 0x1c, 0x25, 0x08, 0x2b, 0x17, 0x1b, 0x17, 0x2a, 0x09, 0x1c,
+  0x24, 0x09, 0x2b, 0x17, 0x1b, 0x17, 0x2b, 0x09, 0x1b, 0x24, 0x09, 0x2b, 0x17, 0x1b, 0x17, 0x2b,
+  0x09, 0x1b, 0x24, 0x09, 0x2b, 0x17, 0x1b, 0x17, 0x2b, 0x09, 0x1b, 0x24, 0x09, 0x2b, 0x17, 0x1b,
+  0x17, 0x2c, 0x08, 0x1b, 0x24, 0x08, 0x2c, 0x17, 0x1b, 0x17, 0x2c, 0x09, 0x1a, 0x23, 0x09, 0x2c,
+  0x17, 0x1b, 0x17, 0x2c, 0x09, 0x1a, 0x23, 0x09, 0x2d, 0x16, 0x1b, 0x17, 0x2c, 0x09, 0x1a, 0x23,
+  0x09, 0x2d, 0x15, 0x1c, 0x17, 0x2d, 0x08, 0x1a, 0x23, 0x08, 0x2e, 0x15, 0x1d, 0x16, 0x2d, 0x08,
+  0x1a, 0x22, 0x09, 0x2e, 0x15, 0x1d, 0x15, 0x2e, 0x09, 0x19, 0x22, 0x09, 0x2e, 0x15, 0x1d, 0x15,
+  0x2e, 0x09, 0x19, 0x22, 0x09, 0x2e, 0x15, 0x1e, 0x14, 0x2e, 0x09, 0x19, 0x22, 0x09, 0x2f, 0x14,
+  0x1e, 0x13, 0x30, 0x08, 0x19, 0x22, 0x09, 0x2f, 0x13, 0x1f, 0x13, 0x30, 0x08, 0x19, 0x22, 0x08,
+  0x30, 0x13, 0x1f, 0x13, 0x30, 0x09, 0x18, 0x22, 0x08, 0x31, 0x11, 0x21, 0x11, 0x31, 0x09, 0x18,
+  0x21, 0x09, 0x31, 0x11, 0x21, 0x11, 0x31, 0x09, 0x18, 0x21, 0x09, 0x32, 0x0f, 0x23, 0x0f, 0x32,
+  0x09, 0x18, 0x21, 0x09, 0x32, 0x0f, 0x23, 0x0f, 0x32, 0x09, 0x18, 0x21, 0x08, 0x34, 0x0d, 0x25,
+  0x0d, 0x34, 0x08, 0x18, 0x21, 0x08, 0x35, 0x0b, 0x27, 0x0b, 0x35, 0x08, 0x18, 0x21, 0x08, 0x36,
+  0x09, 0x29, 0x0a, 0x35, 0x08, 0x18, 0x21, 0x08, 0x38, 0x06, 0x2b, 0x07, 0x37, 0x08, 0x18, 0x21,
+  0x08, 0x39, 0x03, 0x2f, 0x03, 0x39, 0x08, 0x18, 0x21, 0x08, 0x80, 0xa7, 0x09, 0x17, 0x20, 0x09,
+  0x80, 0xa7, 0x09, 0x17, 0x20, 0x09, 0x80, 0xa7, 0x09, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17,
+  0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8,
+  0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09,
+  0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17,
+  0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8,
+  0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09,
+  0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17,
+  0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa8, 0x08, 0x17, 0x20, 0x09, 0x80, 0xa7,
+  0x09, 0x17, 0x20, 0x09, 0x80, 0xa7, 0x09, 0x17, 0x21, 0x08, 0x80, 0xa7, 0x09, 0x17, 0x21, 0x08,
+  0x80, 0xa7, 0x09, 0x17, 0x21, 0x08, 0x80, 0xa7, 0x08, 0x18, 0x21, 0x08, 0x80, 0xa7, 0x08, 0x18,
+  0x21, 0x08, 0x80, 0xa7, 0x08, 0x18, 0x21, 0x08, 0x80, 0xa7, 0x08, 0x18, 0x21, 0x09, 0x80, 0xa6,
+  0x08, 0x18, 0x21, 0x09, 0x80, 0xa5, 0x09, 0x18, 0x21, 0x09, 0x80, 0xa5, 0x09, 0x18, 0x22, 0x08,
+  0x23, 0x04, 0x57, 0x05, 0x22, 0x09, 0x18, 0x22, 0x08, 0x22, 0x06, 0x55, 0x06, 0x22, 0x09, 0x18,
+  0x22, 0x08, 0x21, 0x08, 0x53, 0x08, 0x21, 0x08, 0x19, 0x22, 0x09, 0x20, 0x08, 0x53, 0x09, 0x20,
+  0x08, 0x19, 0x22, 0x09, 0x20, 0x08, 0x52, 0x0a, 0x20, 0x08, 0x19, 0x22, 0x09, 0x20, 0x09, 0x51,
+  0x0a, 0x1f, 0x09, 0x19, 0x22, 0x09, 0x20, 0x09, 0x51, 0x0a, 0x1f, 0x09, 0x19, 0x23, 0x08, 0x20,
+  0x09, 0x51, 0x0a, 0x1f, 0x09, 0x19, 0x23, 0x08, 0x20, 0x0a, 0x50, 0x09, 0x20, 0x08, 0x1a, 0x23,
+  0x09, 0x1f, 0x0a, 0x4f, 0x0a, 0x1f, 0x09, 0x1a, 0x23, 0x09, 0x1f, 0x0a, 0x4f, 0x0a, 0x1f, 0x09,
+  0x1a, 0x23, 0x09, 0x20, 0x0a, 0x4d, 0x0a, 0x20, 0x09, 0x1a, 0x24, 0x09, 0x1f, 0x0a, 0x4d, 0x0a,
+  0x20, 0x09, 0x1a, 0x24, 0x09, 0x1f, 0x0b, 0x4c, 0x0a, 0x20, 0x08, 0x1b, 0x24, 0x09, 0x20, 0x0a,
+  0x4b, 0x0b, 0x1f, 0x09, 0x1b, 0x24, 0x09, 0x20, 0x0a, 0x4b, 0x0a, 0x20, 0x09, 0x1b, 0x25, 0x08,
+  0x20, 0x0b, 0x49, 0x0b, 0x20, 0x09, 0x1b, 0x25, 0x09, 0x20, 0x0a, 0x49, 0x0a, 0x20, 0x09, 0x1c,
+  0x25, 0x09, 0x20, 0x0b, 0x47, 0x0b, 0x20, 0x09, 0x1c, 0x25, 0x09, 0x21, 0x0a, 0x47, 0x0b, 0x20,
+  0x09, 0x1c, 0x26, 0x09, 0x20, 0x0b, 0x45, 0x0b, 0x21, 0x09, 0x1c, 0x26, 0x09, 0x20, 0x0b, 0x45,
+  0x0b, 0x20, 0x09, 0x1d, 0x26, 0x09, 0x21, 0x0b, 0x43, 0x0b, 0x21, 0x09, 0x1d, 0x27, 0x09, 0x20,
+  0x0c, 0x42, 0x0b, 0x20, 0x0a, 0x1d, 0x27, 0x09, 0x21, 0x0b, 0x41, 0x0c, 0x20, 0x09, 0x1e, 0x27,
+  0x09, 0x21, 0x0c, 0x3f, 0x0c, 0x21, 0x09, 0x1e, 0x27, 0x0a, 0x21, 0x0c, 0x3d, 0x0c, 0x22, 0x09,
+  0x1e, 0x28, 0x09, 0x22, 0x0c, 0x3c, 0x0c, 0x21, 0x09, 0x1f, 0x28, 0x09, 0x22, 0x0c, 0x3b, 0x0c,
+  0x22, 0x09, 0x1f, 0x28, 0x0a, 0x21, 0x0d, 0x39, 0x0c, 0x22, 0x0a, 0x1f, 0x29, 0x09, 0x22, 0x0d,
+  0x37, 0x0d, 0x22, 0x09, 0x20, 0x29, 0x0a, 0x22, 0x0d, 0x35, 0x0d, 0x23, 0x09, 0x20, 0x29, 0x0a,
+  0x22, 0x0e, 0x33, 0x0e, 0x22, 0x0a, 0x20, 0x2a, 0x0a, 0x22, 0x0e, 0x31, 0x0e, 0x22, 0x0a, 0x21,
+  0x2a, 0x0a, 0x23, 0x0e, 0x2f, 0x0e, 0x23, 0x0a, 0x21, 0x2b, 0x0a, 0x23, 0x0e, 0x2d, 0x0e, 0x24,
+  0x09, 0x22, 0x2b, 0x0a, 0x24, 0x0f, 0x29, 0x10, 0x23, 0x0a, 0x22, 0x2c, 0x09, 0x24, 0x10, 0x27,
+  0x10, 0x24, 0x0a, 0x22, 0x2c, 0x0a, 0x24, 0x11, 0x23, 0x11, 0x24, 0x0a, 0x23, 0x2d, 0x09, 0x25,
+  0x12, 0x1f, 0x12, 0x25, 0x0a, 0x23, 0x2d, 0x0a, 0x25, 0x13, 0x1b, 0x13, 0x25, 0x0a, 0x24, 0x2d,
+  0x0a, 0x26, 0x15, 0x15, 0x15, 0x26, 0x0a, 0x24, 0x2e, 0x0a, 0x26, 0x17, 0x0f, 0x17, 0x26, 0x0a,
+  0x25, 0x2e, 0x0b, 0x27, 0x3a, 0x27, 0x0a, 0x25, 0x2f, 0x0a, 0x28, 0x37, 0x28, 0x0a, 0x26, 0x2f,
+  0x0b, 0x27, 0x37, 0x27, 0x0b, 0x26, 0x30, 0x0a, 0x29, 0x33, 0x29, 0x0a, 0x27, 0x30, 0x0b, 0x29,
+  0x31, 0x29, 0x0b, 0x27, 0x31, 0x0b, 0x2a, 0x2d, 0x2b, 0x0a, 0x28, 0x31, 0x0b, 0x2c, 0x29, 0x2c,
+  0x0b, 0x28, 0x32, 0x0b, 0x2c, 0x27, 0x2c, 0x0b, 0x29, 0x33, 0x0b, 0x2e, 0x21, 0x2f, 0x0b, 0x29,
+  0x33, 0x0b, 0x30, 0x1d, 0x30, 0x0b, 0x2a, 0x34, 0x0b, 0x32, 0x16, 0x33, 0x0b, 0x2b, 0x35, 0x0b,
+  0x37, 0x0b, 0x37, 0x0c, 0x2b, 0x35, 0x0b, 0x79, 0x0b, 0x2c, 0x36, 0x0b, 0x77, 0x0b, 0x2d, 0x36,
+  0x0c, 0x75, 0x0c, 0x2d, 0x37, 0x0c, 0x74, 0x0b, 0x2e, 0x38, 0x0c, 0x71, 0x0c, 0x2f, 0x38, 0x0c,
+  0x71, 0x0c, 0x2f, 0x39, 0x0c, 0x6f, 0x0c, 0x30, 0x3a, 0x0c, 0x6d, 0x0c, 0x31, 0x3b, 0x0c, 0x6b,
+  0x0d, 0x31, 0x3b, 0x0d, 0x69, 0x0d, 0x32, 0x3c, 0x0d, 0x67, 0x0d, 0x33, 0x3d, 0x0d, 0x65, 0x0d,
+  0x34, 0x3e, 0x0d, 0x63, 0x0d, 0x35, 0x3f, 0x0d, 0x61, 0x0e, 0x35, 0x3f, 0x0e, 0x5f, 0x0e, 0x36,
+  0x40, 0x0e, 0x5d, 0x0e, 0x37, 0x41, 0x0f, 0x5a, 0x0e, 0x38, 0x42, 0x0f, 0x57, 0x0f, 0x39, 0x43,
+  0x0f, 0x55, 0x0f, 0x3a, 0x44, 0x10, 0x51, 0x10, 0x3b, 0x45, 0x10, 0x4f, 0x10, 0x3c, 0x46, 0x10,
+  0x4d, 0x10, 0x3d, 0x48, 0x10, 0x49, 0x11, 0x3e, 0x48, 0x11, 0x47, 0x11, 0x3f, 0x4a, 0x11, 0x43,
+  0x11, 0x41, 0x4b, 0x12, 0x3f, 0x12, 0x42, 0x4c, 0x13, 0x3b, 0x13, 0x43, 0x4d, 0x15, 0x35, 0x15,
+  0x44, 0x4f, 0x15, 0x32, 0x15, 0x45, 0x50, 0x17, 0x2b, 0x17, 0x47, 0x51, 0x18, 0x27, 0x18, 0x48,
+  0x53, 0x19, 0x21, 0x19, 0x4a, 0x55, 0x1e, 0x13, 0x1e, 0x4c, 0x56, 0x4d, 0x4d, 0x58, 0x49, 0x4f,
+  0x5a, 0x45, 0x51, 0x5c, 0x42, 0x52, 0x5e, 0x3d, 0x55, 0x60, 0x39, 0x57, 0x63, 0x33, 0x5a, 0x66,
+  0x2d, 0x5d, 0x68, 0x29, 0x5f, 0x6e, 0x1d, 0x65, 0x72, 0x15, 0x69, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80,
+  0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x6f, 0x11, 0x70, 0x68, 0x1f, 0x69, 0x65,
+  0x25, 0x66, 0x61, 0x2e, 0x61, 0x5e, 0x33, 0x5f, 0x5c, 0x37, 0x5d, 0x58, 0x3f, 0x59, 0x57, 0x41,
+  0x58, 0x55, 0x45, 0x56, 0x53, 0x4a, 0x53, 0x51, 0x4d, 0x52, 0x4f, 0x51, 0x50, 0x4e, 0x1e, 0x16,
+  0x1f, 0x4f, 0x4c, 0x1d, 0x1d, 0x1d, 0x4d, 0x4b, 0x19, 0x27, 0x1a, 0x4b, 0x49, 0x18, 0x2d, 0x18,
+  0x4a, 0x48, 0x17, 0x31, 0x17, 0x49, 0x46, 0x16, 0x37, 0x16, 0x47, 0x45, 0x15, 0x3b, 0x15, 0x46,
+  0x44, 0x14, 0x3f, 0x14, 0x45, 0x43, 0x13, 0x43, 0x13, 0x44, 0x42, 0x12, 0x47, 0x12, 0x43, 0x41,
+  0x12, 0x4a, 0x11, 0x42, 0x40, 0x11, 0x4d, 0x12, 0x40, 0x3f, 0x11, 0x4f, 0x11, 0x40, 0x3d, 0x11,
+  0x53, 0x11, 0x3e, 0x3c, 0x11, 0x55, 0x10, 0x3e, 0x3c, 0x10, 0x58, 0x0f, 0x3d, 0x3a, 0x10, 0x5b,
+  0x10, 0x3b, 0x3a, 0x0f, 0x5d, 0x0f, 0x3b, 0x39, 0x0f, 0x5f, 0x0f, 0x3a, 0x38, 0x0e, 0x63, 0x0e,
+  0x39, 0x37, 0x0f, 0x64, 0x0e, 0x38, 0x36, 0x0e, 0x67, 0x0e, 0x37, 0x35, 0x0e, 0x69, 0x0e, 0x36,
+  0x35, 0x0d, 0x6b, 0x0d, 0x36, 0x34, 0x0d, 0x6d, 0x0d, 0x35, 0x33, 0x0d, 0x6f, 0x0d, 0x34, 0x32,
+  0x0e, 0x70, 0x0d, 0x33, 0x32, 0x0c, 0x73, 0x0d, 0x32, 0x31, 0x0d, 0x73, 0x0d, 0x32, 0x30, 0x0d,
+  0x75, 0x0d, 0x31, 0x2f, 0x0d, 0x77, 0x0d, 0x30, 0x2f, 0x0c, 0x79, 0x0c, 0x30, 0x2e, 0x0c, 0x7b,
+  0x0c, 0x2f, 0x2d, 0x0d, 0x7c, 0x0c, 0x2e, 0x2d, 0x0c, 0x7d, 0x0c, 0x2e, 0x2c, 0x0c, 0x7f, 0x0c,
+  0x2d, 0x2c, 0x0b, 0x80, 0x81, 0x0c, 0x2c, 0x2b, 0x0c, 0x80, 0x81, 0x0c, 0x2c, 0x2a, 0x0c, 0x80,
+  0x83, 0x0c, 0x2b, 0x2a, 0x0b, 0x80, 0x85, 0x0b, 0x2b, 0x29, 0x0c, 0x80, 0x85, 0x0c, 0x2a, 0x29,
+  0x0b, 0x80, 0x87, 0x0b, 0x2a, 0x28, 0x0b, 0x80, 0x89, 0x0b, 0x29, 0x28, 0x0b, 0x80, 0x89, 0x0b,
+  0x29, 0x27, 0x0b, 0x80, 0x8b, 0x0b, 0x28, 0x27, 0x0b, 0x80, 0x8b, 0x0b, 0x28, 0x26, 0x0b, 0x80,
+  0x8d, 0x0b, 0x27, 0x26, 0x0a, 0x80, 0x8f, 0x0a, 0x27, 0x25, 0x0b, 0x80, 0x8f, 0x0b, 0x26, 0x25,
+  0x0a, 0x80, 0x91, 0x0a, 0x26, 0x24, 0x0b, 0x80, 0x91, 0x0b, 0x25, 0x24, 0x0a, 0x80, 0x93, 0x0a,
+  0x25, 0x23, 0x0b, 0x80, 0x93, 0x0b, 0x24, 0x23, 0x0a, 0x2e, 0x04, 0x31, 0x04, 0x2e, 0x0a, 0x24,
+  0x23, 0x0a, 0x2d, 0x07, 0x2d, 0x08, 0x2c, 0x0b, 0x23, 0x22, 0x0a, 0x2c, 0x0b, 0x2a, 0x0a, 0x2c,
+  0x0a, 0x23, 0x22, 0x0a, 0x2b, 0x0c, 0x29, 0x0c, 0x2b, 0x0a, 0x23, 0x21, 0x0a, 0x2b, 0x0e, 0x27,
+  0x0e, 0x2b, 0x0a, 0x22, 0x21, 0x0a, 0x2b, 0x0f, 0x25, 0x0f, 0x2b, 0x0a, 0x22, 0x21, 0x0a, 0x2a,
+  0x10, 0x25, 0x10, 0x2a, 0x0b, 0x21, 0x20, 0x0a, 0x2b, 0x11, 0x23, 0x12, 0x2a, 0x0a, 0x21, 0x20,
+  0x0a, 0x2a, 0x12, 0x23, 0x12, 0x2a, 0x0a, 0x21, 0x1f, 0x0a, 0x2b, 0x13, 0x21, 0x13, 0x2b, 0x0a,
+  0x20, 0x1f, 0x0a, 0x2a, 0x14, 0x21, 0x14, 0x2a, 0x0a, 0x20, 0x1f, 0x0a, 0x2a, 0x14, 0x21, 0x14,
+  0x2b, 0x09, 0x20, 0x1f, 0x09, 0x2b, 0x15, 0x1f, 0x15, 0x2b, 0x0a, 0x1f, 0x1e, 0x0a, 0x2b, 0x15,
+  0x1f, 0x16, 0x2a, 0x0a, 0x1f, 0x1e, 0x09, 0x2b, 0x16, 0x1f, 0x16, 0x2a, 0x0a, 0x1f, 0x1d, 0x0a,
+  0x2b, 0x16, 0x1f, 0x16, 0x2b, 0x09, 0x1f, 0x1d, 0x0a, 0x2b, 0x17, 0x1e, 0x16, 0x2b, 0x0a, 0x1e,
+  0x1d, 0x0a, 0x2b, 0x17, 0x1d, 0x17, 0x2c, 0x09, 0x1e, 0x1d, 0x09, 0x2b, 0x18, 0x1d, 0x17, 0x2c,
+  0x0a, 0x1d, 0x1c, 0x0a, 0x2b, 0x18, 0x1d, 0x18, 0x2b, 0x0a, 0x1d, 0x1c, 0x09, 0x2c, 0x18, 0x1d,
+  0x18, 0x2b, 0x0a, 0x1d, 0x1c, 0x09, 0x2c, 0x18, 0x1d, 0x18, 0x2c, 0x09, 0x1d, 0x1b, 0x0a, 0x2c,
+  0x18, 0x1d, 0x18, 0x2c, 0x09, 0x1d, 0x1b, 0x0a, 0x2c, 0x18, 0x1d, 0x18, 0x2d, 0x09, 0x1c, 0x1b,
+  0x09, 0x2d, 0x18, 0x1d, 0x18, 0x2d, 0x09, 0x1c, 0x1b, 0x09, 0x2d, 0x18, 0x1d, 0x18, 0x2d, 0x09,
+  0x1c, 0x1b, 0x09, 0x2d, 0x18, 0x1d, 0x18, 0x2d, 0x0a, 0x1b, 0x1a, 0x09, 0x2e, 0x18, 0x1d, 0x18,
+  0x2d, 0x0a, 0x1b, 0x1a, 0x09, 0x2e, 0x18, 0x1d, 0x18, 0x2e, 0x09, 0x1b, 0x1a, 0x09, 0x2e, 0x18,
+  0x1d, 0x18, 0x2e, 0x09, 0x1b, 0x19, 0x0a, 0x2e, 0x18, 0x1d, 0x18, 0x2e, 0x09, 0x1b, 0x19, 0x0a,
+  0x2e, 0x18, 0x1d, 0x17, 0x30, 0x08, 0x1b, 0x19, 0x0a, 0x2e, 0x18, 0x1d, 0x17, 0x30, 0x09, 0x1a,
+  0x19, 0x09, 0x30, 0x17, 0x1d, 0x17, 0x30, 0x09, 0x1a, 0x19, 0x09, 0x30, 0x17, 0x1e, 0x16, 0x30,
+  0x09, 0x1a, 0x19, 0x09, 0x30, 0x16, 0x1f, 0x16, 0x30, 0x09, 0x1a, 0x19, 0x08, 0x31, 0x16, 0x1f,
+  0x16, 0x30, 0x0a, 0x19, 0x18, 0x09, 0x32, 0x15, 0x1f, 0x16, 0x30, 0x0a, 0x19, 0x18, 0x09, 0x32,
+  0x14, 0x21, 0x14, 0x32, 0x09, 0x19, 0x18, 0x09, 0x32, 0x14, 0x21, 0x14, 0x32, 0x09, 0x19, 0x18,
+  0x09, 0x32, 0x14, 0x21, 0x13, 0x33, 0x09, 0x19, 0x18, 0x09, 0x33, 0x13, 0x22, 0x12, 0x33, 0x09,
+  0x19, 0x18, 0x09, 0x33, 0x12, 0x23, 0x12, 0x34, 0x08, 0x19, 0x17, 0x0a, 0x34, 0x10, 0x25, 0x10,
+  0x35, 0x08, 0x19, 0x17, 0x09, 0x35, 0x10, 0x25, 0x10, 0x35, 0x09, 0x18, 0x17, 0x09, 0x36, 0x0e,
+  0x27, 0x0e, 0x36, 0x09, 0x18, 0x17, 0x09, 0x37, 0x0d, 0x28, 0x0c, 0x37, 0x09, 0x18, 0x17, 0x09,
+  0x37, 0x0c, 0x29, 0x0b, 0x38, 0x09, 0x18, 0x17, 0x09, 0x39, 0x09, 0x2b, 0x09, 0x39, 0x09, 0x18,
+  0x17, 0x09, 0x3b, 0x05, 0x2f, 0x06, 0x3a, 0x09, 0x18, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17,
+  0x08, 0x80, 0xb0, 0x09, 0x18, 0x17, 0x08, 0x80, 0xb0, 0x0a, 0x17, 0x17, 0x08, 0x80, 0xb0, 0x0a,
+  0x17, 0x17, 0x08, 0x80, 0xb1, 0x09, 0x17, 0x17, 0x08, 0x80, 0xb1, 0x09, 0x17, 0x17, 0x08, 0x80,
+  0xb1, 0x09, 0x17, 0x17, 0x08, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16,
+  0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09,
+  0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80,
+  0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16,
+  0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09,
+  0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x16, 0x09, 0x80, 0xb1, 0x09, 0x17, 0x17, 0x08, 0x80,
+  0xb1, 0x09, 0x17, 0x17, 0x08, 0x80, 0xb1, 0x09, 0x17, 0x17, 0x08, 0x80, 0xb1, 0x09, 0x17, 0x17,
+  0x08, 0x80, 0xb0, 0x0a, 0x17, 0x17, 0x08, 0x80, 0xb0, 0x0a, 0x17, 0x17, 0x08, 0x80, 0xb0, 0x0a,
+  0x17, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17, 0x09, 0x80,
+  0xaf, 0x09, 0x18, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17,
+  0x09, 0x80, 0xaf, 0x09, 0x18, 0x17, 0x09, 0x80, 0xaf, 0x09, 0x18, 0x17, 0x0a, 0x80, 0xae, 0x08,
+  0x19, 0x18, 0x09, 0x54, 0x05, 0x55, 0x08, 0x19, 0x18, 0x09, 0x4c, 0x15, 0x4c, 0x09, 0x19, 0x18,
+  0x09, 0x49, 0x1b, 0x49, 0x09, 0x19, 0x18, 0x09, 0x47, 0x1f, 0x47, 0x09, 0x19, 0x18, 0x09, 0x44,
+  0x25, 0x44, 0x09, 0x19, 0x19, 0x08, 0x42, 0x29, 0x41, 0x0a, 0x19, 0x19, 0x08, 0x40, 0x2d, 0x3f,
+  0x0a, 0x19, 0x19, 0x09, 0x3d, 0x31, 0x3d, 0x0a, 0x19, 0x19, 0x09, 0x3c, 0x33, 0x3c, 0x09, 0x1a,
+  0x19, 0x09, 0x3b, 0x35, 0x3b, 0x09, 0x1a, 0x19, 0x0a, 0x38, 0x39, 0x39, 0x09, 0x1a, 0x19, 0x0a,
+  0x37, 0x3b, 0x38, 0x09, 0x1a, 0x19, 0x0a, 0x36, 0x3d, 0x36, 0x09, 0x1b, 0x1a, 0x09, 0x35, 0x1b,
+  0x0a, 0x1a, 0x35, 0x09, 0x1b, 0x1a, 0x09, 0x34, 0x17, 0x13, 0x17, 0x34, 0x09, 0x1b, 0x1a, 0x09,
+  0x33, 0x14, 0x1b, 0x14, 0x32, 0x0a, 0x1b, 0x1b, 0x09, 0x31, 0x14, 0x1d, 0x14, 0x31, 0x0a, 0x1b,
+  0x1b, 0x09, 0x30, 0x12, 0x23, 0x12, 0x30, 0x09, 0x1c, 0x1b, 0x09, 0x2f, 0x11, 0x27, 0x11, 0x2f,
+  0x09, 0x1c, 0x1b, 0x0a, 0x2e, 0x10, 0x29, 0x11, 0x2e, 0x09, 0x1c, 0x1b, 0x0a, 0x2c, 0x11, 0x2c,
+  0x10, 0x2c, 0x09, 0x1d, 0x1c, 0x09, 0x2c, 0x0f, 0x2f, 0x0f, 0x2c, 0x09, 0x1d, 0x1c, 0x09, 0x2b,
+  0x0f, 0x31, 0x0f, 0x2b, 0x09, 0x1d, 0x1c, 0x0a, 0x29, 0x0f, 0x33, 0x0f, 0x29, 0x0a, 0x1d, 0x1d,
+  0x09, 0x29, 0x0e, 0x35, 0x0e, 0x29, 0x0a, 0x1d, 0x1d, 0x09, 0x28, 0x0e, 0x37, 0x0e, 0x28, 0x09,
+  0x1e, 0x1d, 0x0a, 0x26, 0x0e, 0x39, 0x0e, 0x26, 0x0a, 0x1e, 0x1d, 0x0a, 0x26, 0x0d, 0x3b, 0x0d,
+  0x26, 0x0a, 0x1e, 0x1e, 0x09, 0x25, 0x0d, 0x3d, 0x0d, 0x25, 0x09, 0x1f, 0x1e, 0x0a, 0x23, 0x0d,
+  0x3f, 0x0c, 0x24, 0x0a, 0x1f, 0x1e, 0x0a, 0x23, 0x0d, 0x3f, 0x0d, 0x23, 0x0a, 0x1f, 0x1f, 0x0a,
+  0x21, 0x0d, 0x41, 0x0d, 0x22, 0x09, 0x20, 0x1f, 0x0a, 0x21, 0x0c, 0x43, 0x0c, 0x21, 0x0a, 0x20,
+  0x1f, 0x0a, 0x20, 0x0d, 0x43, 0x0d, 0x20, 0x0a, 0x20, 0x20, 0x0a, 0x1f, 0x0c, 0x45, 0x0c, 0x1f,
+  0x0a, 0x21, 0x20, 0x0a, 0x1e, 0x0c, 0x47, 0x0c, 0x1e, 0x0a, 0x21, 0x21, 0x0a, 0x1d, 0x0c, 0x47,
+  0x0c, 0x1e, 0x0a, 0x21, 0x21, 0x0a, 0x1d, 0x0b, 0x49, 0x0b, 0x1d, 0x0a, 0x22, 0x21, 0x0a, 0x1c,
+  0x0c, 0x4a, 0x0b, 0x1c, 0x0a, 0x22, 0x21, 0x0b, 0x1b, 0x0b, 0x4b, 0x0b, 0x1b, 0x0a, 0x23, 0x22,
+  0x0a, 0x1a, 0x0b, 0x4c, 0x0c, 0x1a, 0x0a, 0x23, 0x23, 0x0a, 0x19, 0x0b, 0x4d, 0x0b, 0x19, 0x0b,
+  0x23, 0x23, 0x0a, 0x19, 0x0b, 0x4d, 0x0b, 0x19, 0x0a, 0x24, 0x23, 0x0b, 0x18, 0x0a, 0x4f, 0x0a,
+  0x18, 0x0b, 0x24, 0x24, 0x0a, 0x18, 0x0a, 0x4f, 0x0a, 0x18, 0x0a, 0x25, 0x24, 0x0b, 0x17, 0x09,
+  0x51, 0x09, 0x17, 0x0b, 0x25, 0x25, 0x0a, 0x17, 0x09, 0x51, 0x09, 0x17, 0x0b, 0x25, 0x25, 0x0b,
+  0x16, 0x08, 0x53, 0x08, 0x16, 0x0b, 0x26, 0x25, 0x0b, 0x17, 0x07, 0x53, 0x07, 0x17, 0x0b, 0x26,
+  0x26, 0x0b, 0x17, 0x05, 0x55, 0x05, 0x17, 0x0b, 0x27, 0x27, 0x0a, 0x18, 0x03, 0x58, 0x01, 0x19,
+  0x0b, 0x27, 0x27, 0x0b, 0x80, 0x8b, 0x0b, 0x28, 0x27, 0x0c, 0x80, 0x89, 0x0c, 0x28, 0x28, 0x0b,
+  0x80, 0x89, 0x0b, 0x29, 0x29, 0x0b, 0x80, 0x87, 0x0c, 0x29, 0x29, 0x0b, 0x80, 0x86, 0x0c, 0x2a,
+  0x2a, 0x0b, 0x80, 0x85, 0x0b, 0x2b, 0x2a, 0x0c, 0x80, 0x83, 0x0c, 0x2b, 0x2b, 0x0b, 0x80, 0x83,
+  0x0b, 0x2c, 0x2b, 0x0c, 0x80, 0x81, 0x0c, 0x2c, 0x2c, 0x0c, 0x7f, 0x0c, 0x2d, 0x2d, 0x0c, 0x7d,
+  0x0c, 0x2e, 0x2d, 0x0d, 0x7c, 0x0c, 0x2e, 0x2e, 0x0c, 0x7b, 0x0c, 0x2f, 0x2f, 0x0c, 0x79, 0x0c,
+  0x30, 0x2f, 0x0d, 0x77, 0x0d, 0x30, 0x30, 0x0c, 0x76, 0x0d, 0x31, 0x31, 0x0d, 0x74, 0x0c, 0x32,
+  0x31, 0x0d, 0x73, 0x0d, 0x32, 0x32, 0x0d, 0x71, 0x0d, 0x33, 0x33, 0x0d, 0x6f, 0x0d, 0x34, 0x34,
+  0x0d, 0x6d, 0x0e, 0x34, 0x34, 0x0e, 0x6b, 0x0e, 0x35, 0x35, 0x0e, 0x69, 0x0e, 0x36, 0x36, 0x0e,
+  0x67, 0x0e, 0x37, 0x37, 0x0e, 0x65, 0x0e, 0x38, 0x38, 0x0e, 0x63, 0x0e, 0x39, 0x38, 0x0f, 0x61,
+  0x0f, 0x39, 0x3a, 0x0f, 0x5e, 0x0f, 0x3a, 0x3a, 0x10, 0x5b, 0x10, 0x3b, 0x3b, 0x10, 0x59, 0x10,
+  0x3c, 0x3c, 0x10, 0x57, 0x10, 0x3d, 0x3d, 0x11, 0x53, 0x11, 0x3e, 0x3e, 0x11, 0x51, 0x11, 0x3f,
+  0x3f, 0x12, 0x4d, 0x12, 0x40, 0x40, 0x12, 0x4b, 0x12, 0x41, 0x42, 0x12, 0x47, 0x13, 0x42, 0x43,
+  0x13, 0x43, 0x13, 0x44, 0x44, 0x13, 0x41, 0x13, 0x45, 0x45, 0x14, 0x3d, 0x14, 0x46, 0x46, 0x16,
+  0x37, 0x16, 0x47, 0x47, 0x16, 0x35, 0x16, 0x48, 0x49, 0x18, 0x2d, 0x18, 0x4a, 0x4a, 0x1a, 0x27,
+  0x1a, 0x4b, 0x4b, 0x1b, 0x23, 0x1b, 0x4c, 0x4d, 0x1f, 0x17, 0x1f, 0x4e, 0x4f, 0x24, 0x09, 0x24,
+  0x50, 0x50, 0x4f, 0x51, 0x52, 0x4b, 0x53, 0x54, 0x47, 0x55, 0x56, 0x43, 0x57, 0x59, 0x3e, 0x59,
+  0x5a, 0x3b, 0x5b, 0x5e, 0x33, 0x5f, 0x60, 0x2f, 0x61, 0x63, 0x29, 0x64, 0x68, 0x1f, 0x69, 0x6b,
+  0x19, 0x6c, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+  0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0, 0x80, 0xf0,
+};
+
+static const uint16_t CARAS_INDICE[40] PROGMEM = {
+  0, 32, 64, 104, 178, 258, 345, 477, 621, 765, 870, 966,
+  1098, 1242, 1384, 1486, 1566, 1638, 1677, 1709, 0, 32, 66, 126,
+  206, 288, 387, 531, 675, 819, 918, 1014, 1121, 1261, 1405, 1525,
+  1606, 1686, 1746, 1779,
+};
+
+static const CaraRLE CARAS[] = {
+  { "A", 240, 320, CARAS_DATOS + 0, CARAS_INDICE + 0 },
+  { "B", 240, 320, CARAS_DATOS + 1741, CARAS_INDICE + 20 },
+};
+
+enum {
+  CARA_A = 0,
+  CARA_B = 1,
+  CARAS_N = 2
+};
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""
+Cuántos Dynamixel entran a 100 Hz: paquetes y tiempo de bus por tick.
+
+Arma los mismos paquetes que PaqueteDXL.h (protocolo 1.0) y primero los
+verifica contra los ejemplos del e-manual de Robotis. Con --cxx compila
+PaqueteDXL.h en la PC y compara byte a byte con lo de acá (también el
+lector de respuestas). Lo mismo corre en ctest del simulador
+(SimuladorHost, prueba dxl_paquetes).
+
+Después modela un tick de control para 1..--max servos:
+  individual   WRITE + READ por servo, cada uno con su respuesta (como el
+               sketch viejo, repetido por articulación)
+  sync+rr      un SYNC_WRITE para todos + READ de un servo por tick
+  sync+bulk    un SYNC_WRITE + BULK_READ de todos (solo MX)
+y muestra el tiempo de bus por tick y el ritmo máximo, a cada baudrate.
+
+Uso:
+    python3 bus_dxl.py
+    python3 bus_dxl.py --baud 9600 1000000 --max 12 --return-delay-us 0
+    python3 bus_dxl.py --cxx
+"""
+import argparse
+import os
+import random
+import subprocess
+import tempfile
+
+BROADCAST = 0xFE
+INST_READ, INST_WRITE, INST_SYNC_WRITE, INST_BULK_READ = 0x02, 0x03, 0x83, 0x92
+REG_GOAL_POS, REG_PRESENT_POS = 30, 36
+BITS_POR_BYTE = 10   # start + 8 + stop
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+SKETCH = os.path.join(AQUI, "..", "Basicocambiodecolorpantalla")
+
+
+def paquete(id_, inst, params):
+    cuerpo = [id_, len(params) + 2, inst, *params]
+    return bytes([0xFF, 0xFF, *cuerpo, ~sum(cuerpo) & 0xFF])
+
+
+def leer(id_, reg, n):
+    return paquete(id_, INST_READ, [reg, n])
+
+
+def escribir16(id_, reg, v):
+    return paquete(id_, INST_WRITE, [reg, v & 0xFF, v >> 8])
+
+
+def sync_write(reg, largo, datos):
+    """datos: [(id, [bytes])]"""
+    return paquete(BROADCAST, INST_SYNC_WRITE, [reg, largo] + [b for i, d in datos for b in (i, *d)])
+
+
+def sync_write16(reg, ids, valores):
+    return sync_write(reg, 2, [(i, [v & 0xFF, v >> 8]) for i, v in zip(ids, valores)])
+
+
+def bulk_read(pedidos):
+    """pedidos: [(largo, id, reg)]"""
+    return paquete(BROADCAST, INST_BULK_READ, [0x00] + [b for p in pedidos for b in p])
+
+
+def estado(id_, error, datos):
+    return paquete(id_, error, list(datos))   # misma forma: el error va donde la instrucción
+
+
+def verificar_manual():
+    """Ejemplos del e-manual (protocolo 1.0)"""
+    casos = [
+        ("READ temperatura id 1", leer(1, 0x2B, 1), "FF FF 01 04 02 2B 01 CC"),
+        ("SYNC_WRITE 4 servos", sync_write(0x1E, 4, [
+            (0, [0x10, 0x00, 0x50, 0x01]), (1, [0x20, 0x02, 0x60, 0x03]),
+            (2, [0x30, 0x00, 0x70, 0x01]), (3, [0x20, 0x02, 0x80, 0x03])]),
+         "FF FF FE 18 83 1E 04 00 10 00 50 01 01 20 02 60 03 02 30 00 70 01 03 20 02 80 03 12"),
+        ("BULK_READ 2 servos", bulk_read([(2, 1, 0x1E), (2, 2, 0x24)]), "FF FF FE 09 92 00 02 01 1E 02 02 24 1D"),
+    ]
+    ok = True
+    for nombre, obtenido, esperado in casos:
+        bien = obtenido == bytes.fromhex(esperado)
+        ok &= bien
+        print(f"  {'ok ' if bien else 'MAL'} {nombre}" + ("" if bien else f": {obtenido.hex(' ').upper()}"))
+    return ok
+
+
+ARNES = r"""
+#include <stdio.h>
+#include "PaqueteDXL.h"
+static void hex(const uint8_t* b, size_t n) { for (size_t i = 0; i < n; i++) printf("%02X", b[i]); printf("\n"); }
+int main() {
+  uint8_t buf[256], ids[12]; uint16_t v[12]; unsigned n, a, b, c;
+  char op;
+  while (scanf(" %c", &op) == 1) {
+    if (op == 'r') { scanf("%u %u %u", &a, &b, &c); hex(buf, dxl1::leer(buf, sizeof(buf), a, b, c)); }
+    if (op == 'w') { scanf("%u %u %u", &a, &b, &c); hex(buf, dxl1::escribir16(buf, sizeof(buf), a, b, c)); }
+    if (op == 's' || op == 'b') {
+      scanf("%u", &n);
+      for (unsigned i = 0; i < n; i++) { scanf("%u %u", &a, &b); ids[i] = a; v[i] = b; }
+      hex(buf, op == 's' ? dxl1::syncWrite16(buf, sizeof(buf), 30, ids, v, n)
+                         : dxl1::bulkRead(buf, sizeof(buf), 36, 2, ids, n));
+    }
+    if (op == 'e') {   // bytes de una respuesta -> id, error, dato16
+      scanf("%u", &n);
+      dxl1::LectorEstado l; int r = -1;
+      for (unsigned i = 0; i < n; i++) { scanf("%u", &a); int x = l.byte(a); if (x != dxl1::LectorEstado::SIGUE) r = x; }
+      printf("%d %u %u %u\n", r, l.id(), l.error(), l.nDatos() >= 2 ? l.dato16() : 0);
+    }
+  }
+}
+"""
+
+
+def verificar_cxx(casos=300):
+    """Compila PaqueteDXL.h y compara con los paquetes de acá"""
+    rnd = random.Random(1)
+    entrada, esperado = [], []
+    for _ in range(casos):
+        t = rnd.choice("rwsbe")
+        if t == "r":
+            a, b, c = rnd.randrange(254), rnd.randrange(74), rnd.randrange(1, 5)
+            entrada.append(f"r {a} {b} {c}")
+            esperado.append(leer(a, b, c).hex().upper())
+        elif t == "w":
+            a, b, c = rnd.randrange(254), rnd.randrange(74), rnd.randrange(1024)
+            entrada.append(f"w {a} {b} {c}")
+            esperado.append(escribir16(a, b, c).hex().upper())
+        elif t in "sb":
+            n = rnd.randrange(1, 13)
+            ids = rnd.sample(range(254), n)
+            vals = [rnd.randrange(1024) for _ in ids]
+            entrada.append(f"{t} {n} " + " ".join(f"{i} {v}" for i, v in zip(ids, vals)))
+            p = sync_write16(REG_GOAL_POS, ids, vals) if t == "s" else bulk_read([(2, i, REG_PRESENT_POS) for i in ids])
+            esperado.append(p.hex().upper())
+        else:
+            id_, err, v = rnd.randrange(254), rnd.choice([0, 0, 0x20]), rnd.randrange(1024)
+            b = bytearray(estado(id_, err, [v & 0xFF, v >> 8]))
+            roto = rnd.random() < 0.2
+            if roto: b[-1] ^= 0x55
+            entrada.append(f"e {len(b)} " + " ".join(map(str, b)))
+            esperado.append(f"2 {id_} {err} {v}" if roto else f"1 {id_} {err} {v}")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        fuente, exe = os.path.join(tmp, "arnes.cpp"), os.path.join(tmp, "arnes")
+        with open(fuente, "w") as f:
+            f.write(ARNES)
+        subprocess.run(["c++", "-std=c++11", "-Wall", "-I", SKETCH, fuente, "-o", exe], check=True)
+        salida = subprocess.run([exe], input="\n".join(entrada), capture_output=True, text=True, check=True).stdout.split("\n")
+    malos = [(e, s, o) for e, s, o in zip(entrada, esperado, salida) if s != o]
+    for e, s, o in malos[:5]:
+        print(f"  MAL {e}\n      esperado {s}\n      obtenido {o}")
+    print(f"  {casos - len(malos)}/{casos} iguales entre PaqueteDXL.h y este script")
+    return not malos
+
+
+def tiempo_us(n_bytes, baud):
+    return n_bytes * BITS_POR_BYTE * 1e6 / baud
+
+
+def tick_us(modo, n, baud, a):
+    """Tiempo de bus de un tick con n servos. Cada transacción paga la vuelta
+    del host (flush, pin de dirección, timeout de RX de la UART); cada
+    respuesta paga el return delay y lo que tarda el servo en procesar."""
+    resp = len(estado(1, 0, [0, 0]))        # respuesta de 2 datos: 8 bytes
+    ack = len(estado(1, 0, []))             # respuesta de un WRITE: 6 bytes
+    espera = a.return_delay_us + a.proceso_us
+    if modo == "individual":
+        por_servo = (tiempo_us(len(escribir16(1, REG_GOAL_POS, 0)) + ack, baud)
+                     + tiempo_us(len(leer(1, REG_PRESENT_POS, 2)) + resp, baud)
+                     + 2 * (espera + a.host_us))
+        return n * por_servo
+    ids, vals = list(range(n)), [0] * n
+    t = tiempo_us(len(sync_write16(REG_GOAL_POS, ids, vals)), baud) + a.host_us
+    if modo == "sync+rr":
+        return t + tiempo_us(len(leer(1, REG_PRESENT_POS, 2)) + resp, baud) + espera + a.host_us
+    return (t + tiempo_us(len(bulk_read([(2, i, REG_PRESENT_POS) for i in ids])) + n * resp, baud)
+            + n * espera + a.host_us)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--baud", type=int, nargs="+", default=[9600, 1000000])
+    ap.add_argument("--max", type=int, default=12, help="servos (hasta ControlMovimiento::MAX_ART)")
+    ap.add_argument("--hz", type=float, default=100, help="ritmo de control buscado")
+    ap.add_argument("--return-delay-us", type=float, default=0, help="registro 5 x 2 us (de fábrica 500)")
+    ap.add_argument("--proceso-us", type=float, default=20, help="lo que tarda el servo en armar la respuesta")
+    ap.add_argument("--host-us", type=float, default=60, help="vuelta del ESP32 por transacción")
+    ap.add_argument("--cxx", action="store_true", help="compilar PaqueteDXL.h y comparar")
+    a = ap.parse_args()
+
+    print("Paquetes contra el e-manual:")
+    ok = verificar_manual()
+    if a.cxx:
+        print("PaqueteDXL.h:")
+        ok &= verificar_cxx()
+    if not ok:
+        raise SystemExit(1)
+
+    modos = ("individual", "sync+rr", "sync+bulk")
+    periodo = 1e6 / a.hz
+    for baud in a.baud:
+        print(f"\n{baud} baud (tiempo de bus por tick / ritmo máximo; * = no llega a {a.hz:g} Hz)")
+        print("servos " + "".join(f"{m:>22}" for m in modos))
+        for n in range(1, a.max + 1):
+            celdas = []
+            for m in modos:
+                t = tick_us(m, n, baud, a)
+                celdas.append(f"{t / 1000:9.2f} ms {1e6 / t:6.0f} Hz{'*' if t > periodo else ' '}")
+            print(f"{n:>6} " + "".join(f"{c:>22}" for c in celdas))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+Compila caras (PNG/BMP o arrays de un .ino) al formato RLE de CaraRLE.h.
+
+Genera un header con:
+  - CARAS_DATOS:  filas RLE de todas las caras, una detrás de otra
+  - CARAS_INDICE: offset de cada FILAS_INDICE filas de cada cara
+  - CARAS[]:      tabla CaraRLE (nombre, ancho, alto, datos, índice)
+  - enum CARA_<NOMBRE> con el índice de cada una, y CARAS_N
+
+Cada cara se decodifica de nuevo y se compara bit a bit con la original
+antes de escribir el header (si no coincide, no se escribe nada). Se
+reporta el tamaño, la relación de compresión y el tiempo de decodificar.
+
+Píxel oscuro (luma < --umbral) = figura (se pinta con fg).
+
+Uso:
+    python3 compilar_caras.py caras_png/ -o ../cambiodecaraaltocar/caras.h
+    python3 compilar_caras.py --ino ../cambiodecaraaltocar/cambiodecaraaltocar.ino -o caras.h
+"""
+import argparse
+import os
+import re
+import time
+
+FILAS_INDICE = 16   # igual que en CaraRLE.h
+EXTENSIONES = (".png", ".bmp")
+PATRON_INO = re.compile(r"const\s+unsigned\s+char\s+(\w+)\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\};", re.S)
+
+
+# ===== Entrada: filas de bits (listas de 0/1) =====
+def desde_imagen(ruta, ancho, alto, umbral):
+    from PIL import Image
+    img = Image.open(ruta).convert("L")
+    if img.size != (ancho, alto):
+        img = img.resize((ancho, alto), Image.LANCZOS)
+    px = img.load()
+    return [[1 if px[x, y] < umbral else 0 for x in range(ancho)] for y in range(alto)]
+
+
+def desde_bitmap(data, ancho, alto):
+    stride = (ancho + 7) // 8
+    return [[(data[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(ancho)] for y in range(alto)]
+
+
+def leer_ino(ruta, ancho, alto):
+    texto = open(ruta, encoding="utf-8", errors="ignore").read()
+    esperado = (ancho + 7) // 8 * alto
+    caras = []
+    for nombre, cuerpo in PATRON_INO.findall(texto):
+        data = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{1,2}", cuerpo))
+        if len(data) == esperado:
+            caras.append((re.sub(r"^epd_bitmap_", "", nombre), desde_bitmap(data, ancho, alto)))
+    return caras
+
+
+# ===== Formato =====
+def largo(n):
+    return bytes([n]) if n < 0x80 else bytes([0x80 | (n >> 8), n & 0xFF])
+
+
+def codificar(filas):
+    """-> (datos, indice): tramos alternando fondo/figura, empezando por fondo"""
+    datos = bytearray()
+    indice = []
+    for y, fila in enumerate(filas):
+        if y % FILAS_INDICE == 0:
+            indice.append(len(datos))
+        color, n = 0, 0
+        for b in fila:
+            if b != color:
+                datos += largo(n)
+                color, n = b, 0
+            n += 1
+        datos += largo(n)
+    return bytes(datos), indice
+
+
+def decodificar(datos, ancho, alto):
+    filas, p = [], 0
+    for _ in range(alto):
+        fila, color = [], 0
+        while len(fila) < ancho:
+            b = datos[p]; p += 1
+            n = ((b & 0x7F) << 8 | datos[p]) if b & 0x80 else b
+            if b & 0x80: p += 1
+            fila += [color] * n
+            color ^= 1
+        filas.append(fila)
+    return filas
+
+
+# ===== Salida =====
+def hex_bloque(valores, fmt, por_linea):
+    lineas = []
+    for i in range(0, len(valores), por_linea):
+        lineas.append("  " + ", ".join(fmt.format(v) for v in valores[i:i + por_linea]) + ",")
+    return "\n".join(lineas)
+
+
+def escribir_header(ruta, caras, ancho, alto):
+    datos, indice, tabla = bytearray(), [], []
+    for nombre, d, idx in caras:
+        tabla.append((nombre, len(datos), len(indice)))
+        indice += idx   # offsets relativos al inicio de cada cara
+        datos += d
+    ident = lambda n: re.sub(r"\W", "_", n).upper()
+    with open(ruta, "w", encoding="utf-8") as f:
+        f.write("// Generado por herramientas/compilar_caras.py: no editar a mano.\n")
+        f.write(f"// {len(caras)} caras de {ancho}x{alto}, {len(datos) + 2 * len(indice)} bytes en flash\n")
+        f.write("#pragma once\n\n#include \"CaraRLE.h\"\n\n")
+        f.write(f"static const uint8_t CARAS_DATOS[{len(datos)}] PROGMEM = {{\n")
+        f.write(hex_bloque(list(datos), "0x{:02x}", 16) + "\n};\n\n")
+        f.write(f"static const uint16_t CARAS_INDICE[{len(indice)}] PROGMEM = {{\n")
+        f.write(hex_bloque(indice, "{}", 12) + "\n};\n\n")
+        f.write("static const CaraRLE CARAS[] = {\n")
+        for nombre, od, oi in tabla:
+            f.write(f"  {{ \"{nombre}\", {ancho}, {alto}, CARAS_DATOS + {od}, CARAS_INDICE + {oi} }},\n")
+        f.write("};\n\n")
+        f.write("enum {\n")
+        for i, (nombre, _, _) in enumerate(tabla):
+            f.write(f"  CARA_{ident(nombre)} = {i},\n")
+        f.write(f"  CARAS_N = {len(tabla)}\n}};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("entradas", nargs="*", help="carpetas o archivos PNG/BMP")
+    ap.add_argument("--ino", action="append", default=[], help="sacar los bitmaps de un .ino")
+    ap.add_argument("-o", "--salida", default="caras.h")
+    ap.add_argument("--ancho", type=int, default=240)
+    ap.add_argument("--alto", type=int, default=320)
+    ap.add_argument("--umbral", type=int, default=128)
+    args = ap.parse_args()
+
+    caras = []
+    for ruta in args.ino:
+        caras += leer_ino(ruta, args.ancho, args.alto)
+    for entrada in args.entradas:
+        rutas = sorted(os.path.join(entrada, n) for n in os.listdir(entrada)) if os.path.isdir(entrada) else [entrada]
+        for ruta in rutas:
+            if ruta.lower().endswith(EXTENSIONES):
+                nombre = os.path.splitext(os.path.basename(ruta))[0]
+                caras.append((nombre, desde_imagen(ruta, args.ancho, args.alto, args.umbral)))
+    if not caras:
+        raise SystemExit("No hay caras para compilar")
+
+    crudo = (args.ancho + 7) // 8 * args.alto
+    salida, total = [], 0
+    print(f"{'cara':<16}{'RLE':>8}{'índice':>8}{'ratio':>8}{'decode':>10}")
+    for nombre, filas in caras:
+        datos, indice = codificar(filas)
+        t0 = time.perf_counter()
+        vuelta = decodificar(datos, args.ancho, args.alto)
+        ms = (time.perf_counter() - t0) * 1e3
+        if vuelta != filas:
+            raise SystemExit(f"❌ {nombre}: la decodificación no coincide bit a bit")
+        tam = len(datos) + 2 * len(indice)
+        total += tam
+        print(f"{nombre:<16}{len(datos):>8}{2 * len(indice):>8}{crudo / tam:>7.1f}x{ms:>8.1f} ms")
+        salida.append((nombre, datos, indice))
+
+    escribir_header(args.salida, salida, args.ancho, args.alto)
+    print(f"\n{len(caras)} caras: {total} B (crudo {crudo * len(caras)} B, {crudo * len(caras) / total:.1f}x)"
+          f" -> {args.salida}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Cuánto cuesta cada cambio de cara en el ILI9341.
+
+Lee las caras de un caras.h generado por compilar_caras.py (RLE) o los
+bitmaps de 1 bit de un .ino (const unsigned char X[] PROGMEM = {...}),
+calcula el XOR entre cada par y arma los tramos por fila igual que
+CaraDelta.h (bytes de 8 px, huecos de hasta GAP_BYTES unidos).
+
+Por cada par muestra: píxeles que cambian, tramos, bytes SPI estimados y
+tiempo a la frecuencia de SPI dada, contra el redibujado viejo
+(fillScreen + drawBitmap).
+
+Uso:
+    python3 delta_caras.py ../cambiodecaraaltocar/caras.h
+    python3 delta_caras.py ../cambiodecaraaltocar/cambiodecaraaltocar.ino
+    python3 delta_caras.py archivo.ino --ancho 240 --alto 320 --mhz 40
+"""
+import argparse
+import itertools
+import re
+
+GAP_BYTES = 2        # igual que CaraDelta::GAP_BYTES
+SPAN_CMD_BYTES = 11  # CASET + PASET + RAMWR con parámetros
+PIXEL_CMD_BYTES = 11 # drawBitmap pinta cada píxel negro con su propia ventana
+
+PATRON = re.compile(r"const\s+unsigned\s+char\s+(\w+)\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\};", re.S)
+
+
+def leer_rle(texto):
+    """caras.h -> {nombre: bitmap}, decodificando el RLE"""
+    from compilar_caras import decodificar
+    datos = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{2}",
+                  re.search(r"CARAS_DATOS\[\d+\] PROGMEM = \{(.*?)\};", texto, re.S).group(1)))
+    caras = {}
+    for nombre, ancho, alto, off in re.findall(r'\{ "(\w+)", (\d+), (\d+), CARAS_DATOS \+ (\d+),', texto):
+        ancho, alto = int(ancho), int(alto)
+        filas = decodificar(datos[int(off):], ancho, alto)
+        stride = (ancho + 7) // 8
+        bm = bytearray(stride * alto)
+        for y, fila in enumerate(filas):
+            for x, b in enumerate(fila):
+                if b: bm[y * stride + x // 8] |= 0x80 >> (x % 8)
+        caras[nombre] = bytes(bm)
+    return caras
+
+
+def leer_bitmaps(ruta):
+    texto = open(ruta, encoding="utf-8", errors="ignore").read()
+    if "CARAS_DATOS" in texto:
+        return leer_rle(texto)
+    caras = {}
+    for nombre, cuerpo in PATRON.findall(texto):
+        caras[nombre] = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{1,2}", cuerpo))
+    return caras
+
+
+def tramos(a, b, ancho, alto):
+    """Lista de (y, b0, b1) con bytes b0..b1 de la fila y que cambian"""
+    stride = (ancho + 7) // 8
+    out = []
+    for y in range(alto):
+        fila = [a[y * stride + x] ^ b[y * stride + x] for x in range(stride)]
+        x = 0
+        while x < stride:
+            if not fila[x]:
+                x += 1
+                continue
+            b0 = b1 = x
+            gap = 0
+            x += 1
+            while x < stride:
+                if fila[x]:
+                    b1, gap = x, 0
+                else:
+                    gap += 1
+                    if gap > GAP_BYTES:
+                        break
+                x += 1
+            out.append((y, b0, b1))
+            x = b1 + 1
+    return out
+
+
+def bits(data):
+    return sum(bin(v).count("1") for v in data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("ino")
+    ap.add_argument("--ancho", type=int, default=240)
+    ap.add_argument("--alto", type=int, default=320)
+    ap.add_argument("--mhz", type=float, default=40.0, help="reloj SPI del ILI9341")
+    args = ap.parse_args()
+
+    caras = leer_bitmaps(args.ino)
+    stride = (args.ancho + 7) // 8
+    esperado = stride * args.alto
+    caras = {n: d for n, d in caras.items() if len(d) == esperado}
+    if len(caras) < 2:
+        raise SystemExit(f"Hacen falta 2 bitmaps de {args.ancho}x{args.alto} ({esperado} bytes)")
+
+    def ms(nbytes):
+        return nbytes * 8 / (args.mhz * 1e6) * 1e3
+
+    total = args.ancho * args.alto
+    print(f"{len(caras)} caras de {args.ancho}x{args.alto}, SPI a {args.mhz:g} MHz\n")
+    for a, b in itertools.combinations(sorted(caras), 2):
+        da, db = caras[a], caras[b]
+        cambian = bits(bytes(x ^ y for x, y in zip(da, db)))
+        ts = tramos(da, db, args.ancho, args.alto)
+        px = sum(min((b1 + 1) * 8, args.ancho) - b0 * 8 for _, b0, b1 in ts)
+        delta = len(ts) * SPAN_CMD_BYTES + px * 2
+        for destino in (b, a):
+            # Camino viejo: fillScreen + un píxel con su ventana por cada bit negro
+            viejo = SPAN_CMD_BYTES + total * 2 + bits(caras[destino]) * (PIXEL_CMD_BYTES + 2)
+            print(f"{a if destino == b else b} -> {destino}")
+            print(f"  píxeles que cambian: {cambian} ({100 * cambian / total:.1f} %)")
+            print(f"  tramos: {len(ts)}, píxeles enviados: {px}")
+            print(f"  delta: {delta} B SPI, ~{ms(delta):.1f} ms")
+            print(f"  antes: {viejo} B SPI, ~{ms(viejo):.1f} ms (fillScreen + drawBitmap)")
+        print(f"  tabla en RAM: {len(ts) * 4} B\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Server de prueba para CaraRemota.h: mide evento -> píxeles sin el notebook.
+
+Implementa solo lo que usa la pantalla:
+  GET  /esp32/poll/<id>?wait=N&lote=N   long-poll con comandos "cara"
+  GET  /esp32/cara/<md5>                cara RLE con cabecera "CRL1"
+  POST /esp32/cara_ok/<id>              confirmación (seq, estado, ms_local, descarga)
+
+Cada --cada segundos encola un cambio de cara (alternando las del sketch,
+y las imágenes de --png si hay) y, al volver la confirmación, anota la
+latencia total. Al final (o con Ctrl+C) muestra p50/p95/máx, separando las
+caras que se bajaron de las que ya estaban en el ESP32.
+
+En el sketch, BASE_URL = "http://<ip de esta PC>:8000".
+
+Uso:
+    python3 mock_caras.py
+    python3 mock_caras.py --png caras_png/feliz.png --cada 1.5 --n 40
+"""
+import argparse
+import hashlib
+import json
+import os
+import queue
+import re
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+from compilar_caras import codificar, desde_imagen
+
+colas: dict[str, queue.Queue] = {}
+caras_rle: dict[str, bytes] = {}
+eventos: dict[int, float] = {}
+latencias: list[tuple] = []
+seq_lock = threading.Lock()
+seq = 0
+
+
+def cola(device_id):
+    return colas.setdefault(device_id, queue.Queue())
+
+
+def binario_cara(ruta, ancho, alto):
+    """Mismo formato que _cara_rle() del server"""
+    datos, indice = codificar(desde_imagen(ruta, ancho, alto, 128))
+    return (struct.pack("<4sHHH", b"CRL1", ancho, alto, len(indice))
+            + struct.pack(f"<{len(indice)}H", *indice) + datos)
+
+
+def encolar(device_id, payload):
+    global seq
+    with seq_lock:
+        seq += 1
+        payload.update({"tipo": "cara", "seq": seq})
+        eventos[seq] = time.monotonic()
+    cola(device_id).put(payload)
+
+
+def percentil(v, p):
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0
+
+
+def resumen():
+    for titulo, sel in (("todas", lambda l: True), ("bajadas", lambda l: l[1]), ("locales", lambda l: not l[1])):
+        v = sorted(l[0] for l in latencias if sel(l))
+        if v:
+            print(f"  {titulo:<8} n={len(v):<4} p50={percentil(v, .5):6.1f} ms  p95={percentil(v, .95):6.1f} ms"
+                  f"  máx={v[-1]:6.1f} ms")
+
+
+class Handler(BaseHTTPRequestHandler):
+    def log_message(self, *args):
+        pass
+
+    def responder(self, code, cuerpo, tipo="application/json"):
+        self.send_response(code)
+        self.send_header("Content-Type", tipo)
+        self.send_header("Content-Length", str(len(cuerpo)))
+        self.end_headers()
+        self.wfile.write(cuerpo)
+
+    def do_GET(self):
+        u = urlparse(self.path)
+        m = re.fullmatch(r"/esp32/poll/([\w-]+)", u.path)
+        if m:
+            q = parse_qs(u.query)
+            wait = min(25, int(q.get("wait", ["0"])[0]))
+            lote = max(1, int(q.get("lote", ["1"])[0]))
+            c, cmds = cola(m.group(1)), []
+            try:
+                cmds.append(c.get(timeout=wait) if wait else c.get_nowait())
+                while len(cmds) < lote:
+                    cmds.append(c.get_nowait())
+            except queue.Empty:
+                pass
+            return self.responder(200, json.dumps({"comandos": cmds}).encode())
+        m = re.fullmatch(r"/esp32/cara/(\w+)", u.path)
+        if m and m.group(1) in caras_rle:
+            return self.responder(200, caras_rle[m.group(1)], "application/octet-stream")
+        self.responder(404, b"{}")
+
+    def do_POST(self):
+        m = re.fullmatch(r"/esp32/cara_ok/([\w-]+)", self.path)
+        if not m:
+            return self.responder(404, b"{}")
+        form = {k: v[0] for k, v in parse_qs(self.rfile.read(int(self.headers.get("Content-Length", 0))).decode()).items()}
+        s = int(form.get("seq", 0))
+        t = eventos.pop(s, None)
+        total = (time.monotonic() - t) * 1e3 if t else None
+        if total is not None and form.get("estado") == "ok":
+            latencias.append((total, form.get("descarga") == "1"))
+        print(f"seq {s}: {form.get('estado')}, total {total or 0:.1f} ms, ESP32 {form.get('ms_local')} ms"
+              + (" (bajada)" if form.get("descarga") == "1" else ""))
+        self.responder(200, b'{"success": true}')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--puerto", type=int, default=8000)
+    ap.add_argument("--device", default="pantalla_1")
+    ap.add_argument("--caras", default="A,B", help="caras compiladas en el sketch")
+    ap.add_argument("--png", action="append", default=[], help="imágenes a mandar comprimidas")
+    ap.add_argument("--ip", default=None, help="IP con la que el ESP32 ve esta PC (para las URL)")
+    ap.add_argument("--cada", type=float, default=2.0, help="segundos entre cambios")
+    ap.add_argument("--n", type=int, default=30, help="cambios a mandar")
+    ap.add_argument("--ancho", type=int, default=240)
+    ap.add_argument("--alto", type=int, default=320)
+    args = ap.parse_args()
+
+    base = f"http://{args.ip or '127.0.0.1'}:{args.puerto}"
+    opciones = [{"cara": c} for c in args.caras.split(",") if c]
+    for ruta in args.png:
+        b = binario_cara(ruta, args.ancho, args.alto)
+        h = hashlib.md5(b).hexdigest()
+        caras_rle[h] = b
+        opciones.append({"cara": os.path.splitext(os.path.basename(ruta))[0], "hash": h,
+                         "bytes": len(b), "url": f"{base}/esp32/cara/{h}"})
+        print(f"{ruta}: {len(b)} B, md5 {h}")
+
+    srv = ThreadingHTTPServer(("0.0.0.0", args.puerto), Handler)
+    threading.Thread(target=srv.serve_forever, daemon=True).start()
+    print(f"Escuchando en :{args.puerto}, {args.n} cambios cada {args.cada:g} s para {args.device}")
+    try:
+        for i in range(args.n):
+            time.sleep(args.cada)
+            encolar(args.device, dict(opciones[i % len(opciones)]))
+        time.sleep(args.cada + 1)
+    except KeyboardInterrupt:
+        pass
+    srv.shutdown()
+    print("\nLatencia evento -> píxeles:")
+    resumen()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,304 @@
+/*
+ * Filtro y clasificador de color (Lab2Colores)
+ * - Sin dependencias de AVR: compila tambin en la PC (herramientas/
+ *   simular.c le pasa logs de ADC etiquetados)
+ * - filtro_paso(): mediana de 3 (saca picos sueltos) + media mvil
+ *   de FILTRO_N muestras con suma corrida, O(1) por muestra
+ * - modelo_t: media y desvo de cada clase (fondo incluido), aprendidos
+ *   con Welford en modo calibracin; sin calibrar sale de los rangos.
+ *   Los bordes (BORDE_N muestras al entrar y al salir) no se aprenden
+ * - clasif_paso(): centroide ms cercano en desvos, con confianza e
+ *   histresis; confirma cuando la seal se asent (NEST muestras
+ *   seguidas a menos de un desvo), no bloquea nunca
+ * - proceso_paso(): lo que hace el loop de main.c con cada muestra
+ *   cruda (filtro + calibracin o clasificacin); simular.c y el bench
+ *   del simulador pasan por ac, no por una copia
+ */
+#ifndef CLASIFICADOR_H
+#define CLASIFICADOR_H
+
+#include <stdint.h>
+#include <math.h>
+
+/*============ COLORES Y RANGOS ==========*/
+typedef enum { C_NONE=0, C_ROSA, C_ROJO, C_AMARILLO, C_VERDE } color_t;
+#define C_N 5
+
+typedef struct {
+	const char *nombre;
+	uint16_t low, high;   // rango [LOW..HIGH] ADC
+	uint8_t  ang;         // ngulo del servo para ese color
+	uint8_t  rgb[3];      // Color RGB para los LEDs
+} rango_t;
+
+// RANGOS MODIFICADOS - sin solapamientos. Ac y no en main.c para que
+// simular.c y el bench usen los mismos (el modelo sin calibrar sale de ac)
+static const rango_t R[] = {
+	[C_ROSA]     = {"ROSA",     500, 540,   0, {255, 0, 80}},
+	[C_ROJO]     = {"ROJO",     560, 590,  60, {255, 0, 0}},
+	[C_AMARILLO] = {"AMARILLO", 600, 630, 120, {255, 255, 0}},
+	[C_VERDE]    = {"VERDE",    640, 680, 180, {0, 255, 0}},
+};
+
+
+/*================ FILTRO ================*/
+#define ADC_FS   2000         // muestras/s (Timer0 en main.c)
+#define FILTRO_N 16           // potencia de 2: la divisin es un shift
+
+typedef struct {
+	uint16_t med[3];          // ltimas 3 crudas (mediana)
+	uint16_t ven[FILTRO_N];   // ventana de la media
+	uint32_t suma;
+	uint8_t  i, n;            // posicin en ven / muestras vistas
+} filtro_t;
+
+static inline void filtro_init(filtro_t *f){
+	f->med[0]=f->med[1]=f->med[2]=0;
+	f->suma=0; f->i=0; f->n=0;
+}
+
+static inline uint16_t mediana3(uint16_t a, uint16_t b, uint16_t c){
+	if(a>b){ uint16_t t=a; a=b; b=t; }
+	if(b>c) b=c;
+	return a>b ? a : b;
+}
+
+// Devuelve el valor filtrado; *listo=1 cuando la ventana ya est llena
+static inline uint16_t filtro_paso(filtro_t *f, uint16_t crudo, uint8_t *listo){
+	f->med[0]=f->med[1]; f->med[1]=f->med[2]; f->med[2]=crudo;
+	uint16_t m = f->n<2 ? crudo : mediana3(f->med[0], f->med[1], f->med[2]);
+	if(f->n<FILTRO_N){ f->n++; } else { f->suma-=f->ven[f->i]; }
+	f->ven[f->i]=m; f->suma+=m;
+	f->i=(f->i+1)&(FILTRO_N-1);
+	*listo = f->n>=FILTRO_N;
+	return (uint16_t)(f->suma / f->n);
+}
+
+// Muestras filtradas que tarda el borde de una pieza en pasar por el
+// sensor: la rampa (BORDE_MS) ms la ventana del filtro. Mientras tanto
+// la seal cruza las clases de en medio: al aprender no cuentan
+#define BORDE_MS 15
+#define BORDE_N  (ADC_FS*BORDE_MS/1000+FILTRO_N)
+#if BORDE_N > 255
+#error "BORDE_N no entra en proceso_t.cal_salto"
+#endif
+
+/*================ MODELO ================*/
+// Valores x16 (1/16 de cuenta ADC) para no usar float al clasificar
+#define MODELO_MAGIA 0xC012
+#define DESV_MIN16   (2*16)   // desvo mnimo: 2 cuentas (clases muy quietas)
+#define DIST_MAX16   (4*16)   // a ms de 4 desvos de todo = sin color
+
+typedef struct {
+	uint16_t magia;
+	uint16_t media16[C_N];    // [C_NONE] = fondo (cinta vaca)
+	uint16_t desv16[C_N];     // 0 = clase sin calibrar (no se usa)
+	uint8_t  suma;            // checksum de lo anterior
+} modelo_t;
+
+static inline uint8_t modelo_suma(const modelo_t *m){
+	const uint8_t *p=(const uint8_t*)m; uint8_t s=0x5A;
+	for(uint8_t i=0;i<sizeof(modelo_t)-1;i++) s=(uint8_t)((s<<1|s>>7)^p[i]);
+	return s;
+}
+
+static inline uint8_t modelo_valido(const modelo_t *m){
+	return m->magia==MODELO_MAGIA && m->suma==modelo_suma(m);
+}
+
+static inline void modelo_sellar(modelo_t *m){
+	m->magia=MODELO_MAGIA; m->suma=modelo_suma(m);
+}
+
+// Modelo inicial a partir de los rangos viejos: centro del rango y
+// desvo = ancho/4 (el rango queda en +-2 desvos); fondo sin calibrar
+static inline void modelo_desde_rangos(modelo_t *m, const rango_t *r){
+	m->media16[C_NONE]=0; m->desv16[C_NONE]=0;
+	for(color_t c=C_ROSA; c<=C_VERDE; c++){
+		m->media16[c]=(uint16_t)((r[c].low+r[c].high)*8);
+		m->desv16[c]=(uint16_t)((r[c].high-r[c].low)*4);
+	}
+	modelo_sellar(m);
+}
+
+// Distancia de v al centroide de c, en desvos x16
+static inline uint16_t modelo_dist(const modelo_t *m, color_t c, uint16_t v){
+	int32_t d=(int32_t)v*16-(int32_t)m->media16[c];
+	if(d<0) d=-d;
+	uint16_t s=m->desv16[c]<DESV_MIN16 ? DESV_MIN16 : m->desv16[c];
+	uint32_t r=(uint32_t)d*16/s;
+	return r>0xFFFF ? 0xFFFF : (uint16_t)r;
+}
+
+/*=============== WELFORD ================*/
+// Media y varianza en una pasada, sin guardar las muestras
+typedef struct { uint16_t n; float media, m2; } welford_t;
+
+static inline void welford_init(welford_t *w){ w->n=0; w->media=0; w->m2=0; }
+
+static inline void welford_paso(welford_t *w, uint16_t x){
+	w->n++;
+	float d=(float)x-w->media;
+	w->media+=d/w->n;
+	w->m2+=d*((float)x-w->media);
+}
+
+// x est a ms de DIST_MAX16 desvos de lo juntado (con DESV_MIN16)
+static inline uint8_t welford_lejos(const welford_t *w, uint16_t x){
+	float d=(float)x-w->media, var=w->n>1 ? w->m2/(w->n-1) : 0;
+	const float min=DESV_MIN16/16.0f, lejos=DIST_MAX16/16.0f;
+	if(var<min*min) var=min*min;
+	return d*d > var*lejos*lejos;
+}
+
+// Pasa lo aprendido a la clase c del modelo (hay que volver a sellarlo)
+static inline void welford_a_modelo(const welford_t *w, modelo_t *m, color_t c){
+	float desv = w->n>1 ? sqrtf(w->m2/(w->n-1)) : 0;
+	m->media16[c]=(uint16_t)(w->media*16+0.5f);
+	m->desv16[c]=(uint16_t)(desv*16+0.5f);
+	if(m->desv16[c]==0) m->desv16[c]=1;   // calibrada aunque no haya variado nada
+}
+
+/*============== CLASIFICADOR ============*/
+// Un color se confirma cuando la seal ya se asent: NEST muestras
+// filtradas seguidas a menos de ASENTADO16 (1.5 desvos: con 1, una pieza
+// un poco corrida o con la luz cambiando tarda o no se confirma nunca),
+// o sea ASENTADO_MS quieta y nunca menos que la ventana del filtro (as
+// toda la ventana es de la pieza). En el borde la seal pasa por las
+// clases de en medio sin quedarse quieta. Sale de ADC_FS: si cambia la
+// frecuencia de muestreo el tiempo de confirmacin sigue igual.
+// HIST: para pasar de un color a otro, el nuevo tiene que estar un
+// desvo ms cerca que el actual (evita el ida y vuelta en los bordes)
+#define ASENTADO_MS 8
+#define NEST_MS     (ADC_FS*ASENTADO_MS/1000)
+#define NEST        (NEST_MS > FILTRO_N ? NEST_MS : FILTRO_N)
+#if NEST > 255
+#error "NEST no entra en clasif_t.nest"
+#endif
+#define HIST16     16
+#define ASENTADO16 24
+
+typedef enum { CL_NADA=0, CL_COLOR, CL_SIN_COLOR, CL_CALIBRADA, CL_CAL_CORTA } evento_t;
+
+typedef struct {
+	color_t  actual;       // ltimo color confirmado (se mantiene sin color)
+	color_t  candidato;
+	color_t  ultima;       // clase de la ltima muestra
+	uint8_t  estab, nest;
+	uint8_t  sin_color;    // ya se avis que no hay color
+	uint8_t  confianza;    // 0..100 de la ltima muestra
+	uint16_t hist16;       // histresis: cunto ms cerca tiene que estar otra clase
+} clasif_t;
+
+static inline void clasif_init(clasif_t *k, uint8_t nest, uint16_t hist16){
+	k->actual=C_NONE; k->candidato=C_NONE; k->ultima=C_NONE;
+	k->estab=0; k->nest=nest; k->sin_color=0; k->confianza=0; k->hist16=hist16;
+}
+
+// Clase ms cercana de una muestra; confianza = cunto le gana a la segunda
+static inline color_t clasif_muestra(clasif_t *k, const modelo_t *m, uint16_t v, uint16_t *dist){
+	color_t mejor=C_NONE; uint16_t d1=0xFFFF, d2=0xFFFF;
+	for(color_t c=C_NONE; c<=C_VERDE; c++){
+		if(!m->desv16[c]) continue;
+		uint16_t d=modelo_dist(m, c, v);
+		if(d<d1){ d2=d1; d1=d; mejor=c; }
+		else if(d<d2){ d2=d; }
+	}
+	if(mejor!=C_NONE && d1>DIST_MAX16) mejor=C_NONE;   // lejos de todo
+	k->confianza = d2==0xFFFF ? 100 : (uint8_t)((uint32_t)(d2-d1)*100/(d2 ? d2 : 1));
+	*dist=d1;
+	return mejor;
+}
+
+// Una muestra filtrada. CL_COLOR: se confirm un color nuevo (k->actual);
+// CL_SIN_COLOR: primera muestra de fondo / fuera de todas las clases.
+// Para cambiar de un color confirmado a otro, el nuevo tiene que estar
+// hist16 ms cerca que el actual y a menos de ASENTADO16 de su centroide
+// durante nest muestras seguidas.
+static inline evento_t clasif_paso(clasif_t *k, const modelo_t *m, uint16_t v){
+	uint16_t d;
+	color_t c = clasif_muestra(k, m, v, &d);
+	k->ultima=c;
+	if(c==C_NONE){
+		k->estab=0;
+		if(k->sin_color) return CL_NADA;
+		k->sin_color=1;
+		return CL_SIN_COLOR;
+	}
+	k->sin_color=0;
+	if(c==k->actual){ k->estab=0; return CL_NADA; }
+	if(k->actual!=C_NONE && m->desv16[k->actual]){
+		uint16_t da=modelo_dist(m, k->actual, v);
+		if((uint32_t)d+k->hist16 >= da){ k->estab=0; return CL_NADA; }   // no gana por lo suficiente
+	}
+	if(c!=k->candidato){ k->candidato=c; k->estab=0; }
+	if(d>ASENTADO16){ k->estab=0; return CL_NADA; }   // todava en el borde
+	if(++k->estab < k->nest) return CL_NADA;
+	k->actual=c; k->estab=0;
+	return CL_COLOR;
+}
+
+/*================ PROCESO ===============*/
+#define CAL_N 1024    // muestras filtradas por clase al calibrar (~0.5 s)
+
+typedef struct {
+	filtro_t  filtro;
+	clasif_t  clasif;
+	welford_t cal;
+	welford_t cal_medio, cal_ant;   // cal hace 0-1 y 1-2 bloques de BORDE_N
+	int8_t    cal_clase;    // clase que se est calibrando (-1 = ninguna)
+	uint8_t   cal_salto;    // muestras que faltan descartar al empezar
+	color_t   calibrada;    // la que termin (con CL_CALIBRADA)
+	uint16_t  v;            // ltima muestra filtrada
+	uint8_t   listo;        // ventana del filtro llena (v vale)
+} proceso_t;
+
+static inline void proceso_init(proceso_t *p, uint8_t nest, uint16_t hist16){
+	filtro_init(&p->filtro);
+	clasif_init(&p->clasif, nest, hist16);
+	welford_init(&p->cal); p->cal_medio=p->cal; p->cal_ant=p->cal;
+	p->cal_salto=0;
+	p->cal_clase=-1; p->calibrada=C_NONE; p->v=0; p->listo=0;
+}
+
+// Las prximas CAL_N muestras filtradas van a la clase c (C_NONE = fondo),
+// despus de descartar BORDE_N (la pieza o la mano asentndose)
+static inline void proceso_calibrar(proceso_t *p, color_t c){
+	p->cal_clase=(int8_t)c;
+	welford_init(&p->cal); p->cal_medio=p->cal; p->cal_ant=p->cal;
+	p->cal_salto=BORDE_N;
+}
+
+// Una muestra cruda del ADC. Calibrando, las muestras van a la clase
+// elegida y no se clasifica; al juntar CAL_N pasa al modelo (sellado),
+// reinicia el clasificador y devuelve CL_CALIBRADA. Si la seal se va
+// lejos de lo juntado (sacaron la pieza antes) termina ah con lo que
+// haba 1-2 bloques de BORDE_N antes: el borde de salida no cuenta; con
+// menos de CAL_N/4 no aprende nada y devuelve CL_CAL_CORTA. Si no
+// calibra, lo de clasif_paso().
+// Sin la ventana llena (p->listo=0) no hay evento.
+static inline evento_t proceso_paso(proceso_t *p, modelo_t *m, uint16_t crudo){
+	p->v=filtro_paso(&p->filtro, crudo, &p->listo);
+	if(!p->listo) return CL_NADA;
+	if(p->cal_clase>=0){
+		if(p->cal_salto){ p->cal_salto--; return CL_NADA; }
+		if(p->cal.n>=BORDE_N && welford_lejos(&p->cal, p->v)){
+			if(p->cal_ant.n < CAL_N/4){ p->cal_clase=-1; return CL_CAL_CORTA; }
+			p->cal=p->cal_ant;
+		}
+		else {
+			welford_paso(&p->cal, p->v);
+			if(p->cal.n%BORDE_N==0){ p->cal_ant=p->cal_medio; p->cal_medio=p->cal; }
+			if(p->cal.n < CAL_N) return CL_NADA;
+		}
+		p->calibrada=(color_t)p->cal_clase;
+		welford_a_modelo(&p->cal, m, p->calibrada);
+		modelo_sellar(m);
+		p->cal_clase=-1;
+		clasif_init(&p->clasif, p->clasif.nest, p->clasif.hist16);
+		return CL_CALIBRADA;
+	}
+	return clasif_paso(&p->clasif, m, p->v);
+}
+
+#endif
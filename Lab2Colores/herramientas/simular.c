@@ -0,0 +1,183 @@
+/*
+ * Simulador del clasificador de Lab2Colores en la PC
+ * - Pasa un log de ADC etiquetado por el mismo filtro y clasificador que
+ *   corre en el ATmega (clasificador.h, sin cambios)
+ * - Log: una muestra cruda por lnea, "etiqueta,adc" a ADC_FS Hz; la
+ *   etiqueta es 0-4 o FONDO/ROSA/ROJO/AMARILLO/VERDE; '#' = comentario
+ * - Modelo: aprendido con Welford en la primera mitad del log (y se
+ *   evala en la otra), ledo de las lneas "M,..." del comando 'm', o
+ *   armado desde los rangos viejos (-rangos, para comparar)
+ * - Reporta acierto por muestra y por tramo, cambios equivocados y la
+ *   latencia de decisin (inicio del tramo -> color confirmado). Con
+ *   algn cambio equivocado o un tramo sin decidir (el servo a otra
+ *   caja) sale con error: as corre la prueba con trazas/cinta.csv
+ *
+ * Compilar (desde Lab2Colores):
+ *   gcc -O2 -I. -o simular herramientas/simular.c -lm
+ * Uso:
+ *   ./simular log.csv
+ *   ./simular log.csv -modelo modelo.txt -hz 2000
+ *   ./simular log.csv -rangos
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "clasificador.h"
+
+// R[] (para -rangos), NEST y HIST16: los de clasificador.h, como main.c
+static const char *NOMBRES[C_N] = {"FONDO", "ROSA", "ROJO", "AMARILLO", "VERDE"};
+
+typedef struct { uint8_t et; uint16_t adc; } muestra_t;
+
+static int etiqueta(const char *s){
+	while(isspace((unsigned char)*s)) s++;
+	if(*s>='0' && *s<'0'+C_N && !isalpha((unsigned char)s[1])) return *s-'0';
+	for(int c=0; c<C_N; c++)
+	if(!strncasecmp(s, NOMBRES[c], strlen(NOMBRES[c]))) return c;
+	return -1;
+}
+
+static muestra_t *leer_log(const char *ruta, size_t *n){
+	FILE *f=fopen(ruta, "r");
+	if(!f){ perror(ruta); exit(1); }
+	size_t cap=4096; muestra_t *m=malloc(cap*sizeof(*m));
+	char linea[128]; size_t nl=0; *n=0;
+	while(fgets(linea, sizeof(linea), f)){
+		nl++;
+		char *coma=strchr(linea, ',');
+		if(linea[0]=='#' || !coma) continue;
+		int et=etiqueta(linea);
+		if(et<0){ fprintf(stderr, "%s:%zu: etiqueta desconocida\n", ruta, nl); continue; }
+		if(*n==cap) m=realloc(m, (cap*=2)*sizeof(*m));
+		m[*n].et=(uint8_t)et; m[*n].adc=(uint16_t)atoi(coma+1);
+		(*n)++;
+	}
+	fclose(f);
+	return m;
+}
+
+static int leer_modelo(const char *ruta, modelo_t *m){
+	FILE *f=fopen(ruta, "r");
+	if(!f){ perror(ruta); return 0; }
+	memset(m, 0, sizeof(*m));
+	char linea[128]; int n=0;
+	unsigned c, media, desv;
+	while(fgets(linea, sizeof(linea), f)){
+		if(sscanf(linea, "M,%u,%u,%u", &c, &media, &desv)==3 && c<C_N){
+			m->media16[c]=(uint16_t)media; m->desv16[c]=(uint16_t)desv; n++;
+		}
+	}
+	fclose(f);
+	modelo_sellar(m);
+	return n>0;
+}
+
+// Como el modo calibracin, pero con la etiqueta de cada muestra. Las
+// primeras y ltimas BORDE_N de cada tramo no cuentan: son el borde de la
+// pieza pasando por las otras clases (inflaran los desvos)
+static void entrenar(const muestra_t *m, size_t n, modelo_t *mod){
+	welford_t w[C_N];
+	for(int c=0; c<C_N; c++) welford_init(&w[c]);
+	filtro_t fl; filtro_init(&fl);
+	size_t ini=0, fin=0;
+	for(size_t i=0; i<n; i++){
+		if(i==fin){ ini=i; while(fin<n && m[fin].et==m[ini].et) fin++; }
+		uint8_t listo;
+		uint16_t v=filtro_paso(&fl, m[i].adc, &listo);
+		if(listo && i-ini>=BORDE_N && fin-i>BORDE_N) welford_paso(&w[m[i].et], v);
+	}
+	memset(mod, 0, sizeof(*mod));
+	for(int c=0; c<C_N; c++)
+	if(w[c].n>1) welford_a_modelo(&w[c], mod, (color_t)c);
+	modelo_sellar(mod);
+}
+
+static unsigned evaluar(const muestra_t *m, size_t n, modelo_t *mod, unsigned hz){
+	proceso_t p; proceso_init(&p, NEST, HIST16);   // el mismo camino que el loop de main.c
+	const clasif_t *k=&p.clasif;
+	size_t ok_muestras=0, muestras=0;
+	unsigned tramos=0, tramos_ok=0, equivocados=0;
+	double lat_suma=0, lat_max=0;
+	size_t ini=0; int decidido=0;
+	unsigned conf_suma=0, decisiones=0;
+
+	for(size_t i=0; i<=n; i++){
+		// Fin de tramo (cambio de etiqueta o fin del log)
+		if(i==n || (i>0 && m[i].et!=m[i-1].et)){
+			// El primero puede estar cortado (la mitad del log): no cuenta
+			if(m[ini].et!=C_NONE && ini>0){
+				tramos++;
+				if(decidido) tramos_ok++;
+			}
+			if(i==n) break;
+			ini=i; decidido=0;
+		}
+		evento_t e=proceso_paso(&p, mod, m[i].adc);
+		if(!p.listo) continue;
+		muestras++;
+		if(k->ultima==m[i].et) ok_muestras++;
+		if(e==CL_COLOR){
+			conf_suma+=k->confianza; decisiones++;
+			if(k->actual!=m[i].et){ equivocados++; continue; }
+		}
+		// Decidido: el color confirmado es el del tramo (si se repite el
+		// anterior no hay evento, el servo ya est ah; cuenta al verlo)
+		if(!decidido && ini>0 && m[ini].et!=C_NONE && k->actual==m[i].et && k->ultima==m[i].et){
+			decidido=1;
+			double ms=1000.0*(i-ini+1)/hz;
+			lat_suma+=ms;
+			if(ms>lat_max) lat_max=ms;
+		}
+	}
+
+	printf("Muestras filtradas: %zu, acierto por muestra %.1f%%\n", muestras,
+	       muestras ? 100.0*ok_muestras/muestras : 0);
+	printf("Tramos de color: %u, clasificados bien %u (%.1f%%)\n", tramos, tramos_ok,
+	       tramos ? 100.0*tramos_ok/tramos : 0);
+	printf("Cambios a un color equivocado: %u\n", equivocados);
+	printf("Latencia de decisin: media %.1f ms, mx %.1f ms\n",
+	       tramos_ok ? lat_suma/tramos_ok : 0, lat_max);
+	printf("Confianza media de las decisiones: %u%%\n", decisiones ? conf_suma/decisiones : 0);
+	return equivocados + (tramos-tramos_ok);
+}
+
+int main(int argc, char **argv){
+	const char *log=NULL, *ruta_modelo=NULL;
+	unsigned hz=ADC_FS; int rangos=0;
+	for(int i=1; i<argc; i++){
+		if(!strcmp(argv[i], "-modelo") && i+1<argc) ruta_modelo=argv[++i];
+		else if(!strcmp(argv[i], "-hz") && i+1<argc) hz=(unsigned)atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-rangos")) rangos=1;
+		else log=argv[i];
+	}
+	if(!log || !hz){
+		fprintf(stderr, "uso: %s log.csv [-modelo archivo | -rangos] [-hz 2000]\n", argv[0]);
+		return 1;
+	}
+
+	if(hz!=ADC_FS) fprintf(stderr, "aviso: NEST y BORDE_N estn calculados para %d Hz\n", ADC_FS);
+
+	size_t n;
+	muestra_t *m=leer_log(log, &n);
+	if(!n){ fprintf(stderr, "%s: sin muestras\n", log); return 1; }
+
+	modelo_t mod;
+	const muestra_t *prueba=m; size_t np=n;
+	if(rangos) modelo_desde_rangos(&mod, R);
+	else if(ruta_modelo){ if(!leer_modelo(ruta_modelo, &mod)) return 1; }
+	else {
+		entrenar(m, n/2, &mod);     // primera mitad para aprender, la otra para evaluar
+		prueba=m+n/2; np=n-n/2;
+	}
+
+	printf("Modelo (x16):\n");
+	for(int c=0; c<C_N; c++)
+	printf("  M,%d,%u,%u   %s%s\n", c, mod.media16[c], mod.desv16[c], NOMBRES[c],
+	       mod.desv16[c] ? "" : " (sin calibrar)");
+	printf("Evaluando %zu muestras (%.1f s a %u Hz)\n", np, (double)np/hz, hz);
+	unsigned fallas=evaluar(prueba, np, &mod, hz);
+	free(m);
+	if(fallas){ printf("FALLA: %u cambios equivocados o tramos sin decidir\n", fallas); return 2; }
+	return 0;
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+Traza de ADC de la cinta en el formato de simular.c ("etiqueta,adc" a
+ADC_FS Hz), para la prueba del clasificador (trazas/cinta.csv).
+
+Por UART a 9600 baud no se puede sacar el ADC crudo a 2 kHz (son ~10 KB/s),
+así que la traza es sintética, con un modelo distinto al del bench del
+simulador:
+- bordes en S (no rampas rectas) de 8 a 20 ms, distintos al entrar y
+  al salir
+- cada pieza con su propio nivel (+-1 cuenta) y la luz que va y viene
+  (+-2 cuentas, ~9 s)
+- ruido gaussiano, cuantizado a cuentas, y picos sueltos de 40-120
+
+Con una captura de verdad (mismo formato) se reemplaza el archivo.
+
+Uso:
+    python3 traza_cinta.py -o trazas/cinta.csv
+    python3 traza_cinta.py --segundos 30 --semilla 3 -o otra.csv
+"""
+import argparse
+import math
+import random
+
+ADC_FS = 2000   # igual que clasificador.h
+
+# Niveles medios (ADC) y ruido de cada clase: FONDO, ROSA, ROJO, AMARILLO, VERDE
+NIVEL = [438, 521, 574, 613, 661]
+RUIDO = [3.0, 4.0, 4.5, 4.5, 5.0]
+
+
+def s_curva(x):
+    return x * x * (3 - 2 * x)
+
+
+def generar(segundos, azar):
+    n = segundos * ADC_FS
+    muestras = []
+    et, nivel = 0, NIVEL[0]
+    while len(muestras) < n:
+        sig = azar.randint(1, 4) if et == 0 else 0
+        ms = azar.uniform(150, 600) if sig == 0 else azar.uniform(120, 400)
+        destino = NIVEL[sig] + (azar.uniform(-1, 1) if sig else 0)
+        borde = int(azar.uniform(8, 20) * ADC_FS / 1000)
+        for k in range(int(ms * ADC_FS / 1000)):
+            t = len(muestras) / ADC_FS
+            base = nivel + (destino - nivel) * s_curva(k / borde) if k < borde else destino
+            v = base + 2 * math.sin(2 * math.pi * t / 9) + azar.gauss(0, RUIDO[sig])
+            if azar.random() < 0.002:
+                v += azar.choice((-1, 1)) * azar.uniform(40, 120)
+            muestras.append((sig, min(1023, max(0, round(v)))))
+        et, nivel = sig, destino
+    return muestras[:n]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-o", "--salida", required=True)
+    ap.add_argument("--segundos", type=int, default=12)
+    ap.add_argument("--semilla", type=int, default=17)
+    a = ap.parse_args()
+    muestras = generar(a.segundos, random.Random(a.semilla))
+    with open(a.salida, "w") as f:
+        f.write(f"# traza_cinta.py --segundos {a.segundos} --semilla {a.semilla}\n")
+        f.write(f"# etiqueta,adc a {ADC_FS} Hz (0=FONDO 1=ROSA 2=ROJO 3=AMARILLO 4=VERDE)\n")
+        for et, v in muestras:
+            f.write(f"{et},{v}\n")
+    print(f"{a.salida}: {len(muestras)} muestras ({len(muestras) / ADC_FS:.1f} s)")
+
+
+if __name__ == "__main__":
+    main()
@@ -3,30 +3,80 @@
 #include <util/delay.h>
 #include <stdio.h>
 #include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include "clasificador.h"   // filtro + clasificador (compila tambin en la PC)
+#include "ws2812.h"         // cuadro de la matriz por SPI (tambin)
 
 /*================ UART =================*/
 #define BAUD 9600
 #define UBRR_VALUE ((F_CPU/16/BAUD)-1)
-static int uart_putchar(char c, FILE *s){ if(c=='\n') uart_putchar('\r',s); while(!(UCSR0A&(1<<UDRE0))); UDR0=c; return 0; }
+// TX por interrupcin: printf solo copia al buffer (a 9600 baud una lnea son ~50 ms)
+#define UART_TX_N 128   // potencia de 2
+static volatile uint8_t tx_buf[UART_TX_N], tx_head, tx_tail;
+static int uart_putchar(char c, FILE *s){
+	if(c=='\n') uart_putchar('\r',s);
+	uint8_t next=(tx_head+1)&(UART_TX_N-1);
+	while(next==tx_tail);   // buffer lleno: espera a que la ISR vace
+	tx_buf[tx_head]=c; tx_head=next;
+	UCSR0B|=(1<<UDRIE0);
+	return 0;
+}
+ISR(USART_UDRE_vect){
+	if(tx_head==tx_tail){ UCSR0B&=~(1<<UDRIE0); return; }
+	UDR0=tx_buf[tx_tail]; tx_tail=(tx_tail+1)&(UART_TX_N-1);
+}
+// RX por polling: solo comandos de una letra, sin bloquear el loop
+static inline int uart_getc(void){
+	return (UCSR0A & (1<<RXC0)) ? UDR0 : -1;
+}
 FILE uart_stdout = FDEV_SETUP_STREAM(uart_putchar,NULL,_FDEV_SETUP_WRITE);
 static inline void uart_init(void){
 	UBRR0H=(uint8_t)(UBRR_VALUE>>8); UBRR0L=(uint8_t)UBRR_VALUE;
-	UCSR0B=(1<<TXEN0); UCSR0C=(1<<UCSZ01)|(1<<UCSZ00); stdout=&uart_stdout;
+	UCSR0B=(1<<TXEN0)|(1<<RXEN0); UCSR0C=(1<<UCSZ01)|(1<<UCSZ00); stdout=&uart_stdout;
 }
 
 /*================ ADC ==================*/
-#define LDR_ADC_CH 0
+// Conversiones disparadas por Timer0 (CTC a ADC_FS Hz) sin la CPU; la ISR
+// deja cada muestra en un buffer circular que vaca el main loop.
+#define LDR_ADC_CH 0      // ADC_FS (muestras/s) est en clasificador.h
+#define ADC_BUF_N  64     // potencia de 2 (32 ms a 2 kHz)
+static volatile uint16_t adc_buf[ADC_BUF_N];
+static volatile uint8_t  adc_head, adc_tail;
+static volatile uint16_t adc_perdidas;   // buffer lleno
+
 static void adc_init(void){
 	ADMUX  = (1<<REFS0) | (LDR_ADC_CH & 0x0F);               // AVcc
-	ADCSRA = (1<<ADEN) | (1<<ADPS2)|(1<<ADPS1)|(1<<ADPS0);   // presc 128
+	ADCSRB = (1<<ADTS1)|(1<<ADTS0);                          // disparo: Timer0 compare A
+	ADCSRA = (1<<ADEN)|(1<<ADATE)|(1<<ADIE) | (1<<ADPS2)|(1<<ADPS1)|(1<<ADPS0);   // presc 128
+	DIDR0  = (1<<LDR_ADC_CH);                                // sin buffer digital en el pin
+	TCCR0A = (1<<WGM01);                                     // Timer0 CTC
+	TCCR0B = (1<<CS01)|(1<<CS00);                            // presc 64
+	OCR0A  = (F_CPU/64/ADC_FS)-1;                            // 124 -> 2 kHz
 	_delay_ms(2);
 }
-static uint16_t adc_read(uint8_t ch){
-	ADMUX = (ADMUX & 0xF0) | (ch & 0x0F);
-	ADCSRA |= (1<<ADSC); while(ADCSRA & (1<<ADSC)); return ADC;
+
+// Latencia de la ISR: TCNT0 vuelve a 0 en el disparo y la conversin tarda
+// 13.5 ciclos de ADC (27 cuentas de 4 us); lo que sobre es tiempo con las
+// interrupciones tapadas (hasta ~400 us: ms que eso se pierde el disparo)
+#define ADC_TCNT_CONV 27
+static volatile uint8_t adc_tcnt_max;
+
+ISR(ADC_vect){
+	uint8_t t = TCNT0;
+	if(t > adc_tcnt_max) adc_tcnt_max = t;
+	TIFR0 = (1<<OCF0A);   // sin esto el flag no vuelve a subir y no hay prximo disparo
+	uint8_t next=(adc_head+1)&(ADC_BUF_N-1);
+	if(next==adc_tail){ adc_perdidas++; return; }
+	adc_buf[adc_head]=ADC; adc_head=next;
 }
-static uint16_t adc_avg(uint8_t ch, uint8_t n){
-	uint32_t s=0; for(uint8_t i=0;i<n;i++) s+=adc_read(ch); return (uint16_t)(s/n);
+
+// Saca una muestra del buffer; 0 si no hay. La ISR nunca escribe la
+// posicin adc_tail, as que leerla no necesita cli().
+static uint8_t adc_pop(uint16_t *v){
+	if(adc_tail==adc_head) return 0;
+	*v=adc_buf[adc_tail];
+	adc_tail=(adc_tail+1)&(ADC_BUF_N-1);
+	return 1;
 }
 
 /*================ SERVO (Timer1) =======*/
@@ -51,93 +101,72 @@ static void servo_angle(uint8_t a){
 }
 
 /*============ LGICA POR RANGOS =========*/
-typedef enum { C_NONE=0, C_ROSA, C_ROJO, C_AMARILLO, C_VERDE } color_t;
-
-typedef struct {
-	const char *nombre;
-	uint16_t low, high;   // rango [LOW..HIGH] ADC
-	uint8_t  ang;         // ngulo del servo para ese color
-	uint8_t  rgb[3];      // Color RGB para los LEDs
-} rango_t;
-
-// RANGOS MODIFICADOS - sin solapamientos
-static rango_t R[] = {
-	[C_ROSA]     = {"ROSA",     500, 540,   0, {255, 0, 80}},
-	[C_ROJO]     = {"ROJO",     560, 590,  60, {255, 0, 0}},
-	[C_AMARILLO] = {"AMARILLO", 600, 630, 120, {255, 255, 0}},
-	[C_VERDE]    = {"VERDE",    640, 680, 180, {0, 255, 0}},
-};
+// color_t, rango_t y los rangos R[] estn en clasificador.h
+
+/*============ MODELO (EEPROM) ===========*/
+// Media y desvo por clase, aprendidos por UART (ver comandos en main).
+// Sin modelo vlido en la EEPROM se arranca desde los rangos de arriba.
+EEMEM modelo_t modelo_ee;
+static modelo_t modelo;
 
-static inline color_t detectar(uint16_t v){
-	for(color_t c=C_ROSA; c<=C_VERDE; c++)
-	if(v>=R[c].low && v<=R[c].high) return c;
-	return C_NONE;
+static void modelo_cargar(void){
+	eeprom_read_block(&modelo, &modelo_ee, sizeof(modelo));
+	if(!modelo_valido(&modelo)) modelo_desde_rangos(&modelo, R);
 }
 
 static inline uint16_t sp_mid(color_t c){
-	return (uint16_t)((R[c].low + R[c].high)/2);
+	return (uint16_t)((modelo.media16[c]+8)/16);
+}
+
+static void modelo_imprimir(void){
+	for(color_t c=C_NONE; c<=C_VERDE; c++)
+	printf("M,%u,%u,%u\n", c, modelo.media16[c], modelo.desv16[c]);
 }
 
-// LEDS
-#define LED 3
+/*========== LEDS WS2812 (SPI) ===========*/
+// Matriz 8x8 por el SPI por hardware: DIN en MOSI (PB3). Los cdigos de
+// cada bit, la carga del SPI y los bajos que la tira tiene que aguantar
+// estn en ws2812.h; ac solo cundo se manda un cuadro.
 #define WIDTH 8
 #define HEIGHT 8
 #define NUM_LEDS (WIDTH * HEIGHT)
 
 uint8_t leds[NUM_LEDS][3];
+static uint8_t ws_sucio;             // hay cambios sin mandar
+static uint16_t ws_ultimo;           // reloj del ltimo cuadro (para el latch)
 
-void sendBit(uint8_t bitVal);
-void sendByte(uint8_t byte);
-void show(uint8_t (*colors)[3]);
-void setLedRGB(uint8_t (*leds)[3], int ledIndex, uint8_t r, uint8_t g, uint8_t b);
-void fillAllLedsRGB(uint8_t r, uint8_t g, uint8_t b);
-
-void sendBit(uint8_t bitVal){
-	if(bitVal){
-		PORTD |= (1 << LED);
-		asm volatile (
-		"nop\n\t""nop\n\t""nop\n\t""nop\n\t""nop\n\t"
-		"nop\n\t""nop\n\t""nop\n\t""nop\n\t"
-		);
-		PORTD &= ~ (1 << LED);
-		asm volatile(
-		"nop\n\t""nop\n\t""nop\n\t""nop\n\t"
-		);
-		} else {
-		PORTD |= (1 << LED);
-		asm volatile(
-		"nop\n\t""nop\n\t""nop\n\t"
-		);
-		PORTD &= ~(1 << LED);
-		asm volatile(
-		"nop\n\t""nop\n\t""nop\n\t""nop\n\t""nop\n\t"
-		"nop\n\t""nop\n\t""nop\n\t""nop\n\t""nop\n\t"
-		);
-	}
-}
+// Mtricas (comando 'w'): TCNT1 cuenta a 2 MHz con el servo (0.5 us)
+static uint16_t ws_cuadros, ws_max_us, anim_cuadros;
 
-void sendByte(uint8_t byte){
-	for(uint8_t i = 0; i < 8; i++){
-		sendBit(byte & (1 << (7-i)));
-	}
+static void ws_stats(void){
+	uint8_t t = adc_tcnt_max;
+	printf("W,cuadros=%u,animados=%u,max_us=%u,isr_lat_us=%u\n", ws_cuadros, anim_cuadros, ws_max_us,
+	t > ADC_TCNT_CONV ? (t - ADC_TCNT_CONV) * 4 : 0);
+	ws_cuadros = anim_cuadros = ws_max_us = 0;
+	adc_tcnt_max = 0;
 }
 
-void show(uint8_t (*colors)[3]){
-	cli();
-	for (int i = 0; i < NUM_LEDS; i++){
-		sendByte(colors[i][1]); // G
-		sendByte(colors[i][0]); // R
-		sendByte(colors[i][2]); // B
-	}
-	sei();
-	_delay_us(60);
+// Manda el cuadro solo si cambi algo. ~2 ms de CPU (las ISR siguen
+// corriendo); 'ahora' en ticks de reloj para respetar el latch (> 0.5 ms)
+static void ws_mostrar(uint16_t ahora){
+	if(!ws_sucio) return;
+	if((uint16_t)(ahora - ws_ultimo) < 2) return;
+	uint16_t t0 = TCNT1;
+	ws_cuadro(leds, NUM_LEDS);
+	uint16_t t1 = TCNT1;
+	uint16_t us = (uint16_t)((t1 >= t0 ? t1 - t0 : t1 + SERVO_TIMER_TOP - t0) / 2);
+	if(us > ws_max_us) ws_max_us = us;
+	ws_cuadros++;
+	ws_sucio = 0;
+	ws_ultimo = ahora;
 }
 
 void setLedRGB(uint8_t (*leds)[3], int ledIndex, uint8_t r, uint8_t g, uint8_t b){
 	if (ledIndex < 0 || ledIndex >= NUM_LEDS) return;
-	leds[ledIndex][0]=r;
-	leds[ledIndex][1]=g;
-	leds[ledIndex][2]=b;
+	uint8_t *l = leds[ledIndex];
+	if(l[0]==r && l[1]==g && l[2]==b) return;
+	l[0]=r; l[1]=g; l[2]=b;
+	ws_sucio = 1;
 }
 
 void fillAllLedsRGB(uint8_t r, uint8_t g, uint8_t b){
@@ -146,26 +175,80 @@ void fillAllLedsRGB(uint8_t r, uint8_t g, uint8_t b){
 	}
 }
 
-// Funcin para aplicar el color actual a los LEDs
-void aplicar_color_actual(color_t color_actual){
-	switch(color_actual){
-		case C_ROSA:
-		fillAllLedsRGB(R[C_ROSA].rgb[0], R[C_ROSA].rgb[1], R[C_ROSA].rgb[2]);
-		break;
-		case C_ROJO:
-		fillAllLedsRGB(R[C_ROJO].rgb[0], R[C_ROJO].rgb[1], R[C_ROJO].rgb[2]);
-		break;
-		case C_AMARILLO:
-		fillAllLedsRGB(R[C_AMARILLO].rgb[0], R[C_AMARILLO].rgb[1], R[C_AMARILLO].rgb[2]);
-		break;
-		case C_VERDE:
-		fillAllLedsRGB(R[C_VERDE].rgb[0], R[C_VERDE].rgb[1], R[C_VERDE].rgb[2]);
+/*============ ANIMACIONES ===============*/
+// Cuadros cada ANIM_CUADRO ticks (2 ticks = 1 ms) mientras haya una
+// animacin; al terminar queda el color final y no se manda nada ms
+#define ANIM_CUADRO 40    // 20 ms -> 50 cuadros/s, ~10% de CPU mientras dura
+
+typedef enum { ANIM_NADA=0, ANIM_FUNDIDO, ANIM_BARRIDO, ANIM_LATIDO } anim_tipo_t;
+
+typedef struct { anim_tipo_t tipo; uint16_t ms; } patron_t;
+
+// Patrn con el que entra cada color
+static const patron_t PATRON[C_N] = {
+	[C_NONE]     = {ANIM_FUNDIDO, 300},
+	[C_ROSA]     = {ANIM_FUNDIDO, 250},
+	[C_ROJO]     = {ANIM_BARRIDO, 200},
+	[C_AMARILLO] = {ANIM_FUNDIDO, 250},
+	[C_VERDE]    = {ANIM_BARRIDO, 200},
+};
+
+static struct {
+	anim_tipo_t tipo;
+	uint8_t  desde[3], hacia[3];
+	uint16_t t0, dur, ult;   // en ticks
+} anim;
+
+// Arranca desde el color que se est mostrando (el destino de la anterior)
+static void anim_empezar(anim_tipo_t tipo, const uint8_t *rgb, uint16_t ms, uint16_t ahora){
+	for(uint8_t i=0;i<3;i++){ anim.desde[i]=anim.hacia[i]; anim.hacia[i]=rgb[i]; }
+	anim.tipo = tipo;
+	anim.dur = ms ? ms*2 : 1;
+	anim.t0 = ahora;
+	anim.ult = ahora - ANIM_CUADRO;   // primer cuadro ya
+}
+
+static inline uint8_t mezclar(uint8_t a, uint8_t b, uint16_t k){   // k en 0..256
+	return (uint8_t)(a + (((int32_t)b - a) * k >> 8));
+}
+
+static void anim_paso(uint16_t ahora){
+	if(anim.tipo == ANIM_NADA) return;
+	if((uint16_t)(ahora - anim.ult) < ANIM_CUADRO) return;
+	anim.ult = ahora;
+	anim_cuadros++;
+	uint16_t t = ahora - anim.t0;
+	uint16_t k = t >= anim.dur ? 256 : (uint16_t)((uint32_t)t * 256 / anim.dur);
+
+	switch(anim.tipo){
+		case ANIM_FUNDIDO:
+		fillAllLedsRGB(mezclar(anim.desde[0], anim.hacia[0], k), mezclar(anim.desde[1], anim.hacia[1], k),
+		mezclar(anim.desde[2], anim.hacia[2], k));
 		break;
+		case ANIM_BARRIDO: {   // columna a columna, de izquierda a derecha
+			uint8_t cols = (uint8_t)((k * WIDTH + 255) >> 8);
+			for(uint8_t i = 0; i < NUM_LEDS; i++){
+				const uint8_t *c = (i % WIDTH) < cols ? anim.hacia : anim.desde;
+				setLedRGB(leds, i, c[0], c[1], c[2]);
+			}
+		} break;
+		case ANIM_LATIDO: {    // sube y baja entre 1/4 y todo el brillo, sin fin
+			uint16_t f = (uint16_t)((uint32_t)(t % anim.dur) * 512 / anim.dur);
+			uint16_t b = 64 + ((f < 256 ? f : 511 - f) * 3 >> 2);
+			fillAllLedsRGB(mezclar(0, anim.hacia[0], b), mezclar(0, anim.hacia[1], b), mezclar(0, anim.hacia[2], b));
+			return;
+		}
 		default:
-		// C_NONE - no hacer nada, mantener el color anterior
 		break;
 	}
-	show(leds);
+	if(k >= 256) anim.tipo = ANIM_NADA;
+}
+
+// Funcin para aplicar el color actual a los LEDs (con el patrn de su clase)
+void aplicar_color_actual(color_t color_actual, uint16_t ahora){
+	static const uint8_t apagado[3] = {0, 0, 0};
+	const uint8_t *rgb = color_actual == C_NONE ? apagado : R[color_actual].rgb;
+	anim_empezar(PATRON[color_actual].tipo, rgb, PATRON[color_actual].ms, ahora);
 }
 
 /*================ MAIN =================*/
@@ -175,37 +258,66 @@ int main(void){
 	adc_init();
 	servo_init();
 	
-	// INICIALIZACIN DEL LED
-	DDRD |= (1 << LED);  // Configurar PD3 como salida
-	PORTD &= ~(1 << LED); // Inicialmente apagado
+	ws_init();
 	
 	// Inicializar matriz de LEDs apagada
-	for(int i = 0; i < NUM_LEDS; i++){
-		setLedRGB(leds, i, 0, 0, 0);
-	}
-	show(leds);
+	ws_sucio = 1;
+	ws_ultimo = (uint16_t)-2;
+	ws_mostrar(0);
 	
 	sei();
 
-	color_t actual = C_NONE;
-	uint8_t estab = 0, NEST = 3;   // 3 lecturas consecutivas para confirmar
+	// NEST y HIST16 (confirmacin e histresis) estn en clasificador.h
+	#define LOG_CADA 16   // 'l': una de cada 16 muestras filtradas (125/s a 9600 baud)
+	proceso_t proc; proceso_init(&proc, NEST, HIST16);   // filtro + calibracin + clasificador
+	modelo_cargar();
+
+	uint8_t  log_on = 0, log_cnt = 0;
+	uint16_t reloj = 0;         // muestras del ADC: 2 ticks por ms
+	static const uint8_t BLANCO_TENUE[3] = {40, 40, 40};
 
 	printf("Sistema iniciado - Esperando deteccin de colores...\n");
+	printf("Comandos: 0-4 calibrar clase (0=fondo), g guardar, m modelo, r rangos, l log, w leds\n");
 
 	while(1){
-		uint16_t v = adc_avg(LDR_ADC_CH, 32);   // suavizado
-		color_t c = detectar(v);
-
-		if(c == actual){
-			estab = 0;
+		int cmd = uart_getc();
+		if(cmd >= '0' && cmd <= '0'+C_VERDE){
+			proceso_calibrar(&proc, (color_t)(cmd-'0'));
+			printf("Calibrando clase %d (%s)...\n", proc.cal_clase, proc.cal_clase ? R[proc.cal_clase].nombre : "FONDO");
+			anim_empezar(ANIM_LATIDO, BLANCO_TENUE, 1000, reloj);
 		}
-		else if(c != C_NONE){
-			if(++estab >= NEST){
-				actual = c;
-				estab = 0;
-				
+		else if(cmd == 'g'){
+			modelo_sellar(&modelo);
+			eeprom_update_block(&modelo, &modelo_ee, sizeof(modelo));
+			printf("Modelo guardado\n");
+		}
+		else if(cmd == 'm') modelo_imprimir();
+		else if(cmd == 'r'){ modelo_desde_rangos(&modelo, R); printf("Modelo desde rangos\n"); }
+		else if(cmd == 'l'){ log_on = !log_on; }
+		else if(cmd == 'w') ws_stats();
+
+		uint16_t crudo;
+		while(adc_pop(&crudo)){
+			reloj++;
+			evento_t e = proceso_paso(&proc, &modelo, crudo);   // mediana 3 + media 16 + clase
+			if(!proc.listo) continue;
+			uint16_t v = proc.v;
+
+			if(log_on && ++log_cnt >= LOG_CADA){ log_cnt = 0; printf("L,%u\n", v); }
+
+			if(e == CL_CALIBRADA){
+				color_t c = proc.calibrada;
+				printf("Clase %d: media=%u desv=%u (x16)\n", c, modelo.media16[c], modelo.desv16[c]);
+				aplicar_color_actual(C_NONE, reloj);
+			}
+			else if(e == CL_CAL_CORTA){
+				printf("Calibracin cortada: la seal cambi (dejar la pieza quieta)\n");
+				aplicar_color_actual(C_NONE, reloj);
+			}
+			else if(e == CL_COLOR){
+				color_t c = proc.clasif.actual;
 				// SWITCH para controlar el servomotor segn el color
-				switch(actual){
+				switch(c){
 					case C_ROSA:
 					servo_angle(R[C_ROSA].ang);
 					printf("Color ROSA detectado - Servo en 0\n");
@@ -228,21 +340,21 @@ int main(void){
 				}
 				
 				// Aplicar el color a los LEDs
-				aplicar_color_actual(actual);
+				aplicar_color_actual(c, reloj);
 				
 				// Log adicional
 				uint16_t sp = sp_mid(c);
 				int16_t dif = (int16_t)sp - (int16_t)v;
-				printf("LDR=%u | Color=%s | SP=%u | Dif=%d\n", v, R[c].nombre, sp, dif);
+				printf("LDR=%u | Color=%s | SP=%u | Dif=%d | Conf=%u%% | Perdidas=%u\n", v, R[c].nombre, sp, dif, proc.clasif.confianza, adc_perdidas);
+			}
+			else if(e == CL_SIN_COLOR){
+				// Se avisa una vez al ver fondo o nada conocido; se mantiene el ltimo color
+				printf("Ningn color detectado - ADC: %u | Manteniendo color anterior\n", v);
 			}
 		}
-		else {
-			// Cuando no se detecta color, mantener el color actual (ltimo detectado)
-			// No cambiamos 'actual', as que mantiene su ltimo valor vlido
-			estab = 0;
-			printf("Ningn color detectado - ADC: %u | Manteniendo color anterior\n", v);
-		}
-
-		_delay_ms(10);
+		// Sin esperas: la CPU queda libre entre muestras (servo por hardware,
+		// UART por interrupcin, LEDs solo mientras hay animacin y cambi algo)
+		anim_paso(reloj);
+		ws_mostrar(reloj);
 	}
 }
\ No newline at end of file
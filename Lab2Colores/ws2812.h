@@ -0,0 +1,64 @@
+/*
+ * Cuadro del WS2812 por el SPI por hardware (Lab2Colores)
+ * - Solo SPCR/SPSR/SPDR y el puerto B de <avr/io.h>: compila tambin en
+ *   la PC (SimuladorHost/pruebas/prueba_ws.c le pone un SPI que cuenta
+ *   ciclos y le mete las ISR de main.c en el medio)
+ * - A 8 MHz cada bit del WS2812 es un byte de SPI: WS_0 = 375 ns arriba
+ *   y 625 abajo, WS_1 = 750 y 250; el SPI arma el pulso solo, la CPU
+ *   nada ms carga el prximo byte, con las interrupciones habilitadas
+ * - Todos los cdigos empiezan en 1 y terminan en 0: entre byte y byte
+ *   MOSI se queda con el ltimo bit, as que cualquier demora de la CPU
+ *   alarga el bajo del bit anterior y nunca el alto
+ *
+ * Requisito para la tira: SPDR no tiene buffer doble (el prximo byte se
+ * carga recin cuando SPIF avisa que termin el anterior), as que TODOS
+ * los bajos salen estirados. Segn prueba_ws.c, el bajo de un 0 (625 ns
+ * nominal) sale de ~0.9 us dentro de un color y de ~1.5 us entre LED y
+ * LED (la vuelta del for); si cae una ISR en el medio (ADC o UART, ~5 us
+ * cada una) llega a ~11 us. La tira tiene que aguantar al menos 1 us de
+ * ms en cualquier bajo y bajos de hasta WS_BAJO_MAX_US sin cortar el
+ * cuadro (la hoja de datos pide > 50 us para el latch; hay WS2812 que
+ * cortan bastante antes: con esos la matriz muestra colores corridos)
+ */
+#ifndef WS2812_H
+#define WS2812_H
+
+#include <stdint.h>
+
+#define WS_PIN   PB3      // MOSI
+#define WS_SCK   PB5
+#define WS_SS    PB2      // tiene que ser salida para que el SPI siga en maestro
+#define WS_0     0xE0
+#define WS_1     0xFC
+#define WS_SPI_CICLOS  2  // ciclos de CPU por bit de SPI (fosc/2)
+#define WS_BAJO_MAX_US 25 // el bajo ms largo que puede salir (prueba_ws.c)
+
+static inline void ws_init(void){
+	DDRB |= (1<<WS_PIN)|(1<<WS_SCK)|(1<<WS_SS);
+	PORTB &= ~(1<<WS_PIN);
+	SPCR = (1<<SPE)|(1<<MSTR);        // modo 0, MSB primero, fosc/4...
+	SPSR = (1<<SPI2X);                // ...x2 = 8 MHz
+}
+
+// El cdigo del bit se arma antes de esperar: mientras sale el byte
+// anterior (16 ciclos) hay tiempo de sobra
+static inline void ws_byte(uint8_t b){
+	for(uint8_t m=0x80; m; m>>=1){
+		uint8_t x = (b & m) ? WS_1 : WS_0;
+		while(!(SPSR & (1<<SPIF)));
+		SPDR = x;
+	}
+}
+
+// Un cuadro entero, G-R-B por LED; vuelve con la lnea en bajo
+static inline void ws_cuadro(uint8_t (*leds)[3], uint8_t n){
+	SPDR = 0;                         // primer byte en bajo: arranca SPIF
+	for(uint8_t i = 0; i < n; i++){
+		ws_byte(leds[i][1]); // G
+		ws_byte(leds[i][0]); // R
+		ws_byte(leds[i][2]); // B
+	}
+	while(!(SPSR & (1<<SPIF)));
+}
+
+#endif
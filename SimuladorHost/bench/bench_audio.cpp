@@ -0,0 +1,248 @@
+/****************************************************
+ * Bench de audio: AudioPipeline + AudioGeneratorIMA
+ * tal cual, con la fuente HTTP de Vocesconwifiperfecto
+ * (AudioFileSourceHTTPStream, SetReconnect(3, 200))
+ * contra el mock del server y cada perfil de red
+ * - Un clip de voz sintética de 3 s a 16 kHz, en WAV
+ *   PCM y en IMA-ADPCM (?fmt=ima), mismos tamaños de
+ *   ring y prebuffer que el sketch
+ * - Mide: primer audio (desde que se crea la fuente),
+ *   underruns del decoder, espera más larga, huecos
+ *   en el DMA (lo que se oye) y reconexiones
+ * - Comandos mientras suena: CommandChannel y el loop()
+ *   de Vocesconwifiperfecto.cpp (routeCommand y
+ *   delay(1)) con un clip largo sonando; volumen y al
+ *   final detener, encolados en el server. Mide del
+ *   encolado a la acción (detener: hasta que calla)
+ * - Tiempo virtual: mismos números en cada corrida
+ *   (SIM_SEMILLA cambia la semilla)
+ ****************************************************/
+#include <Arduino.h>
+#include <AudioFileSourceHTTPStream.h>
+#include <AudioOutputI2SNoDAC.h>
+#include <algorithm>
+#include "AudioPipeline.h"
+#include "CommandChannel.h"
+#include "ImaAdpcm.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+// Los de Vocesconwifiperfecto.cpp
+const size_t AUDIO_RING_BYTES      = 64 * 1024;
+const size_t AUDIO_PREBUFFER_BYTES = 12 * 1024;
+const size_t AUDIO_PREBUFFER_IMA   = 3 * 1024;
+
+const uint32_t RATE = 16000;
+const uint32_t CLIP_MS = 3000;
+const char*    BASE_URL = "http://server:8000";
+
+AudioPipeline        pipeline;
+AudioOutputI2SNoDAC* dac = nullptr;
+AudioOutputKeepOpen* out = nullptr;
+
+// Dos parciales con envolvente de sílabas (~4 por segundo)
+std::string clipVoz(uint32_t ms = CLIP_MS) {
+  size_t n = (size_t)RATE * ms / 1000;
+  std::vector<int16_t> m(n);
+  for (size_t i = 0; i < n; i++) {
+    double t = (double)i / RATE;
+    double env = 0.5 + 0.5 * sin(2 * PI * 4 * t);
+    double v = 0.6 * sin(2 * PI * 180 * t) + 0.3 * sin(2 * PI * 720 * t) + 0.05 * sim::azar().normal();
+    m[i] = (int16_t)constrain(v * env * 12000, -32768.0, 32767.0);
+  }
+  return sim::ServidorMock::wavPcm(m.data(), n, RATE);
+}
+
+struct Resultado {
+  uint32_t bytes;
+  uint32_t primerMs;
+  uint32_t underruns;
+  uint32_t esperaMaxMs;
+  AudioOutputI2SNoDAC::Stats dac;
+  uint32_t reconexiones;
+  bool     ok;
+};
+
+Resultado reproducir(bool ima) {
+  char url[128];
+  snprintf(url, sizeof(url), "%s/esp32/audio_raw/clip%s", BASE_URL, ima ? "?fmt=ima" : "");
+  dac->reiniciar();
+  uint64_t t0 = sim::ahoraUs();
+  AudioFileSourceHTTPStream* src = new AudioFileSourceHTTPStream(url);
+  src->SetReconnect(3, 200);
+  AudioGeneratorIMA* gen = new AudioGeneratorIMA();
+  pipeline.setPrebuffer(ima ? AUDIO_PREBUFFER_IMA : AUDIO_PREBUFFER_BYTES);
+
+  Resultado r = {};
+  r.bytes = src->getSize();
+  if (pipeline.play(src, gen, out)) {
+    while (pipeline.isBusy()) vTaskDelay(pdMS_TO_TICKS(20));
+  }
+  AudioPipelineStats st = pipeline.stats();
+  r.primerMs = dac->primeraUs() ? (uint32_t)((dac->primeraUs() - t0) / 1000) : 0;
+  r.underruns = st.underruns;
+  r.esperaMaxMs = st.maxStallMs;
+  r.dac = dac->stats();
+  r.reconexiones = src->reconexiones();
+  // Completo y sin repetir (la reconexión de la librería vuelve a empezar
+  // el archivo)
+  r.ok = pipeline.started() && pipeline.lastOk() && r.dac.muestras == RATE * CLIP_MS / 1000;
+  out->close();
+  delete gen;
+  delete src;
+  return r;
+}
+
+uint32_t percentil(std::vector<uint32_t>& v, double p) {
+  if (v.empty()) return 0;
+  size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+  return v[i];
+}
+
+// ====== Comandos mientras suena ======
+const uint32_t LARGO_MS   = 10000;   // el clip que suena
+const uint32_t VOLUMEN_MS = 400;     // un cambio de volumen cada ~400 ms
+const char*    DEVICE     = "robot-audio";
+
+CommandChannel*       canal = nullptr;
+std::vector<uint32_t> accionMs;      // encolado -> handler, volumen
+uint32_t              detenerMs = 0; // encolado -> el DMA queda vacío
+volatile bool         detenido = false;
+volatile bool         loopCorre = false;
+
+uint32_t encoladoMs(JsonObject c) {
+  return (uint32_t)(sim::servidor().encoladoUs(DEVICE, c["seq"] | 0) / 1000);
+}
+
+void cmdVolumen(JsonObject c, uint32_t) {
+  out->SetGain(constrain((int)(c["volume"] | 50), 0, 100) / 100.0f);
+  accionMs.push_back(millis() - encoladoMs(c));
+}
+
+void cmdDetener(JsonObject c, uint32_t) {
+  pipeline.stop();
+  uint64_t calla = std::max(dac->finUs(), sim::ahoraUs());   // lo que ya está en el DMA suena igual
+  detenerMs = (uint32_t)(calla / 1000) - encoladoMs(c);
+  detenido = true;
+}
+
+const CommandRoute RUTAS[] = {
+  { "detener",        cmdDetener },
+  { "musica_volumen", cmdVolumen },
+};
+
+// processCommands() + delay(1), como loop() del sketch
+void loopSketch(void*) {
+  static StaticJsonDocument<768> doc;
+  static CommandChannel::Command cmd;
+  while (loopCorre) {
+    while (canal->receive(cmd)) {
+      if (deserializeJson(doc, cmd.json)) continue;
+      routeCommand(RUTAS, doc.as<JsonObject>(), cmd.tRecv);
+    }
+    delay(1);
+  }
+  vTaskDelete(nullptr);
+}
+
+void comandos(size_t perfil, bool largo) {
+  sim::usarPerfil(sim::PERFILES[perfil]);
+  sim::azar().sembrar(sim::semilla() * 1000 + 100 + perfil * 2 + largo);
+  sim::servidor().sinLongPoll(!largo);
+  accionMs.clear();
+  detenido = false;
+
+  canal = new CommandChannel();
+  CommandChannel::Config cfg;
+  cfg.baseUrl  = BASE_URL;
+  cfg.deviceId = DEVICE;
+  if (!canal->begin(cfg)) {
+    printf("No se pudo crear el canal\n");
+    sim::fin(1);
+  }
+  loopCorre = true;
+  xTaskCreate(loopSketch, "loop", 8192, nullptr, 1, nullptr);
+
+  char url[128];
+  snprintf(url, sizeof(url), "%s/esp32/audio_raw/largo?fmt=ima", BASE_URL);
+  dac->reiniciar();
+  AudioFileSourceHTTPStream* src = new AudioFileSourceHTTPStream(url);
+  src->SetReconnect(3, 200);
+  AudioGeneratorIMA* gen = new AudioGeneratorIMA();
+  pipeline.setPrebuffer(AUDIO_PREBUFFER_IMA);
+  pipeline.play(src, gen, out);
+  while (!pipeline.started() && pipeline.isBusy()) vTaskDelay(pdMS_TO_TICKS(5));
+
+  // Volumen al azar mientras suena; detener cuando falta ~1 s
+  uint32_t t0 = millis(), enviados = 0;
+  while (millis() - t0 < LARGO_MS - 1000) {
+    vTaskDelay(pdMS_TO_TICKS(1 + (uint32_t)sim::azar().exponencial(VOLUMEN_MS)));
+    char campos[64];
+    snprintf(campos, sizeof(campos), "\"tipo\":\"musica_volumen\",\"volume\":%u", 20 + (unsigned)(millis() % 80));
+    sim::servidor().encolar(DEVICE, campos);
+    enviados++;
+  }
+  sim::servidor().encolar(DEVICE, "\"tipo\":\"detener\"");
+  uint32_t tDetener = millis();
+  while (!detenido && millis() - tDetener < 30000) vTaskDelay(pdMS_TO_TICKS(5));
+
+  AudioOutputI2SNoDAC::Stats st = dac->stats();
+  std::sort(accionMs.begin(), accionMs.end());
+  uint32_t dentro = std::count_if(accionMs.begin(), accionMs.end(), [&](uint32_t ms) { return ms <= cfg.pollIntervalMs; });
+  printf("%-10s %-9s %5u %5u %6u %6u %6u %7.0f%% %11s %7u\n", sim::PERFILES[perfil].nombre,
+         largo ? "long-poll" : "poll", enviados, (unsigned)accionMs.size(), percentil(accionMs, 0.50),
+         percentil(accionMs, 0.99), accionMs.empty() ? 0 : accionMs.back(),
+         accionMs.empty() ? 0.0 : 100.0 * dentro / accionMs.size(),
+         detenido ? std::to_string(detenerMs).c_str() : "no llegó", st.huecos);
+
+  loopCorre = false;
+  canal->end();
+  while (canal->activo()) vTaskDelay(pdMS_TO_TICKS(100));
+  out->close();
+  delete gen;
+  delete src;
+}
+
+void principal(void*) {
+  sim::servidor().agregarAudio("clip", clipVoz());
+  sim::servidor().agregarAudio("largo", clipVoz(LARGO_MS));
+
+  AudioPipeline::Config acfg;
+  acfg.ringBytes      = AUDIO_RING_BYTES;
+  acfg.prebufferBytes = AUDIO_PREBUFFER_BYTES;
+  if (!pipeline.begin(acfg)) {
+    printf("No se pudo crear el pipeline\n");
+    sim::fin(1);
+  }
+  dac = new AudioOutputI2SNoDAC();
+  dac->SetOutputModeMono(true);
+  out = new AudioOutputKeepOpen(dac);
+
+  printf("== Audio: pipeline + IMA, clip de %u ms a %u Hz (semilla %llu) ==\n", CLIP_MS, RATE,
+         (unsigned long long)sim::semilla());
+  printf("%-10s %-4s %7s %9s %9s %10s %7s %10s %8s %4s\n", "perfil", "fmt", "bytes", "primer_ms",
+         "underruns", "espera_ms", "huecos", "silencio_ms", "reconex", "ok");
+  for (size_t p = 0; p < sim::N_PERFILES; p++) {
+    for (int ima = 0; ima < 2; ima++) {
+      sim::usarPerfil(sim::PERFILES[p]);
+      sim::azar().sembrar(sim::semilla() * 1000 + p * 2 + ima);   // cada caso, su propia serie
+      Resultado r = reproducir(ima);
+      printf("%-10s %-4s %7u %9u %9u %10u %7u %10.1f %8u %4s\n", sim::PERFILES[p].nombre, ima ? "ima" : "pcm",
+             r.bytes, r.primerMs, r.underruns, r.esperaMaxMs, r.dac.huecos, r.dac.huecosUs / 1000.0,
+             r.reconexiones, r.ok ? "sí" : "NO");
+    }
+  }
+  printf("\n");
+
+  printf("== Comandos mientras suena: clip IMA de %u ms, volumen cada ~%u ms y detener ==\n", LARGO_MS, VOLUMEN_MS);
+  printf("%-10s %-9s %5s %5s %6s %6s %6s %8s %11s %7s\n", "perfil", "modo", "cmds", "aplic", "p50_ms",
+         "p99_ms", "max_ms", "<=200ms", "detener_ms", "huecos");
+  for (size_t p = 0; p < sim::N_PERFILES; p++) {
+    comandos(p, true);
+    comandos(p, false);
+  }
+  printf("\n");
+  sim::fin(0);
+}
+
+int main() { sim::correr(principal); }
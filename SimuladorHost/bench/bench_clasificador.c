@@ -0,0 +1,163 @@
+/*
+ * Bench del clasificador de Lab2Colores: filtro + clasificador.h tal
+ * cual (rangos, NEST y HIST16 de ahí, como main.c) con el ADC y el servo
+ * del simulador
+ * - Señal sintética etiquetada a ADC_FS: fondo entre piezas, piezas de
+ *   los 4 colores con la media de los rangos de main.c, ruido, rampas
+ *   al entrar/salir del sensor y picos sueltos
+ * - Igual que Lab2Colores/herramientas/simular.c: la primera mitad
+ *   entrena (Welford) y la segunda se evalúa, muestra a muestra en
+ *   tiempo virtual; las rampas pasan por los colores intermedios. Un
+ *   cambio a un color equivocado (el servo a otra caja) es una falla:
+ *   el programa sale con error
+ * - Cada color confirmado mueve el servo (SG90, ~600 grados/s): se mide
+ *   la decisión y cuándo el servo llega a su ángulo
+ * - "muestras/s en host" es lo único que depende de la PC
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "clasificador.h"
+#include "SimC.h"
+
+#define SEG     60            /* segundos de señal */
+#define N       (ADC_FS*SEG)
+
+static const char *NOMBRES[C_N] = {"FONDO", "ROSA", "ROJO", "AMARILLO", "VERDE"};
+
+#define FONDO_ADC 440
+
+typedef struct { uint8_t et; uint16_t adc; } muestra_t;
+static muestra_t M[N];
+
+static double media(uint8_t c){ return c==C_NONE ? FONDO_ADC : (R[c].low+R[c].high)/2.0; }
+static double desvio(uint8_t c){ return c==C_NONE ? 3 : (R[c].high-R[c].low)/6.0; }
+
+/* Fondo 250-700 ms, pieza 150-450 ms; rampa de 15 ms entre niveles */
+static void generar(void){
+	size_t i=0; uint8_t et=C_NONE; double antes=FONDO_ADC;
+	while(i<N){
+		uint8_t sig = et==C_NONE ? (uint8_t)(1+(int)(sim_azar_uniforme()*4)) : C_NONE;
+		unsigned ms = sig==C_NONE ? 250+(unsigned)(sim_azar_uniforme()*450) : 150+(unsigned)(sim_azar_uniforme()*300);
+		size_t n=(size_t)ms*ADC_FS/1000, rampa=15*ADC_FS/1000;
+		for(size_t k=0; k<n && i<N; k++, i++){
+			double nivel = k<rampa ? antes+(media(sig)-antes)*k/rampa : media(sig);
+			double v = nivel + desvio(sig)*sim_azar_normal();
+			if(sim_azar_uniforme()<0.002) v += sim_azar_uniforme()<0.5 ? -80 : 80;
+			M[i].et=sig;
+			M[i].adc=(uint16_t)(v<0 ? 0 : v>1023 ? 1023 : v);
+		}
+		antes=media(sig); et=sig;
+	}
+}
+
+/* Como simular.c: sin las primeras y últimas BORDE_N de cada tramo */
+static void entrenar(const muestra_t *m, size_t n, modelo_t *mod){
+	welford_t w[C_N];
+	for(int c=0; c<C_N; c++) welford_init(&w[c]);
+	filtro_t fl; filtro_init(&fl);
+	size_t ini=0, fin=0;
+	for(size_t i=0; i<n; i++){
+		if(i==fin){ ini=i; while(fin<n && m[fin].et==m[ini].et) fin++; }
+		uint8_t listo;
+		uint16_t v=filtro_paso(&fl, m[i].adc, &listo);
+		if(listo && i-ini>=BORDE_N && fin-i>BORDE_N) welford_paso(&w[m[i].et], v);
+	}
+	memset(mod, 0, sizeof(*mod));
+	for(int c=0; c<C_N; c++)
+	if(w[c].n>1) welford_a_modelo(&w[c], mod, (color_t)c);
+	modelo_sellar(mod);
+}
+
+/* Lo que ve el ADC: la muestra que corresponde a ese instante */
+static uint64_t t_base;
+static uint16_t senal(uint64_t us){
+	size_t i=(size_t)((us-t_base)*ADC_FS/1000000);
+	return M[i<N ? i : N-1].adc;
+}
+
+static modelo_t modelo;
+
+static void evaluar(void *arg){
+	(void)arg;
+	size_t desde=N/2;
+	proceso_t p; proceso_init(&p, NEST, HIST16);   // el mismo camino que el loop de main.c
+	const clasif_t *k=&p.clasif;
+	size_t ok_muestras=0, muestras=0;
+	unsigned tramos=0, tramos_ok=0, equivocados=0, movidas=0;
+	double lat_suma=0, lat_max=0, servo_suma=0, servo_max=0, total_suma=0, total_max=0;
+	size_t ini=desde; int decidido=0;
+
+	t_base=sim_ahora_us()-(uint64_t)desde*1000000/ADC_FS;
+	sim_adc_conectar(0, senal);
+	for(size_t i=desde; i<=N; i++){
+		if(i==N || (i>desde && M[i].et!=M[i-1].et)){
+			if(M[ini].et!=C_NONE){ tramos++; if(decidido) tramos_ok++; }
+			if(i==N) break;
+			ini=i; decidido=0;
+		}
+		uint64_t t=t_base+(uint64_t)i*1000000/ADC_FS;
+		sim_dormir_hasta(t);
+		evento_t e=proceso_paso(&p, &modelo, sim_adc_leer(0));
+		if(!p.listo) continue;
+		muestras++;
+		if(k->ultima==M[i].et) ok_muestras++;
+		if(e==CL_COLOR){
+			sim_servo_pedir(0, R[k->actual].ang, t);
+			uint64_t llega=sim_servo_llega(0);
+			double ms=(llega-t)/1000.0;
+			servo_suma+=ms; movidas++;
+			if(ms>servo_max) servo_max=ms;
+			if(k->actual!=M[i].et){ equivocados++; continue; }
+		}
+		if(!decidido && M[ini].et!=C_NONE && k->actual==M[i].et && k->ultima==M[i].et){
+			decidido=1;
+			double ms=1000.0*(i-ini+1)/ADC_FS;
+			lat_suma+=ms;
+			if(ms>lat_max) lat_max=ms;
+			/* Pieza -> servo en su ángulo (si ya estaba, es la decisión) */
+			uint64_t llega=sim_servo_llega(0);
+			double total=((llega>t ? llega : t)-(t_base+(uint64_t)ini*1000000/ADC_FS))/1000.0;
+			total_suma+=total;
+			if(total>total_max) total_max=total;
+		}
+	}
+
+	printf("Muestras filtradas: %zu, acierto por muestra %.1f%%\n", muestras,
+	       muestras ? 100.0*ok_muestras/muestras : 0);
+	printf("Tramos de color: %u, clasificados bien %u (%.1f%%)\n", tramos, tramos_ok,
+	       tramos ? 100.0*tramos_ok/tramos : 0);
+	printf("Cambios a un color equivocado: %u\n", equivocados);
+	printf("Latencia de decisión: media %.1f ms, máx %.1f ms\n",
+	       tramos_ok ? lat_suma/tramos_ok : 0, lat_max);
+	printf("Servo: %u movimientos, media %.1f ms, máx %.1f ms\n", movidas,
+	       movidas ? servo_suma/movidas : 0, servo_max);
+	printf("Pieza -> servo en posición: media %.1f ms, máx %.1f ms\n",
+	       tramos_ok ? total_suma/tramos_ok : 0, total_max);
+
+	/* Velocidad del filtro + clasificador en la PC (no es tiempo virtual) */
+	clock_t c0=clock();
+	unsigned vueltas=0; volatile unsigned sumidero=0;
+	while(clock()-c0 < CLOCKS_PER_SEC/5){
+		proceso_init(&p, NEST, HIST16);
+		for(size_t i=desde; i<N; i++) sumidero+=proceso_paso(&p, &modelo, M[i].adc);
+		vueltas++;
+	}
+	double s=(double)(clock()-c0)/CLOCKS_PER_SEC;
+	printf("Muestras/s en host: %.1f M (varía con la PC)\n\n", vueltas*(double)(N-desde)/s/1e6);
+	if(equivocados){ printf("FALLA: %u cambios a un color equivocado\n\n", equivocados); sim_fin(1); }
+	sim_fin(0);
+}
+
+int main(void){
+	generar();
+	entrenar(M, N/2, &modelo);
+	printf("== Clasificador: %d s a %d Hz, NEST %d (semilla %llu) ==\n", SEG, ADC_FS, NEST,
+	       (unsigned long long)sim_semilla());
+	printf("Modelo:");
+	for(int c=0; c<C_N; c++) printf(" %s %.1f±%.1f", NOMBRES[c], modelo.media16[c]/16.0, modelo.desv16[c]/16.0);
+	printf("\n");
+	sim_correr(evaluar, NULL);
+	return 0;
+}
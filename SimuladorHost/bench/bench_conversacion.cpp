@@ -0,0 +1,172 @@
+/****************************************************
+ * Bench de conversación: respuesta entera contra
+ * flujo frase por frase (/control/conversar), con
+ * AudioPipeline + AudioGeneratorIMA y las fuentes
+ * que usa Vocesconwifiperfecto
+ * - TTS de mentira: cada síntesis tarda SIM_TTS_MS +
+ *   TTS_RTF x lo que dura el audio, de a TTS_PARALELO
+ *   (el semáforo del almacén del server)
+ * - entero: una síntesis de toda la respuesta y recién
+ *   ahí el ESP32 la pide (AudioFileSourceHTTPStream,
+ *   /esp32/audio_raw)
+ * - flujo: el ESP32 la pide enseguida (AudioFileSource-
+ *   HTTPRange en HTTP/1.0, /esp32/audio_flujo) y cada
+ *   frase sale cuando termina la suya y las anteriores
+ * - Tiempo desde que está el texto de Gemini: el
+ *   comando tarda lo mismo en los dos (ver bench_poll)
+ * - Mide primer audio, huecos en el DMA (lo que se oye
+ *   entre frases) y cuándo termina de sonar
+ ****************************************************/
+#include <Arduino.h>
+#include <AudioFileSourceHTTPStream.h>
+#include <AudioOutputI2SNoDAC.h>
+#include "AudioFileSourceHTTPRange.h"
+#include "AudioPipeline.h"
+#include "ImaAdpcm.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+// Los de Vocesconwifiperfecto.cpp
+const size_t AUDIO_RING_BYTES      = 64 * 1024;
+const size_t AUDIO_PREBUFFER_BYTES = 12 * 1024;
+const size_t AUDIO_PREBUFFER_IMA   = 3 * 1024;
+
+const uint32_t RATE         = 16000;
+const uint32_t TTS_PARALELO = 4;      // TTS_PARALELO del almacén
+const double   TTS_RTF      = 0.25;   // ms de síntesis por ms de audio
+const char*    BASE_URL     = "http://server:8000";
+
+// Lo que dura cada frase de la respuesta (la primera, corta: "¡Hola! Soy Nao.")
+const uint32_t FRASES_MS[] = { 1300, 3400, 2600, 4100, 2200, 3000 };
+const size_t   N_FRASES    = sizeof(FRASES_MS) / sizeof(FRASES_MS[0]);
+
+AudioPipeline        pipeline;
+AudioOutputI2SNoDAC* dac = nullptr;
+AudioOutputKeepOpen* out = nullptr;
+
+uint32_t ttsMs() {
+  const char* e = getenv("SIM_TTS_MS");
+  return e && *e ? (uint32_t)atol(e) : 600;
+}
+
+uint64_t sintesisUs(uint32_t audioMs) { return (ttsMs() + (uint64_t)(TTS_RTF * audioMs)) * 1000; }
+
+// Voz sintética como la de bench_audio, de 'ms' de largo
+std::vector<int16_t> voz(uint32_t ms) {
+  size_t n = (size_t)RATE * ms / 1000;
+  std::vector<int16_t> m(n);
+  for (size_t i = 0; i < n; i++) {
+    double t = (double)i / RATE;
+    double env = 0.5 + 0.5 * sin(2 * PI * 4 * t);
+    double v = 0.6 * sin(2 * PI * 180 * t) + 0.3 * sin(2 * PI * 720 * t) + 0.05 * sim::azar().normal();
+    m[i] = (int16_t)constrain(v * env * 12000, -32768.0, 32767.0);
+  }
+  return m;
+}
+
+struct Resultado {
+  uint32_t ttsMs;        // cuándo el server tiene el primer audio
+  uint32_t primerMs;
+  AudioOutputI2SNoDAC::Stats dac;
+  uint32_t finMs;        // termina de sonar
+  bool     ok;
+};
+
+Resultado correr(bool flujo, bool ima, uint32_t caso) {
+  char id[24], url[128];
+  snprintf(id, sizeof(id), "resp%u", caso);
+  uint64_t t0 = sim::ahoraUs();
+
+  // Las frases y cuándo termina cada síntesis: de a TTS_PARALELO, en orden
+  std::vector<std::vector<int16_t>> frases;
+  std::vector<std::string> wavs;
+  std::vector<uint64_t> listo;
+  uint64_t libre[TTS_PARALELO] = {};
+  uint32_t totalMs = 0, esperadas = 0;
+  for (size_t i = 0; i < N_FRASES; i++) {
+    frases.push_back(voz(FRASES_MS[i]));
+    wavs.push_back(sim::ServidorMock::wavPcm(frases[i].data(), frases[i].size(), RATE));
+    uint64_t* hilo = std::min_element(libre, libre + TTS_PARALELO);
+    *hilo += sintesisUs(FRASES_MS[i]);
+    listo.push_back(t0 + *hilo);
+    totalMs += FRASES_MS[i];
+    size_t n = frases[i].size();
+    esperadas += flujo && ima ? (n + sim::ServidorMock::IMA_SPB - 1) / sim::ServidorMock::IMA_SPB *
+                                    sim::ServidorMock::IMA_SPB
+                              : n;
+  }
+
+  Resultado r = {};
+  AudioFileSource* src;
+  dac->reiniciar();
+  if (flujo) {
+    sim::servidor().agregarFlujo(id, wavs, listo, ima);
+    r.ttsMs = (uint32_t)((listo[0] - t0) / 1000);
+    snprintf(url, sizeof(url), "%s/esp32/audio_flujo/%s", BASE_URL, id);
+    AudioFileSourceHTTPRange* h = new AudioFileSourceHTTPRange();
+    h->useHTTP10(true);
+    h->open(url);
+    src = h;
+  } else {
+    // La respuesta entera es una sola síntesis; el comando sale cuando termina
+    std::vector<int16_t> todo;
+    for (const auto& f : frases) todo.insert(todo.end(), f.begin(), f.end());
+    sim::servidor().agregarAudio(id, sim::ServidorMock::wavPcm(todo.data(), todo.size(), RATE));
+    r.ttsMs = (uint32_t)(sintesisUs(totalMs) / 1000);
+    sim::dormirHasta(t0 + sintesisUs(totalMs));
+    snprintf(url, sizeof(url), "%s/esp32/audio_raw/%s%s", BASE_URL, id, ima ? "?fmt=ima" : "");
+    AudioFileSourceHTTPStream* h = new AudioFileSourceHTTPStream(url);
+    h->SetReconnect(3, 200);
+    src = h;
+  }
+  AudioGeneratorIMA* gen = new AudioGeneratorIMA();
+  pipeline.setPrebuffer(ima ? AUDIO_PREBUFFER_IMA : AUDIO_PREBUFFER_BYTES);
+  if (pipeline.play(src, gen, out)) {
+    while (pipeline.isBusy()) vTaskDelay(pdMS_TO_TICKS(20));
+  }
+  r.primerMs = dac->primeraUs() ? (uint32_t)((dac->primeraUs() - t0) / 1000) : 0;
+  r.dac = dac->stats();
+  r.finMs = (uint32_t)((dac->finUs() - t0) / 1000);
+  r.ok = pipeline.started() && pipeline.lastOk() && r.dac.muestras == esperadas;
+  out->close();
+  delete gen;
+  delete src;
+  return r;
+}
+
+void principal(void*) {
+  AudioPipeline::Config acfg;
+  acfg.ringBytes      = AUDIO_RING_BYTES;
+  acfg.prebufferBytes = AUDIO_PREBUFFER_BYTES;
+  if (!pipeline.begin(acfg)) {
+    printf("No se pudo crear el pipeline\n");
+    sim::fin(1);
+  }
+  dac = new AudioOutputI2SNoDAC();
+  dac->SetOutputModeMono(true);
+  out = new AudioOutputKeepOpen(dac);
+
+  uint32_t totalMs = 0;
+  for (size_t i = 0; i < N_FRASES; i++) totalMs += FRASES_MS[i];
+  printf("== Conversación: %u frases, %u ms de audio, TTS %u ms + %.2f x audio, %u a la vez (semilla %llu) ==\n",
+         (unsigned)N_FRASES, totalMs, ttsMs(), TTS_RTF, TTS_PARALELO, (unsigned long long)sim::semilla());
+  printf("%-10s %-4s %-6s %7s %9s %7s %10s %8s %4s\n", "perfil", "fmt", "modo", "tts_ms", "primer_ms", "huecos",
+         "silencio_ms", "fin_ms", "ok");
+  uint32_t caso = 0;
+  for (size_t p = 0; p < sim::N_PERFILES; p++) {
+    for (int ima = 0; ima < 2; ima++) {
+      for (int flujo = 0; flujo < 2; flujo++) {
+        sim::usarPerfil(sim::PERFILES[p]);
+        sim::azar().sembrar(sim::semilla() * 1000 + p * 4 + ima * 2 + flujo);
+        Resultado r = correr(flujo, ima, caso++);
+        printf("%-10s %-4s %-6s %7u %9u %7u %10.1f %8u %4s\n", sim::PERFILES[p].nombre, ima ? "ima" : "pcm",
+               flujo ? "flujo" : "entero", r.ttsMs, r.primerMs, r.dac.huecos, r.dac.huecosUs / 1000.0, r.finMs,
+               r.ok ? "sí" : "NO");
+      }
+    }
+  }
+  printf("\n");
+  sim::fin(0);
+}
+
+int main() { sim::correr(principal); }
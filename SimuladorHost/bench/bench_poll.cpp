@@ -0,0 +1,304 @@
+/****************************************************
+ * Bench de comandos: CommandChannel tal cual (long-
+ * poll con ?wait, lote, reuse) contra el mock del
+ * server y cada perfil de red
+ * - long-poll: el server retiene hasta que hay un
+ *   comando; poll: server viejo sin X-Long-Poll, el
+ *   canal cae solo a pedir cada pollIntervalMs
+ * - Comandos a tiempos al azar (exponencial, media
+ *   COMANDO_MEDIO_MS); latencia = encolado en el
+ *   server -> tRecv en el ESP32
+ * - Mide p50/p95/p99 y pedidos HTTP por minuto (lo
+ *   que cuesta en batería y en el túnel)
+ * - Carga: de 1 a 200 devices contra el mismo server
+ *   (perfil lan, el server en la misma red), cada uno
+ *   con su canal; p50/p99, pedidos por segundo y cuánto
+ *   queda ocupado el event loop del server
+ * - Ráfaga: RAFAGA comandos de golpe (la app de Flutter)
+ *   con lote 1..8 en el poll y en confirmar_lote, con
+ *   la regla de serviceConfirms() del sketch: comandos
+ *   por segundo de punta a punta (encolado -> el server
+ *   tiene la confirmación) y confirmaciones por pedido
+ ****************************************************/
+#include <Arduino.h>
+#include <algorithm>
+#include "CommandChannel.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+const char*    BASE_URL         = "http://server:8000";
+const uint32_t CORRIDA_S        = 120;
+const uint32_t COMANDO_MEDIO_MS = 3000;
+const uint32_t CARGA_S          = 60;
+const uint32_t DEVICES[]        = { 1, 10, 50, 100, 200 };
+const uint32_t RAFAGA           = 200;
+const uint32_t EJECUTAR_MS      = 5;      // routeCommand + arrancar la acción
+
+struct Caso {
+  char     device[24];
+  uint32_t finMs;
+  uint32_t enviados;
+};
+
+// Encola comandos en el server hasta finMs
+void generador(void* p) {
+  Caso* c = (Caso*)p;
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(1 + (uint32_t)sim::azar().exponencial(COMANDO_MEDIO_MS)));
+    if (millis() >= c->finMs) break;
+    sim::servidor().encolar(c->device, "\"tipo\":\"mover\",\"angulo\":90");
+    c->enviados++;
+  }
+  vTaskDelete(nullptr);
+}
+
+uint32_t seqDe(const char* json) {
+  const char* s = strstr(json, "\"seq\":");
+  return s ? (uint32_t)atol(s + 6) : 0;
+}
+
+uint32_t percentil(std::vector<uint32_t>& v, double p) {
+  if (v.empty()) return 0;
+  size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+  return v[i];
+}
+
+void correr(size_t perfil, bool largo) {
+  // Uno nuevo por caso (y no se liberan: el generador puede seguir vivo)
+  Caso* caso = new Caso();
+  snprintf(caso->device, sizeof(caso->device), "robot-%u%c", (unsigned)perfil, largo ? 'l' : 'p');
+
+  sim::usarPerfil(sim::PERFILES[perfil]);
+  sim::azar().sembrar(sim::semilla() * 1000 + perfil * 2 + largo);
+  sim::servidor().sinLongPoll(!largo);
+
+  CommandChannel* canal = new CommandChannel();
+  CommandChannel::Config cfg;
+  cfg.baseUrl  = BASE_URL;
+  cfg.deviceId = caso->device;
+  if (!canal->begin(cfg)) {
+    printf("No se pudo crear el canal\n");
+    sim::fin(1);
+  }
+
+  uint32_t t0 = millis();
+  caso->finMs = t0 + CORRIDA_S * 1000;
+  xTaskCreate(generador, "generador", 4096, caso, 1, nullptr);
+  std::vector<uint32_t> lat;
+  CommandChannel::Command cmd;
+  // Hasta el final de la corrida y que lleguen todos (30 s de gracia:
+  // lo que falte se ve en "recib")
+  while (millis() < caso->finMs || (lat.size() < caso->enviados && millis() < caso->finMs + 30000)) {
+    if (!canal->receive(cmd, pdMS_TO_TICKS(100))) continue;
+    uint64_t enc = sim::servidor().encoladoUs(caso->device, seqDe(cmd.json));
+    lat.push_back(cmd.tRecv - (uint32_t)(enc / 1000));
+  }
+
+  CommandChannel::Stats st = canal->stats();
+  std::sort(lat.begin(), lat.end());
+  double min = (millis() - t0) / 60000.0;
+  printf("%-10s %-9s %6u %6u %6u %6u %6u %9.1f %6u\n", sim::PERFILES[perfil].nombre, largo ? "long-poll" : "poll",
+         caso->enviados, (unsigned)lat.size(), percentil(lat, 0.50), percentil(lat, 0.95), percentil(lat, 0.99),
+         st.requests / min, st.errors);
+  canal->end();
+  while (canal->activo()) vTaskDelay(pdMS_TO_TICKS(100));
+}
+
+// ====== Carga: muchos devices ======
+struct Flota {
+  std::vector<CommandChannel*> canales;
+  std::vector<std::string>     ids;
+  uint32_t finMs;
+  uint32_t enviados;
+};
+
+// Un comando a un device al azar; en total, cada device recibe uno cada
+// ~COMANDO_MEDIO_MS
+void generadorFlota(void* p) {
+  Flota* f = (Flota*)p;
+  double medio = (double)COMANDO_MEDIO_MS / f->ids.size();
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(1 + (uint32_t)sim::azar().exponencial(medio)));
+    if (millis() >= f->finMs) break;
+    sim::servidor().encolar(f->ids[(size_t)(sim::azar().uniforme() * f->ids.size())], "\"tipo\":\"mover\",\"angulo\":90");
+    f->enviados++;
+  }
+  vTaskDelete(nullptr);
+}
+
+void carga(uint32_t devices, bool largo) {
+  Flota* f = new Flota();
+  sim::usarPerfil(*sim::buscarPerfil("lan"));
+  sim::azar().sembrar(sim::semilla() * 1000 + devices * 2 + largo);
+  sim::servidor().sinLongPoll(!largo);
+  for (uint32_t d = 0; d < devices; d++) {
+    char id[32];
+    snprintf(id, sizeof(id), "flota%u-%u%c", (unsigned)devices, (unsigned)d, largo ? 'l' : 'p');
+    f->ids.push_back(id);
+  }
+  for (uint32_t d = 0; d < devices; d++) {
+    CommandChannel* canal = new CommandChannel();
+    CommandChannel::Config cfg;
+    cfg.baseUrl  = BASE_URL;
+    cfg.deviceId = f->ids[d].c_str();
+    if (!canal->begin(cfg)) {
+      printf("No se pudo crear el canal\n");
+      sim::fin(1);
+    }
+    f->canales.push_back(canal);
+  }
+
+  sim::ServidorMock::Stats s0 = sim::servidor().stats();
+  uint32_t t0 = millis();
+  f->finMs = t0 + CARGA_S * 1000;
+  xTaskCreate(generadorFlota, "generador", 4096, f, 1, nullptr);
+  // Cada canal anota tRecv al recibir: alcanza con vaciar las colas seguido
+  std::vector<uint32_t> lat;
+  CommandChannel::Command cmd;
+  while (millis() < f->finMs || (lat.size() < f->enviados && millis() < f->finMs + 30000)) {
+    for (uint32_t d = 0; d < devices; d++) {
+      while (f->canales[d]->receive(cmd)) {
+        uint64_t enc = sim::servidor().encoladoUs(f->ids[d], seqDe(cmd.json));
+        lat.push_back(cmd.tRecv - (uint32_t)(enc / 1000));
+      }
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));
+  }
+  uint32_t ms = millis() - t0;
+  sim::ServidorMock::Stats s1 = sim::servidor().stats();
+
+  std::sort(lat.begin(), lat.end());
+  printf("%7u %-9s %6u %6u %6u %6u %8.1f %9.0f%%\n", (unsigned)devices, largo ? "long-poll" : "poll",
+         f->enviados, (unsigned)lat.size(), percentil(lat, 0.50), percentil(lat, 0.99),
+         (s1.pedidos - s0.pedidos) * 1000.0 / ms, std::min((s1.ocupadoUs - s0.ocupadoUs) / 10.0 / ms, 100.0));
+
+  // Que los canales de este caso no carguen al server en el siguiente
+  for (CommandChannel* c : f->canales) c->end();
+  for (CommandChannel* c : f->canales) {
+    while (c->activo()) vTaskDelay(pdMS_TO_TICKS(100));
+  }
+}
+
+// ====== Ráfaga: lote en el poll y en las confirmaciones ======
+// Lo que hacen loop() y flushConfirms() en Vocesconwifiperfecto.cpp, con
+// 'lote' en lugar de CONFIRM_LEN / 2: ejecutar cada comando y confirmar
+// cuando se juntaron 'lote' o no queda nada por hacer
+struct Ejecutor {
+  CommandChannel* canal;
+  const char*     device;
+  uint32_t        lote;
+  volatile bool   fin;
+};
+
+bool confirmar(HTTPClient& http, const char* device, const uint32_t* seqs, uint32_t n) {
+  static char url[160], cuerpo[1024];
+  snprintf(url, sizeof(url), "%s/esp32/confirmar_lote/%s", BASE_URL, device);
+  size_t k = snprintf(cuerpo, sizeof(cuerpo), "{\"confirmaciones\":[");
+  for (uint32_t i = 0; i < n; i++) {
+    k += snprintf(cuerpo + k, sizeof(cuerpo) - k, "%s{\"seq\":%u,\"audio_id\":\"clip%u\",\"status\":\"success\"}",
+                  i ? "," : "", seqs[i], seqs[i]);
+  }
+  k += snprintf(cuerpo + k, sizeof(cuerpo) - k, "]}");
+  if (!http.begin(url)) return false;
+  http.addHeader("Content-Type", "application/json");
+  int code = http.POST((uint8_t*)cuerpo, k);
+  http.end();
+  return code >= 200 && code < 300;
+}
+
+void ejecutor(void* p) {
+  Ejecutor* e = (Ejecutor*)p;
+  HTTPClient http;
+  http.setReuse(true);
+  http.setTimeout(8000);
+  uint32_t seqs[8], n = 0;
+  CommandChannel::Command cmd;
+  while (!e->fin) {
+    bool hay = e->canal->receive(cmd, pdMS_TO_TICKS(n ? 0 : 100));
+    if (hay) {
+      vTaskDelay(pdMS_TO_TICKS(EJECUTAR_MS));
+      seqs[n++] = seqDe(cmd.json);
+    }
+    if (n && (n >= e->lote || !hay)) {
+      while (!confirmar(http, e->device, seqs, n)) vTaskDelay(pdMS_TO_TICKS(200));
+      n = 0;
+    }
+  }
+  vTaskDelete(nullptr);
+}
+
+void rafaga(size_t perfil, uint32_t lote) {
+  Caso* caso = new Caso();
+  snprintf(caso->device, sizeof(caso->device), "rafaga-%u-%u", (unsigned)perfil, (unsigned)lote);
+  sim::usarPerfil(sim::PERFILES[perfil]);
+  sim::azar().sembrar(sim::semilla() * 1000 + perfil * 10 + lote);
+  sim::servidor().sinLongPoll(false);
+
+  CommandChannel* canal = new CommandChannel();
+  CommandChannel::Config cfg;
+  cfg.baseUrl  = BASE_URL;
+  cfg.deviceId = caso->device;
+  cfg.batchMax = lote;
+  if (!canal->begin(cfg)) {
+    printf("No se pudo crear el canal\n");
+    sim::fin(1);
+  }
+  vTaskDelay(pdMS_TO_TICKS(1000));   // el canal ya está esperando en el long-poll
+
+  sim::ServidorMock::Stats s0 = sim::servidor().stats();
+  uint32_t t0 = millis();
+  for (uint32_t i = 0; i < RAFAGA; i++) sim::servidor().encolar(caso->device, "\"tipo\":\"reproducir_frase\"");
+  Ejecutor* e = new Ejecutor{ canal, caso->device, lote, false };
+  xTaskCreate(ejecutor, "ejecutor", 8192, e, 1, nullptr);
+  while (sim::servidor().stats().confirmados - s0.confirmados < RAFAGA && millis() - t0 < 120000) {
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+  uint32_t ms = millis() - t0;
+  sim::ServidorMock::Stats s1 = sim::servidor().stats();
+  // Los polls del canal (cuenta al volver la respuesta): el server también
+  // contaría el long-poll que quedó esperando después del último
+  uint32_t polls = canal->stats().requests, posts = s1.confirmaciones - s0.confirmaciones;
+  uint32_t hechos = s1.confirmados - s0.confirmados;
+  printf("%-10s %4u %7.1f %6u %9.2f %6u %9.2f %9.2f\n", sim::PERFILES[perfil].nombre, (unsigned)lote,
+         hechos * 1000.0 / ms, polls, (double)(s1.comandos - s0.comandos) / (polls ? polls : 1), posts,
+         (double)hechos / (posts ? posts : 1), (double)(polls + posts) / (hechos ? hechos : 1));
+
+  canal->end();
+  e->fin = true;
+  while (canal->activo()) vTaskDelay(pdMS_TO_TICKS(100));
+}
+
+void principal(void*) {
+  printf("== Comandos: CommandChannel, %u s por caso, un comando cada ~%u ms (semilla %llu) ==\n", CORRIDA_S,
+         COMANDO_MEDIO_MS, (unsigned long long)sim::semilla());
+  printf("%-10s %-9s %6s %6s %6s %6s %6s %9s %6s\n", "perfil", "modo", "cmds", "recib", "p50_ms", "p95_ms",
+         "p99_ms", "pedidos/m", "error");
+  for (size_t p = 0; p < sim::N_PERFILES; p++) {
+    correr(p, true);
+    correr(p, false);
+  }
+  printf("\n");
+
+  printf("== Carga: N devices contra un server (lan, %u ms por pedido), %u s por caso ==\n",
+         sim::buscarPerfil("lan")->servidorMs, CARGA_S);
+  printf("%7s %-9s %6s %6s %6s %6s %8s %10s\n", "devices", "modo", "cmds", "recib", "p50_ms", "p99_ms",
+         "pedidos/s", "server");
+  for (uint32_t n : DEVICES) {
+    carga(n, true);
+    carga(n, false);
+  }
+  printf("\n");
+
+  printf("== Ráfaga: %u comandos de golpe, lote en poll y confirmar_lote, %u ms por comando ==\n", RAFAGA,
+         EJECUTAR_MS);
+  printf("%-10s %4s %7s %6s %9s %6s %9s %9s\n", "perfil", "lote", "cmds/s", "polls", "cmds/poll", "posts",
+         "conf/post", "pedid/cmd");
+  for (const char* nombre : { "lan", "wifi" }) {
+    size_t p = sim::buscarPerfil(nombre) - sim::PERFILES;
+    for (uint32_t lote = 1; lote <= 8; lote++) rafaga(p, lote);
+  }
+  printf("\n");
+  sim::fin(0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,186 @@
+/****************************************************
+ * Bench de pantalla: CaraDelta, AnimadorCara, BusSPI
+ * y TactilIRQ tal cual, contra el ILI9341 y el
+ * XPT2046 del simulador
+ * - Cambios de cara: bytes SPI medidos en el TFT (y
+ *   los que cuenta CaraDelta, tienen que coincidir),
+ *   tramos, tiempo de bus a 40 MHz; lo que queda en
+ *   pantalla se compara píxel a píxel con la cara
+ * - Carga: 10 s de animación (parpadeo + hablar) con
+ *   toques en el medio; cuadros perdidos/excedidos,
+ *   bytes por segundo y latencia IRQ -> muestra del
+ *   touch con el bus compartido
+ ****************************************************/
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>
+#include <XPT2046_Touchscreen.h>
+#include "CaraDelta.h"
+#include "AnimadorCara.h"
+#include "TactilIRQ.h"
+#include "BusSPI.h"
+#include <Telemetria.h>
+#include "caras.h"
+
+// Los del sketch (cambiodecaraaltocar.ino)
+#define TOUCH_IRQ 27
+const int16_t SCR_W = 240;
+const int16_t SCR_H = 320;
+const CalTactil CAL_TACTIL = { 200, 200, 3800, 3800, SCR_W, SCR_H };
+
+static const Cuadro CUADROS_PARPADEO[] = {
+  { CARA_B, 60, 100 },
+  { CARA_A, 0, 100 },
+};
+static const Cuadro CUADROS_HABLAR[] = {
+  { CARA_B, 120, 0 },
+  { CARA_A, 120, 0 },
+};
+static const Secuencia PARPADEO = { "parpadeo", CUADROS_PARPADEO, 2, false };
+static const Secuencia HABLAR   = { "hablar",   CUADROS_HABLAR,   2, true };
+
+const uint32_t CARGA_MS = 10000;
+const uint8_t  TOQUES   = 20;
+
+Adafruit_ILI9341    tft(5, 21, 4);
+XPT2046_Touchscreen ts(2);
+BusSPI              bus;
+CaraDelta           caras(tft, ILI9341_BLACK, ILI9341_WHITE);
+AnimadorCara        anim(caras);
+TactilIRQ           tactil(ts, TOUCH_IRQ, CAL_TACTIL);
+
+telemetria::Registro   tele;
+telemetria::Histograma teleToque(tele, "toque_us", telemetria::CUBETAS_US);
+telemetria::Histograma teleRedibujo(tele, "redibujo_us", telemetria::CUBETAS_US);
+
+// Píxeles distintos de la cara 'c' (decodificada aparte con LectorRLE)
+uint32_t diferencias(uint8_t c) {
+  LectorRLE lr;
+  lr.begin(&CARAS[c]);
+  uint8_t fila[SCR_W / 8];
+  uint32_t malos = 0;
+  for (int16_t y = 0; y < SCR_H; y++) {
+    lr.bits(y, fila);
+    for (int16_t x = 0; x < SCR_W; x++) {
+      uint16_t esperado = fila[x >> 3] & (0x80 >> (x & 7)) ? ILI9341_BLACK : ILI9341_WHITE;
+      if (tft.leer(x, y) != esperado) malos++;
+    }
+  }
+  return malos;
+}
+
+void fila(const char* cambio, uint8_t destino, uint16_t spans, uint32_t pixeles, uint32_t bytesDelta,
+          uint32_t us) {
+  uint32_t malos = diferencias(destino);
+  printf("%-14s %6u %8u %10llu %10u %8.2f %7s\n", cambio, spans, pixeles, (unsigned long long)tft.bytesSpi(),
+         bytesDelta, us / 1000.0, malos ? "MAL" : "ok");
+  if (malos) printf("  %u píxeles distintos de la cara %s\n", malos, CARAS[destino].nombre);
+  tft.reiniciarCuenta();
+}
+
+void cambios() {
+  printf("== Cambios de cara (240x320, 40 MHz) ==\n");
+  printf("%-14s %6s %8s %10s %10s %8s %7s\n", "cambio", "tramos", "pixeles", "bytes_spi", "bytes_delta",
+         "bus_ms", "frame");
+
+  tft.reiniciarCuenta();
+  uint64_t t0 = sim::ahoraUs();
+  tft.fillScreen(ILI9341_WHITE);
+  dibujarRLE(tft, &CARAS[CARA_A], 0, 0, ILI9341_BLACK, ILI9341_WHITE);
+  fila("fillScreen+A", CARA_A, 0, 0, 0, sim::ahoraUs() - t0);
+
+  caras.drawFull(CARA_B);
+  const CaraDelta::Stats& st = caras.lastStats();
+  fila("drawFull B", CARA_B, st.spans, st.pixels, st.spiBytes, st.us);
+  caras.show(CARA_A);
+  fila("show B->A", CARA_A, st.spans, st.pixels, st.spiBytes, st.us);
+  caras.show(CARA_B);
+  fila("show A->B", CARA_B, st.spans, st.pixels, st.spiBytes, st.us);
+
+  // Wipe como el parpadeo: 100 ms a 30 fps = 3 cuadros
+  uint16_t filas = (caras.height() + 2) / 3;
+  uint32_t spans = 0, pixeles = 0, bytes = 0, us = 0;
+  caras.wipe(CARA_A);
+  for (bool fin = false; !fin;) {
+    fin = caras.step(filas);
+    spans += st.spans;
+    pixeles += st.pixels;
+    bytes += st.spiBytes;
+    us += st.us;
+  }
+  fila("wipe B->A x3", CARA_A, spans, pixeles, bytes, us);
+  printf("Tramos precalculados: %u\n\n", caras.spansUsed());
+}
+
+// Toques cortos repartidos en la carga, con posición y duración al azar
+std::vector<ToqueSim> guion(uint64_t desde) {
+  std::vector<ToqueSim> t;
+  uint64_t paso = (uint64_t)CARGA_MS * 1000 / (TOQUES + 1);
+  for (uint8_t i = 1; i <= TOQUES; i++) {
+    ToqueSim k;
+    k.inicioUs = desde + i * paso + (uint64_t)(sim::azar().uniforme() * paso / 4);
+    k.duracionMs = 80 + sim::azar().u32() % 120;
+    k.x = 400 + sim::azar().u32() % 3200;
+    k.y = 400 + sim::azar().u32() % 3200;
+    k.z = 600 + sim::azar().u32() % 600;
+    t.push_back(k);
+  }
+  return t;
+}
+
+void carga() {
+  bus.begin();
+  caras.usarBus(&bus);
+  tactil.usarBus(&bus);
+  tactil.medir(&teleToque);
+  anim.medir(&teleRedibujo);
+  ts.begin();
+  tactil.begin();
+  caras.drawFull(CARA_A);
+  anim.parpadeo(&PARPADEO, 2000, 6000);
+  anim.begin(CARA_A);
+
+  uint64_t t0 = sim::ahoraUs();
+  XPT2046_Touchscreen::guion(TOUCH_IRQ, guion(t0));
+  uint32_t gestos = 0;
+  bool hablo = false;
+  while (sim::ahoraUs() - t0 < (uint64_t)CARGA_MS * 1000) {
+    Gesto g;
+    while (tactil.leer(g)) gestos++;
+    // Habla en el medio, como con un audio de 3 s
+    if (!hablo && sim::ahoraUs() - t0 > 4000000) {
+      anim.hablar(&HABLAR, 3000);
+      hablo = true;
+    }
+    delay(10);
+  }
+
+  AnimadorCara::Stats a = anim.stats();
+  TactilIRQ::Stats t = tactil.stats();
+  BusSPI::Stats bt = bus.stats(BusSPI::TFT);
+  BusSPI::Stats bk = bus.stats(BusSPI::TACTIL);
+  printf("== Carga: %u s de animación + %u toques ==\n", CARGA_MS / 1000, TOQUES);
+  printf("Cuadros %u, dibujados %u, perdidos %u, excedidos %u (presupuesto %u us), máx %u us\n", a.cuadros,
+         a.dibujados, a.perdidos, a.excedidos, AnimadorCara::PRESUPUESTO_US, a.maxUs);
+  printf("SPI del TFT: %.1f KB/s; redibujo medio %.2f ms\n", a.spiBytes / 1024.0 / (CARGA_MS / 1000.0),
+         teleRedibujo.n() ? teleRedibujo.suma() / 1000.0 / teleRedibujo.n() : 0);
+  printf("Touch: %u despertares, %u muestras, %u gestos (%u leídos, %u perdidos)\n", t.despertares,
+         t.muestras, t.gestos, gestos, t.perdidos);
+  printf("Latencia IRQ -> muestra: media %u us, máx %u us (n %u)\n",
+         teleToque.n() ? teleToque.suma() / teleToque.n() : 0, t.latenciaMaxUs, teleToque.n());
+  printf("Bus: TFT %u usos, cedió %u veces, uso continuo máx %u us; touch espera máx %u us\n", bt.usos,
+         bt.cedidas, bt.maxOcupadoUs, bk.maxEsperaUs);
+  printf("\n");
+}
+
+void principal(void*) {
+  tft.begin();
+  tft.setRotation(0);   // 240x320 como SCR_W/SCR_H
+  caras.add(&CARAS[CARA_A]);
+  caras.add(&CARAS[CARA_B]);
+  caras.begin();
+  cambios();
+  carga();
+  sim::fin(0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,84 @@
+// Adafruit_GFX para el simulador: solo lo que usan los sketches (el
+// texto no se dibuja, pero la interfaz de Print está). Las primitivas
+// salen de drawPixel/fillRect como en la librería; GFXcanvas16 dibuja en
+// un buffer RGB565 en memoria
+#pragma once
+
+#include <vector>
+#include "Arduino.h"
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  uint8_t getRotation() const { return rotation; }
+
+  virtual void drawPixel(int16_t, int16_t, uint16_t) {}
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++)
+      for (int16_t i = x; i < x + w; i++) drawPixel(i, j, color);
+  }
+  void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+  }
+  // Bresenham de círculo, igual que la librería
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+    drawPixel(x0, y0 + r, color);
+    drawPixel(x0, y0 - r, color);
+    drawPixel(x0 + r, y0, color);
+    drawPixel(x0 - r, y0, color);
+    while (x < y) {
+      if (f >= 0) { y--; ddy += 2; f += ddy; }
+      x++; ddx += 2; f += ddx;
+      drawPixel(x0 + x, y0 + y, color); drawPixel(x0 - x, y0 + y, color);
+      drawPixel(x0 + x, y0 - y, color); drawPixel(x0 - x, y0 - y, color);
+      drawPixel(x0 + y, y0 + x, color); drawPixel(x0 - y, y0 + x, color);
+      drawPixel(x0 + y, y0 - x, color); drawPixel(x0 - y, y0 - x, color);
+    }
+  }
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    int16_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+    while (x < y) {
+      if (f >= 0) { y--; ddy += 2; f += ddy; }
+      x++; ddx += 2; f += ddx;
+      drawFastVLine(x0 + x, y0 - y, 2 * y + 1, color); drawFastVLine(x0 - x, y0 - y, 2 * y + 1, color);
+      drawFastVLine(x0 + y, y0 - x, 2 * x + 1, color); drawFastVLine(x0 - y, y0 - x, 2 * x + 1, color);
+    }
+  }
+
+  void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+  void setTextColor(uint16_t) {}
+  void setTextColor(uint16_t, uint16_t) {}
+  void setTextSize(uint8_t) {}
+  void setTextWrap(bool) {}
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+
+protected:
+  const int16_t WIDTH, HEIGHT;
+  int16_t _width, _height;
+  int16_t cursor_x = 0, cursor_y = 0;
+  uint8_t rotation = 0;
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+  GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buf_((size_t)w * h) {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x >= 0 && y >= 0 && x < _width && y < _height) buf_[(size_t)y * _width + x] = color;
+  }
+  uint16_t* getBuffer() { return buf_.empty() ? nullptr : buf_.data(); }
+
+private:
+  std::vector<uint16_t> buf_;
+};
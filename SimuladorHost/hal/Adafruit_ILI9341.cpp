@@ -0,0 +1,55 @@
+#include "Adafruit_ILI9341.h"
+
+Adafruit_ILI9341::Adafruit_ILI9341(int8_t, int8_t, int8_t)
+  : Adafruit_GFX(ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT), fb_((size_t)ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT, 0) {}
+
+void Adafruit_ILI9341::begin(uint32_t freq) {
+  nsPorByte_ = (uint32_t)(8000000000ull / (freq ? freq : 40000000));
+}
+
+// 0 y 2 retrato (240x320), 1 y 3 apaisado (320x240)
+void Adafruit_ILI9341::setRotation(uint8_t r) {
+  rotation = r & 3;
+  _width = rotation & 1 ? HEIGHT : WIDTH;
+  _height = rotation & 1 ? WIDTH : HEIGHT;
+  std::fill(fb_.begin(), fb_.end(), 0);
+}
+
+void Adafruit_ILI9341::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  wx0_ = cx_ = x;
+  wy0_ = cy_ = y;
+  wx1_ = x + w - 1;
+  wy1_ = y + h - 1;
+  ventanas_++;
+  cobrar(VENTANA_BYTES);
+}
+
+void Adafruit_ILI9341::writePixels(uint16_t* colores, uint32_t n, bool, bool) {
+  for (uint32_t i = 0; i < n; i++) pixel(colores[i]);
+  cobrar(n * 2);
+}
+
+void Adafruit_ILI9341::writeColor(uint16_t color, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) pixel(color);
+  cobrar(n * 2);
+}
+
+void Adafruit_ILI9341::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+  if (w <= 0 || h <= 0) return;
+  setAddrWindow(x, y, w, h);
+  writeColor(color, (uint32_t)w * h);
+}
+
+// El tiempo del bus se paga de a ~10 us (o todo al cerrar la transacción)
+void Adafruit_ILI9341::cobrar(uint32_t bytes, bool todo) {
+  bytes_ += bytes;
+  pendienteNs_ += (uint64_t)bytes * nsPorByte_;
+  if (pendienteNs_ >= 10000 || (todo && pendienteNs_ >= 1000)) {
+    sim::ocupar((uint32_t)(pendienteNs_ / 1000));
+    pendienteNs_ %= 1000;
+  }
+}
@@ -0,0 +1,83 @@
+/****************************************************
+ * ILI9341 (Adafruit) para el simulador
+ * - Frame en memoria (RGB565) en las coordenadas de
+ *   la rotación actual: los bench comparan lo que
+ *   quedó en pantalla contra una referencia
+ * - Ventanas como el controlador: setAddrWindow() y
+ *   los píxeles se escriben en orden de fila dentro
+ *   de la ventana
+ * - Cuenta bytes SPI igual que CaraDelta (ventana =
+ *   11 bytes, píxel = 2) y cobra su tiempo a la tarea
+ *   (ocupar) a la frecuencia de begin(), de a ~10 us
+ *   para que BusSPI pueda ceder entre tramos
+ ****************************************************/
+#pragma once
+
+#include <vector>
+#include "Adafruit_GFX.h"
+#include "SPI.h"
+
+#define ILI9341_TFTWIDTH  240
+#define ILI9341_TFTHEIGHT 320
+
+#define ILI9341_BLACK   0x0000
+#define ILI9341_NAVY    0x000F
+#define ILI9341_DARKGREEN 0x03E0
+#define ILI9341_OLIVE   0x7BE0
+#define ILI9341_BLUE    0x001F
+#define ILI9341_GREEN   0x07E0
+#define ILI9341_CYAN    0x07FF
+#define ILI9341_RED     0xF800
+#define ILI9341_MAGENTA 0xF81F
+#define ILI9341_YELLOW  0xFFE0
+#define ILI9341_ORANGE  0xFD20
+#define ILI9341_GREENYELLOW 0xAFE5
+#define ILI9341_WHITE   0xFFFF
+
+class Adafruit_ILI9341 : public Adafruit_GFX {
+public:
+  static const uint8_t VENTANA_BYTES = 11;   // CASET + PASET + RAMWR con parámetros
+
+  Adafruit_ILI9341(int8_t cs = -1, int8_t dc = -1, int8_t rst = -1);
+
+  void begin(uint32_t freq = 40000000);
+  void setRotation(uint8_t r);
+
+  void startWrite() {}
+  void endWrite() { cobrar(0, true); }
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+  void writePixel(uint16_t color) { pixel(color); cobrar(2); }
+  void writePixels(uint16_t* colores, uint32_t n, bool = true, bool = false);
+  void writeColor(uint16_t color, uint32_t n);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { writeFillRect(x, y, w, h, color); endWrite(); }
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override { fillRect(x, y, 1, 1, color); }
+
+  // ---- Para los bench ----
+  uint16_t leer(int16_t x, int16_t y) const { return fb_[(size_t)y * _width + x]; }
+  uint64_t bytesSpi() const { return bytes_; }
+  uint32_t ventanas() const { return ventanas_; }
+  uint64_t pixeles() const { return pixeles_; }
+  void     reiniciarCuenta() { bytes_ = 0; ventanas_ = 0; pixeles_ = 0; }
+
+private:
+  void pixel(uint16_t color) {
+    if (cy_ <= wy1_ && cx_ < _width && cy_ < _height) fb_[(size_t)cy_ * _width + cx_] = color;
+    pixeles_++;
+    if (++cx_ > wx1_) {
+      cx_ = wx0_;
+      cy_++;
+    }
+  }
+  void cobrar(uint32_t bytes, bool todo = false);
+
+  std::vector<uint16_t> fb_;
+  uint16_t wx0_ = 0, wy0_ = 0, wx1_ = 0, wy1_ = 0;
+  uint16_t cx_ = 0, cy_ = 0;
+  uint32_t nsPorByte_ = 200;   // 40 MHz
+  uint64_t pendienteNs_ = 0;
+  uint64_t bytes_ = 0;
+  uint32_t ventanas_ = 0;
+  uint64_t pixeles_ = 0;
+};
@@ -0,0 +1,55 @@
+#include "Arduino.h"
+#include "SPI.h"
+#include "WiFi.h"
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass       ESP;
+SPIClass       SPI;
+WiFiClass      WiFi;
+
+namespace {
+bool serialVisible() {
+  static int v = -1;
+  if (v < 0) {
+    const char* e = getenv("SIM_SERIAL");
+    v = e && *e == '1';
+  }
+  return v;
+}
+
+struct CanalLedc {
+  double  hz;
+  uint8_t bits;
+};
+CanalLedc canales[16];
+}  // namespace
+
+size_t HardwareSerial::write(const uint8_t* p, size_t n) {
+  if (serialVisible()) fwrite(p, 1, n, stderr);
+  return n;
+}
+
+void EspClass::restart() {
+  fprintf(stderr, "ESP.restart() en %.3f s\n", sim::ahoraUs() / 1e6);
+  sim::fin(3);
+}
+
+// ====== PWM (LEDC) ======
+double ledcSetup(uint8_t canal, double hz, uint8_t bits) {
+  if (canal >= 16) return 0;
+  canales[canal] = { hz, bits };
+  return hz;
+}
+
+void ledcAttachPin(uint8_t, uint8_t) {}
+
+// Duty -> ancho de pulso -> ángulo del servo de ese canal
+void ledcWrite(uint8_t canal, uint32_t duty) {
+  if (canal >= 16 || !canales[canal].hz) return;
+  double pulsoUs = duty * (1e6 / canales[canal].hz) / (1u << canales[canal].bits);
+  if (pulsoUs < 400 || pulsoUs > 2600) return;   // no es un pulso de servo
+  double grados = (pulsoUs - 500) / 2000 * 180;
+  sim::servo(canal).pedir((float)constrain(grados, 0.0, 180.0), sim::ahoraUs());
+}
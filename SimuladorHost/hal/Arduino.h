@@ -0,0 +1,270 @@
+/****************************************************
+ * Arduino-ESP32 para el simulador en host
+ * - millis()/micros()/delay() sobre el reloj virtual
+ *   (Sim.h), FreeRTOS en freertos/FreeRTOS.h
+ * - Pines con interrupción por flanco, analogRead()
+ *   de una señal conectada con sim::conectarAdc()
+ * - ledcWrite(): el pulso de servo (0.5-2.5 ms) mueve
+ *   sim::servo(canal)
+ * - String, Print, Stream y Serial lo justo para lo
+ *   que usa el firmware; Serial escribe a stderr solo
+ *   con SIM_SERIAL=1 (así los bench quedan limpios)
+ * - random() sale de sim::azar(): reproducible
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include "Sim.h"
+#include "freertos/FreeRTOS.h"
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+
+using std::min;
+using std::max;
+
+#define HIGH 1
+#define LOW  0
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+#define DEC 10
+#define HEX 16
+#define PI  3.1415926535897932384626433832795
+
+#define IRAM_ATTR
+#define PROGMEM
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define F(s) (s)
+#define constrain(v, lo, hi) ((v) < (lo) ? (lo) : ((v) > (hi) ? (hi) : (v)))
+
+// newlib del ESP32 la tiene; glibc recién desde 2.38
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char* dst, const char* src, size_t n) {
+  size_t largo = strlen(src);
+  if (n) {
+    size_t k = largo < n - 1 ? largo : n - 1;
+    memcpy(dst, src, k);
+    dst[k] = 0;
+  }
+  return largo;
+}
+#endif
+
+// ====== Tiempo ======
+inline unsigned long millis() { return sim::ahoraMs(); }   // unsigned long, como el core
+inline unsigned long micros() { return (uint32_t)sim::ahoraUs(); }
+inline void delay(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+inline void delayMicroseconds(uint32_t us) { sim::ocupar(us); }   // espera activa: no suelta la CPU
+inline void yield() { vTaskDelay(0); }
+
+// ====== Pines ======
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t v) { sim::fijarPin(pin, v); }
+inline int  digitalRead(uint8_t pin) { return sim::leerPin(pin); }
+inline int  digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(uint8_t pin, void (*isr)(), int modo) { sim::adjuntarIsr(pin, isr, modo); }
+inline void detachInterrupt(uint8_t pin) { sim::adjuntarIsr(pin, nullptr, 0); }
+inline uint16_t analogRead(uint8_t pin) { return sim::leerAdc(pin); }
+inline void analogReadResolution(uint8_t) {}
+
+// ====== PWM (LEDC) ======
+// Un servo estándar: 0.5 ms = 0°, 2.5 ms = 180°, a 50 Hz
+double   ledcSetup(uint8_t canal, double hz, uint8_t bits);
+void     ledcAttachPin(uint8_t pin, uint8_t canal);
+void     ledcWrite(uint8_t canal, uint32_t duty);
+
+// ====== Azar y matemática ======
+inline long random(long max) { return max > 0 ? (long)(sim::azar().u32() % (uint32_t)max) : 0; }
+inline long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+inline void randomSeed(unsigned long s) { sim::azar().sembrar(s); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ====== String ======
+class String {
+public:
+  String(const char* s = "") : s_(s ? s : "") { heap(); }
+  String(const std::string& s) : s_(s) { heap(); }
+  String(const String& o) : s_(o.s_) { heap(); }
+  String(String&& o) = default;
+  String& operator=(const String& o) { s_ = o.s_; heap(); return *this; }
+  String& operator=(String&& o) = default;
+  explicit String(int v)           : s_(std::to_string(v)) { heap(); }
+  explicit String(unsigned v)      : s_(std::to_string(v)) { heap(); }
+  explicit String(long v)          : s_(std::to_string(v)) { heap(); }
+  explicit String(unsigned long v) : s_(std::to_string(v)) { heap(); }
+
+  const char* c_str() const { return s_.c_str(); }
+  unsigned length() const   { return (unsigned)s_.size(); }
+  bool isEmpty() const      { return s_.empty(); }
+  long toInt() const        { return strtol(s_.c_str(), nullptr, 10); }
+  float toFloat() const     { return strtof(s_.c_str(), nullptr); }
+  int indexOf(char c, unsigned desde = 0) const {
+    size_t i = s_.find(c, desde);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  int indexOf(const char* s, unsigned desde = 0) const {
+    size_t i = s_.find(s, desde);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  String substring(unsigned desde, unsigned hasta = 0xFFFFFFFF) const {
+    if (desde > s_.size()) return String();
+    return String(s_.substr(desde, hasta < desde ? 0 : hasta - desde));
+  }
+  bool startsWith(const char* p) const { return s_.compare(0, strlen(p), p) == 0; }
+  char operator[](unsigned i) const { return i < s_.size() ? s_[i] : 0; }
+
+  bool reserve(unsigned n)        { s_.reserve(n); heap(); return true; }
+  bool concat(const char* o)      { s_ += o; heap(); return true; }
+  bool concat(char c)             { s_ += c; heap(); return true; }
+  String& operator+=(const String& o) { s_ += o.s_; heap(); return *this; }
+  String& operator+=(const char* o)   { s_ += o; heap(); return *this; }
+  String& operator+=(char c)          { s_ += c; heap(); return *this; }
+  friend String operator+(String a, const String& b) { return a += b; }
+  friend String operator+(String a, const char* b)   { return a += b; }
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const   { return s_ == o; }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+
+private:
+  // En la placa el contenido va al heap (ver sim::heapFirmware)
+  void heap() const { if (!s_.empty()) sim::heapFirmware(); }
+  std::string s_;
+};
+
+// ====== Print / Stream ======
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* p, size_t n) {
+    size_t k = 0;
+    while (k < n && write(p[k])) k++;
+    return k;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s)   { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c)          { return write((uint8_t)c); }
+  size_t print(long v, int base = DEC)          { return printf(base == HEX ? "%lX" : "%ld", v); }
+  size_t print(unsigned long v, int base = DEC) { return printf(base == HEX ? "%lX" : "%lu", v); }
+  size_t print(int v, int base = DEC)           { return print((long)v, base); }
+  size_t print(unsigned v, int base = DEC)      { return print((unsigned long)v, base); }
+  size_t print(uint8_t v, int base = DEC)       { return print((unsigned long)v, base); }
+  size_t print(double v, int dec = 2)           { return printf("%.*f", dec, v); }
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(const T& v, int b) { size_t n = print(v, b); return n + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n <= 0) return 0;
+    return write((const uint8_t*)buf, (size_t)n < sizeof(buf) ? n : sizeof(buf) - 1);
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual void flush() {}
+
+  void setTimeout(uint32_t ms) { timeout_ = ms; }
+  uint32_t getTimeout() const  { return timeout_; }
+
+  // Como en Arduino: espera cada byte hasta 'timeout' (en tiempo virtual)
+  size_t readBytes(uint8_t* p, size_t n) {
+    size_t k = 0;
+    while (k < n) {
+      int c = timedRead();
+      if (c < 0) break;
+      p[k++] = (uint8_t)c;
+    }
+    return k;
+  }
+  size_t readBytes(char* p, size_t n) { return readBytes((uint8_t*)p, n); }
+  String readString() {
+    std::string s;
+    for (int c; (c = timedRead()) >= 0;) s += (char)c;
+    return String(s);
+  }
+
+protected:
+  // Hasta 'limiteUs' o hasta que haya algo para leer. Por defecto mira cada ms.
+  virtual void esperarDatos(uint64_t limiteUs) {
+    uint64_t t = sim::ahoraUs() + 1000;
+    sim::dormirHasta(t < limiteUs ? t : limiteUs);
+  }
+  int timedRead() {
+    uint64_t limite = sim::ahoraUs() + (uint64_t)timeout_ * 1000;
+    for (;;) {
+      int c = read();
+      if (c >= 0 || sim::ahoraUs() >= limite) return c;
+      esperarDatos(limite);
+    }
+  }
+  uint32_t timeout_ = 1000;
+};
+
+// Serial: lo escrito va a stderr con SIM_SERIAL=1; lo que se lee lo
+// carga el bench con entrada() (comandos por Serial)
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int n) : n_(n) {}
+  void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+  void end() {}
+  void setRxBufferSize(size_t) {}
+  void entrada(const char* s) { rx_ += s; }
+  int available() override { return (int)(rx_.size() - rxPos_); }
+  int read() override { return rxPos_ < rx_.size() ? (uint8_t)rx_[rxPos_++] : -1; }
+  int peek() override { return rxPos_ < rx_.size() ? (uint8_t)rx_[rxPos_] : -1; }
+  using Print::write;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* p, size_t n) override;
+  operator bool() const { return true; }
+
+private:
+  int         n_;
+  std::string rx_;
+  size_t      rxPos_ = 0;
+};
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+#define SERIAL_8N1 0x800001c
+
+// ====== ESP ======
+// Heap de un ESP32 sin PSRAM con WiFi arriba, con números fijos: el
+// simulador mide tiempos, no memoria
+class EspClass {
+public:
+  uint32_t getFreeHeap() { return 150 * 1024; }
+  uint32_t getMinFreeHeap() { return 120 * 1024; }
+  uint32_t getMaxAllocHeap() { return 100 * 1024; }
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getPsramSize() { return 0; }
+  [[noreturn]] void restart();
+};
+extern EspClass ESP;
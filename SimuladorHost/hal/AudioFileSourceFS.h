@@ -0,0 +1,28 @@
+// AudioFileSourceFS de ESP8266Audio para el simulador: un archivo del FS
+// en memoria (FS.h); mientras está abierto el archivo no se puede borrar
+#pragma once
+
+#include "AudioFileSource.h"
+#include "FS.h"
+
+class AudioFileSourceFS : public AudioFileSource {
+public:
+  AudioFileSourceFS(fs::FS& fs) : fs_(&fs) {}
+  AudioFileSourceFS(fs::FS& fs, const char* ruta) : fs_(&fs) { open(ruta); }
+  ~AudioFileSourceFS() override { close(); }
+
+  bool open(const char* ruta) override {
+    f_ = fs_->open(ruta, "r");
+    return (bool)f_;
+  }
+  uint32_t read(void* data, uint32_t len) override { return f_ ? f_.read((uint8_t*)data, len) : 0; }
+  bool seek(int32_t pos, int dir) override { return f_ && f_.seek(pos, (fs::SeekMode)dir); }
+  bool close() override { f_.close(); return true; }
+  bool isOpen() override { return (bool)f_; }
+  uint32_t getSize() override { return f_ ? f_.size() : 0; }
+  uint32_t getPos() override { return f_ ? f_.position() : 0; }
+
+private:
+  fs::FS*  fs_;
+  fs::File f_;
+};
@@ -0,0 +1,88 @@
+/****************************************************
+ * AudioFileSourceHTTPStream de ESP8266Audio para el
+ * simulador, con el mismo comportamiento de read():
+ * - Espera hasta 500 ms a que haya 'len' bytes y
+ *   devuelve lo que haya
+ * - Si no llegó nada, cierra y reconecta (hasta
+ *   SetReconnect() veces) y, como la librería, vuelve
+ *   a pedir desde el principio del archivo
+ * - La librería espera con yield(), que en el ESP32 no
+ *   suelta la CPU a tareas de menos prioridad; acá se
+ *   espera de a 1 ms (el reloj virtual tiene que
+ *   avanzar)
+ ****************************************************/
+#pragma once
+
+#include "AudioFileSource.h"
+#include "HTTPClient.h"
+
+class AudioFileSourceHTTPStream : public AudioFileSource {
+public:
+  AudioFileSourceHTTPStream() {}
+  explicit AudioFileSourceHTTPStream(const char* url) { open(url); }
+  ~AudioFileSourceHTTPStream() override { http_.end(); }
+
+  bool open(const char* url) override {
+    url_ = url;
+    pos_ = 0;
+    http_.begin(url);
+    http_.setReuse(true);
+    int code = http_.GET();
+    if (code != HTTP_CODE_OK) {
+      http_.end();
+      return false;
+    }
+    size_ = http_.getSize();
+    return true;
+  }
+
+  uint32_t read(void* data, uint32_t len) override { return leer(data, len, false); }
+  uint32_t readNonBlock(void* data, uint32_t len) override { return leer(data, len, true); }
+
+  bool close() override { http_.end(); return true; }
+  bool isOpen() override { return http_.connected(); }
+  uint32_t getSize() override { return size_; }
+  uint32_t getPos() override { return pos_; }
+
+  void SetReconnect(int intentos, int esperaMs) {
+    intentos_ = intentos;
+    esperaMs_ = esperaMs;
+  }
+  uint32_t reconexiones() const { return reconexiones_; }
+
+private:
+  uint32_t leer(void* data, uint32_t len, bool noBloquear) {
+    for (;;) {
+      if (!http_.connected()) {
+        http_.end();
+        for (int i = 0; i < intentos_; i++) {
+          delay(esperaMs_);
+          reconexiones_++;
+          if (open(url_.c_str())) break;
+        }
+        if (!http_.connected()) return 0;
+      }
+      if (size_ > 0 && pos_ >= size_) return 0;
+      WiFiClient* s = http_.getStreamPtr();
+      if (!noBloquear) {
+        uint32_t t0 = millis();
+        while (s->available() < (int)len && millis() - t0 < 500) delay(1);
+      }
+      uint32_t hay = s->available();
+      if (!noBloquear && !hay) { http_.end(); continue; }   // "No stream data available"
+      if (!hay) return 0;
+      if (hay < len) len = hay;
+      int n = s->read((uint8_t*)data, len);
+      pos_ += n;
+      return n;
+    }
+  }
+
+  HTTPClient  http_;
+  std::string url_;
+  uint32_t    pos_ = 0;
+  uint32_t    size_ = 0;
+  int         intentos_ = 0;
+  int         esperaMs_ = 0;
+  uint32_t    reconexiones_ = 0;
+};
@@ -0,0 +1,22 @@
+// AudioGenerator de ESP8266Audio (misma interfaz) para el simulador
+#pragma once
+
+#include "AudioFileSource.h"
+#include "AudioOutput.h"
+
+class AudioGenerator {
+public:
+  AudioGenerator() { lastSample[0] = lastSample[1] = 0; }
+  virtual ~AudioGenerator() {}
+  virtual bool begin(AudioFileSource*, AudioOutput*) { return false; }
+  virtual bool loop() { return false; }
+  virtual bool stop() { return false; }
+  virtual bool isRunning() { return false; }
+  virtual void desync() {}
+
+protected:
+  bool             running = false;
+  AudioFileSource* file = nullptr;
+  AudioOutput*     output = nullptr;
+  int16_t          lastSample[2];
+};
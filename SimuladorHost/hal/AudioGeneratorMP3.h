@@ -0,0 +1,45 @@
+// AudioGeneratorMP3 de ESP8266Audio para el simulador: no decodifica; cada
+// 2 bytes de la fuente salen como una muestra en cero a 44.1 kHz, así el
+// tiempo de reproducción sigue al tamaño del stream
+#pragma once
+
+#include "AudioGenerator.h"
+
+class AudioGeneratorMP3 : public AudioGenerator {
+public:
+  bool begin(AudioFileSource* src, AudioOutput* out) override {
+    if (!src || !out) return false;
+    file = src;
+    output = out;
+    output->SetRate(44100);
+    output->SetChannels(2);
+    output->SetBitsPerSample(16);
+    if (!output->begin()) return false;
+    n_ = pos_ = 0;
+    running = true;
+    return true;
+  }
+  bool loop() override {
+    if (!running) return false;
+    for (;;) {
+      if (pos_ == n_) {
+        n_ = file->read(buf_, sizeof(buf_));
+        pos_ = 0;
+        if (!n_) { running = file->isOpen() || file->getPos() < file->getSize(); return running; }
+      }
+      lastSample[0] = lastSample[1] = 0;
+      if (!output->ConsumeSample(lastSample)) return true;   // DMA lleno
+      pos_ += pos_ + 2 <= n_ ? 2 : n_ - pos_;
+    }
+  }
+  bool stop() override {
+    running = false;
+    if (output) output->stop();
+    return true;
+  }
+  bool isRunning() override { return running; }
+
+private:
+  uint8_t  buf_[512];
+  uint32_t n_ = 0, pos_ = 0;
+};
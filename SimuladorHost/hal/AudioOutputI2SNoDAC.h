@@ -0,0 +1,81 @@
+/****************************************************
+ * Salida de audio del simulador (en lugar del I2S ->
+ * DAC interno)
+ * - Modela el buffer DMA: entran DMA_MUESTRAS y se
+ *   vacía a la frecuencia de muestreo en tiempo
+ *   virtual; lleno => ConsumeSample() da false, igual
+ *   que i2s_write() con timeout 0
+ * - Si el DMA se vacía con la salida abierta es un
+ *   hueco audible: se cuenta y se mide
+ * - primeraUs(): cuándo sonó la primera muestra desde
+ *   begin() (para medir "primer audio")
+ ****************************************************/
+#pragma once
+
+#include "AudioOutput.h"
+
+class AudioOutputI2SNoDAC : public AudioOutput {
+public:
+  static const uint32_t DMA_MUESTRAS = 512;   // 8 buffers de 64 (config. de la librería)
+
+  struct Stats {
+    uint32_t muestras;
+    uint32_t huecos;        // el DMA se quedó sin muestras
+    uint64_t huecosUs;      // silencio total por huecos
+    uint32_t huecoMaxUs;
+  };
+
+  AudioOutputI2SNoDAC(int = 0) {}
+  bool SetOutputModeMono(bool) { return true; }
+
+  bool begin() override {
+    abierta_ = true;
+    sonando_ = false;
+    primeraUs_ = 0;
+    return true;
+  }
+
+  bool ConsumeSample(int16_t sample[2]) override {
+    (void)sample;
+    uint64_t ahora = sim::ahoraUs();
+    double us = 1e6 / (hertz ? hertz : 16000);
+    if (!sonando_) {
+      sonando_ = true;
+      fin_ = (double)ahora;
+      if (!primeraUs_) primeraUs_ = ahora;
+    } else if (fin_ < ahora) {
+      uint32_t hueco = (uint32_t)(ahora - fin_);
+      stats_.huecos++;
+      stats_.huecosUs += hueco;
+      if (hueco > stats_.huecoMaxUs) stats_.huecoMaxUs = hueco;
+      fin_ = (double)ahora;
+    }
+    if (fin_ - ahora >= DMA_MUESTRAS * us) return false;   // DMA lleno
+    fin_ += us;
+    stats_.muestras++;
+    return true;
+  }
+
+  // En pausa el DMA queda en cero: no es un hueco
+  void flush() override { sonando_ = false; }
+
+  bool stop() override {
+    abierta_ = false;
+    sonando_ = false;
+    return true;
+  }
+
+  bool     abierta() const { return abierta_; }
+  uint64_t primeraUs() const { return primeraUs_; }
+  // Cuándo termina de sonar lo que ya está en el DMA
+  uint64_t finUs() const { return (uint64_t)fin_; }
+  Stats    stats() const { return stats_; }
+  void     reiniciar() { stats_ = {}; primeraUs_ = 0; }
+
+private:
+  bool     abierta_ = false;
+  bool     sonando_ = false;
+  double   fin_ = 0;
+  uint64_t primeraUs_ = 0;
+  Stats    stats_ = {};
+};
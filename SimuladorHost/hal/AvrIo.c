@@ -0,0 +1,11 @@
+/* Los registros de avr/io.h (ver ahí) */
+#include "avr/io.h"
+
+volatile uint8_t  UCSR0A, UCSR0B, UCSR0C, UBRR0H, UBRR0L, UDR0;
+volatile uint8_t  ADMUX, ADCSRA, ADCSRB, DIDR0;
+volatile uint16_t ADC;
+volatile uint8_t  TCCR0A, TCCR0B, OCR0A, TCNT0, TIFR0;
+volatile uint8_t  TCCR1A, TCCR1B;
+volatile uint16_t ICR1, OCR1A, TCNT1;
+volatile uint8_t  DDRB, PORTB, PINB;
+volatile uint8_t  SPCR, SPSR, SPDR;
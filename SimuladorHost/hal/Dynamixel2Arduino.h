@@ -0,0 +1,39 @@
+// Dynamixel2Arduino para el simulador: solo la configuración inicial que
+// hace el sketch (ping, baud, modo, torque); no hay motores, todo contesta
+#pragma once
+
+#include "Arduino.h"
+
+namespace ControlTableItem {
+enum ControlTableItemIndex : uint8_t {
+  ID = 0,
+  BAUD_RATE,
+  RETURN_DELAY_TIME,
+  TORQUE_ENABLE,
+  GOAL_POSITION,
+  PRESENT_POSITION,
+};
+}
+
+enum OperatingMode : uint8_t { OP_CURRENT = 0, OP_VELOCITY, OP_POSITION = 3, OP_EXTENDED_POSITION, OP_PWM = 16 };
+
+class Dynamixel2Arduino {
+public:
+  Dynamixel2Arduino(HardwareSerial& port, int dirPin = -1) : port_(&port), dir_(dirPin) {}
+  void begin(unsigned long baud = 57600) { port_->begin(baud); }
+  bool setPortProtocolVersion(float v) { version_ = v; return true; }
+  bool ping(uint8_t) { return true; }
+  bool setBaudrate(uint8_t, uint32_t) { return true; }
+  bool writeControlTableItem(uint8_t, uint8_t, int32_t, uint32_t = 10) { return true; }
+  int32_t readControlTableItem(uint8_t, uint8_t, uint32_t = 10) { return 0; }
+  bool setOperatingMode(uint8_t, uint8_t) { return true; }
+  bool torqueOn(uint8_t) { return true; }
+  bool torqueOff(uint8_t) { return true; }
+  bool setGoalPosition(uint8_t, float) { return true; }
+  float getPresentPosition(uint8_t) { return 0; }
+
+private:
+  HardwareSerial* port_;
+  int             dir_;
+  float           version_ = 2.0f;
+};
@@ -0,0 +1,150 @@
+#include "FS.h"
+#include "LittleFS.h"
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+namespace {
+std::string normal(const char* ruta) {
+  std::string r = ruta ? ruta : "";
+  if (r.empty() || r[0] != '/') r = "/" + r;
+  while (r.size() > 1 && r.back() == '/') r.pop_back();
+  return r;
+}
+std::string padre(const std::string& r) {
+  size_t i = r.rfind('/');
+  return i ? r.substr(0, i) : "/";
+}
+}  // namespace
+
+// ====== File ======
+void File::copiar(const File& o) {
+  fs_ = o.fs_;
+  nodo_ = o.nodo_;
+  ruta_ = o.ruta_;
+  nombre_ = o.nombre_;
+  pos_ = o.pos_;
+  escribe_ = o.escribe_;
+  esDir_ = o.esDir_;
+  listado_ = o.listado_;
+  if (nodo_) nodo_->abiertos++;
+}
+
+void File::close() {
+  if (nodo_) nodo_->abiertos--;
+  nodo_.reset();
+  esDir_ = false;
+}
+
+size_t File::write(const uint8_t* p, size_t n) {
+  if (!nodo_ || !escribe_) return 0;
+  std::vector<uint8_t>& d = nodo_->datos;
+  if (pos_ + n > d.size()) d.resize(pos_ + n);
+  memcpy(d.data() + pos_, p, n);
+  pos_ += n;
+  return n;
+}
+
+bool File::seek(uint32_t pos, SeekMode modo) {
+  if (!nodo_) return false;
+  size_t base = modo == SeekSet ? 0 : modo == SeekCur ? pos_ : nodo_->datos.size();
+  if (base + pos > nodo_->datos.size()) return false;
+  pos_ = base + pos;
+  return true;
+}
+
+File File::openNextFile(const char* modo) {
+  if (!esDir_ || !fs_) return File();
+  std::vector<std::string> hijos = fs_->listar(ruta_);
+  while (listado_ < hijos.size()) {
+    File f = fs_->open(hijos[listado_++].c_str(), modo);
+    if (f) return f;
+  }
+  return File();
+}
+
+// ====== FS ======
+bool FS::esDir(const std::string& r) const {
+  if (r == "/" || dirs_.count(r)) return true;
+  std::string pre = r + "/";
+  auto it = archivos_.lower_bound(pre);
+  return it != archivos_.end() && it->first.compare(0, pre.size(), pre) == 0;
+}
+
+std::vector<std::string> FS::listar(const std::string& dir) const {
+  std::vector<std::string> v;
+  std::string pre = dir == "/" ? "/" : dir + "/";
+  for (auto& a : archivos_)
+    if (a.first.compare(0, pre.size(), pre) == 0 && a.first.find('/', pre.size()) == std::string::npos)
+      v.push_back(a.first);
+  return v;
+}
+
+File FS::open(const char* ruta, const char* modo, bool crear) {
+  std::string r = normal(ruta);
+  File f;
+  f.fs_ = this;
+  f.ruta_ = r;
+  f.nombre_ = r.substr(r.rfind('/') + 1);
+  bool escribe = modo && (modo[0] == 'w' || modo[0] == 'a');
+  if (!escribe && esDir(r)) {
+    f.esDir_ = true;
+    return f;
+  }
+  auto it = archivos_.find(r);
+  if (it == archivos_.end()) {
+    if (!escribe) return File();
+    if (!crear && !esDir(padre(r))) return File();
+    it = archivos_.emplace(r, std::make_shared<Nodo>()).first;
+  }
+  f.nodo_ = it->second;
+  f.nodo_->abiertos++;
+  f.escribe_ = escribe;
+  if (modo && modo[0] == 'w') f.nodo_->datos.clear();
+  if (modo && modo[0] == 'a') f.pos_ = f.nodo_->datos.size();
+  return f;
+}
+
+bool FS::exists(const char* ruta) const {
+  std::string r = normal(ruta);
+  return archivos_.count(r) || esDir(r);
+}
+
+bool FS::remove(const char* ruta) {
+  auto it = archivos_.find(normal(ruta));
+  if (it == archivos_.end() || it->second->abiertos) return false;
+  archivos_.erase(it);
+  return true;
+}
+
+bool FS::rename(const char* desde, const char* hasta) {
+  auto it = archivos_.find(normal(desde));
+  std::string h = normal(hasta);
+  if (it == archivos_.end() || it->second->abiertos) return false;
+  auto dst = archivos_.find(h);
+  if (dst != archivos_.end() && dst->second->abiertos) return false;
+  std::shared_ptr<Nodo> n = it->second;
+  archivos_.erase(it);
+  archivos_[h] = n;
+  return true;
+}
+
+bool FS::mkdir(const char* ruta) {
+  dirs_[normal(ruta)] = true;
+  return true;
+}
+
+bool FS::rmdir(const char* ruta) {
+  std::string r = normal(ruta);
+  if (!listar(r).empty()) return false;
+  return dirs_.erase(r) > 0;
+}
+
+size_t FS::bytesUsados() const {
+  size_t n = 0;
+  for (auto& a : archivos_) n += a.second->datos.size();
+  return n;
+}
+
+}  // namespace fs
@@ -0,0 +1,117 @@
+/****************************************************
+ * FS / File de Arduino-ESP32 para el simulador: un
+ * sistema de archivos en memoria (lo monta LittleFS.h)
+ * - Rutas planas ("/clips/abc.wav"); los directorios
+ *   existen si se crearon o si tienen algo adentro
+ * - open(dir) + openNextFile() recorre un nivel, en
+ *   orden alfabético
+ * - remove()/rename() de un archivo abierto fallan,
+ *   como esp_littlefs ("file is open")
+ * - Sin tiempos ni límite de espacio: el simulador
+ *   mide la lógica, no la flash
+ ****************************************************/
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct Nodo {
+  std::vector<uint8_t> datos;
+  int abiertos = 0;
+};
+
+class FS;
+
+class File : public Stream {
+public:
+  File() {}
+  File(const File& o) : Stream(o) { copiar(o); }
+  File& operator=(const File& o) {
+    if (this != &o) { close(); copiar(o); }
+    return *this;
+  }
+  ~File() override { close(); }
+
+  explicit operator bool() const { return (bool)nodo_ || esDir_; }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* p, size_t n) override;
+  using Print::write;
+  int available() override { return nodo_ ? (int)(nodo_->datos.size() - pos_) : 0; }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  int read(uint8_t* p, size_t n) {
+    size_t hay = (size_t)available();
+    if (n > hay) n = hay;
+    if (n) memcpy(p, nodo_->datos.data() + pos_, n);
+    pos_ += n;
+    return (int)n;
+  }
+  int peek() override { return available() > 0 ? nodo_->datos[pos_] : -1; }
+  bool seek(uint32_t pos, SeekMode modo = SeekSet);
+  size_t position() const { return pos_; }
+  size_t size() const { return nodo_ ? nodo_->datos.size() : 0; }
+  void close();
+  const char* name() const { return nombre_.c_str(); }
+  const char* path() const { return ruta_.c_str(); }
+  bool isDirectory() const { return esDir_; }
+  File openNextFile(const char* = "r");
+  void rewindDirectory() { listado_ = 0; }
+
+private:
+  friend class FS;
+  void copiar(const File& o);
+
+  FS*                   fs_ = nullptr;
+  std::shared_ptr<Nodo> nodo_;
+  std::string           ruta_, nombre_;
+  size_t                pos_ = 0;
+  bool                  escribe_ = false;
+  bool                  esDir_ = false;
+  size_t                listado_ = 0;
+};
+
+class FS {
+public:
+  File open(const char* ruta, const char* modo = "r", bool crear = false);
+  File open(const String& ruta, const char* modo = "r") { return open(ruta.c_str(), modo); }
+  bool exists(const char* ruta) const;
+  bool exists(const String& ruta) const { return exists(ruta.c_str()); }
+  bool remove(const char* ruta);
+  bool remove(const String& ruta) { return remove(ruta.c_str()); }
+  bool rename(const char* desde, const char* hasta);
+  bool rename(const String& desde, const String& hasta) { return rename(desde.c_str(), hasta.c_str()); }
+  bool mkdir(const char* ruta);
+  bool mkdir(const String& ruta) { return mkdir(ruta.c_str()); }
+  bool rmdir(const char* ruta);
+
+  // ---- Para los bench ----
+  size_t archivos() const { return archivos_.size(); }
+  size_t bytesUsados() const;
+  void   formatear() { archivos_.clear(); dirs_.clear(); }
+
+private:
+  friend class File;
+  bool esDir(const std::string& ruta) const;
+  std::vector<std::string> listar(const std::string& dir) const;
+
+  std::map<std::string, std::shared_ptr<Nodo>> archivos_;
+  std::map<std::string, bool>                  dirs_;
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
@@ -0,0 +1,116 @@
+#include "HTTPClient.h"
+
+uint32_t HTTPClient::conexiones_ = 0;
+
+// "http://host:puerto/ruta?query"
+// Lo que pide el simulador no es heap del firmware (sim::EnHal); el
+// String de header() y getString() sí
+bool HTTPClient::begin(const char* url) {
+  sim::EnHal hal;
+  const char* p = strstr(url, "://");
+  if (!p) return false;
+  p += 3;
+  const char* barra = strchr(p, '/');
+  std::string host = barra ? std::string(p, barra - p) : std::string(p);
+  std::string resto = barra ? barra : "/";
+  if (host.empty()) return false;
+  if (host != host_) conectado_ = false;   // otro server: otro socket
+  host_ = host;
+
+  size_t q = resto.find('?');
+  pedido_.ruta = resto.substr(0, q);
+  pedido_.query = q == std::string::npos ? "" : resto.substr(q + 1);
+  codigo_ = 0;
+  return true;
+}
+
+void HTTPClient::collectHeaders(const char* claves[], size_t n) {
+  sim::EnHal hal;
+  claves_.assign(claves, claves + n);
+}
+
+int HTTPClient::enviar(const char* metodo, const uint8_t* cuerpo, size_t n) {
+  sim::EnHal hal;
+  if (WiFi.status() != WL_CONNECTED) return codigo_ = HTTPC_ERROR_CONNECTION_REFUSED;
+  uint64_t limite = sim::ahoraUs() + (uint64_t)timeoutMs_ * 1000;
+
+  // Conexión nueva: SYN / SYN-ACK
+  if (!conectado_) {
+    sim::dormirHasta(sim::ahoraUs() + sim::viajeUs() + sim::viajeUs());
+    conexiones_++;
+    conectado_ = true;
+  }
+
+  // Pedido: línea + headers + cuerpo, un viaje hasta el server
+  pedido_.metodo = metodo;
+  pedido_.cuerpo.assign((const char*)cuerpo, n);
+  size_t bytes = 96 + host_.size() + pedido_.ruta.size() + pedido_.query.size() + n;
+  for (const auto& h : pedido_.headers) bytes += h.first.size() + h.second.size() + 4;
+  sim::dormirHasta(sim::ahoraUs() + sim::transmitirUs(bytes) + sim::viajeUs());
+
+  sim::Respuesta r = sim::servidor().atender(pedido_);
+  uint64_t envio = sim::ahoraUs();
+  uint64_t llegan = envio + sim::viajeUs();
+  if (llegan > limite) {
+    if (sim::ahoraUs() < limite) sim::dormirHasta(limite);
+    conectado_ = false;
+    return codigo_ = HTTPC_ERROR_READ_TIMEOUT;
+  }
+  sim::dormirHasta(llegan);
+
+  recibidos_.clear();
+  for (const auto& k : claves_) {
+    std::string v = r.header(k.c_str());
+    if (!v.empty()) recibidos_.push_back({ k, v });
+  }
+  entrega_.armar(r.cuerpo, envio, r.listos, r.sinLargo);
+  cliente_.enlazar(&entrega_);
+  cliente_.setTimeout(timeoutMs_);
+  return codigo_ = r.codigo;
+}
+
+String HTTPClient::header(const char* k) const {
+  for (const auto& h : recibidos_) {
+    if (!strcasecmp(h.first.c_str(), k)) return String(h.second);
+  }
+  return String();
+}
+
+bool HTTPClient::hasHeader(const char* k) const {
+  for (const auto& h : recibidos_) {
+    if (!strcasecmp(h.first.c_str(), k)) return true;
+  }
+  return false;
+}
+
+String HTTPClient::getString() {
+  if (codigo_ <= 0) return String();
+  std::string s;
+  uint8_t buf[512];
+  while (s.size() < entrega_.total()) {
+    size_t n = cliente_.readBytes(buf, sizeof(buf) < entrega_.total() - s.size() ? sizeof(buf) : entrega_.total() - s.size());
+    if (!n) break;
+    s.append((const char*)buf, n);
+  }
+  return String(s);
+}
+
+// Con reuse el socket queda abierto solo si la respuesta se leyó entera
+void HTTPClient::end() {
+  sim::EnHal hal;
+  if (!reuse_ || codigo_ <= 0 || cliente_.leidos() < entrega_.total()) conectado_ = false;
+  cliente_.enlazar(nullptr);
+  entrega_.cerrar();
+  pedido_.headers.clear();
+  recibidos_.clear();
+  codigo_ = 0;
+}
+
+String HTTPClient::errorToString(int codigo) {
+  switch (codigo) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return String("connection refused");
+    case HTTPC_ERROR_NOT_CONNECTED:      return String("not connected");
+    case HTTPC_ERROR_READ_TIMEOUT:       return String("read Timeout");
+    default:                             return String();
+  }
+}
@@ -0,0 +1,77 @@
+/****************************************************
+ * HTTPClient de Arduino-ESP32 para el simulador
+ * - Los pedidos van a sim::servidor() (ServidorMock.h)
+ *   y cuestan lo que diga el perfil de red (Red.h):
+ *   conexión nueva = un RTT de handshake, pedido =
+ *   un viaje, respuesta = un viaje + el cuerpo en
+ *   segmentos por getStream()
+ * - setReuse(true) mantiene el socket solo si se leyó
+ *   toda la respuesta (si no, end() lo cierra)
+ * - Pasado setTimeout() sin respuesta: -11 (read
+ *   timeout) y se cierra la conexión, como el real
+ * - useHTTP10(): sin keep-alive; una respuesta sin
+ *   largo da getSize() = -1 y termina con el cierre
+ ****************************************************/
+#pragma once
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "ServidorMock.h"
+
+#define HTTP_CODE_OK               200
+#define HTTP_CODE_PARTIAL_CONTENT  206
+#define HTTP_CODE_BAD_REQUEST      400
+#define HTTP_CODE_NOT_FOUND        404
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_NOT_CONNECTED      (-4)
+#define HTTPC_ERROR_READ_TIMEOUT       (-11)
+
+class HTTPClient {
+public:
+  bool begin(const String& url) { return begin(url.c_str()); }
+  bool begin(const char* url);
+  void end();
+
+  void setReuse(bool r) { reuse_ = r; }
+  void useHTTP10(bool v = true) { http10_ = v; reuse_ = !v; }   // como el real: 1.0 no reusa
+  void setTimeout(uint16_t ms) { timeoutMs_ = ms; }
+  void setConnectTimeout(int32_t) {}
+  void addHeader(const String& k, const String& v) {
+    sim::EnHal hal;
+    pedido_.headers.push_back({ k.c_str(), v.c_str() });
+  }
+  void collectHeaders(const char* claves[], size_t n);
+
+  int GET() { return enviar("GET", nullptr, 0); }
+  int POST(uint8_t* cuerpo, size_t n) { return enviar("POST", cuerpo, n); }
+  int POST(const String& cuerpo) { return enviar("POST", (const uint8_t*)cuerpo.c_str(), cuerpo.length()); }
+
+  String header(const char* k) const;
+  bool   hasHeader(const char* k) const;
+  int    getSize() const { return codigo_ > 0 && !entrega_.cierra() ? (int)entrega_.total() : -1; }
+  String getString();
+  WiFiClient& getStream() { return cliente_; }
+  WiFiClient* getStreamPtr() { return codigo_ > 0 ? &cliente_ : nullptr; }
+  bool   connected() { return conectado_ && cliente_.connected(); }
+  static String errorToString(int codigo);
+
+  // Para los bench: conexiones TCP abiertas desde el arranque
+  static uint32_t conexiones() { return conexiones_; }
+
+private:
+  int enviar(const char* metodo, const uint8_t* cuerpo, size_t n);
+
+  sim::Pedido  pedido_;
+  sim::Headers recibidos_;
+  std::vector<std::string> claves_;
+  std::string  host_;
+  sim::Entrega entrega_;
+  WiFiClient   cliente_;
+  int          codigo_ = 0;
+  uint16_t     timeoutMs_ = 5000;
+  bool         reuse_ = true;
+  bool         http10_ = false;
+  bool         conectado_ = false;
+
+  static uint32_t conexiones_;
+};
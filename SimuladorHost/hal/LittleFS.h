@@ -0,0 +1,20 @@
+// LittleFS de Arduino-ESP32 para el simulador: el FS en memoria de FS.h
+#pragma once
+
+#include "FS.h"
+
+namespace fs {
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatearSiFalla = false, const char* = "/littlefs", uint8_t = 10, const char* = "spiffs") {
+    (void)formatearSiFalla;
+    return true;
+  }
+  void end() {}
+  bool format() { formatear(); return true; }
+  size_t totalBytes() { return 1536 * 1024; }
+  size_t usedBytes() { return bytesUsados(); }
+};
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,82 @@
+// MD5Builder de Arduino-ESP32 para el simulador (MD5 de la RFC 1321)
+#pragma once
+
+#include "Arduino.h"
+
+class MD5Builder {
+public:
+  void begin() {
+    h_[0] = 0x67452301; h_[1] = 0xefcdab89; h_[2] = 0x98badcfe; h_[3] = 0x10325476;
+    largo_ = 0;
+    n_ = 0;
+  }
+  void add(const uint8_t* p, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) {
+      buf_[n_++] = p[i];
+      if (n_ == 64) { bloque(buf_); n_ = 0; }
+    }
+    largo_ += n;
+  }
+  void add(const char* s) { add((const uint8_t*)s, (uint16_t)strlen(s)); }
+  void add(const String& s) { add(s.c_str()); }
+  void calculate() {
+    uint64_t bits = largo_ * 8;
+    uint8_t  uno = 0x80, cero = 0;
+    add(&uno, 1);
+    while (n_ != 56) add(&cero, 1);
+    for (int i = 0; i < 8; i++) { buf_[n_++] = (uint8_t)(bits >> (8 * i)); }
+    bloque(buf_);
+    for (int i = 0; i < 4; i++)
+      for (int k = 0; k < 4; k++) res_[i * 4 + k] = (uint8_t)(h_[i] >> (8 * k));
+  }
+  void getBytes(uint8_t* out) const { memcpy(out, res_, 16); }
+  void getChars(char* out) const {
+    for (int i = 0; i < 16; i++) sprintf(out + 2 * i, "%02x", res_[i]);
+  }
+  String toString() const {
+    char s[33];
+    getChars(s);
+    return String(s);
+  }
+
+private:
+  static uint32_t rot(uint32_t x, int c) { return (x << c) | (x >> (32 - c)); }
+  void bloque(const uint8_t* p) {
+    static const uint32_t K[64] = {
+      0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+      0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+      0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+      0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+      0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+      0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+      0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+      0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+    static const int R[64] = { 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                               5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                               4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                               6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21 };
+    uint32_t m[16];
+    for (int i = 0; i < 16; i++) m[i] = p[i * 4] | p[i * 4 + 1] << 8 | p[i * 4 + 2] << 16 | (uint32_t)p[i * 4 + 3] << 24;
+    uint32_t a = h_[0], b = h_[1], c = h_[2], d = h_[3];
+    for (int i = 0; i < 64; i++) {
+      uint32_t f;
+      int g;
+      if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+      else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+      else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+      else             { f = c ^ (b | ~d);       g = (7 * i) % 16; }
+      uint32_t t = d;
+      d = c;
+      c = b;
+      b = b + rot(a + f + K[i] + m[g], R[i]);
+      a = t;
+    }
+    h_[0] += a; h_[1] += b; h_[2] += c; h_[3] += d;
+  }
+
+  uint32_t h_[4];
+  uint64_t largo_ = 0;
+  uint8_t  buf_[64];
+  uint8_t  n_ = 0;
+  uint8_t  res_[16] = {};
+};
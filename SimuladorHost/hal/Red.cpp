@@ -0,0 +1,101 @@
+#include "Red.h"
+
+#include <string.h>
+#include "Sim.h"
+
+namespace sim {
+
+// ====== Perfiles ======
+// lan: el server en la misma red. wifi: casa, señal buena. wifi_malo:
+// lejos del router, con microcortes. ngrok: el túnel del notebook (Colab),
+// RTT alto y pausas largas cada tanto.
+const PerfilRed PERFILES[] = {
+  //  nombre       rtt  jitter  bytes/s  pausa   pausaMs  server  rssi
+  { "lan",          2,    1,   2000000, 0.0,        0,      2,  -40 },
+  { "wifi",        12,    6,    600000, 0.0005,   120,      5,  -60 },
+  { "wifi_malo",   35,   30,    150000, 0.004,    350,      5,  -78 },
+  { "ngrok",      180,   50,    250000, 0.002,    900,     20,  -60 },
+};
+const size_t N_PERFILES = sizeof(PERFILES) / sizeof(PERFILES[0]);
+
+namespace {
+const PerfilRed* actual = &PERFILES[1];
+}
+
+const PerfilRed* buscarPerfil(const char* nombre) {
+  for (size_t i = 0; i < N_PERFILES; i++) {
+    if (!strcmp(PERFILES[i].nombre, nombre)) return &PERFILES[i];
+  }
+  return nullptr;
+}
+
+void usarPerfil(const PerfilRed& p) { actual = &p; }
+const PerfilRed& perfil() { return *actual; }
+
+uint64_t viajeUs() {
+  return (uint64_t)actual->rttMs * 500 + (uint64_t)azar().exponencial(actual->jitterMs * 1000.0);
+}
+
+uint64_t transmitirUs(size_t bytes) { return (uint64_t)bytes * 1000000 / actual->bytesPorS; }
+
+// ====== Entrega ======
+void Entrega::armar(const std::string& datos, uint64_t desdeUs, const Listos& listos, bool cierra) {
+  datos_ = datos;
+  listos_ = listos;
+  cierra_ = cierra;
+  fin_.clear();
+  size_t l = 0;
+  for (size_t desde = 0; desde < datos_.size();) {
+    while (l < listos_.size() && listos_[l].first <= desde) l++;
+    size_t hasta = desde + SEGMENTO;
+    if (l < listos_.size() && listos_[l].first < hasta) hasta = listos_[l].first;
+    if (hasta > datos_.size()) hasta = datos_.size();
+    fin_.push_back(hasta);
+    desde = hasta;
+  }
+  llegada_.clear();
+  k_ = 0;
+  leidos_ = 0;
+  envio_ = desdeUs;
+  ultima_ = desdeUs;
+  calcular(desdeUs);
+}
+
+// Habilita los segmentos que entran en la ventana; el server se enteró
+// de la última lectura en 'avisoUs'
+void Entrega::calcular(uint64_t avisoUs) {
+  while (llegada_.size() < fin_.size()) {
+    size_t i = llegada_.size();
+    size_t desde = i ? fin_[i - 1] : 0, hasta = fin_[i];
+    if (hasta - leidos_ > VENTANA) break;
+    uint64_t t = envio_ > avisoUs ? envio_ : avisoUs;
+    for (const auto& l : listos_) {
+      if (l.first < hasta) continue;
+      if (l.second > t) t = l.second;   // el server todavía no lo tiene
+      break;
+    }
+    if (azar().prob(actual->probPausa)) t += (uint64_t)azar().exponencial(actual->pausaMs * 1000.0);
+    t += transmitirUs(hasta - desde);
+    envio_ = t;
+    uint64_t llega = t + viajeUs();
+    if (llega < ultima_) llega = ultima_;
+    ultima_ = llega;
+    llegada_.push_back(llega);
+  }
+}
+
+size_t Entrega::llegados(uint64_t us) {
+  while (k_ < llegada_.size() && llegada_[k_] <= us) k_++;
+  return k_ ? fin_[k_ - 1] : 0;
+}
+
+uint64_t Entrega::proxima() const { return k_ < llegada_.size() ? llegada_[k_] : SIN_LIMITE; }
+
+void Entrega::consumir(size_t leidos, uint64_t us) {
+  if (leidos <= leidos_) return;
+  leidos_ = leidos;
+  // El aviso de ventana solo importa si abre lugar para el próximo segmento
+  if (llegada_.size() < fin_.size() && fin_[llegada_.size()] - leidos_ <= VENTANA) calcular(us + viajeUs());
+}
+
+}  // namespace sim
@@ -0,0 +1,79 @@
+/****************************************************
+ * Red simulada entre el ESP32 y el server
+ * - Perfiles de red: RTT, jitter, ancho de banda y
+ *   pausas (la red se queda quieta un rato: WiFi
+ *   lejos del router, ngrok)
+ * - Entrega: los bytes de una respuesta llegando en
+ *   segmentos TCP. El server no manda más de una
+ *   ventana (TCP_WND de lwIP) por delante de lo que
+ *   leyó el ESP32, y se entera de cada lectura un
+ *   viaje después: si el firmware no lee, la red para
+ * - Respuestas que el server sigue generando: cada
+ *   tramo sale cuando está listo, y sin largo la
+ *   conexión se cierra al llegar el último byte
+ * - Todo sale de sim::azar(): reproducible
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+struct PerfilRed {
+  const char* nombre;
+  uint32_t rttMs;        // ida y vuelta sin carga
+  uint32_t jitterMs;     // demora extra media por viaje (exponencial)
+  uint32_t bytesPorS;    // ancho de banda
+  double   probPausa;    // por segmento: la red se queda quieta
+  uint32_t pausaMs;      // duración media de esas pausas (exponencial)
+  uint32_t servidorMs;   // lo que tarda el server en armar cada respuesta
+  int8_t   rssi;
+};
+
+extern const PerfilRed PERFILES[];
+extern const size_t    N_PERFILES;
+const PerfilRed* buscarPerfil(const char* nombre);   // nullptr si no existe
+void usarPerfil(const PerfilRed& p);
+const PerfilRed& perfil();
+
+uint64_t viajeUs();                        // un sentido, con jitter
+uint64_t transmitirUs(size_t bytes);       // bytes al ancho de banda del perfil
+
+class Entrega {
+public:
+  static const uint32_t SEGMENTO = 1460;
+  static const uint32_t VENTANA  = 5744;   // CONFIG_LWIP_TCP_WND_DEFAULT de Arduino-ESP32
+
+  // (hasta qué byte, desde cuándo lo tiene el server), en orden
+  typedef std::vector<std::pair<size_t, uint64_t>> Listos;
+
+  // El server empieza a mandar 'datos' en 'desdeUs'; con 'listos', cada
+  // tramo recién cuando está. 'cierra': sin largo, el fin es el cierre
+  void armar(const std::string& datos, uint64_t desdeUs, const Listos& listos = {}, bool cierra = false);
+  void cerrar() { datos_.clear(); fin_.clear(); llegada_.clear(); listos_.clear(); k_ = 0; leidos_ = 0; }
+
+  size_t   total() const { return datos_.size(); }
+  bool     cierra() const { return cierra_; }
+  const char* datos() const { return datos_.data(); }
+  size_t   llegados(uint64_t us);         // bytes recibidos hasta 'us'
+  uint64_t proxima() const;               // cuándo llega el próximo segmento (SIN_LIMITE: no viene nada)
+  void     consumir(size_t leidos, uint64_t us);   // el ESP32 leyó hasta 'leidos'
+
+private:
+  void calcular(uint64_t avisoUs);
+
+  std::string           datos_;
+  std::vector<size_t>   fin_;             // dónde termina cada segmento (cortan también en 'listos')
+  std::vector<uint64_t> llegada_;         // por segmento, ya habilitados por la ventana
+  Listos                listos_;
+  bool                  cierra_ = false;
+  size_t                k_ = 0;           // segmentos ya llegados
+  size_t                leidos_ = 0;
+  uint64_t              envio_ = 0;       // fin del último segmento mandado
+  uint64_t              ultima_ = 0;      // llegada del último (TCP entrega en orden)
+};
+
+}  // namespace sim
@@ -0,0 +1,24 @@
+// SPI de Arduino-ESP32 para el simulador: los fakes de TFT y touch
+// cobran el tiempo del bus ellos mismos, esto es solo la interfaz
+#pragma once
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0
+#define MSBFIRST  1
+
+class SPISettings {
+public:
+  SPISettings(uint32_t = 1000000, uint8_t = MSBFIRST, uint8_t = SPI_MODE0) {}
+};
+
+class SPIClass {
+public:
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t  transfer(uint8_t) { return 0; }
+  uint16_t transfer16(uint16_t) { return 0; }
+};
+extern SPIClass SPI;
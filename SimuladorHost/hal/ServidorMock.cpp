@@ -0,0 +1,330 @@
+#include "ServidorMock.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Red.h"
+#include "Sim.h"
+
+namespace sim {
+
+namespace {
+std::string buscar(const Headers& hs, const char* k) {
+  for (const auto& h : hs) {
+    if (!strcasecmp(h.first.c_str(), k)) return h.second;
+  }
+  return "";
+}
+
+// "/esp32/poll/abc" con prefijo "/esp32/poll/" -> "abc"
+bool ruta(const std::string& r, const char* prefijo, std::string& resto) {
+  size_t n = strlen(prefijo);
+  if (r.compare(0, n, prefijo)) return false;
+  resto = r.substr(n);
+  return !resto.empty() && resto.find('/') == std::string::npos;
+}
+
+Respuesta json(int codigo, const std::string& cuerpo) {
+  Respuesta r;
+  r.codigo = codigo;
+  r.headers.push_back({ "Content-Type", "application/json" });
+  r.cuerpo = cuerpo;
+  return r;
+}
+
+void u16(std::string& s, uint16_t v) { s += (char)(v & 0xFF); s += (char)(v >> 8); }
+void u32(std::string& s, uint32_t v) { u16(s, v & 0xFFFF); u16(s, v >> 16); }
+}  // namespace
+
+std::string Pedido::param(const char* k) const {
+  size_t n = strlen(k);
+  for (size_t i = 0; i < query.size();) {
+    size_t fin = query.find('&', i);
+    if (fin == std::string::npos) fin = query.size();
+    if (!query.compare(i, n, k) && i + n < fin && query[i + n] == '=') return query.substr(i + n + 1, fin - i - n - 1);
+    i = fin + 1;
+  }
+  return "";
+}
+
+std::string Pedido::header(const char* k) const { return buscar(headers, k); }
+std::string Respuesta::header(const char* k) const { return buscar(headers, k); }
+
+ServidorMock& servidor() {
+  static ServidorMock s;
+  return s;
+}
+
+// ====== Bench ======
+uint32_t ServidorMock::encolar(const std::string& deviceId, const std::string& campos) {
+  Cola& c = colas_[deviceId];
+  uint32_t seq = ++c.seq;
+  c.cmds.push_back("{" + campos + ",\"seq\":" + std::to_string(seq) + "}");
+  c.encolado[seq] = ahoraUs();
+  return seq;
+}
+
+uint64_t ServidorMock::encoladoUs(const std::string& deviceId, uint32_t seq) const {
+  auto c = colas_.find(deviceId);
+  if (c == colas_.end()) return 0;
+  auto e = c->second.encolado.find(seq);
+  return e == c->second.encolado.end() ? 0 : e->second;
+}
+
+size_t ServidorMock::pendientes(const std::string& deviceId) const {
+  auto c = colas_.find(deviceId);
+  return c == colas_.end() ? 0 : c->second.cmds.size();
+}
+
+void ServidorMock::agregarAudio(const std::string& id, const std::string& wavPcm) { audios_[id] = wavPcm; }
+
+// Como FlujoAudio.trozos(): el header de la primera frase sin 'fact' y con
+// los largos al máximo, después los datos de cada frase en orden, cada uno
+// completado a un bloque entero. Una frase sale cuando están ella y las
+// anteriores.
+void ServidorMock::agregarFlujo(const std::string& id, const std::vector<std::string>& frasesPcm,
+                                const std::vector<uint64_t>& listoUs, bool ima) {
+  Flujo f;
+  uint64_t listo = 0;
+  for (size_t i = 0; i < frasesPcm.size(); i++) {
+    std::string wav = ima ? wavAIma(frasesPcm[i]) : frasesPcm[i];
+    // RIFF/WAVE, 'fmt ' y después 'fact' (IMA) y 'data'
+    const uint8_t* w = (const uint8_t*)wav.data();
+    uint32_t tamFmt = w[16] | w[17] << 8 | w[18] << 16 | (uint32_t)w[19] << 24;
+    uint16_t bloque = w[32] | w[33] << 8;
+    size_t d = 20 + tamFmt;
+    if (!wav.compare(d, 4, "fact")) d += 12;
+    std::string datos = wav.substr(d + 8);
+    if (datos.size() % bloque) datos.append(bloque - datos.size() % bloque, '\0');
+    if (i == 0) {
+      f.cuerpo = "RIFF";
+      u32(f.cuerpo, 0xFFFFFFFF);
+      f.cuerpo += "WAVE" + wav.substr(12, 8 + tamFmt) + "data";
+      u32(f.cuerpo, 0xFFFFFFFF);
+    }
+    f.cuerpo += datos;
+    if (listoUs[i] > listo) listo = listoUs[i];
+    f.listos.push_back({ f.cuerpo.size(), listo });
+  }
+  flujos_[id] = f;
+}
+
+const std::string& ServidorMock::metricas(const std::string& deviceId) const {
+  static const std::string nada;
+  auto m = metricas_.find(deviceId);
+  return m == metricas_.end() ? nada : m->second;
+}
+
+// ====== Rutas ======
+Respuesta ServidorMock::atender(const Pedido& p) {
+  stats_.pedidos++;
+  // Un solo event loop (uvicorn en el notebook): cada pedido lo ocupa
+  // servidorMs y los que llegan mientras tanto esperan su turno. La
+  // espera del long-poll no lo ocupa (es async)
+  uint64_t costo = perfil().servidorMs * 1000;
+  libreUs_ = std::max(ahoraUs(), libreUs_) + costo;
+  stats_.ocupadoUs += costo;
+  dormirHasta(libreUs_);
+  std::string id;
+  if (p.metodo == "GET" && ruta(p.ruta, "/esp32/poll/", id)) return poll(p, id);
+  if (p.metodo == "GET" && ruta(p.ruta, "/esp32/audio_raw/", id)) return audio(p, id);
+  if (p.metodo == "GET" && ruta(p.ruta, "/esp32/audio_flujo/", id)) return flujo(id);
+  if (p.metodo == "POST" && p.ruta == "/esp32/register") {
+    return json(200, "{\"success\":true,\"mensaje\":\"Dispositivo registrado\"}");
+  }
+  if (p.metodo == "POST" && ruta(p.ruta, "/esp32/confirmar/", id)) {
+    stats_.confirmaciones++;
+    stats_.confirmados++;
+    return json(200, "{\"success\":true}");
+  }
+  if (p.metodo == "POST" && ruta(p.ruta, "/esp32/confirmar_lote/", id)) {
+    stats_.confirmaciones++;
+    for (size_t i = p.cuerpo.find("\"seq\""); i != std::string::npos; i = p.cuerpo.find("\"seq\"", i + 1)) {
+      stats_.confirmados++;
+    }
+    return json(200, "{\"success\":true}");
+  }
+  if (p.metodo == "POST" && ruta(p.ruta, "/admin/metrics/", id)) {
+    if (p.cuerpo.empty() || p.cuerpo[0] != '{') return json(400, "{\"detail\":\"JSON inválido\"}");
+    metricas_[id] = p.cuerpo;
+    stats_.metricas++;
+    return json(200, "{\"success\":true}");
+  }
+  return json(404, "{\"detail\":\"Not Found\"}");
+}
+
+// Long-poll: retiene hasta que haya un comando o pasen 'wait' s
+Respuesta ServidorMock::poll(const Pedido& p, const std::string& id) {
+  stats_.polls++;
+  Cola& c = colas_[id];
+  long wait = sinLongPoll_ ? 0 : atol(p.param("wait").c_str());
+  if (wait < 0) wait = 0;
+  if (wait > (long)LONG_POLL_MAX_S) wait = LONG_POLL_MAX_S;
+  long lote = atol(p.param("lote").c_str());
+  if (lote < 1) lote = 1;
+  if (lote > (long)POLL_MAX_CMDS) lote = POLL_MAX_CMDS;
+
+  uint64_t t0 = ahoraUs();
+  if (wait) esperar([&c] { return !c.cmds.empty(); }, t0 + (uint64_t)wait * 1000000);
+
+  std::string cuerpo = "{\"comandos\":[";
+  for (long i = 0; i < lote && !c.cmds.empty(); i++) {
+    if (i) cuerpo += ",";
+    cuerpo += c.cmds.front();
+    c.cmds.pop_front();
+    stats_.comandos++;
+  }
+  cuerpo += "]";
+  if (!sinLongPoll_) cuerpo += ",\"retenido_ms\":" + std::to_string((ahoraUs() - t0) / 1000);
+  cuerpo += "}";
+  Respuesta r = json(200, cuerpo);
+  if (!sinLongPoll_) {
+    r.headers.push_back({ "X-Long-Poll", std::to_string(LONG_POLL_MAX_S) });
+    r.headers.push_back({ "X-Retenido-Ms", std::to_string((ahoraUs() - t0) / 1000) });
+  }
+  return r;
+}
+
+Respuesta ServidorMock::audio(const Pedido& p, const std::string& id) {
+  auto a = audios_.find(id);
+  if (a == audios_.end()) return json(404, "{\"detail\":\"Audio no encontrado\"}");
+  Respuesta r;
+  r.headers.push_back({ "Content-Type", "audio/wav" });
+  r.headers.push_back({ "Accept-Ranges", "bytes" });
+  r.cuerpo = p.param("fmt") == "ima" ? wavAIma(a->second) : a->second;
+  // "bytes=a-", "bytes=a-b" o "bytes=-n", como rango_http(); lo demás se ignora
+  std::string rango = p.header("Range");
+  unsigned long ini = 0, fin = 0, tam = r.cuerpo.size();
+  char sobra;
+  bool hay = false, fuera = false;
+  if (!rango.compare(0, 7, "bytes=-")) {          // antes: %lu acepta el signo
+    if (sscanf(rango.c_str(), "bytes=-%lu%c", &fin, &sobra) == 1) {
+      hay = true, fuera = fin == 0;
+      ini = tam > fin ? tam - fin : 0, fin = tam - 1;
+    }
+  } else if (sscanf(rango.c_str(), "bytes=%lu-%lu%c", &ini, &fin, &sobra) == 2) hay = fin >= ini, fuera = hay && ini >= tam;
+  else if (sscanf(rango.c_str(), "bytes=%lu-%c", &ini, &sobra) == 1) hay = true, fuera = ini >= tam, fin = tam - 1;
+  if (fuera) {
+    Respuesta e = json(416, "{\"detail\":\"Rango fuera del audio\"}");
+    e.headers.push_back({ "Content-Range", "bytes */" + std::to_string(tam) });
+    return e;
+  }
+  if (hay) {
+    fin = std::min(fin, tam - 1);
+    r.codigo = 206;
+    r.headers.push_back({ "Content-Range", "bytes " + std::to_string(ini) + "-" + std::to_string(fin) + "/" +
+                                               std::to_string(tam) });
+    r.cuerpo = r.cuerpo.substr(ini, fin - ini + 1);
+  }
+  stats_.audios++;
+  stats_.bytesAudio += r.cuerpo.size();
+  return r;
+}
+
+// Los headers salen enseguida (StreamingResponse), el cuerpo a medida que
+// está cada frase; sin Range
+Respuesta ServidorMock::flujo(const std::string& id) {
+  auto f = flujos_.find(id);
+  if (f == flujos_.end()) return json(404, "{\"detail\":\"Flujo no encontrado\"}");
+  Respuesta r;
+  r.headers.push_back({ "Content-Type", "audio/wav" });
+  r.cuerpo = f->second.cuerpo;
+  r.listos = f->second.listos;
+  r.sinLargo = true;
+  stats_.audios++;
+  stats_.bytesAudio += r.cuerpo.size();
+  return r;
+}
+
+// ====== WAV ======
+std::string ServidorMock::wavPcm(const int16_t* m, size_t n, uint32_t rate) {
+  std::string s = "RIFF";
+  u32(s, 36 + n * 2);
+  s += "WAVEfmt ";
+  u32(s, 16);
+  u16(s, 1);
+  u16(s, 1);
+  u32(s, rate);
+  u32(s, rate * 2);
+  u16(s, 2);
+  u16(s, 16);
+  s += "data";
+  u32(s, n * 2);
+  for (size_t i = 0; i < n; i++) u16(s, (uint16_t)m[i]);
+  return s;
+}
+
+// Port de wav_a_ima()/_ima_bloque() del server (solo WAV mono 16 bit)
+std::string ServidorMock::wavAIma(const std::string& wav) {
+  static const int16_t STEP[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+  };
+  static const int8_t INDEX[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+  const uint8_t* w = (const uint8_t*)wav.data();
+  uint32_t rate = w[24] | w[25] << 8 | w[26] << 16 | (uint32_t)w[27] << 24;
+  size_t n = (wav.size() - 44) / 2;
+  std::vector<int16_t> m(n);
+  for (size_t i = 0; i < n; i++) m[i] = (int16_t)(w[44 + 2 * i] | w[45 + 2 * i] << 8);
+
+  std::string data;
+  int idx = 0;
+  for (size_t b = 0; b < n; b += IMA_SPB) {
+    size_t fin = b + IMA_SPB < n ? b + IMA_SPB : n;
+    int pred = m[b];
+    u16(data, (uint16_t)pred);
+    data += (char)idx;
+    data += (char)0;
+    std::vector<uint8_t> nibs;
+    for (size_t i = b + 1; i < fin; i++) {
+      int step = STEP[idx];
+      int diff = m[i] - pred;
+      uint8_t c = 0;
+      if (diff < 0) { c = 8; diff = -diff; }
+      if (diff >= step) { c |= 4; diff -= step; }
+      if (diff >= step >> 1) { c |= 2; diff -= step >> 1; }
+      if (diff >= step >> 2) c |= 1;
+      int d = step >> 3;
+      if (c & 4) d += step;
+      if (c & 2) d += step >> 1;
+      if (c & 1) d += step >> 2;
+      pred = c & 8 ? pred - d : pred + d;
+      pred = pred < -32768 ? -32768 : pred > 32767 ? 32767 : pred;
+      idx += INDEX[c];
+      idx = idx < 0 ? 0 : idx > 88 ? 88 : idx;
+      nibs.push_back(c);
+    }
+    if (nibs.size() % 2) nibs.push_back(0);
+    for (size_t i = 0; i < nibs.size(); i += 2) data += (char)(nibs[i] | nibs[i + 1] << 4);
+  }
+
+  std::string fmt;
+  u16(fmt, 0x11);
+  u16(fmt, 1);
+  u32(fmt, rate);
+  u32(fmt, rate * IMA_BLOCK / IMA_SPB);
+  u16(fmt, IMA_BLOCK);
+  u16(fmt, 4);
+  u16(fmt, 2);
+  u16(fmt, IMA_SPB);
+  std::string chunks = "fmt ";
+  u32(chunks, fmt.size());
+  chunks += fmt + "fact";
+  u32(chunks, 4);
+  u32(chunks, n);
+  chunks += "data";
+  u32(chunks, data.size());
+  chunks += data;
+  if (data.size() % 2) chunks += '\0';
+  std::string s = "RIFF";
+  u32(s, 4 + chunks.size());
+  return s + "WAVE" + chunks;
+}
+
+}  // namespace sim
@@ -0,0 +1,122 @@
+/****************************************************
+ * Mock de las rutas del server (RobotNao.ipynb) que
+ * usa el firmware, dentro del simulador
+ * - /esp32/register, /esp32/poll/{id} (long-poll con
+ *   ?wait y ?lote, X-Long-Poll, retenido_ms),
+ *   /esp32/audio_raw/{id} (?fmt=ima, Range -> 206/416
+ *   como rango_http()), /esp32/audio_flujo/{id} (frase
+ *   por frase, cada una cuando la "sintetiza" el bench),
+ *   /esp32/confirmar,
+ *   /esp32/confirmar_lote/{id}, /admin/metrics/{id}
+ * - Misma forma de respuesta que FastAPI; los comandos
+ *   llevan "seq" como los de _put_cmd()
+ * - wavAIma(): mismo encoder IMA-ADPCM que wav_a_ima()
+ *   (bloques de 256 bytes, 505 muestras)
+ * - atender() corre en la tarea del ESP32 que hizo el
+ *   pedido: el long-poll la bloquea en tiempo virtual
+ * - Un solo event loop para todos los devices, como
+ *   uvicorn: con muchos, los pedidos hacen cola
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Red.h"
+
+namespace sim {
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+struct Pedido {
+  std::string metodo;
+  std::string ruta;      // sin host ni query
+  std::string query;     // sin '?'
+  Headers     headers;
+  std::string cuerpo;
+
+  std::string param(const char* k) const;
+  std::string header(const char* k) const;
+};
+
+struct Respuesta {
+  int         codigo = 200;
+  Headers     headers;
+  std::string cuerpo;
+  // Cuerpo que el server sigue generando: cada tramo sale cuando está y,
+  // sin largo, el fin es el cierre (/esp32/audio_flujo)
+  Entrega::Listos listos;
+  bool        sinLargo = false;
+
+  std::string header(const char* k) const;
+};
+
+class ServidorMock {
+public:
+  static const uint32_t LONG_POLL_MAX_S = 25;   // igual que el server
+  static const uint32_t POLL_MAX_CMDS   = 8;
+  static const uint32_t IMA_BLOCK       = 256;
+  static const uint32_t IMA_SPB         = 1 + (IMA_BLOCK - 4) * 2;
+
+  struct Stats {
+    uint32_t pedidos;
+    uint32_t polls;
+    uint32_t comandos;       // entregados en polls
+    uint32_t audios;
+    uint64_t bytesAudio;
+    uint32_t confirmaciones;  // POST a confirmar o confirmar_lote
+    uint32_t confirmados;     // audios confirmados (varios por lote)
+    uint32_t metricas;
+    uint64_t ocupadoUs;      // event loop ocupado atendiendo
+  };
+
+  // ---- Lo que arma el bench ----
+  // 'campos' es el JSON del comando sin las llaves; devuelve el seq
+  uint32_t encolar(const std::string& deviceId, const std::string& campos);
+  uint64_t encoladoUs(const std::string& deviceId, uint32_t seq) const;
+  size_t   pendientes(const std::string& deviceId) const;
+  void     agregarAudio(const std::string& id, const std::string& wavPcm);
+  // Una respuesta en flujo: la frase i está lista en listoUs[i] (absoluto)
+  void     agregarFlujo(const std::string& id, const std::vector<std::string>& frasesPcm,
+                        const std::vector<uint64_t>& listoUs, bool ima);
+  void     sinLongPoll(bool s) { sinLongPoll_ = s; }   // server viejo
+  const std::string& metricas(const std::string& deviceId) const;
+  Stats    stats() const { return stats_; }
+
+  // ---- Lo que ve el ESP32 ----
+  Respuesta atender(const Pedido& p);
+
+  static std::string wavPcm(const int16_t* m, size_t n, uint32_t rate);
+  static std::string wavAIma(const std::string& wav);
+
+private:
+  struct Cola {
+    std::deque<std::string>      cmds;
+    std::map<uint32_t, uint64_t> encolado;   // seq -> us
+    uint32_t                     seq = 0;
+  };
+
+  Respuesta poll(const Pedido& p, const std::string& id);
+  Respuesta audio(const Pedido& p, const std::string& id);
+  Respuesta flujo(const std::string& id);
+
+  struct Flujo {
+    std::string     cuerpo;
+    Entrega::Listos listos;
+  };
+
+  std::map<std::string, Cola>        colas_;
+  std::map<std::string, std::string> audios_;
+  std::map<std::string, Flujo>       flujos_;
+  std::map<std::string, std::string> metricas_;
+  bool     sinLongPoll_ = false;
+  uint64_t libreUs_ = 0;      // cuándo se desocupa el event loop
+  Stats    stats_ = {};
+};
+
+ServidorMock& servidor();
+
+}  // namespace sim
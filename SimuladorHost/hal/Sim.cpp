@@ -0,0 +1,284 @@
+#include "Sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+// ====== Planificador ======
+// Un mutex para todo el simulador: solo lo suelta el que espera su turno,
+// así que nunca hay dos tareas (ni la controladora) corriendo a la vez.
+struct Tarea {
+  std::string nombre;
+  unsigned    prio;
+  FuncionTarea f;
+  void*       arg;
+  std::thread hilo;
+  std::condition_variable cv;
+  bool        turno = false;
+  bool        terminada = false;
+
+  // Bloqueada: lista cuando limite <= reloj o (*cond)() da true
+  const std::function<bool()>* cond = nullptr;
+  uint64_t    limite = 0;
+  uint64_t    ultimoTurno = 0;   // para repartir entre iguales
+  uint32_t    notif = 0;
+};
+
+namespace {
+std::mutex              mtx;
+std::condition_variable cvControl;
+bool                    turnoControl = false;
+uint64_t                reloj = 0;
+uint64_t                turnos = 0;
+std::vector<Tarea*>     tareas;
+thread_local Tarea*     propia = nullptr;
+
+void cuerpo(Tarea* t) {
+  propia = t;
+  {
+    std::unique_lock<std::mutex> l(mtx);
+    t->cv.wait(l, [t] { return t->turno; });
+    t->turno = false;
+  }
+  t->f(t->arg);
+  terminarTarea();
+}
+
+// Con el mutex tomado: le pasa el turno a la controladora y espera el propio
+void soltarTurno(std::unique_lock<std::mutex>& l, Tarea* t) {
+  turnoControl = true;
+  cvControl.notify_one();
+  t->cv.wait(l, [t] { return t->turno; });
+  t->turno = false;
+}
+
+bool lista(const Tarea* t) {
+  return !t->terminada && (t->limite <= reloj || (t->cond && (*t->cond)()));
+}
+
+[[noreturn]] void trabada() {
+  fprintf(stderr, "sim: todas las tareas bloqueadas sin límite en t=%.3f s\n", reloj / 1e6);
+  for (const Tarea* t : tareas) {
+    if (!t->terminada) fprintf(stderr, "  %-12s prio %u\n", t->nombre.c_str(), t->prio);
+  }
+  fin(2);
+}
+
+Tarea* actualOFalla(const char* que) {
+  if (!propia) {
+    fprintf(stderr, "sim: %s fuera de una tarea\n", que);
+    abort();
+  }
+  return propia;
+}
+}  // namespace
+
+uint64_t ahoraUs() { return reloj; }
+
+Tarea* crearTarea(FuncionTarea f, void* arg, const char* nombre, unsigned prio) {
+  Tarea* t = new Tarea();
+  t->nombre = nombre ? nombre : "";
+  t->prio = prio;
+  t->f = f;
+  t->arg = arg;
+  t->limite = 0;   // lista
+  tareas.push_back(t);
+  t->hilo = std::thread(cuerpo, t);
+  t->hilo.detach();
+  return t;
+}
+
+Tarea* tareaActual() { return propia; }
+
+// ====== Heap del firmware ======
+namespace {
+thread_local unsigned enHal_ = 0;
+std::atomic<uint32_t> asignaciones_{ 0 };
+}  // namespace
+
+EnHal::EnHal() { enHal_++; }
+EnHal::~EnHal() { enHal_--; }
+bool enHal() { return enHal_ > 0; }
+void heapFirmware() {
+  if (propia && !enHal_) asignaciones_++;
+}
+uint32_t asignacionesFirmware() { return asignaciones_; }
+unsigned prioridad(const Tarea* t) { return t ? t->prio : 0; }
+const char* nombre(const Tarea* t) { return t ? t->nombre.c_str() : "main"; }
+
+bool esperar(const std::function<bool()>& cond, uint64_t limiteUs) {
+  EnHal hal;
+  Tarea* t = actualOFalla("esperar()");
+  if (cond && cond()) return true;
+  if (limiteUs <= reloj) return false;
+  std::unique_lock<std::mutex> l(mtx);
+  t->cond = cond ? &cond : nullptr;
+  t->limite = limiteUs;
+  soltarTurno(l, t);
+  t->cond = nullptr;
+  return cond && cond();
+}
+
+void dormirHasta(uint64_t us) {
+  static const std::function<bool()> nunca;
+  esperar(nunca, us);
+}
+
+void ceder() {
+  Tarea* t = actualOFalla("taskYIELD()");
+  std::unique_lock<std::mutex> l(mtx);
+  t->cond = nullptr;
+  t->limite = reloj;
+  soltarTurno(l, t);
+}
+
+void terminarTarea() {
+  Tarea* t = actualOFalla("vTaskDelete()");
+  std::unique_lock<std::mutex> l(mtx);
+  t->terminada = true;
+  turnoControl = true;
+  cvControl.notify_one();
+  for (;;) t->cv.wait(l);   // el hilo queda estacionado hasta el _exit
+}
+
+void notificar(Tarea* t) {
+  if (t) t->notif++;
+}
+
+uint32_t tomarNotificacion(bool limpiar, uint64_t limiteUs) {
+  Tarea* t = actualOFalla("ulTaskNotifyTake()");
+  esperar([t] { return t->notif > 0; }, limiteUs);
+  uint32_t v = t->notif;
+  if (v) t->notif = limpiar ? 0 : v - 1;
+  return v;
+}
+
+void correr(FuncionTarea principal, void* arg, unsigned prio) {
+  crearTarea(principal, arg, "loopTask", prio);
+  std::unique_lock<std::mutex> l(mtx);
+  for (;;) {
+    Tarea* elegida = nullptr;
+    for (Tarea* t : tareas) {
+      if (!lista(t)) continue;
+      if (!elegida || t->prio > elegida->prio ||
+          (t->prio == elegida->prio && t->ultimoTurno < elegida->ultimoTurno)) {
+        elegida = t;
+      }
+    }
+    if (!elegida) {
+      // Nadie listo: el reloj salta al próximo despertar
+      uint64_t prox = SIN_LIMITE;
+      for (const Tarea* t : tareas) {
+        if (!t->terminada && t->limite < prox) prox = t->limite;
+      }
+      if (prox == SIN_LIMITE) trabada();
+      reloj = prox;
+      continue;
+    }
+    elegida->ultimoTurno = ++turnos;
+    elegida->turno = true;
+    elegida->cv.notify_one();
+    cvControl.wait(l, [] { return turnoControl; });
+    turnoControl = false;
+  }
+}
+
+void fin(int codigo) {
+  fflush(stdout);
+  fflush(stderr);
+  _exit(codigo);
+}
+
+// ====== Azar ======
+double Azar::normal() {
+  // Box-Muller; se descarta la segunda para no guardar estado
+  double u1 = 1.0 - uniforme(), u2 = uniforme();
+  return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+double Azar::exponencial(double media) { return -media * log(1.0 - uniforme()); }
+
+uint64_t semilla() {
+  static uint64_t s = [] {
+    const char* e = getenv("SIM_SEMILLA");
+    return e ? strtoull(e, nullptr, 0) : 1ull;
+  }();
+  return s;
+}
+
+Azar& azar() {
+  static Azar a(semilla());
+  return a;
+}
+
+// ====== Pines y ADC ======
+namespace {
+struct Pin {
+  int  nivel = 1;             // pull-up: sin nada conectado se lee HIGH
+  void (*isr)() = nullptr;
+  int  modo = 0;
+};
+Pin pines[64];
+std::map<uint8_t, std::function<uint16_t(uint64_t)>> adcs;
+}  // namespace
+
+int leerPin(uint8_t pin) { return pin < 64 ? pines[pin].nivel : 0; }
+
+void fijarPin(uint8_t pin, int nivel) {
+  if (pin >= 64) return;
+  Pin& p = pines[pin];
+  int antes = p.nivel;
+  p.nivel = nivel ? 1 : 0;
+  if (!p.isr || antes == p.nivel) return;
+  // Modos como en Arduino-ESP32: RISING 1, FALLING 2, CHANGE 3
+  bool sube = p.nivel;
+  if (p.modo == 3 || (p.modo == 1 && sube) || (p.modo == 2 && !sube)) p.isr();
+}
+
+void adjuntarIsr(uint8_t pin, void (*isr)(), int modo) {
+  if (pin >= 64) return;
+  pines[pin].isr = isr;
+  pines[pin].modo = modo;
+}
+
+void conectarAdc(uint8_t pin, std::function<uint16_t(uint64_t)> senal) { adcs[pin] = senal; }
+
+uint16_t leerAdc(uint8_t pin) {
+  auto it = adcs.find(pin);
+  return it == adcs.end() ? 0 : it->second(reloj);
+}
+
+// ====== Servo ======
+void Servo::pedir(float grados, uint64_t us) {
+  desde_ = posicion(us);
+  dst_ = grados;
+  t0_ = us;
+}
+
+float Servo::posicion(uint64_t us) const {
+  float d = dst_ - desde_;
+  float hecho = vel_ * (float)(us - t0_) / 1e6f;
+  if (hecho >= fabsf(d)) return dst_;
+  return desde_ + (d > 0 ? hecho : -hecho);
+}
+
+uint64_t Servo::llega() const {
+  return t0_ + (uint64_t)(fabsf(dst_ - desde_) / vel_ * 1e6f);
+}
+
+Servo& servo(uint8_t canal) {
+  static Servo servos[16];
+  return servos[canal & 15];
+}
+
+}  // namespace sim
@@ -0,0 +1,130 @@
+/****************************************************
+ * Simulador en host: reloj virtual y planificador
+ * - Cada tarea de FreeRTOS es un hilo de la PC, pero
+ *   corre una sola a la vez (como un core): la que
+ *   tiene el turno sigue hasta que se bloquea
+ * - El reloj NO es el de la PC: avanza solo cuando
+ *   todas las tareas están bloqueadas, hasta el próximo
+ *   despertar. 1 tick = 1 ms (configTICK_RATE_HZ 1000)
+ * - La CPU es gratis: el tiempo lo ponen las esperas
+ *   (vTaskDelay, red, colas) y lo que cobran los fakes
+ *   con ocupar() (bytes SPI, salida de audio)
+ * - Entre las listas, elige la de más prioridad y, a
+ *   igual prioridad, la que hace más que no corre
+ * - Mismo binario + misma semilla = mismos números
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+namespace sim {
+
+// ====== Reloj virtual ======
+uint64_t ahoraUs();
+inline uint32_t ahoraMs() { return (uint32_t)(ahoraUs() / 1000); }
+
+// ====== Tareas ======
+struct Tarea;
+typedef void (*FuncionTarea)(void*);
+
+// Crea la tarea lista para correr (arranca cuando le toque el turno)
+Tarea* crearTarea(FuncionTarea f, void* arg, const char* nombre, unsigned prio);
+Tarea* tareaActual();                 // nullptr fuera de una tarea
+unsigned prioridad(const Tarea* t);
+const char* nombre(const Tarea* t);
+
+// Bloquea la tarea actual hasta que cond() dé true o el reloj llegue a
+// 'limiteUs' (SIN_LIMITE = nunca). Si cond() ya es true vuelve enseguida,
+// sin ceder. Devuelve cond() (o false sin cond).
+static const uint64_t SIN_LIMITE = UINT64_MAX;
+bool esperar(const std::function<bool()>& cond, uint64_t limiteUs);
+void dormirHasta(uint64_t us);
+inline void ocupar(uint32_t us) { dormirHasta(ahoraUs() + us); }   // la tarea no suelta nada
+void ceder();                          // taskYIELD(): pasa el turno sin dormir
+[[noreturn]] void terminarTarea();     // vTaskDelete(nullptr)
+
+// Notificación directa a tarea (xTaskNotifyGive / ulTaskNotifyTake)
+void notificar(Tarea* t);
+uint32_t tomarNotificacion(bool limpiar, uint64_t limiteUs);
+
+// Corre 'principal' como primera tarea (hace de setup() + loop()) hasta
+// que alguna llame a fin(). No vuelve.
+[[noreturn]] void correr(FuncionTarea principal, void* arg = nullptr, unsigned prio = 1);
+// Termina todo el proceso: las tareas bloqueadas para siempre no se esperan
+[[noreturn]] void fin(int codigo = 0);
+
+// ====== Azar reproducible ======
+// xorshift64* con distribuciones hechas a mano: no depende de la libc
+// (rand(), std::normal_distribution cambian entre plataformas)
+class Azar {
+public:
+  explicit Azar(uint64_t semilla = 1) { sembrar(semilla); }
+  void     sembrar(uint64_t semilla) { s_ = semilla ? semilla : 0x9E3779B97F4A7C15ull; }
+  uint64_t u64() {
+    s_ ^= s_ >> 12;
+    s_ ^= s_ << 25;
+    s_ ^= s_ >> 27;
+    return s_ * 0x2545F4914F6CDD1Dull;
+  }
+  uint32_t u32() { return (uint32_t)(u64() >> 32); }
+  double   uniforme() { return (u64() >> 11) * (1.0 / 9007199254740992.0); }   // [0, 1)
+  bool     prob(double p) { return uniforme() < p; }
+  double   normal();                       // media 0, desvío 1
+  double   exponencial(double media);
+
+private:
+  uint64_t s_;
+};
+
+Azar& azar();                          // la del simulador (semilla de SIM_SEMILLA o 1)
+uint64_t semilla();
+
+// ====== Pines y ADC ======
+// Nivel de los pines (digitalRead/digitalWrite) e interrupción por flanco
+int  leerPin(uint8_t pin);
+void fijarPin(uint8_t pin, int nivel);   // desde el "hardware": dispara la ISR si corresponde
+void adjuntarIsr(uint8_t pin, void (*isr)(), int modo);
+
+// Lo que ve analogRead(pin): una función del tiempo (us) que da cuentas crudas
+void conectarAdc(uint8_t pin, std::function<uint16_t(uint64_t)> senal);
+uint16_t leerAdc(uint8_t pin);
+
+// ====== Servo (PWM) ======
+// Modelo de un SG90: va hacia el ángulo pedido a velocidad fija (sin
+// sobrepaso). La posición depende solo del tiempo desde cada orden.
+class Servo {
+public:
+  explicit Servo(float gradosPorSegundo = 600.0f) : vel_(gradosPorSegundo) {}
+  void  pedir(float grados, uint64_t us);       // nuevo destino (pulso cambiado)
+  float posicion(uint64_t us) const;
+  uint64_t llega() const;                       // cuándo alcanza el destino actual
+  float destino() const { return dst_; }
+
+private:
+  float    vel_;
+  float    desde_ = 0, dst_ = 0;
+  uint64_t t0_ = 0;
+};
+
+// Un servo por canal de PWM (ledcWrite en ESP32, OCR1A en el AVR)
+Servo& servo(uint8_t canal);
+
+// ====== Heap del firmware ======
+// Para probar "sin heap en régimen": el simulador usa std::string y
+// vectores por todos lados (red, server, planificador), así que esas
+// partes se marcan con EnHal y lo que piden no cuenta. Lo demás es del
+// sketch. Un String con contenido cuenta siempre: en la PC no pide heap
+// si es corto, en la placa sí.
+// String llama a heapFirmware() solo; lo demás (operator new, malloc)
+// solo si la prueba los reemplaza (pruebas/prueba_heap_poll.cpp).
+struct EnHal {
+  EnHal();
+  ~EnHal();
+};
+bool enHal();
+void heapFirmware();               // una asignación del sketch (si no está en la HAL)
+uint32_t asignacionesFirmware();
+
+}  // namespace sim
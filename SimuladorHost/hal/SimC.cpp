@@ -0,0 +1,22 @@
+#include "SimC.h"
+#include "Sim.h"
+
+extern "C" {
+
+uint64_t sim_ahora_us(void) { return sim::ahoraUs(); }
+void     sim_dormir_hasta(uint64_t us) { sim::dormirHasta(us); }
+void     sim_correr(void (*principal)(void*), void* arg) { sim::correr(principal, arg); }
+void     sim_fin(int codigo) { sim::fin(codigo); }
+
+double   sim_azar_uniforme(void) { return sim::azar().uniforme(); }
+double   sim_azar_normal(void) { return sim::azar().normal(); }
+uint64_t sim_semilla(void) { return sim::semilla(); }
+
+void sim_adc_conectar(uint8_t pin, uint16_t (*senal)(uint64_t)) { sim::conectarAdc(pin, senal); }
+uint16_t sim_adc_leer(uint8_t pin) { return sim::leerAdc(pin); }
+
+void     sim_servo_pedir(uint8_t canal, float grados, uint64_t us) { sim::servo(canal).pedir(grados, us); }
+float    sim_servo_posicion(uint8_t canal, uint64_t us) { return sim::servo(canal).posicion(us); }
+uint64_t sim_servo_llega(uint8_t canal) { return sim::servo(canal).llega(); }
+
+}
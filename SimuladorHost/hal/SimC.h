@@ -0,0 +1,34 @@
+/*
+ * Lo del simulador (Sim.h) que hace falta desde C: Lab2Colores es C
+ * puro (clasificador.h no compila como C++), así que su bench usa esto
+ */
+#ifndef SIM_C_H
+#define SIM_C_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t sim_ahora_us(void);
+void     sim_dormir_hasta(uint64_t us);
+void     sim_correr(void (*principal)(void *), void *arg);   /* no vuelve */
+void     sim_fin(int codigo);                                /* no vuelve */
+
+double   sim_azar_uniforme(void);
+double   sim_azar_normal(void);
+uint64_t sim_semilla(void);
+
+void     sim_adc_conectar(uint8_t pin, uint16_t (*senal)(uint64_t us));
+uint16_t sim_adc_leer(uint8_t pin);
+
+void     sim_servo_pedir(uint8_t canal, float grados, uint64_t us);
+float    sim_servo_posicion(uint8_t canal, uint64_t us);
+uint64_t sim_servo_llega(uint8_t canal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
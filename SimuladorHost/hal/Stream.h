@@ -0,0 +1,3 @@
+// ArduinoJson incluye <Stream.h> cuando ARDUINO está definido
+#pragma once
+#include "Arduino.h"
@@ -0,0 +1,3 @@
+// ArduinoJson incluye <WString.h> cuando ARDUINO está definido
+#pragma once
+#include "Arduino.h"
@@ -0,0 +1,100 @@
+/****************************************************
+ * WiFi de Arduino-ESP32 para el simulador en host
+ * - WiFi: siempre conectado (salvo cortar()), RSSI
+ *   del perfil de red (Red.h)
+ * - WiFiClient: el socket de una respuesta HTTP; lee
+ *   de la Entrega del HTTPClient, o sea que los bytes
+ *   aparecen cuando llegan en tiempo virtual
+ ****************************************************/
+#pragma once
+
+#include "Arduino.h"
+#include "Red.h"
+
+typedef enum {
+  WL_IDLE_STATUS    = 0,
+  WL_NO_SSID_AVAIL  = 1,
+  WL_CONNECTED      = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED   = 6,
+} wl_status_t;
+
+#define WIFI_STA 1
+#define WIFI_PS_NONE 0
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : ip_{ a, b, c, d } {}
+  String toString() const {
+    char s[16];
+    snprintf(s, sizeof(s), "%u.%u.%u.%u", ip_[0], ip_[1], ip_[2], ip_[3]);
+    return String(s);
+  }
+
+private:
+  uint8_t ip_[4];
+};
+
+class WiFiClass {
+public:
+  wl_status_t begin(const char*, const char* = nullptr) { return status(); }
+  wl_status_t status() const { return cortado_ ? WL_DISCONNECTED : WL_CONNECTED; }
+  bool   isConnected() const { return status() == WL_CONNECTED; }
+  bool   mode(int) { return true; }
+  bool   setSleep(bool) { return true; }
+  bool   setAutoReconnect(bool) { return true; }
+  bool   reconnect() { return true; }
+  bool   disconnect(bool = false) { return true; }
+  int8_t RSSI() const { return sim::perfil().rssi; }
+  IPAddress localIP() const { return IPAddress(192, 168, 1, 50); }
+  String macAddress() const { return String("24:0A:C4:00:00:01"); }
+
+  // Lo usa el bench: simula que se cae (o vuelve) la asociación
+  void cortar(bool c) { cortado_ = c; }
+
+private:
+  bool cortado_ = false;
+};
+extern WiFiClass WiFi;
+
+class WiFiClient : public Stream {
+public:
+  // Lo llama HTTPClient: el cuerpo de la respuesta en curso (nullptr: cerrado)
+  void enlazar(sim::Entrega* e) { e_ = e; pos_ = 0; }
+  size_t leidos() const { return pos_; }
+
+  int available() override {
+    if (!e_) return 0;
+    return (int)(e_->llegados(sim::ahoraUs()) - pos_);
+  }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  int read(uint8_t* p, size_t n) {
+    size_t hay = (size_t)available();
+    if (n > hay) n = hay;
+    if (!n) return 0;
+    memcpy(p, e_->datos() + pos_, n);
+    pos_ += n;
+    e_->consumir(pos_, sim::ahoraUs());
+    return (int)n;
+  }
+  int peek() override { return available() > 0 ? (uint8_t)e_->datos()[pos_] : -1; }
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+  // Sin largo, el server cierra después del último byte
+  uint8_t connected() { return e_ && !(e_->cierra() && e_->llegados(sim::ahoraUs()) == e_->total()); }
+  void stop() { e_ = nullptr; }
+
+protected:
+  // Duerme hasta el próximo segmento (o el límite)
+  void esperarDatos(uint64_t limiteUs) override {
+    uint64_t t = e_ ? e_->proxima() : sim::SIN_LIMITE;
+    sim::dormirHasta(t < limiteUs ? t : limiteUs);
+  }
+
+private:
+  sim::Entrega* e_ = nullptr;
+  size_t        pos_ = 0;
+};
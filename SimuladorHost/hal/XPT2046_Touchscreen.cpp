@@ -0,0 +1,39 @@
+#include "XPT2046_Touchscreen.h"
+
+std::vector<ToqueSim> XPT2046_Touchscreen::toques_;
+uint8_t               XPT2046_Touchscreen::pin_ = 255;
+const ToqueSim*       XPT2046_Touchscreen::actual_ = nullptr;
+uint32_t              XPT2046_Touchscreen::lecturas_ = 0;
+
+TS_Point XPT2046_Touchscreen::getPoint() {
+  sim::ocupar(LECTURA_US);
+  lecturas_++;
+  if (!actual_) return TS_Point(0, 0, 0);
+  // La rotación de la librería: 0 = crudo
+  int16_t x = actual_->x, y = actual_->y;
+  switch (rotacion_) {
+    case 1: return TS_Point(4095 - y, x, actual_->z);
+    case 2: return TS_Point(4095 - x, 4095 - y, actual_->z);
+    case 3: return TS_Point(y, 4095 - x, actual_->z);
+    default: return TS_Point(x, y, actual_->z);
+  }
+}
+
+void XPT2046_Touchscreen::guion(uint8_t pinIrq, const std::vector<ToqueSim>& toques) {
+  toques_ = toques;
+  pin_ = pinIrq;
+  sim::fijarPin(pin_, HIGH);
+  sim::crearTarea(hardware, nullptr, "xpt2046_hw", configMAX_PRIORITIES - 1);
+}
+
+void XPT2046_Touchscreen::hardware(void*) {
+  for (const ToqueSim& t : toques_) {
+    sim::dormirHasta(t.inicioUs);
+    actual_ = &t;
+    sim::fijarPin(pin_, LOW);     // PENIRQ: flanco de bajada
+    sim::dormirHasta(t.inicioUs + (uint64_t)t.duracionMs * 1000);
+    actual_ = nullptr;
+    sim::fijarPin(pin_, HIGH);
+  }
+  sim::terminarTarea();
+}
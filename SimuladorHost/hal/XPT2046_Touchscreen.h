@@ -0,0 +1,57 @@
+/****************************************************
+ * XPT2046 (PaulStoffregen) para el simulador
+ * - Los toques los arma el bench con guion(): una
+ *   tarea de "hardware" baja PENIRQ (dispara la ISR
+ *   adjuntada a ese pin), deja el dedo apoyado y lo
+ *   levanta
+ * - getPoint() devuelve el crudo del toque en curso
+ *   (z = 0 sin dedo) y cobra la lectura SPI a 2 MHz
+ ****************************************************/
+#pragma once
+
+#include <vector>
+#include "Arduino.h"
+#include "SPI.h"
+
+class TS_Point {
+public:
+  TS_Point(int16_t x = 0, int16_t y = 0, int16_t z = 0) : x(x), y(y), z(z) {}
+  int16_t x, y, z;
+};
+
+struct ToqueSim {
+  uint64_t inicioUs;
+  uint32_t duracionMs;
+  int16_t  x, y;      // crudo (200..3800 aprox.)
+  int16_t  z;         // presión
+};
+
+class XPT2046_Touchscreen {
+public:
+  static const uint32_t LECTURA_US = 120;   // ~30 bytes a 2 MHz
+
+  XPT2046_Touchscreen(uint8_t cs, uint8_t irq = 255) : cs_(cs), irq_(irq) {}
+  bool begin(SPIClass& = SPI) { return true; }
+  void setRotation(uint8_t r) { rotacion_ = r & 3; }
+
+  TS_Point getPoint();
+  bool touched() { return getPoint().z >= 300; }
+  bool tirqTouched() { return actual_ != nullptr; }
+  bool bufferEmpty() { return true; }
+
+  // Toques ordenados por inicio; la tarea de hardware tiene la
+  // prioridad más alta (hace de la señal eléctrica)
+  static void guion(uint8_t pinIrq, const std::vector<ToqueSim>& toques);
+  static uint32_t lecturas() { return lecturas_; }
+
+private:
+  static void hardware(void*);
+
+  uint8_t cs_, irq_;
+  uint8_t rotacion_ = 0;
+
+  static std::vector<ToqueSim> toques_;
+  static uint8_t               pin_;
+  static const ToqueSim*       actual_;
+  static uint32_t              lecturas_;
+};
@@ -0,0 +1,12 @@
+/* <avr/eeprom.h> para la PC: EEMEM es RAM común */
+#ifndef SIM_AVR_EEPROM_H
+#define SIM_AVR_EEPROM_H
+
+#include <stddef.h>
+#include <string.h>
+
+#define EEMEM
+static inline void eeprom_read_block(void *dst, const void *src, size_t n){ memcpy(dst, src, n); }
+static inline void eeprom_update_block(const void *src, void *dst, size_t n){ memcpy(dst, src, n); }
+
+#endif
@@ -0,0 +1,10 @@
+/* <avr/interrupt.h> para la PC: cada ISR es una función que el bench
+ * puede llamar; cli()/sei() no hacen nada (no hay interrupciones) */
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+#define ISR(vector) void vector(void)
+static inline void cli(void) {}
+static inline void sei(void) {}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * <avr/io.h> del ATmega328P para compilar Lab2Colores/main.c en la PC
+ * - Los registros que usa main.c son variables: escribirlos no hace
+ *   nada, leerlos da lo último escrito (el bench no corre main(); usa
+ *   proceso_paso() de clasificador.h, que es lo mismo muestra a muestra)
+ * - Los bits con los números de la hoja de datos
+ * - FDEV_SETUP_STREAM: en avr-libc está en <stdio.h>; acá el FILE es el
+ *   de la libc de la PC y queda sin usar
+ */
+#ifndef SIM_AVR_IO_H
+#define SIM_AVR_IO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* UART0 */
+extern volatile uint8_t UCSR0A, UCSR0B, UCSR0C, UBRR0H, UBRR0L, UDR0;
+#define RXC0   7
+#define UDRE0  5
+#define RXCIE0 7
+#define UDRIE0 5
+#define RXEN0  4
+#define TXEN0  3
+#define UCSZ01 2
+#define UCSZ00 1
+
+/* ADC */
+extern volatile uint8_t  ADMUX, ADCSRA, ADCSRB, DIDR0;
+extern volatile uint16_t ADC;
+#define REFS0 6
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define ADTS1 1
+#define ADTS0 0
+
+/* Timer0 */
+extern volatile uint8_t TCCR0A, TCCR0B, OCR0A, TCNT0, TIFR0;
+#define WGM01 1
+#define CS01  1
+#define CS00  0
+#define OCF0A 1
+
+/* Timer1 */
+extern volatile uint8_t  TCCR1A, TCCR1B;
+extern volatile uint16_t ICR1, OCR1A, TCNT1;
+#define COM1A1 7
+#define WGM11  1
+#define WGM13  4
+#define WGM12  3
+#define CS11   1
+
+/* Puerto B */
+extern volatile uint8_t DDRB, PORTB, PINB;
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+
+/* SPI */
+extern volatile uint8_t SPCR, SPSR, SPDR;
+#define SPE   6
+#define MSTR  4
+#define SPIF  7
+#define SPI2X 0
+
+/* avr-libc <stdio.h> */
+#define _FDEV_SETUP_WRITE 2
+#define FDEV_SETUP_STREAM(put, get, rwflag) { 0 }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,7 @@
+// driver/dac.h del IDF para el simulador
+#pragma once
+
+typedef enum { DAC_CHANNEL_1 = 0, DAC_CHANNEL_2 = 1 } dac_channel_t;
+
+static inline int dac_output_enable(dac_channel_t) { return 0; }
+static inline int dac_output_disable(dac_channel_t) { return 0; }
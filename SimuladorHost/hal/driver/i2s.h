@@ -0,0 +1,12 @@
+// driver/i2s.h del IDF para el simulador: el modo DAC no cambia nada
+// (la salida es AudioOutputI2SNoDAC.h)
+#pragma once
+
+typedef enum {
+  I2S_DAC_CHANNEL_DISABLE  = 0,
+  I2S_DAC_CHANNEL_RIGHT_EN = 1,
+  I2S_DAC_CHANNEL_LEFT_EN  = 2,
+  I2S_DAC_CHANNEL_BOTH_EN  = 3,
+} i2s_dac_mode_t;
+
+static inline int i2s_set_dac_mode(i2s_dac_mode_t) { return 0; }
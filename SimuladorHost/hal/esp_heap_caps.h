@@ -0,0 +1,15 @@
+// heap_caps del IDF para el simulador: un ESP32 sin PSRAM
+#pragma once
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT    (1 << 2)
+#define MALLOC_CAP_SPIRAM  (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline void* heap_caps_malloc(size_t n, uint32_t caps) {
+  return caps & MALLOC_CAP_SPIRAM ? nullptr : malloc(n);
+}
+inline void heap_caps_free(void* p) { free(p); }
@@ -0,0 +1,176 @@
+/****************************************************
+ * FreeRTOS (lo que usa el firmware) sobre Sim.h
+ * - Tareas, delays, notificaciones, colas y mutex con
+ *   la misma semántica de ticks que el ESP32 (1 ms)
+ * - Los timeouts se alinean al tick como en FreeRTOS:
+ *   vTaskDelay(1) despierta en el próximo ms entero
+ * - Sin afinidad de core (todas las tareas comparten
+ *   el único "core") ni herencia de prioridad
+ * - Las secciones críticas no hacen nada: nunca corren
+ *   dos tareas a la vez
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "../Sim.h"
+
+typedef uint32_t    TickType_t;
+typedef int         BaseType_t;
+typedef unsigned    UBaseType_t;
+typedef sim::Tarea* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE          1
+#define pdFALSE         0
+#define pdPASS          1
+#define pdFAIL          0
+#define errQUEUE_FULL   0
+#define errQUEUE_EMPTY  0
+#define portMAX_DELAY   ((TickType_t)0xFFFFFFFF)
+#define configMAX_PRIORITIES 25
+#define configTICK_RATE_HZ   1000
+#define portTICK_PERIOD_MS   1
+#define tskNO_AFFINITY       0x7FFFFFFF
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+
+struct portMUX_TYPE { int libre; };
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portENTER_CRITICAL(m)      ((void)(m))
+#define portEXIT_CRITICAL(m)       ((void)(m))
+#define portENTER_CRITICAL_ISR(m)  ((void)(m))
+#define portEXIT_CRITICAL_ISR(m)   ((void)(m))
+#define portYIELD_FROM_ISR(...)    ((void)0)
+
+namespace sim {
+// Límite en us para un timeout en ticks contado desde el tick actual
+inline uint64_t limiteTicks(TickType_t ticks) {
+  if (ticks == portMAX_DELAY) return SIN_LIMITE;
+  if (ticks == 0) return ahoraUs();
+  return (ahoraUs() / 1000 + ticks) * 1000;
+}
+}  // namespace sim
+
+// ====== Tareas ======
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t f, const char* nombre, uint32_t, void* arg,
+                                          UBaseType_t prio, TaskHandle_t* h, BaseType_t) {
+  TaskHandle_t t = sim::crearTarea(f, arg, nombre, prio);
+  if (h) *h = t;
+  return pdPASS;
+}
+inline BaseType_t xTaskCreate(TaskFunction_t f, const char* nombre, uint32_t pila, void* arg,
+                              UBaseType_t prio, TaskHandle_t* h) {
+  return xTaskCreatePinnedToCore(f, nombre, pila, arg, prio, h, tskNO_AFFINITY);
+}
+inline void vTaskDelete(TaskHandle_t t) {
+  if (!t || t == sim::tareaActual()) sim::terminarTarea();
+}
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return sim::tareaActual(); }
+inline TickType_t   xTaskGetTickCount() { return (TickType_t)(sim::ahoraUs() / 1000); }
+inline UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t) { return 1024; }
+
+inline void vTaskDelay(TickType_t ticks) {
+  if (!ticks) sim::ceder();
+  else sim::dormirHasta(sim::limiteTicks(ticks));
+}
+inline void vTaskDelayUntil(TickType_t* previo, TickType_t incremento) {
+  TickType_t despertar = *previo + incremento;
+  *previo = despertar;
+  int32_t falta = (int32_t)(despertar - xTaskGetTickCount());
+  if (falta > 0) sim::dormirHasta((uint64_t)despertar * 1000);
+}
+#define taskYIELD() sim::ceder()
+
+// ====== Notificaciones ======
+inline uint32_t ulTaskNotifyTake(BaseType_t limpiar, TickType_t espera) {
+  return sim::tomarNotificacion(limpiar, sim::limiteTicks(espera));
+}
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t) {
+  sim::notificar(t);
+  return pdPASS;
+}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t* despertada) {
+  sim::notificar(t);
+  if (despertada && sim::prioridad(t) > sim::prioridad(sim::tareaActual())) *despertada = pdTRUE;
+}
+
+// ====== Colas y semáforos ======
+// Un semáforo es una cola de ítems de 0 bytes, igual que en FreeRTOS
+struct ColaSim {
+  size_t               item;
+  UBaseType_t          cap;
+  UBaseType_t          n = 0;
+  UBaseType_t          cabeza = 0;
+  std::vector<uint8_t> datos;
+
+  ColaSim(UBaseType_t largo, size_t tam) : item(tam), cap(largo), datos(largo * tam) {}
+
+  bool meter(const void* p, bool alFrente = false) {
+    if (n >= cap) return false;
+    UBaseType_t i = alFrente ? (cabeza + cap - 1) % cap : (cabeza + n) % cap;
+    if (alFrente) cabeza = i;
+    if (item && p) memcpy(&datos[i * item], p, item);
+    n++;
+    return true;
+  }
+  bool sacar(void* p, bool mirar = false) {
+    if (!n) return false;
+    if (item && p) memcpy(p, &datos[cabeza * item], item);
+    if (!mirar) {
+      cabeza = (cabeza + 1) % cap;
+      n--;
+    }
+    return true;
+  }
+};
+typedef ColaSim* QueueHandle_t;
+typedef ColaSim* SemaphoreHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t largo, size_t tam) { return new ColaSim(largo, tam); }
+inline void vQueueDelete(QueueHandle_t q) { delete q; }
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* p, TickType_t espera) {
+  sim::esperar([q] { return q->n < q->cap; }, sim::limiteTicks(espera));
+  return q->meter(p) ? pdTRUE : errQUEUE_FULL;
+}
+inline BaseType_t xQueueSendToBack(QueueHandle_t q, const void* p, TickType_t espera) { return xQueueSend(q, p, espera); }
+inline BaseType_t xQueueSendToFront(QueueHandle_t q, const void* p, TickType_t espera) {
+  sim::esperar([q] { return q->n < q->cap; }, sim::limiteTicks(espera));
+  return q->meter(p, true) ? pdTRUE : errQUEUE_FULL;
+}
+inline BaseType_t xQueueSendFromISR(QueueHandle_t q, const void* p, BaseType_t*) {
+  return q->meter(p) ? pdTRUE : errQUEUE_FULL;
+}
+inline BaseType_t xQueueOverwrite(QueueHandle_t q, const void* p) {
+  q->n = 0;
+  return q->meter(p) ? pdTRUE : pdFAIL;
+}
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* p, TickType_t espera) {
+  sim::esperar([q] { return q->n > 0; }, sim::limiteTicks(espera));
+  return q->sacar(p) ? pdTRUE : pdFALSE;
+}
+inline BaseType_t xQueuePeek(QueueHandle_t q, void* p, TickType_t espera) {
+  sim::esperar([q] { return q->n > 0; }, sim::limiteTicks(espera));
+  return q->sacar(p, true) ? pdTRUE : pdFALSE;
+}
+inline BaseType_t  xQueueReset(QueueHandle_t q) { q->n = 0; return pdPASS; }
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) { return q->n; }
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) { return q->cap - q->n; }
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  SemaphoreHandle_t s = new ColaSim(1, 0);
+  s->n = 1;
+  return s;
+}
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new ColaSim(1, 0); }
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t inicial) {
+  SemaphoreHandle_t s = new ColaSim(max, 0);
+  s->n = inicial;
+  return s;
+}
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t espera) { return xQueueReceive(s, nullptr, espera); }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return s->meter(nullptr) ? pdTRUE : pdFALSE; }
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t*) { return xSemaphoreGive(s); }
+inline UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t s) { return s->n; }
@@ -0,0 +1,8 @@
+/* <util/delay.h> para la PC: las esperas de arranque no cuentan */
+#ifndef SIM_UTIL_DELAY_H
+#define SIM_UTIL_DELAY_H
+
+static inline void _delay_ms(double ms) { (void)ms; }
+static inline void _delay_us(double us) { (void)us; }
+
+#endif
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+Archivos de prueba de ImaAdpcm.h (prueba_ima.cpp), hechos con el encoder
+del server: wav_a_ima() se saca tal cual de RobotNao.ipynb, no es una copia.
+
+- voz.wav      PCM 16 bit mono, 16 kHz: la referencia
+- voz.ima.wav  wav_a_ima(voz.wav), lo que baja el ESP32 con ?fmt=ima
+- voz.dec.wav  lo que tiene que dar el decoder, muestra por muestra: el
+               encoder va reconstruyendo igual que el decoder, así que es
+               exacto, no aproximado
+
+La señal es sintética (tono con vibrato, ruido, un golpe y silencio) y el
+largo deja el último bloque corto y con un nibble de relleno, para que la
+cuenta del chunk fact sea la que corta.
+
+Uso:
+    python3 audio_ima.py
+"""
+import io
+import json
+import math
+import os
+import random
+import struct
+import wave
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+NOTEBOOK = os.path.join(AQUI, "..", "..", "..", "RobotNao.ipynb")
+RATE = 16000
+
+
+def encoder_del_notebook():
+    """Ejecuta del notebook sólo las tablas IMA, _ima_bloque y wav_a_ima"""
+    nb = json.load(open(NOTEBOOK, encoding="utf-8"))
+    for celda in nb["cells"]:
+        s = "".join(celda["source"])
+        if "def wav_a_ima" in s:
+            ini = s.index("IMA_STEP = [")
+            fin = s.index("\n# =", s.index("def wav_a_ima"))
+            g = {"io": io, "struct": struct, "wave": wave}
+            exec(s[ini:fin], g)
+            return g
+    raise SystemExit("wav_a_ima no está en el notebook")
+
+
+def senal(azar, n):
+    out = []
+    for i in range(n):
+        t = i / RATE
+        if t < 0.08:
+            v = 9000 * math.sin(2 * math.pi * (220 + 30 * math.sin(2 * math.pi * 5 * t)) * t)
+            v += 3000 * math.sin(2 * math.pi * 1320 * t)
+        elif t < 0.11:
+            v = azar.gauss(0, 4000)
+        elif t < 0.115:
+            v = 30000 if (i // 8) % 2 else -30000          # golpe: satura el paso
+        elif t < 0.13:
+            v = 0
+        else:
+            v = 6000 * math.sin(2 * math.pi * 440 * t) * math.exp(-(t - 0.13) * 20)
+        out.append(max(-32768, min(32767, round(v))))
+    return out
+
+
+def wav_pcm(muestras):
+    buf = io.BytesIO()
+    with wave.open(buf, "wb") as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(struct.pack(f"<{len(muestras)}h", *muestras))
+    return buf.getvalue()
+
+
+def reconstruir(g, muestras):
+    """Lo que reconstruye el encoder, bloque por bloque (= decoder exacto)"""
+    out, idx = [], 0
+    for i in range(0, len(muestras), g["IMA_SPB"]):
+        blq = muestras[i:i + g["IMA_SPB"]]
+        pred = blq[0]
+        out.append(pred)
+        for s in blq[1:]:
+            step = g["IMA_STEP"][idx]
+            diff, n = s - pred, 0
+            if diff < 0:
+                n, diff = 8, -diff
+            if diff >= step: n |= 4; diff -= step
+            if diff >= step >> 1: n |= 2; diff -= step >> 1
+            if diff >= step >> 2: n |= 1
+            d = step >> 3
+            if n & 4: d += step
+            if n & 2: d += step >> 1
+            if n & 1: d += step >> 2
+            pred = max(-32768, min(32767, pred - d if n & 8 else pred + d))
+            idx = max(0, min(88, idx + g["IMA_INDEX"][n]))
+            out.append(pred)
+    return out
+
+
+def main():
+    g = encoder_del_notebook()
+    spb = g["IMA_SPB"]
+    n = 4 * spb + 138                  # último bloque: 137 nibbles, uno de relleno
+    pcm = senal(random.Random(5), n)
+    ref = wav_pcm(pcm)
+    archivos = {
+        "voz.wav": ref,
+        "voz.ima.wav": g["wav_a_ima"](ref),
+        "voz.dec.wav": wav_pcm(reconstruir(g, pcm)),
+    }
+    for nombre, datos in archivos.items():
+        with open(os.path.join(AQUI, nombre), "wb") as f:
+            f.write(datos)
+        print(f"{nombre}: {len(datos)} bytes")
+    print(f"{n} muestras, {spb} por bloque")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+/****************************************************
+ * AnimadorCara contra el ILI9341 del simulador (que
+ * cuenta los bytes SPI y cobra el tiempo del bus)
+ * - Orden: tick() a mano cada 33 ms con un reloj propio
+ *   (beginManual). Parpadeo = wipe a B en 3 cuadros y
+ *   wipe a A en 3; hablar = cortes B/A cada 4 cuadros;
+ *   un parpadeo pedido a mitad de un wipe termina el
+ *   anterior en ese cuadro
+ * - Bytes: en cada tick, lo que llegó al TFT es lo que
+ *   sumó AnimadorCara con las stats de CaraDelta; al
+ *   final la pantalla es la cara de reposo
+ * - Contadores: con la tarea de verdad, a 40 MHz no hay
+ *   cuadros perdidos ni excedidos; con el bus a 2 MHz
+ *   (un corte tarda más que un periodo) aparecen los dos
+ ****************************************************/
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>
+#include <vector>
+#include "CaraDelta.h"
+#include "AnimadorCara.h"
+#include "caras.h"
+
+const int16_t SCR_W = 240;
+const int16_t SCR_H = 320;
+
+static const Cuadro CUADROS_PARPADEO[] = {
+  { CARA_B, 60, 100 },
+  { CARA_A, 0, 100 },
+};
+static const Cuadro CUADROS_HABLAR[] = {
+  { CARA_B, 120, 0 },
+  { CARA_A, 120, 0 },
+};
+static const Secuencia PARPADEO = { "parpadeo", CUADROS_PARPADEO, 2, false };
+static const Secuencia HABLAR   = { "hablar",   CUADROS_HABLAR,   2, true };
+
+Adafruit_ILI9341 tft(5, 21, 4);
+CaraDelta        caras(tft, ILI9341_BLACK, ILI9341_WHITE);
+AnimadorCara     anim(caras);      // a mano
+AnimadorCara     animTarea(caras); // con su tarea
+
+int fallas = 0;
+
+void verificar(bool ok, const char* que) {
+  printf("%s: %s\n", ok ? "ok " : "MAL", que);
+  if (!ok) fallas++;
+}
+
+// Píxeles distintos de la cara 'c' (decodificada aparte con LectorRLE)
+uint32_t diferencias(uint8_t c) {
+  LectorRLE lr;
+  lr.begin(&CARAS[c]);
+  uint8_t fila[SCR_W / 8];
+  uint32_t malos = 0;
+  for (int16_t y = 0; y < SCR_H; y++) {
+    lr.bits(y, fila);
+    for (int16_t x = 0; x < SCR_W; x++) {
+      uint16_t esperado = fila[x >> 3] & (0x80 >> (x & 7)) ? ILI9341_BLACK : ILI9341_WHITE;
+      if (tft.leer(x, y) != esperado) malos++;
+    }
+  }
+  return malos;
+}
+
+// Cada vez que cambia la cara de CaraDelta: cuál quedó y en cuántos
+// cuadros que dibujaron se llegó (1 = corte, 3 = wipe de 100 ms)
+struct Cambio {
+  uint8_t cara;
+  uint8_t cuadros;
+};
+
+void orden() {
+  printf("== Orden y bytes por cuadro (tick a mano) ==\n");
+  caras.drawFull(CARA_A);
+  anim.parpadeo(&PARPADEO, 2000, 2000);
+  anim.beginManual(CARA_A);
+  tft.reiniciarCuenta();
+
+  std::vector<Cambio> cambios;
+  uint8_t antes = caras.current(), racha = 0;
+  uint32_t malBytes = 0, ticks = 0;
+  bool hablo = false, pisado = false;
+  for (uint32_t t = 0; t < 2600; t += AnimadorCara::PERIODO_MS) {
+    // Hablar 1 s (aplicado en el tick de 528) y un parpadeo extra en el
+    // medio del wipe a A del segundo parpadeo (tick de 2211)
+    if (!hablo && t >= 500) hablo = anim.hablar(&HABLAR, 1000) != 0;
+    if (!pisado && t >= 2200) pisado = anim.reproducir(&PARPADEO) != 0;
+
+    uint64_t bytes0 = tft.bytesSpi();
+    uint32_t cuenta0 = anim.stats().spiBytes;
+    anim.tick(t);
+    ticks++;
+    uint64_t alTft = tft.bytesSpi() - bytes0;
+    uint32_t contados = anim.stats().spiBytes - cuenta0;
+    if (alTft != contados) {
+      if (malBytes++ < 5) printf("  t=%u: TFT %llu bytes, AnimadorCara %u\n", t, (unsigned long long)alTft, contados);
+    }
+    if (alTft) racha++;
+    if (caras.current() != antes) {
+      cambios.push_back({ caras.current(), racha });
+      antes = caras.current();
+      racha = 0;
+    }
+  }
+
+  // 2211: termina el wipe a A (2 cuadros) y empieza el de B, que
+  // sigue en 2244 y 2277; el último wipe a A arranca en 2376
+  static const Cambio ESPERADO[] = {
+    { CARA_B, 3 }, { CARA_A, 3 },                                      // parpadeo en 0
+    { CARA_B, 1 }, { CARA_A, 1 }, { CARA_B, 1 }, { CARA_A, 1 },        // hablar de 528
+    { CARA_B, 1 }, { CARA_A, 1 }, { CARA_B, 1 }, { CARA_A, 1 },        // a 1528
+    { CARA_B, 3 }, { CARA_A, 2 }, { CARA_B, 2 }, { CARA_A, 3 },        // parpadeo en 2013 + pisado
+  };
+  const size_t N = sizeof(ESPERADO) / sizeof(ESPERADO[0]);
+  bool igual = cambios.size() == N;
+  for (size_t i = 0; i < cambios.size(); i++) {
+    bool ok = i < N && cambios[i].cara == ESPERADO[i].cara && cambios[i].cuadros == ESPERADO[i].cuadros;
+    printf("  %2u: %s en %u cuadro(s)%s\n", (unsigned)i, CARAS[cambios[i].cara].nombre, cambios[i].cuadros,
+           ok ? "" : "  <- distinto");
+    igual = igual && ok;
+  }
+  verificar(igual, "cambios de cara en el orden y con los cuadros esperados");
+  verificar(malBytes == 0, "bytes al TFT por tick == los que cuenta CaraDelta");
+  verificar(anim.stats().spiBytes == tft.bytesSpi(), "spiBytes total == bytes al TFT");
+  verificar(diferencias(CARA_A) == 0, "termina con la cara de reposo en pantalla");
+  AnimadorCara::Stats st = anim.stats();
+  verificar(st.perdidos == 0 && st.excedidos == 0 && st.cuadros == 0, "sin tarea no se cuentan tiempos");
+  printf("  %u ticks, %u dibujaron, %u bytes\n\n", ticks, st.dibujados, st.spiBytes);
+}
+
+// Hablar en loop durante 'ms' y lo que sumaron los contadores
+AnimadorCara::Stats tramo(uint32_t ms) {
+  AnimadorCara::Stats a = animTarea.stats();
+  delay(ms);
+  AnimadorCara::Stats b = animTarea.stats();
+  b.cuadros -= a.cuadros;
+  b.dibujados -= a.dibujados;
+  b.perdidos -= a.perdidos;
+  b.excedidos -= a.excedidos;
+  b.spiBytes -= a.spiBytes;
+  printf("  cuadros %u, dibujados %u, perdidos %u, excedidos %u, máx %u us (presupuesto %u)\n", b.cuadros,
+         b.dibujados, b.perdidos, b.excedidos, b.maxUs, AnimadorCara::PRESUPUESTO_US);
+  return b;
+}
+
+void contadores() {
+  printf("== Contadores con la tarea (hablar en loop) ==\n");
+  animTarea.begin(CARA_A);
+  animTarea.hablar(&HABLAR);
+
+  printf("40 MHz:\n");
+  AnimadorCara::Stats rapido = tramo(2000);
+  verificar(rapido.dibujados > 0 && rapido.perdidos == 0 && rapido.excedidos == 0,
+            "a 40 MHz ningún cuadro perdido ni excedido");
+
+  tft.begin(2000000);
+  printf("2 MHz:\n");
+  AnimadorCara::Stats lento = tramo(2000);
+  verificar(lento.excedidos > 0 && lento.maxUs > AnimadorCara::PRESUPUESTO_US,
+            "a 2 MHz los cortes se pasan del presupuesto");
+  verificar(lento.perdidos > 0, "a 2 MHz hay cuadros perdidos");
+  verificar(lento.excedidos <= lento.dibujados, "solo se exceden los que dibujan");
+  tft.begin();
+}
+
+void principal(void*) {
+  tft.begin();
+  tft.setRotation(0);
+  caras.add(&CARAS[CARA_A]);
+  caras.add(&CARAS[CARA_B]);
+  caras.begin();
+  orden();
+  contadores();
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
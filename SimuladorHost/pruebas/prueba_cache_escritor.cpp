@@ -0,0 +1,89 @@
+/****************************************************
+ * Prueba: ClipCache con dos escritores (la red por
+ * CacheTee y el prewarm) sobre el LittleFS en memoria
+ * - La escritura de la red se pasa del presupuesto con
+ *   largo desconocido y la caché la aborta por dentro;
+ *   el prewarm empieza la suya. Lo que la red sigue
+ *   mandando con su token viejo (write, commit) tiene
+ *   que rebotar y el clip del prewarm queda con sus
+ *   bytes, bajo su clave
+ * - commit() con largo conocido y bytes de menos no
+ *   guarda nada
+ * - Un clip fijado con acquire() no se expulsa
+ ****************************************************/
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "ClipCache.h"
+
+const uint32_t PRESUPUESTO = 8 * 1024;
+
+uint32_t fallas = 0;
+
+void verificar(const char* que, bool ok) {
+  printf("%s: %s\n", que, ok ? "ok" : "FALLA");
+  if (!ok) fallas++;
+}
+
+std::string leer(const char* ruta) {
+  File f = LittleFS.open(ruta, "r");
+  std::string s;
+  if (!f) return s;
+  uint8_t b[256];
+  for (int n; (n = f.read(b, sizeof(b))) > 0;) s.append((char*)b, n);
+  return s;
+}
+
+void principal(void*) {
+  static ClipCache cache;
+  cache.begin(PRESUPUESTO);
+  printf("== ClipCache: un escritor a la vez, con token ==\n");
+
+  uint8_t red[1024], pre[1024];
+  memset(red, 'r', sizeof(red));
+  memset(pre, 'p', sizeof(pre));
+
+  // La red, sin largo: se pasa del presupuesto y la caché la aborta
+  ClipCache::Token tRed = cache.beginWrite("clipred", 0);
+  verificar("beginWrite de la red", tRed != 0);
+  verificar("otro beginWrite mientras escribe la red", !cache.beginWrite("otro", 0));
+  bool rebota = false;
+  for (uint32_t i = 0; i < PRESUPUESTO / sizeof(red) + 1 && !rebota; i++)
+    rebota = !cache.write(tRed, red, sizeof(red));
+  verificar("write de la red pasado el presupuesto rebota", rebota);
+
+  // El prewarm entra, y la red sigue con su token viejo
+  ClipCache::Token tPre = cache.beginWrite("clippre", 2 * sizeof(pre));
+  verificar("beginWrite del prewarm después del aborto", tPre != 0 && tPre != tRed);
+  verificar("write del prewarm", cache.write(tPre, pre, sizeof(pre)));
+  verificar("write de la red con el token viejo rebota", !cache.write(tRed, red, sizeof(red)));
+  verificar("write del prewarm", cache.write(tPre, pre, sizeof(pre)));
+  verificar("commit de la red con el token viejo rebota", !cache.commit(tRed));
+  cache.abort(tRed);   // no hace nada
+  verificar("commit del prewarm", cache.commit(tPre));
+  verificar("clippre tiene sólo bytes del prewarm", leer("/clips/clippre.wav") == std::string(2048, 'p'));
+  verificar("clipred no quedó en la caché", !cache.contains("clipred"));
+
+  // Largo conocido y bytes de menos: no se guarda
+  ClipCache::Token t = cache.beginWrite("corto", 3 * sizeof(pre));
+  cache.write(t, pre, sizeof(pre));
+  verificar("commit con bytes de menos no guarda", !cache.commit(t) && !cache.contains("corto"));
+
+  // Fijado: llenar el resto no lo expulsa
+  char ruta[48];
+  verificar("acquire de clippre", cache.acquire("clippre", ruta, sizeof(ruta)));
+  for (int k = 0; k < 10; k++) {
+    char clave[8];
+    snprintf(clave, sizeof(clave), "c%d", k);
+    ClipCache::Token w = cache.beginWrite(clave, sizeof(red));
+    if (w && cache.write(w, red, sizeof(red))) cache.commit(w);
+  }
+  verificar("clippre fijado sigue después de llenar la caché", cache.contains("clippre"));
+  cache.release("clippre");
+  ClipCache::Stats st = cache.stats();
+  printf("%u clips, %u/%u B, %u expulsados\n", st.entries, st.bytesUsed, st.budget, st.evictions);
+  verificar("se expulsaron otros y no se pasó del presupuesto", st.evictions > 0 && st.bytesUsed <= st.budget);
+  printf("\n");
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,95 @@
+/****************************************************
+ * Prueba: CommandChannel con respuestas de Gemini
+ * - Lotes de 4 comandos "reproducir_conversacion" con
+ *   texto_usuario y texto_robot de hasta 3000 letras,
+ *   como los que arma /control/conversar: el lote
+ *   entero pasa los 4096 de doc_ y cada uno los 512 del
+ *   slot
+ * - El filtro (CMD_CAMPOS) los tiene que dejar pasar a
+ *   todos, en orden, con audio_id, clip_id y seq, y sin
+ *   los textos
+ * - Después, otro canal que sí guarda texto_robot: el
+ *   lote no entra en doc_ (NoMemory) y sus 4 comandos
+ *   tienen que ir a Stats::lost; el comando corto que
+ *   sigue llega por la misma conexión
+ * - Sale con 1 si falta un comando, llega mal, el
+ *   primer canal cuenta descartados, perdidos o errores
+ *   o el segundo no cuenta los perdidos
+ ****************************************************/
+#include <Arduino.h>
+#include "CommandChannel.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+const char*    DEVICE = "robot-largo";
+const uint32_t LOTES  = 6;
+const uint32_t LOTE   = 4;
+
+void principal(void*) {
+  sim::usarPerfil(sim::PERFILES[1]);   // wifi
+  static CommandChannel canal;
+  CommandChannel::Config cfg;
+  cfg.baseUrl  = "http://server:8000";
+  cfg.deviceId = DEVICE;
+  cfg.batchMax = LOTE;
+  if (!canal.begin(cfg)) {
+    printf("No se pudo crear el canal\n");
+    sim::fin(1);
+  }
+
+  uint32_t seqs[LOTES * LOTE];
+  for (uint32_t i = 0; i < LOTES * LOTE; i++) {
+    std::string largo(500 + 500 * (i % LOTES), 'a' + i % 26);
+    char campos[96];
+    snprintf(campos, sizeof(campos), "\"tipo\":\"reproducir_conversacion\",\"audio_id\":\"a%u\",\"clip_id\":\"c%u\"",
+             i, i);
+    seqs[i] = sim::servidor().encolar(DEVICE, std::string(campos) + ",\"texto_usuario\":\"" + largo +
+                                                  "\",\"texto_robot\":\"" + largo + largo + "\"");
+  }
+
+  static StaticJsonDocument<CommandChannel::CMD_JSON_LEN> doc;
+  CommandChannel::Command cmd;
+  uint32_t recibidos = 0, malos = 0, maxLargo = 0;
+  uint32_t t0 = millis();
+  while (recibidos < LOTES * LOTE && millis() - t0 < 30000) {
+    if (!canal.receive(cmd, pdMS_TO_TICKS(100))) continue;
+    uint32_t i = recibidos++;
+    if (strlen(cmd.json) > maxLargo) maxLargo = strlen(cmd.json);
+    char id[16];
+    snprintf(id, sizeof(id), "a%u", i);
+    bool ok = !deserializeJson(doc, cmd.json) && !strcmp(doc["audio_id"] | "", id) &&
+              *(doc["clip_id"] | "") && (doc["seq"] | 0u) == seqs[i] && !doc.containsKey("texto_robot") &&
+              !doc.containsKey("texto_usuario");
+    if (!ok) {
+      printf("comando %u: %s  FALLA\n", i, cmd.json);
+      malos++;
+    }
+  }
+  CommandChannel::Stats st = canal.stats();
+  printf("== CommandChannel: %u lotes de %u con textos de hasta 3000 letras ==\n", LOTES, LOTE);
+  printf("Recibidos %u de %u (el más largo: %u B en el slot), %u pedidos\n", recibidos, LOTES * LOTE,
+         maxLargo, st.requests);
+  printf("Descartados %u, perdidos %u, errores %u\n", st.dropped, st.lost, st.errors);
+  bool ok = recibidos == LOTES * LOTE && !malos && !st.dropped && !st.lost && !st.errors;
+
+  // Guardando texto_robot el lote no entra en doc_
+  static const char* const CON_TEXTO[] = { "tipo", "texto_robot", nullptr };
+  static CommandChannel canal2;
+  cfg.deviceId = "robot-largo-texto";
+  cfg.campos   = CON_TEXTO;
+  canal2.begin(cfg);
+  std::string largo(3000, 'x');
+  for (uint32_t i = 0; i < LOTE; i++)
+    sim::servidor().encolar(cfg.deviceId, "\"tipo\":\"reproducir_conversacion\",\"texto_robot\":\"" + largo + "\"");
+  t0 = millis();
+  while (canal2.stats().lost < LOTE && millis() - t0 < 10000) vTaskDelay(pdMS_TO_TICKS(50));
+  sim::servidor().encolar(cfg.deviceId, "\"tipo\":\"reproducir_conversacion\",\"texto_robot\":\"corto\"");
+  bool corto = canal2.receive(cmd, pdMS_TO_TICKS(10000));
+  st = canal2.stats();
+  printf("Guardando texto_robot: perdidos %u de %u, errores %u, el corto que sigue %s\n\n", st.lost, LOTE,
+         st.errors, corto ? "llega" : "NO llega");
+  if (st.lost != LOTE || st.errors != 1 || !corto) ok = false;
+  sim::fin(ok ? 0 : 1);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,108 @@
+/****************************************************
+ * Prueba: AudioPipeline::lastOk() sólo si el clip
+ * llegó hasta el final
+ * - Un clip PCM de 1 s desde una fuente en memoria que
+ *   entrega de a pedazos, como la red:
+ *   completo, con un chunk LIST después de data (cola
+ *   corta que el decoder no lee), cortado a la mitad
+ *   (la red cierra antes de getSize()) y con la red
+ *   quieta 5 s a la mitad (más que stallTimeoutMs)
+ * - Espera ok en los dos primeros y no en los otros;
+ *   el de la red quieta además con lastStalled() y
+ *   stats().stalls en 1
+ ****************************************************/
+#include <Arduino.h>
+#include <AudioOutputI2SNoDAC.h>
+#include "AudioPipeline.h"
+#include "ImaAdpcm.h"
+#include "ServidorMock.h"
+
+const uint32_t RATE = 16000;
+const uint32_t PEDAZO = 512;
+
+// Entrega 'b' de a PEDAZO; getSize() dice el largo entero. Con 'corte'
+// deja de entregar ahí (fin antes de tiempo) o se queda 'pausaMs' quieta
+class FuenteRed : public AudioFileSource {
+public:
+  FuenteRed(const std::string& b, size_t corte, uint32_t pausaMs) : b_(b), corte_(corte), pausaMs_(pausaMs) {}
+  uint32_t read(void* data, uint32_t len) override {
+    if (pos_ == corte_) {
+      if (!pausaMs_) return 0;
+      vTaskDelay(pdMS_TO_TICKS(pausaMs_));
+      pausaMs_ = 0;
+      corte_ = b_.size();
+    }
+    size_t hasta = pos_ < corte_ ? corte_ : b_.size();
+    uint32_t n = std::min<uint32_t>({ len, PEDAZO, (uint32_t)(hasta - pos_) });
+    memcpy(data, b_.data() + pos_, n);
+    pos_ += n;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    return n;
+  }
+  bool close() override { return true; }
+  bool isOpen() override { return true; }
+  uint32_t getSize() override { return b_.size(); }
+  uint32_t getPos() override { return pos_; }
+
+private:
+  std::string b_;
+  size_t      corte_;
+  uint32_t    pausaMs_;
+  size_t      pos_ = 0;
+};
+
+AudioPipeline        pipeline;
+AudioOutputI2SNoDAC* dac = nullptr;
+AudioOutputKeepOpen* out = nullptr;
+uint32_t             fallas = 0;
+
+void caso(const char* nombre, const std::string& wav, size_t corte, uint32_t pausaMs, bool esperaOk,
+          bool esperaStall) {
+  FuenteRed src(wav, corte, pausaMs);
+  AudioGeneratorIMA gen;
+  if (!pipeline.play(&src, &gen, out)) {
+    printf("%-16s no arranca  FALLA\n", nombre);
+    fallas++;
+    return;
+  }
+  while (pipeline.isBusy()) vTaskDelay(pdMS_TO_TICKS(20));
+  out->close();
+  AudioPipelineStats st = pipeline.stats();
+  bool ok = pipeline.lastOk() == esperaOk && pipeline.lastStalled() == esperaStall &&
+            st.stalls == (esperaStall ? 1u : 0u);
+  printf("%-16s lastOk %-5s lastStalled %-5s stalls %u, %6u bytes al decoder%s\n", nombre,
+         pipeline.lastOk() ? "true" : "false", pipeline.lastStalled() ? "true" : "false", st.stalls,
+         st.bytesOut, ok ? "" : "  FALLA");
+  if (!ok) fallas++;
+}
+
+void principal(void*) {
+  std::vector<int16_t> m(RATE);
+  for (size_t i = 0; i < m.size(); i++) m[i] = (int16_t)(8000 * sin(2 * PI * 440 * i / RATE));
+  std::string wav = sim::ServidorMock::wavPcm(m.data(), m.size(), RATE);
+
+  // Chunk LIST de 200 bytes después de data (RIFF crece igual)
+  std::string conCola = wav + "LIST" + std::string("\xc8\0\0\0", 4) + std::string(200, 'i');
+  uint32_t riff = conCola.size() - 8;
+  memcpy(&conCola[4], &riff, 4);
+
+  AudioPipeline::Config cfg;
+  cfg.ringBytes      = 16 * 1024;
+  cfg.prebufferBytes = 4 * 1024;
+  if (!pipeline.begin(cfg)) {
+    printf("No se pudo crear el pipeline\n");
+    sim::fin(1);
+  }
+  dac = new AudioOutputI2SNoDAC();
+  out = new AudioOutputKeepOpen(dac);
+
+  printf("== AudioPipeline: lastOk() con clips completos y cortados ==\n");
+  caso("completo", wav, wav.size(), 0, true, false);
+  caso("con cola LIST", conCola, conCola.size(), 0, true, false);
+  caso("red cortada", wav, wav.size() / 2, 0, false, false);
+  caso("red quieta 5 s", wav, wav.size() / 2, 5000, false, true);
+  printf("\n");
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,192 @@
+/****************************************************
+ * Prueba: PaqueteDXL.h (Dynamixel protocolo 1.0)
+ * - READ, SYNC_WRITE y BULK_READ contra los ejemplos
+ *   del e-manual de Robotis, byte a byte (los mismos
+ *   que verifica herramientas/bus_dxl.py)
+ * - syncWrite16() y el bulkRead() de un registro dan lo
+ *   mismo que las versiones generales, con 1..12 servos
+ *   al azar; un paquete que no entra devuelve 0
+ * - LectorEstado: las respuestas del e-manual, y
+ *   respuestas armadas con paquete() que vuelven igual
+ *   (con FF de relleno, basura antes, varias seguidas
+ *   como en un BULK_READ); checksum roto = MAL_CHECKSUM
+ * - Sin simulador: PaqueteDXL.h no usa Arduino
+ ****************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+#include "PaqueteDXL.h"
+
+static int fallas = 0;
+
+static void verificar(bool ok, const char* que) {
+  printf("%s: %s\n", ok ? "ok " : "MAL", que);
+  if (!ok) fallas++;
+}
+
+// "FF FF 01 ..." -> bytes
+static std::vector<uint8_t> hexa(const char* s) {
+  std::vector<uint8_t> v;
+  for (char* p = (char*)s; *p;) {
+    long b = strtol(p, &p, 16);
+    v.push_back((uint8_t)b);
+    while (*p == ' ') p++;
+  }
+  return v;
+}
+
+static bool igual(const uint8_t* buf, size_t n, const char* esperado) {
+  std::vector<uint8_t> e = hexa(esperado);
+  if (n == e.size() && memcmp(buf, e.data(), n) == 0) return true;
+  printf("  esperado %s\n  obtenido", esperado);
+  for (size_t i = 0; i < n; i++) printf(" %02X", buf[i]);
+  printf("\n");
+  return false;
+}
+
+static void manual() {
+  printf("== Paquetes contra el e-manual ==\n");
+  uint8_t buf[256];
+
+  size_t n = dxl1::leer(buf, sizeof(buf), 1, 0x2B, 1);
+  verificar(igual(buf, n, "FF FF 01 04 02 2B 01 CC"), "READ temperatura id 1");
+
+  // Posición y velocidad (4 bytes desde 0x1E) de 4 servos
+  const uint8_t ids[] = { 0, 1, 2, 3 };
+  const uint8_t datos[] = { 0x10, 0x00, 0x50, 0x01, 0x20, 0x02, 0x60, 0x03,
+                            0x30, 0x00, 0x70, 0x01, 0x20, 0x02, 0x80, 0x03 };
+  n = dxl1::syncWrite(buf, sizeof(buf), 0x1E, 4, ids, datos, 4);
+  verificar(igual(buf, n, "FF FF FE 18 83 1E 04 00 10 00 50 01 01 20 02 60 03 "
+                          "02 30 00 70 01 03 20 02 80 03 12"),
+            "SYNC_WRITE 4 servos");
+
+  const dxl1::PedidoBulk pedidos[] = { { 2, 1, 0x1E }, { 2, 2, 0x24 } };
+  n = dxl1::bulkRead(buf, sizeof(buf), pedidos, 2);
+  verificar(igual(buf, n, "FF FF FE 09 92 00 02 01 1E 02 02 24 1D"), "BULK_READ 2 servos");
+  printf("\n");
+}
+
+static void variantes() {
+  printf("== syncWrite16 / bulkRead de un registro ==\n");
+  std::mt19937 rnd(1);
+  uint8_t a[256], b[256];
+  int malos = 0;
+  for (int caso = 0; caso < 300; caso++) {
+    uint8_t n = 1 + rnd() % 12;
+    uint8_t ids[12], bytes[24];
+    uint16_t v[12];
+    dxl1::PedidoBulk pedidos[12];
+    for (uint8_t i = 0; i < n; i++) {
+      ids[i] = rnd() % 254;
+      v[i] = rnd() % 1024;
+      bytes[2 * i] = (uint8_t)v[i];
+      bytes[2 * i + 1] = (uint8_t)(v[i] >> 8);
+      pedidos[i] = { 2, ids[i], dxl1::REG_PRESENT_POS };
+    }
+    size_t na = dxl1::syncWrite16(a, sizeof(a), dxl1::REG_GOAL_POS, ids, v, n);
+    size_t nb = dxl1::syncWrite(b, sizeof(b), dxl1::REG_GOAL_POS, 2, ids, bytes, n);
+    if (!na || na != nb || memcmp(a, b, na)) malos++;
+    na = dxl1::bulkRead(a, sizeof(a), dxl1::REG_PRESENT_POS, 2, ids, n);
+    nb = dxl1::bulkRead(b, sizeof(b), pedidos, n);
+    if (!na || na != nb || memcmp(a, b, na)) malos++;
+  }
+  printf("  %d/600 distintos\n", malos);
+  verificar(malos == 0, "iguales a syncWrite() y bulkRead() generales");
+
+  // 4 servos = 14 parámetros + 6; y el largo del paquete no pasa de 255
+  uint8_t ids[85] = {};
+  uint16_t v[85] = {};
+  bool cortos = dxl1::syncWrite16(a, 19, dxl1::REG_GOAL_POS, ids, v, 4) == 0 &&
+                dxl1::syncWrite16(a, 20, dxl1::REG_GOAL_POS, ids, v, 4) == 20 &&
+                dxl1::syncWrite16(a, sizeof(a), dxl1::REG_GOAL_POS, ids, v, 85) == 0 &&
+                dxl1::bulkRead(a, 15, dxl1::REG_PRESENT_POS, 2, ids, 3) == 0;
+  verificar(cortos, "si no entra en el buffer o pasa de 255, devuelve 0");
+  printf("\n");
+}
+
+// Pasa los bytes al lector; cuenta las respuestas completas y la última
+struct Lectura {
+  int listos = 0, malos = 0;
+  std::vector<uint8_t> ids;
+  uint8_t error = 0, nDatos = 0;
+  uint16_t dato = 0;
+};
+
+static Lectura leerTodo(dxl1::LectorEstado& l, const uint8_t* b, size_t n) {
+  Lectura r;
+  for (size_t i = 0; i < n; i++) {
+    dxl1::LectorEstado::Resultado x = l.byte(b[i]);
+    if (x == dxl1::LectorEstado::MAL_CHECKSUM) r.malos++;
+    if (x != dxl1::LectorEstado::LISTO) continue;
+    r.listos++;
+    r.ids.push_back(l.id());
+    r.error = l.error();
+    r.nDatos = l.nDatos();
+    r.dato = l.nDatos() >= 2 ? l.dato16() : 0;
+  }
+  return r;
+}
+
+static void lector() {
+  printf("== LectorEstado ==\n");
+  dxl1::LectorEstado l;
+
+  // Respuesta al READ de temperatura (32 °C) y a un WRITE
+  std::vector<uint8_t> t = hexa("FF FF 01 03 00 20 DB");
+  Lectura r = leerTodo(l, t.data(), t.size());
+  verificar(r.listos == 1 && r.ids[0] == 1 && r.error == 0 && r.nDatos == 1, "e-manual: respuesta de READ");
+  t = hexa("FF FF 01 02 00 FC");
+  r = leerTodo(l, t.data(), t.size());
+  verificar(r.listos == 1 && r.ids[0] == 1 && r.error == 0 && r.nDatos == 0, "e-manual: respuesta de WRITE");
+
+  // Ida y vuelta: el error va donde iría la instrucción
+  std::mt19937 rnd(2);
+  uint8_t buf[32];
+  int malos = 0, rotos = 0;
+  for (int caso = 0; caso < 300; caso++) {
+    uint8_t id = rnd() % 254, error = caso % 3 ? 0 : 0x20;
+    uint16_t v = rnd() % 1024;
+    uint8_t datos[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    size_t n = dxl1::paquete(buf, sizeof(buf), id, error, datos, 2);
+    if (caso % 5 == 0) {
+      buf[n - 1] ^= 0x55;
+      r = leerTodo(l, buf, n);
+      if (r.listos || r.malos != 1) rotos++;
+      continue;
+    }
+    r = leerTodo(l, buf, n);
+    if (r.listos != 1 || r.ids[0] != id || r.error != error || r.nDatos != 2 || r.dato != v) malos++;
+  }
+  printf("  %d/240 distintas, %d/60 rotas aceptadas\n", malos, rotos);
+  verificar(malos == 0, "paquete() -> LectorEstado devuelve id, error y dato");
+  verificar(rotos == 0, "checksum roto = MAL_CHECKSUM");
+
+  // Basura y FF de relleno antes; un largo imposible se descarta
+  std::vector<uint8_t> s = hexa("00 FF 12 FF FF 07 30 FF FF FF");
+  uint8_t datos[2] = { 0x34, 0x02 };
+  size_t n = dxl1::paquete(buf, sizeof(buf), 7, 0, datos, 2);
+  s.insert(s.end(), buf, buf + n);
+  r = leerTodo(l, s.data(), s.size());
+  verificar(r.listos == 1 && r.malos == 0 && r.ids[0] == 7 && r.dato == 0x234, "se resincroniza con basura y relleno");
+
+  // Las respuestas de un BULK_READ llegan una atrás de la otra
+  s.clear();
+  for (uint8_t id = 1; id <= 6; id++) {
+    uint8_t p[2] = { (uint8_t)(id * 40), 1 };
+    n = dxl1::paquete(buf, sizeof(buf), id, 0, p, 2);
+    s.insert(s.end(), buf, buf + n);
+  }
+  r = leerTodo(l, s.data(), s.size());
+  bool enOrden = r.listos == 6;
+  for (size_t i = 0; enOrden && i < r.ids.size(); i++) enOrden = r.ids[i] == i + 1;
+  verificar(enOrden && r.malos == 0 && r.dato == 0x100 + 240, "6 respuestas seguidas, en orden");
+}
+
+int main() {
+  manual();
+  variantes();
+  lector();
+  return fallas ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/****************************************************
+ * Prueba: AudioPipeline::queueNext() sin huecos
+ * - Tres clips IMA de largos distintos, encolados con
+ *   queueNext() mientras suena el anterior, como
+ *   prefetchNext() en Vocesconwifiperfecto.cpp
+ * - En cada cambio de clip mira el DMA: la primera
+ *   muestra del clip nuevo tiene que entrar antes de
+ *   que se vacíe (hueco 0), y es la del clip: no un
+ *   cero de más (un clic)
+ * - Todos los perfiles de red; sale con 1 si algún
+ *   cambio falla o sobran o faltan muestras
+ ****************************************************/
+#include <Arduino.h>
+#include <AudioFileSourceHTTPStream.h>
+#include <AudioOutputI2SNoDAC.h>
+#include "AudioPipeline.h"
+#include "ImaAdpcm.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+// Los de Vocesconwifiperfecto.cpp
+const size_t AUDIO_RING_BYTES    = 64 * 1024;
+const size_t AUDIO_PREBUFFER_IMA = 3 * 1024;
+
+const uint32_t RATE = 16000;
+const char*    BASE_URL = "http://server:8000";
+// En ngrok abrir la conexión del siguiente (lo hace quien encola) tarda
+// ~600 ms: cada clip que tiene otro detrás dura más que eso, si no el
+// hueco es de la red y no del cambio de clip
+const uint32_t CLIPS_MS[] = { 1200, 900, 450 };
+const size_t   N_CLIPS = sizeof(CLIPS_MS) / sizeof(CLIPS_MS[0]);
+const int16_t  AMPLITUD = 9000;   // cada clip empieza en esta muestra (coseno)
+
+AudioPipeline        pipeline;
+AudioOutputI2SNoDAC* dac = nullptr;
+
+// Entre AudioOutputKeepOpen y el DAC: ve la primera muestra de cada clip
+// (advances() ya cambió) y cuánto audio quedaba en el DMA en ese momento
+class SalidaCambios : public AudioOutput {
+public:
+  struct Cambio {
+    int64_t margenUs;   // < 0: el DMA se vació antes (hueco)
+    int16_t muestra;    // la primera del clip nuevo
+  };
+
+  explicit SalidaCambios(AudioOutputI2SNoDAC* real) : real_(real) {}
+  bool SetRate(int hz) override { return real_->SetRate(hz); }
+  bool begin() override { return real_->begin(); }
+  bool stop() override { return real_->stop(); }
+  void flush() override { real_->flush(); }
+  bool ConsumeSample(int16_t s[2]) override {
+    if (pipeline.advances() != visto_ && n < N_CLIPS) {
+      visto_ = pipeline.advances();
+      cambios[n++] = { (int64_t)real_->finUs() - (int64_t)sim::ahoraUs(), s[0] };
+    }
+    return real_->ConsumeSample(s);
+  }
+  void reiniciar() { n = 0; visto_ = 0; }
+
+  Cambio   cambios[N_CLIPS];
+  uint32_t n = 0;
+
+private:
+  AudioOutputI2SNoDAC* real_;
+  uint32_t             visto_ = 0;
+};
+
+SalidaCambios*       medida = nullptr;
+AudioOutputKeepOpen* out = nullptr;
+
+// Cada clip con su tono, para que el cambio se note
+std::string clip(uint32_t ms, double hz) {
+  size_t n = (size_t)RATE * ms / 1000;
+  std::vector<int16_t> m(n);
+  for (size_t i = 0; i < n; i++) m[i] = (int16_t)(AMPLITUD * cos(2 * PI * hz * i / RATE));
+  return sim::ServidorMock::wavPcm(m.data(), n, RATE);
+}
+
+struct Voz {
+  AudioFileSourceHTTPStream* src = nullptr;
+  AudioGeneratorIMA*         gen = nullptr;
+};
+
+void preparar(Voz& v, size_t k) {
+  char url[128];
+  snprintf(url, sizeof(url), "%s/esp32/audio_raw/clip%u?fmt=ima", BASE_URL, (unsigned)k);
+  v.src = new AudioFileSourceHTTPStream(url);
+  v.src->SetReconnect(3, 200);
+  v.gen = new AudioGeneratorIMA();
+}
+
+void soltar(Voz& v) {
+  delete v.gen;
+  delete v.src;
+  v = Voz();
+}
+
+// Reproduce los clips seguidos; true si ningún cambio dejó hueco ni clic
+bool reproducir(const char* perfil) {
+  Voz voces[N_CLIPS];
+  dac->reiniciar();
+  medida->reiniciar();
+  pipeline.setPrebuffer(AUDIO_PREBUFFER_IMA);
+  preparar(voces[0], 0);
+  if (!pipeline.play(voces[0].src, voces[0].gen, out)) return false;
+
+  size_t encolados = 1;
+  while (pipeline.isBusy()) {
+    if (encolados < N_CLIPS && !pipeline.hasNext()) {
+      preparar(voces[encolados], encolados);
+      if (pipeline.queueNext(voces[encolados].src, voces[encolados].gen)) encolados++;
+      else soltar(voces[encolados]);
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));
+  }
+  out->close();
+  for (size_t k = 0; k < N_CLIPS; k++) soltar(voces[k]);
+
+  uint32_t esperadas = 0;
+  for (size_t k = 0; k < N_CLIPS; k++) esperadas += RATE * CLIPS_MS[k] / 1000;
+
+  AudioOutputI2SNoDAC::Stats st = dac->stats();
+  bool ok = pipeline.lastOk() && pipeline.advances() == N_CLIPS - 1 && medida->n == N_CLIPS - 1 &&
+            st.muestras == esperadas;
+  printf("%-10s %7u %8u %6u", perfil, st.muestras, esperadas, st.huecos);
+  for (uint32_t k = 0; k < N_CLIPS - 1; k++) {
+    const SalidaCambios::Cambio& c = medida->cambios[k];
+    bool hueco = c.margenUs < 0, clic = c.muestra != AMPLITUD;
+    printf("  %5.1f ms %6d%s%s", c.margenUs / 1000.0, c.muestra, hueco ? " HUECO" : "", clic ? " CLIC" : "");
+    if (hueco || clic) ok = false;
+  }
+  printf("%s\n", ok ? "" : "  FALLA");
+  return ok;
+}
+
+void principal(void*) {
+  const double TONOS[N_CLIPS] = { 220, 330, 440 };
+  for (size_t k = 0; k < N_CLIPS; k++) {
+    char id[16];
+    snprintf(id, sizeof(id), "clip%u", (unsigned)k);
+    sim::servidor().agregarAudio(id, clip(CLIPS_MS[k], TONOS[k]));
+  }
+
+  AudioPipeline::Config acfg;
+  acfg.ringBytes      = AUDIO_RING_BYTES;
+  acfg.prebufferBytes = AUDIO_PREBUFFER_IMA;
+  if (!pipeline.begin(acfg)) {
+    printf("No se pudo crear el pipeline\n");
+    sim::fin(1);
+  }
+  dac = new AudioOutputI2SNoDAC();
+  dac->SetOutputModeMono(true);
+  medida = new SalidaCambios(dac);
+  out = new AudioOutputKeepOpen(medida);
+
+  printf("== Gapless: %u clips IMA con queueNext(), DMA en cada cambio ==\n", (unsigned)N_CLIPS);
+  printf("%-10s %7s %8s %6s  %s\n", "perfil", "muestras", "esperadas", "huecos",
+         "cambio: DMA que quedaba, primera muestra");
+  uint32_t fallas = 0;
+  for (size_t p = 0; p < sim::N_PERFILES; p++) {
+    sim::usarPerfil(sim::PERFILES[p]);
+    sim::azar().sembrar(sim::semilla() * 1000 + p);
+    if (!reproducir(sim::PERFILES[p].nombre)) fallas++;
+  }
+  printf("\n");
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,79 @@
+/****************************************************
+ * Prueba: ClasificadorGestos con trazas grabadas
+ * - Lee una traza "T,ms,x,y,z" (lo que imprime
+ *   TactilIRQ::registrar) y la pasa muestra a muestra
+ * - La línea "# espera: toque, desliz der, ..." dice
+ *   qué gestos tienen que salir, en orden
+ * - Sale con 1 si falta, sobra o cambia alguno
+ * - Sin simulador: Gestos.h no usa Arduino
+ ****************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Gestos.h"
+
+static std::string nombre(const Gesto& g) {
+  std::string s = nombreGesto(g.tipo);
+  if (g.tipo == G_DESLIZ) s += std::string(" ") + nombreDireccion(g.dir);
+  return s;
+}
+
+// "toque, desliz der" -> {"toque", "desliz der"}
+static std::vector<std::string> partir(const char* p) {
+  std::vector<std::string> v;
+  std::string s;
+  for (;; p++) {
+    if (*p == ',' || *p == '\n' || *p == '\r' || !*p) {
+      size_t a = s.find_first_not_of(' '), b = s.find_last_not_of(' ');
+      if (a != std::string::npos) v.push_back(s.substr(a, b - a + 1));
+      s.clear();
+      if (*p != ',') break;
+    } else {
+      s += *p;
+    }
+  }
+  return v;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: %s traza.csv\n", argv[0]);
+    return 2;
+  }
+  FILE* f = fopen(argv[1], "r");
+  if (!f) {
+    perror(argv[1]);
+    return 2;
+  }
+
+  ClasificadorGestos clasif;
+  std::vector<std::string> espera, salio;
+  uint32_t muestras = 0, t0 = 0;
+  char linea[128];
+  while (fgets(linea, sizeof(linea), f)) {
+    if (!strncmp(linea, "# espera:", 9)) {
+      espera = partir(linea + 9);
+      continue;
+    }
+    unsigned long ms;
+    int x, y;
+    unsigned z;
+    if (sscanf(linea, "T,%lu,%d,%d,%u", &ms, &x, &y, &z) != 4) continue;
+    if (!muestras++) t0 = ms;
+    MuestraTactil m = { (uint32_t)ms, (int16_t)x, (int16_t)y, (uint16_t)z };
+    Gesto g;
+    if (clasif.procesar(m, g)) {
+      salio.push_back(nombre(g));
+      printf("  %6u ms  %-12s en (%d,%d) recorrido (%d,%d) %u ms apoyado\n", (unsigned)(g.ms - t0),
+             salio.back().c_str(), g.x, g.y, g.dx, g.dy, g.duracion);
+    }
+  }
+  fclose(f);
+
+  bool ok = salio == espera && muestras;
+  printf("%s: %u muestras, %zu gestos (espera %zu)%s\n", argv[1], (unsigned)muestras, salio.size(),
+         espera.size(), ok ? "" : "  FALLA");
+  if (clasif.activo()) printf("  la traza termina con el dedo apoyado\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+/****************************************************
+ * Prueba: CommandChannel no usa heap en régimen
+ * - Cuenta cada malloc/calloc/realloc del firmware
+ *   (operator new pasa por malloc) y cada String con
+ *   contenido; lo que pide el simulador (red, server,
+ *   planificador) va marcado con sim::EnHal y no cuenta
+ * - Canal con Config::rtt puesto, como en
+ *   Vocesconwifiperfecto.cpp, long-poll y lote
+ * - Después de CALENTAR comandos (la primera conexión,
+ *   la cola y el documento ya armados) cuenta durante
+ *   MEDIR comandos: tiene que dar 0
+ ****************************************************/
+#include <Arduino.h>
+#include "CommandChannel.h"
+#include "Red.h"
+#include "ServidorMock.h"
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+
+void* malloc(size_t n) {
+  sim::heapFirmware();
+  return __libc_malloc(n);
+}
+void* calloc(size_t n, size_t t) {
+  sim::heapFirmware();
+  return __libc_calloc(n, t);
+}
+void* realloc(void* p, size_t n) {
+  sim::heapFirmware();
+  return __libc_realloc(p, n);
+}
+}
+
+telemetria::Registro   tele;
+telemetria::Histograma pollRtt(tele, "poll_rtt_ms", telemetria::CUBETAS_MS);
+
+const char*    DEVICE  = "robot-heap";
+const uint32_t CALENTAR = 20;
+const uint32_t MEDIR    = 200;
+
+// Hace de server: lo que encola no es del firmware
+void generador(void*) {
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(1 + (uint32_t)sim::azar().exponencial(300)));
+    sim::EnHal hal;
+    sim::servidor().encolar(DEVICE, "\"tipo\":\"mover\",\"angulo\":90");
+  }
+}
+
+void principal(void*) {
+  sim::usarPerfil(sim::PERFILES[1]);   // wifi
+  static CommandChannel canal;
+  CommandChannel::Config cfg;
+  cfg.baseUrl  = "http://server:8000";
+  cfg.deviceId = DEVICE;
+  cfg.rtt      = &pollRtt;
+  if (!canal.begin(cfg)) {
+    printf("No se pudo crear el canal\n");
+    sim::fin(1);
+  }
+  xTaskCreate(generador, "generador", 4096, nullptr, 1, nullptr);
+
+  CommandChannel::Command cmd;
+  uint32_t recibidos = 0, antes = 0;
+  while (recibidos < CALENTAR + MEDIR) {
+    if (!canal.receive(cmd, pdMS_TO_TICKS(100))) continue;
+    if (++recibidos == CALENTAR) antes = sim::asignacionesFirmware();
+  }
+  uint32_t asignaciones = sim::asignacionesFirmware() - antes;
+  CommandChannel::Stats st = canal.stats();
+  printf("== Heap del firmware en régimen: CommandChannel con rtt ==\n");
+  printf("%u comandos en %u pedidos, %u errores: %u asignaciones\n\n", (unsigned)MEDIR,
+         (unsigned)st.requests, (unsigned)st.errors, (unsigned)asignaciones);
+  if (asignaciones) printf("FALLA: el canal pide heap en cada poll\n\n");
+  sim::fin(asignaciones ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
@@ -0,0 +1,157 @@
+/****************************************************
+ * Prueba: ImaAdpcm contra el encoder del server
+ * - pruebas/audio/voz.ima.wav sale de wav_a_ima() del
+ *   notebook (audio_ima.py); voz.dec.wav es lo que
+ *   reconstruye ese encoder y voz.wav el PCM original
+ * - decodeBlock bloque por bloque: igual a voz.dec.wav
+ *   muestra por muestra (el último bloque es corto)
+ * - AudioGeneratorIMA leyendo de a pedazos: mismas
+ *   muestras y ni una más (la cuenta del chunk fact
+ *   corta el nibble de relleno)
+ * - Además, voz.dec.wav se parece a voz.wav (SNR)
+ ****************************************************/
+#include <Arduino.h>
+#include <math.h>
+#include <vector>
+#include "ImaAdpcm.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes leer(const char* dir, const char* nombre) {
+  char ruta[512];
+  snprintf(ruta, sizeof(ruta), "%s/%s", dir, nombre);
+  Bytes b;
+  FILE* f = fopen(ruta, "rb");
+  if (!f) {
+    perror(ruta);
+    exit(2);
+  }
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) b.insert(b.end(), buf, buf + n);
+  fclose(f);
+  return b;
+}
+
+static uint32_t u32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+// Puntero y largo de un chunk del WAV (nullptr si no está)
+static const uint8_t* chunk(const Bytes& wav, const char* id, uint32_t& len) {
+  for (size_t p = 12; p + 8 <= wav.size(); p += 8 + len + (len & 1)) {
+    len = u32(&wav[p + 4]);
+    if (!memcmp(&wav[p], id, 4)) return &wav[p + 8];
+  }
+  return nullptr;
+}
+
+static std::vector<int16_t> muestrasPcm(const Bytes& wav) {
+  uint32_t len;
+  const uint8_t* d = chunk(wav, "data", len);
+  std::vector<int16_t> v(len / 2);
+  for (size_t i = 0; i < v.size(); i++) v[i] = (int16_t)(d[2 * i] | (d[2 * i + 1] << 8));
+  return v;
+}
+
+// Fuente en memoria que entrega de a pedazos chicos, como la red
+class FuenteMemoria : public AudioFileSource {
+public:
+  FuenteMemoria(const Bytes& b, uint32_t pedazo) : b_(b), pedazo_(pedazo) {}
+  uint32_t read(void* data, uint32_t len) override {
+    uint32_t n = std::min<uint32_t>({ len, pedazo_, (uint32_t)(b_.size() - pos_) });
+    memcpy(data, b_.data() + pos_, n);
+    pos_ += n;
+    return n;
+  }
+  bool close() override { return true; }
+  bool isOpen() override { return true; }
+  uint32_t getSize() override { return b_.size(); }
+  uint32_t getPos() override { return pos_; }
+
+private:
+  const Bytes& b_;
+  uint32_t     pedazo_, pos_ = 0;
+};
+
+class SalidaCaptura : public AudioOutput {
+public:
+  bool begin() override { return true; }
+  bool ConsumeSample(int16_t s[2]) override {
+    v.push_back(s[0]);
+    return true;
+  }
+  bool stop() override { return true; }
+  std::vector<int16_t> v;
+};
+
+static uint32_t fallas = 0;
+
+static void comparar(const char* que, const std::vector<int16_t>& got, const std::vector<int16_t>& ref) {
+  size_t distintas = 0, primera = 0;
+  for (size_t i = 0; i < got.size() && i < ref.size(); i++) {
+    if (got[i] != ref[i] && !distintas++) primera = i;
+  }
+  bool ok = got.size() == ref.size() && !distintas;
+  printf("%-28s %5zu muestras (espera %zu), %zu distintas", que, got.size(), ref.size(), distintas);
+  if (distintas) printf(", la primera en %zu", primera);
+  printf("%s\n", ok ? "" : "  FALLA");
+  if (!ok) fallas++;
+}
+
+void principal(void* arg) {
+  const char* dir = (const char*)arg;
+  Bytes ima = leer(dir, "voz.ima.wav");
+  std::vector<int16_t> dec = muestrasPcm(leer(dir, "voz.dec.wav"));
+  std::vector<int16_t> orig = muestrasPcm(leer(dir, "voz.wav"));
+
+  uint32_t len, fmtLen, factLen;
+  const uint8_t* fmt = chunk(ima, "fmt ", fmtLen);
+  const uint8_t* fact = chunk(ima, "fact", factLen);
+  const uint8_t* data = chunk(ima, "data", len);
+  uint16_t blockAlign = fmt[12] | (fmt[13] << 8);
+  printf("== ImaAdpcm: %u bytes en bloques de %u, fact %u muestras ==\n", len, blockAlign, u32(fact));
+
+  // decodeBlock solo: devuelve también el nibble de relleno del último bloque
+  std::vector<int16_t> got;
+  int16_t pcm[1 + (AudioGeneratorIMA::MAX_BLOCK - 4) * 2];
+  for (uint32_t p = 0; p < len; p += blockAlign) {
+    size_t n = ImaAdpcm::decodeBlock(data + p, std::min<uint32_t>(blockAlign, len - p), pcm);
+    got.insert(got.end(), pcm, pcm + n);
+  }
+  if (got.size() == dec.size() + 1) got.pop_back();
+  else printf("decodeBlock: el último bloque no trae el nibble de relleno\n");
+  comparar("decodeBlock", got, dec);
+
+  // Generador completo, con lecturas de 1, 7 y 100 bytes
+  for (uint32_t pedazo : { 1u, 7u, 100u }) {
+    FuenteMemoria src(ima, pedazo);
+    SalidaCaptura out;
+    AudioGeneratorIMA gen;
+    if (!gen.begin(&src, &out) || !gen.isAdpcm()) {
+      printf("AudioGeneratorIMA no abre el WAV  FALLA\n");
+      fallas++;
+      continue;
+    }
+    while (gen.loop()) {}
+    char que[48];
+    snprintf(que, sizeof(que), "AudioGeneratorIMA de a %u", pedazo);
+    comparar(que, out.v, dec);
+  }
+
+  double senal = 0, error = 0;
+  for (size_t i = 0; i < orig.size() && i < dec.size(); i++) {
+    senal += (double)orig[i] * orig[i];
+    error += (double)(orig[i] - dec[i]) * (orig[i] - dec[i]);
+  }
+  // Con el ruido y el golpe saturado, 4 bits no dan mucho más (el tono solo da ~26 dB):
+  // esto sólo confirma que voz.dec.wav es el mismo audio que voz.wav
+  double snr = 10 * log10(senal / (error ? error : 1));
+  printf("%-28s %.1f dB%s\n\n", "SNR contra voz.wav", snr, snr >= 10 ? "" : "  FALLA");
+  if (snr < 10) fallas++;
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main(int argc, char** argv) {
+  static char dir[512] = "pruebas/audio";
+  if (argc > 1) snprintf(dir, sizeof(dir), "%s", argv[1]);
+  sim::correr(principal, dir);
+}
@@ -0,0 +1,73 @@
+/****************************************************
+ * Prueba: PollComandos con respuestas que no entran
+ * - Lotes de 8 comandos con un campo de relleno que
+ *   crece de a 3 bytes: el cuerpo pasa de entrar
+ *   holgado en el buffer (512 B, como el de
+ *   PosesRemotas) a no entrar, y los "tipo" caen a
+ *   veces partidos entre el buffer y el resto
+ * - En cada pedido la cuenta de comandos tiene que
+ *   dar lo encolado, entre o no; si no entra tiene
+ *   que volver PERDIDOS y sumarse a stats().perdidos
+ * - Al final la cola del server está vacía: esos
+ *   comandos ya salieron, por eso se cuentan
+ * - Todos los pedidos van por una sola conexión TCP
+ *   (HTTPClient con reuse, leyendo cada respuesta hasta
+ *   el final)
+ ****************************************************/
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <PollComandos.h>
+#include "Red.h"
+#include "ServidorMock.h"
+
+const char*    DEVICE = "robot-poll";
+const uint32_t LOTE   = 8;
+const size_t   BUF    = 512;
+
+void principal(void*) {
+  sim::usarPerfil(sim::PERFILES[1]);   // wifi
+  sim::servidor().sinLongPoll(true);
+  PollComandos poll;
+  poll.begin("http://server:8000", DEVICE, 0, LOTE);
+
+  uint32_t conexiones0 = HTTPClient::conexiones();
+  static char buf[BUF];
+  uint32_t fallas = 0, entraron = 0, noEntraron = 0, encolados = 0, perdidos = 0;
+  for (uint32_t relleno = 0; relleno <= 150; relleno += 3) {
+    for (uint32_t i = 0; i < LOTE; i++) {
+      std::string campos = "\"tipo\":\"pose\",\"r\":\"" + std::string(relleno, 'x') + "\"";
+      sim::servidor().encolar(DEVICE, campos);
+    }
+    encolados += LOTE;
+    uint32_t ms, comandos;
+    PollComandos::Resultado r = poll.pedir(buf, sizeof(buf), ms, comandos);
+    bool entra = r == PollComandos::COMANDOS;
+    if (entra) entraron++;
+    else if (r == PollComandos::PERDIDOS) {
+      noEntraron++;
+      perdidos += comandos;
+    }
+    bool ok = (entra || r == PollComandos::PERDIDOS) && comandos == LOTE && (!entra || strlen(buf) < BUF);
+    if (!ok) {
+      printf("relleno %3u: resultado %u, %u comandos de %u  FALLA\n", relleno, r, comandos, LOTE);
+      fallas++;
+    }
+  }
+
+  // Lo que queda en la cola del server: tiene que ser nada
+  uint32_t ms, comandos;
+  poll.pedir(buf, sizeof(buf), ms, comandos);
+  PollComandos::Stats st = poll.stats();
+  uint32_t conexiones = HTTPClient::conexiones() - conexiones0;
+  printf("== PollComandos: lotes de %u comandos en un buffer de %u B ==\n", LOTE, (unsigned)BUF);
+  printf("Respuestas que entran: %u, que no entran: %u (grandes %u)\n", entraron, noEntraron, st.grandes);
+  printf("Comandos encolados: %u, perdidos contados: %u (stats %u), quedan en el server: %u\n", encolados,
+         perdidos, st.perdidos, comandos);
+  printf("%u pedidos por %u conexiones TCP\n\n", st.pedidos, conexiones);
+  if (!entraron || !noEntraron || st.grandes != noEntraron || st.perdidos != perdidos ||
+      perdidos != noEntraron * LOTE || comandos || st.errores || st.cortadas || conexiones != 1)
+    fallas++;
+  sim::fin(fallas ? 1 : 0);
+}
+
+int main() { sim::correr(principal); }
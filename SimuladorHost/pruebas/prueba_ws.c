@@ -0,0 +1,195 @@
+/*
+ * Prueba: el cuadro del WS2812 de Lab2Colores (ws2812.h) contando ciclos
+ * - ws_cuadro() tal cual, con SPSR y SPDR de un modelo del SPI: 16
+ *   ciclos por byte, SPIF al terminar, MOSI quieto en el último bit
+ *   hasta la próxima carga (SPDR sin buffer doble)
+ * - Entre carga y carga la CPU gasta lo que gasta el código de avr-gcc
+ *   (contado a mano, ver CICLOS_*); las ISR de main.c (ADC a ADC_FS y la
+ *   UART vaciando printf a 9600) caen en cualquier momento y frenan a
+ *   la CPU, no al SPI
+ * - Mide cada bajo que ve la tira, el cuadro entero, cuánto quedan
+ *   tapadas las interrupciones y la latencia de la ISR del ADC (lo que
+ *   da 'w' como isr_lat_us en la placa)
+ * - Sale con 1 si un código no empieza en 1 y termina en 0, si la tira
+ *   no recibiría los colores que se mandaron, si se carga SPDR con un
+ *   byte saliendo, o si algún bajo pasa WS_BAJO_MAX_US
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avr/io.h"
+#include "clasificador.h"   // ADC_FS
+
+#define F_CPU 16000000UL
+
+static uint8_t *spi_sr(void);
+static uint8_t *spi_dr(void);
+#define SPSR (*spi_sr())
+#define SPDR (*spi_dr())
+#include "ws2812.h"
+
+#define NUM_LEDS 64
+#define CUADROS  500
+
+/* Ciclos de CPU desde que se carga SPDR hasta el próximo sondeo de SPIF
+ * (avr-gcc -Og, como el Debug del proyecto) */
+#define CICLOS_BIT   8    // m>>=1, brne, armar x (and, breq, ldi), rjmp
+#define CICLOS_BYTE  17   // sale de ws_byte (ret), carga el próximo color, call, primer x
+#define CICLOS_LED   26   // lo anterior más i++, la comparación y leds + i*3
+#define CICLOS_PRIMERO 20 // después de SPDR = 0: arranca el for y el primer x
+
+/* Las ISR de main.c: respuesta (4) + jmp del vector (3) + prólogo y
+ * epílogo con 6 registros (~43) + cuerpo */
+#define ISR_ADC_CICLOS  90   // TCNT0, TIFR0, buffer circular de 16 bits
+#define ISR_UART_CICLOS 72   // UDRE: un byte del buffer de printf
+#define ADC_CADA   (F_CPU/ADC_FS)
+#define UART_CADA  (F_CPU/960)   // 10 bits por byte a 9600
+
+static uint64_t ciclo;                 // reloj de la CPU
+static uint64_t spi_fin;               // termina el byte que está saliendo
+static uint8_t  sr, dr;
+static uint8_t  pendiente;             // hay trabajo de CPU antes del próximo sondeo
+static uint32_t escrituras, colisiones;
+static uint64_t escrita[1 + NUM_LEDS*24];
+static uint8_t  valor[1 + NUM_LEDS*24];
+static uint32_t isr_vistas[1 + NUM_LEDS*24];   // ISR corridas hasta cada carga
+
+/* ISR */
+static uint64_t prox_adc, prox_uart, isr_libre;
+static uint32_t isr_adc, isr_uart, adc_lat_max;
+
+static double us(uint64_t c){ return c*1e6/F_CPU; }
+
+/* La CPU gasta c ciclos; cada ISR que vence en el medio los corre */
+static void cpu(uint32_t c){
+	uint64_t fin = ciclo + c;
+	for(;;){
+		int adc = prox_adc <= prox_uart;
+		uint64_t t = adc ? prox_adc : prox_uart;
+		if(t >= fin) break;
+		uint64_t ini = t > isr_libre ? t : isr_libre;   // no se anidan
+		uint32_t costo = adc ? ISR_ADC_CICLOS : ISR_UART_CICLOS;
+		isr_libre = ini + costo;
+		fin += costo;
+		if(adc){
+			if(ini - t > adc_lat_max) adc_lat_max = (uint32_t)(ini - t);
+			prox_adc += ADC_CADA; isr_adc++;
+		} else {
+			prox_uart += UART_CADA; isr_uart++;
+		}
+	}
+	ciclo = fin;
+}
+
+/* Lo que se escribió en la carga anterior ya está en dr */
+static void guardar_anterior(void){
+	if(escrituras) valor[escrituras-1] = dr;
+}
+
+static uint8_t *spi_sr(void){
+	if(pendiente){
+		uint32_t w = escrituras - 1;   // la última carga (0 es el SPDR = 0)
+		uint32_t c = !w ? CICLOS_PRIMERO : w % 24 == 0 ? CICLOS_LED : w % 8 == 0 ? CICLOS_BYTE : CICLOS_BIT;
+		cpu(c);
+		pendiente = 0;
+	}
+	cpu(1);                            // in: lee el registro
+	sr = ciclo >= spi_fin ? (1<<SPIF) : 0;
+	cpu(sr ? 2 : 3);                   // sbrs (salta) / sbrs + rjmp
+	return &sr;
+}
+
+static uint8_t *spi_dr(void){
+	guardar_anterior();
+	if(ciclo < spi_fin) colisiones++;   // WCOL: el byte anterior no terminó
+	cpu(1);                            // out
+	isr_vistas[escrituras] = isr_adc + isr_uart;
+	escrita[escrituras++] = ciclo;
+	spi_fin = ciclo + 8*WS_SPI_CICLOS;
+	pendiente = 1;
+	return &dr;
+}
+
+/* Bajo de cada código: desde su último 1 hasta que arranca el próximo */
+static uint8_t altos(uint8_t x){ uint8_t n=0; while(x & 0x80){ n++; x<<=1; } return n; }
+
+typedef struct {
+	uint64_t bajo_max[3];      // sin ISR: bit, entre colores, entre LED
+	uint64_t bajo_isr_max;     // con una ISR en el medio
+	uint64_t periodo_min, cuadro_max;
+	uint32_t malos;            // bits que la tira leería mal
+} medida_t;
+
+static void cuadro(uint8_t (*leds)[3], medida_t *m){
+	escrituras = 0; pendiente = 0;
+	uint64_t t0 = ciclo;
+	ws_cuadro(leds, NUM_LEDS);
+	guardar_anterior();
+	uint64_t t = ciclo - t0;
+	if(t > m->cuadro_max) m->cuadro_max = t;
+
+	if(escrituras != 1 + NUM_LEDS*24 || valor[0] != 0){ m->malos++; return; }
+	for(uint32_t w = 1; w < escrituras; w++){
+		/* Lo que lee la tira: un alto largo es un 1; G-R-B, MSB primero */
+		uint8_t led = (w-1)/24, color = (w-1)/8%3, bit = 7-(w-1)%8;
+		uint8_t esperado = (leds[led][color==0 ? 1 : color==1 ? 0 : 2] >> bit) & 1;
+		uint8_t a = altos(valor[w]);
+		if((a*WS_SPI_CICLOS > 8) != esperado) m->malos++;   // corta en ~500 ns
+		if(w+1 == escrituras) break;   // el último bajo es el latch
+		uint64_t periodo = escrita[w+1] - escrita[w];
+		uint64_t bajo = periodo - a*WS_SPI_CICLOS;
+		if(periodo < m->periodo_min) m->periodo_min = periodo;
+		int tipo = w % 24 == 0 ? 2 : w % 8 == 0 ? 1 : 0;
+		if(isr_vistas[w+1] != isr_vistas[w]){   // cayó una ISR en el medio
+			if(bajo > m->bajo_isr_max) m->bajo_isr_max = bajo;
+		} else if(bajo > m->bajo_max[tipo]) m->bajo_max[tipo] = bajo;
+	}
+}
+
+int main(void){
+	int fallas = 0;
+	if(!(WS_0 & 0x80) || !(WS_1 & 0x80) || (WS_0 & 1) || (WS_1 & 1)){
+		printf("WS_0/WS_1 tienen que empezar en 1 y terminar en 0  FALLA\n");
+		fallas++;
+	}
+
+	srand(19);
+	static uint8_t leds[NUM_LEDS][3];
+	medida_t m;
+	memset(&m, 0, sizeof(m));
+	m.periodo_min = (uint64_t)-1;
+	prox_adc = 1 + rand() % ADC_CADA;
+	prox_uart = 1 + rand() % UART_CADA;
+	for(int k = 0; k < CUADROS; k++){
+		for(int i = 0; i < NUM_LEDS; i++) for(int c = 0; c < 3; c++) leds[i][c] = (uint8_t)rand();
+		cuadro(leds, &m);
+		cpu(2*ADC_CADA + rand() % ADC_CADA);   // el loop entre cuadros: otra fase cada vez
+	}
+
+	/* Peor caso: las dos ISR juntas entre dos LED */
+	uint64_t peor = m.bajo_max[2] + ISR_ADC_CICLOS + ISR_UART_CICLOS;
+	uint64_t nominal = 8*WS_SPI_CICLOS - altos(WS_0)*WS_SPI_CICLOS;
+	/* Con cli() (el show() viejo) las ISR esperan todo el cuadro */
+	uint32_t cli_us = NUM_LEDS*24*125/100;
+
+	printf("== WS2812 por SPI: %d cuadros de %d LED, ISR del ADC a %d Hz y UART a 9600 ==\n",
+	       CUADROS, NUM_LEDS, ADC_FS);
+	printf("Cuadro: máx %.0f us (%u ISR en el medio)\n", us(m.cuadro_max), isr_adc + isr_uart);
+	printf("Bit: período mín %.2f us; bajo de un 0 nominal %.2f us\n", us(m.periodo_min), us(nominal));
+	printf("Bajo más largo sin ISR: %.2f us en el bit, %.2f entre colores, %.2f entre LED\n",
+	       us(m.bajo_max[0]), us(m.bajo_max[1]), us(m.bajo_max[2]));
+	printf("Bajo más largo con ISR: %.2f us (peor caso, ADC + UART entre dos LED: %.2f; tope %d)\n",
+	       us(m.bajo_isr_max), us(peor), WS_BAJO_MAX_US);
+	printf("Interrupciones tapadas: máx %.1f us (la ISR más larga); con cli() eran %u us por cuadro\n",
+	       us(ISR_ADC_CICLOS > ISR_UART_CICLOS ? ISR_ADC_CICLOS : ISR_UART_CICLOS), cli_us);
+	printf("Latencia de la ISR del ADC: máx %.1f us ('w' en la placa: isr_lat_us <= %u)\n",
+	       us(adc_lat_max), (unsigned)((us(adc_lat_max) + 3.999) / 4) * 4);
+	printf("Bits leídos mal: %u, cargas con el SPI ocupado: %u\n\n", m.malos, colisiones);
+
+	if(m.malos || colisiones) fallas++;
+	if(us(m.bajo_isr_max) > WS_BAJO_MAX_US || us(peor) > WS_BAJO_MAX_US){
+		printf("FALLA: un bajo pasa los %d us\n\n", WS_BAJO_MAX_US);
+		fallas++;
+	}
+	return fallas ? 1 : 0;
+}
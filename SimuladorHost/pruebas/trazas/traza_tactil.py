@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+Trazas del táctil en el formato que imprime TactilIRQ::registrar(true)
+("T,ms,x,y,z" cada 10 ms), para prueba_gestos.cpp. Cada archivo lleva en
+"# espera:" los gestos que tiene que sacar ClasificadorGestos.
+
+Son sintéticas, con lo que hace el XPT2046 de verdad:
+- la presión sube en 2-3 muestras al apoyar y baja igual al soltar
+- posición con ruido (~2 px) y lecturas sueltas que saltan 30-80 px
+- con poca presión (al apoyar y al soltar) la posición se va más
+- rebote al soltar: una o dos muestras con presión después de 0
+
+Una captura de verdad (Serial con 't', mismo formato) reemplaza el archivo.
+
+Uso:
+    python3 traza_tactil.py              (escribe todas acá)
+    python3 traza_tactil.py --semilla 5 --dir /tmp
+"""
+import argparse
+import os
+import random
+
+PERIODO_MS = 10   # igual que TactilIRQ::PERIODO_MS
+ANCHO, ALTO = 320, 240
+
+
+class Traza:
+    def __init__(self, azar, t0=5000):
+        self.azar = azar
+        self.t = t0
+        self.lineas = []
+
+    def muestra(self, x, y, z):
+        a = self.azar
+        ruido = 2 if z >= 400 else 8
+        x += a.gauss(0, ruido)
+        y += a.gauss(0, ruido)
+        if z and a.random() < 0.06:
+            x += a.choice((-1, 1)) * a.uniform(30, 80)
+            y += a.choice((-1, 1)) * a.uniform(30, 80)
+        x = min(ANCHO - 1, max(0, round(x)))
+        y = min(ALTO - 1, max(0, round(y)))
+        if not z:
+            x, y = 0, 0   # sin presión el XPT2046 no da posición
+        self.lineas.append(f"T,{self.t},{x},{y},{int(z)}")
+        self.t += PERIODO_MS
+
+    def toque(self, x0, y0, x1, y1, ms, rebote=False, pausa=False):
+        a = self.azar
+        n = max(2, ms // PERIODO_MS)
+        for k in range(n):
+            f = k / (n - 1)
+            x, y = x0 + (x1 - x0) * f, y0 + (y1 - y0) * f
+            if k == 0:
+                z = a.uniform(420, 500)
+            elif k == n - 1:
+                z = a.uniform(260, 330)          # ya soltando
+            elif pausa and k == n // 2:
+                z = a.uniform(260, 330)          # afloja sin soltar
+            else:
+                z = a.uniform(600, 900)
+            self.muestra(x, y, z)
+        if rebote:
+            self.muestra(x1, y1, 0)
+            self.muestra(x1, y1, a.uniform(410, 480))   # vuelve a pasar zApoyo
+            self.muestra(x1, y1, 0)
+            self.muestra(x1, y1, a.uniform(120, 200))   # debajo de zSuelta
+        for _ in range(6):                       # > soltarMs sin presión
+            self.muestra(0, 0, 0)
+
+    def nada(self, ms):
+        self.t += ms
+
+
+def casos(azar):
+    c = {}
+
+    t = Traza(azar)
+    t.toque(160, 120, 161, 119, 120)
+    c["toque"] = (t, "toque")
+
+    t = Traza(azar)
+    t.toque(80, 60, 83, 62, 900)
+    c["largo"] = (t, "largo")
+
+    for nombre, (x0, y0, x1, y1) in {
+        "izq": (240, 120, 110, 128),
+        "der": (70, 100, 210, 92),
+        "arriba": (150, 200, 158, 80),
+        "abajo": (170, 40, 162, 170),
+    }.items():
+        t = Traza(azar)
+        t.toque(x0, y0, x1, y1, 260)
+        c["desliz_" + nombre] = (t, "desliz " + nombre)
+
+    t = Traza(azar)
+    t.toque(200, 150, 201, 151, 150, rebote=True, pausa=True)
+    c["rebote"] = (t, "toque")
+
+    # Varios seguidos: cada uno tiene que salir una sola vez
+    t = Traza(azar)
+    t.toque(160, 120, 160, 120, 100, rebote=True)
+    t.nada(300)
+    t.toque(60, 120, 230, 115, 240, rebote=True)
+    t.nada(500)
+    t.toque(100, 100, 102, 101, 800)
+    t.nada(250)
+    t.toque(50, 50, 51, 52, 130)
+    c["seguidos"] = (t, "toque, desliz der, largo, toque")
+    return c
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--dir", default=os.path.dirname(os.path.abspath(__file__)))
+    ap.add_argument("--semilla", type=int, default=13)
+    a = ap.parse_args()
+    for nombre, (t, espera) in casos(random.Random(a.semilla)).items():
+        ruta = os.path.join(a.dir, f"tactil_{nombre}.csv")
+        with open(ruta, "w") as f:
+            f.write(f"# traza_tactil.py --semilla {a.semilla}\n")
+            f.write(f"# espera: {espera}\n")
+            f.write("\n".join(t.lineas) + "\n")
+        print(f"{ruta}: {len(t.lineas)} muestras, espera {espera}")
+
+
+if __name__ == "__main__":
+    main()
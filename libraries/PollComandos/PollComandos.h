@@ -0,0 +1,142 @@
+/****************************************************
+ * Long-poll de comandos del server para las tareas
+ * de red de las pantallas (CaraRemota, PosesRemotas)
+ * - GET /esp32/poll/<id>?wait=<s>&lote=<n> y el
+ *   cuerpo entero a un buffer de quien llama, con
+ *   '\0' al final (para deserializeJson zero-copy)
+ * - Al contestar, el server ya sacó esos comandos de
+ *   la cola: una respuesta que no entra en el buffer
+ *   o que llega cortada no se tira callada. Se lee
+ *   hasta el final contando los "tipo" (uno por
+ *   comando), se suman a perdidos y se avisa por
+ *   Serial
+ * - 'comandos' devuelve esa cuenta también cuando
+ *   todo entra: si después deserializeJson falla,
+ *   quien llama sabe cuántos se perdieron
+ * - Un solo HTTPClient (miembro, setReuse como
+ *   CommandChannel): la conexión keep-alive sigue entre
+ *   polls, sin un TCP nuevo por ngrok ni cliente y
+ *   socket nuevos en el heap cada vez. HTTPClient sí
+ *   usa String por dentro para el pedido y los headers
+ ****************************************************/
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+
+// Cuenta los comandos de una respuesta mientras pasa, sin parsearla: uno
+// por cada "tipo" (dentro de un texto las comillas van escapadas, no cuentan).
+// Sirve también para lo que quedó sin leer de un JSON que no se pudo parsear
+struct ContadorComandos {
+  uint32_t n = 0;
+
+  void ver(char c) {
+    static const char PATRON[] = "\"tipo\"";
+    if (c == PATRON[k_]) {
+      if (++k_ < sizeof(PATRON) - 1) return;
+      n++;
+      k_ = 0;
+      return;
+    }
+    k_ = c == '"' ? 1 : 0;
+  }
+
+private:
+  uint8_t k_ = 0;   // letras del patrón ya vistas
+};
+
+class PollComandos {
+public:
+  enum Resultado : uint8_t {
+    COMANDOS,    // buf tiene la respuesta
+    VACIO,       // 200 sin cuerpo
+    PERDIDOS,    // no entraba en buf: los comandos están en stats().perdidos
+    ERROR_RED,   // sin conexión, código distinto de 200 o cuerpo cortado: probar más tarde
+  };
+
+  struct Stats {
+    uint32_t pedidos;
+    uint32_t errores;    // sin conexión o código distinto de 200
+    uint32_t grandes;    // respuestas más grandes que el buffer
+    uint32_t cortadas;   // la conexión se cortó a mitad del cuerpo
+    uint32_t perdidos;   // comandos que venían en esas respuestas
+  };
+
+  void begin(const char* baseUrl, const char* deviceId, uint8_t waitS, uint8_t lote) {
+    waitS_ = waitS;
+    http_.setReuse(true);
+    snprintf(url_, sizeof(url_), "%s/esp32/poll/%s?wait=%u&lote=%u", baseUrl, deviceId, waitS, lote);
+  }
+
+  // Un pedido. 'ms': del GET a la respuesta (incluye lo que el server la retuvo)
+  Resultado pedir(char* buf, size_t cap, uint32_t& ms, uint32_t& comandos) {
+    comandos = 0;
+    stats_.pedidos++;
+    http_.setTimeout((waitS_ + 5) * 1000);
+    if (!http_.begin(url_)) { stats_.errores++; return ERROR_RED; }
+    uint32_t t0 = millis();
+    int code = http_.GET();
+    ms = millis() - t0;
+    if (code != HTTP_CODE_OK) {
+      http_.end();
+      stats_.errores++;
+      return ERROR_RED;
+    }
+
+    // Sin Content-Length (len < 0) se lee hasta que el server cierra
+    int len = http_.getSize();
+    WiFiClient* s = http_.getStreamPtr();
+    char resto[128];                       // lo que ya no entra en buf
+    size_t got = 0, total = 0;
+    ContadorComandos cuenta;
+    uint32_t t1 = millis();
+    while (s && (len < 0 || total < (size_t)len) && millis() - t1 < 3000) {
+      bool enBuf = got + 1 < cap;
+      char* dst = enBuf ? buf + got : resto;
+      size_t quiero = enBuf ? cap - 1 - got : sizeof(resto);
+      if (len >= 0) quiero = min(quiero, (size_t)len - total);
+      int n = s->readBytes((uint8_t*)dst, quiero);
+      if (n <= 0) {
+        if (!http_.connected() && !s->available()) break;
+        vTaskDelay(1);
+        continue;
+      }
+      for (int i = 0; i < n; i++) cuenta.ver(dst[i]);
+      if (enBuf) got += n;
+      total += n;
+    }
+    bool cortada = len >= 0 && total < (size_t)len;
+    if (cortada) http_.setReuse(false);   // lo que falta llegaría en el próximo pedido
+    http_.end();                          // con reuse deja la conexión abierta
+    http_.setReuse(true);
+    buf[got] = '\0';
+    comandos = cuenta.n;
+
+    if (cortada) {
+      stats_.cortadas++;
+      perder(comandos, "cortada", total, len);
+      return ERROR_RED;
+    }
+    if (total > got) {
+      stats_.grandes++;
+      perder(comandos, "no entra", total, cap - 1);
+      return PERDIDOS;
+    }
+    return got ? COMANDOS : VACIO;
+  }
+
+  Stats stats() const { return stats_; }
+
+private:
+  void perder(uint32_t comandos, const char* por, size_t bytes, size_t limite) {
+    stats_.perdidos += comandos;
+    Serial.printf("Poll: respuesta %s (%u de %u B), %lu comandos perdidos\n", por, (unsigned)bytes,
+                  (unsigned)limite, (unsigned long)comandos);
+  }
+
+  HTTPClient http_;
+  uint8_t waitS_ = 20;
+  char    url_[160];
+  Stats   stats_ = {};
+};
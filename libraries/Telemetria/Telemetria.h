@@ -0,0 +1,307 @@
+/****************************************************
+ * Telemetría de rendimiento en el ESP32
+ * - Contador: total que solo crece (o que se copia de
+ *   los Stats de otro módulo con fijar())
+ * - Medidor: valor del momento (heap, RSSI)
+ * - Histograma: cubetas fijas (ms o us) + suma, n y
+ *   máximo; sirve para RTT del poll, primer audio,
+ *   redibujo, latencia del touch
+ * - Todo con atomics relajados: se puede registrar
+ *   desde cualquier tarea sin locks ni heap
+ * - Cronometro: mide un bloque (RAII) en us
+ * - Registro: las métricas se anotan solas al crearse
+ *   (objetos globales) y json() arma la foto que
+ *   EnvioTelemetria manda a /admin/metrics/<id>
+ * - Con TELEMETRIA 0 (antes del #include) todo queda
+ *   vacío y el compilador lo saca
+ * - Compila también en host (g++ normal), ver
+ *   CodigosAudio/herramientas/bench_telemetria.py
+ * - Librería de Arduino compartida por los sketches
+ *   de audio y de la cara: copiar (o enlazar) la
+ *   carpeta libraries/Telemetria en la carpeta
+ *   libraries del sketchbook
+ ****************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <atomic>
+
+#ifndef TELEMETRIA
+  #define TELEMETRIA 1
+#endif
+
+#ifdef ARDUINO
+  #include <Arduino.h>
+  #include <WiFi.h>
+  #include <HTTPClient.h>
+#else
+  #include <chrono>
+#endif
+
+namespace telemetria {
+
+inline uint32_t ahoraUs() {
+#ifdef ARDUINO
+  return micros();
+#else
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Cubetas (límite superior incluido); lo que pasa el último va a "+Inf"
+static const uint32_t CUBETAS_MS[] = { 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 };
+static const uint32_t CUBETAS_US[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000 };
+static const uint8_t  MAX_CUBETAS  = 12;
+static const uint8_t  MAX_METRICAS = 24;
+
+class Registro;
+
+// Base común: nombre y tipo para armar la foto
+class Metrica {
+public:
+  enum Tipo : uint8_t { CONTADOR, MEDIDOR, HISTOGRAMA };
+  const char* nombre() const { return nombre_; }
+  Tipo tipo() const { return tipo_; }
+
+protected:
+  Metrica(Registro& r, const char* nombre, Tipo tipo);
+  const char* nombre_;
+  Tipo        tipo_;
+};
+
+class Registro {
+public:
+  void anotar(Metrica* m) {
+#if TELEMETRIA
+    if (n_ < MAX_METRICAS) metricas_[n_++] = m;
+#endif
+  }
+  uint8_t cantidad() const { return n_; }
+  Metrica* metrica(uint8_t i) const { return metricas_[i]; }
+
+  // Foto en JSON; devuelve el largo (0 si no entró en 'max')
+  size_t json(char* buf, size_t max, const char* deviceId, uint32_t uptimeS) const;
+
+private:
+  Metrica* metricas_[MAX_METRICAS];
+  uint8_t  n_ = 0;
+};
+
+inline Metrica::Metrica(Registro& r, const char* nombre, Tipo tipo) : nombre_(nombre), tipo_(tipo) {
+  r.anotar(this);
+}
+
+class Contador : public Metrica {
+public:
+  Contador(Registro& r, const char* nombre) : Metrica(r, nombre, CONTADOR) {}
+  void sumar(uint32_t n = 1) {
+#if TELEMETRIA
+    v_.fetch_add(n, std::memory_order_relaxed);
+#endif
+  }
+  // Para totales que ya lleva otro módulo (underruns del pipeline)
+  void fijar(uint32_t v) {
+#if TELEMETRIA
+    v_.store(v, std::memory_order_relaxed);
+#endif
+  }
+  uint32_t valor() const { return v_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> v_{0};
+};
+
+class Medidor : public Metrica {
+public:
+  Medidor(Registro& r, const char* nombre) : Metrica(r, nombre, MEDIDOR) {}
+  void fijar(int32_t v) {
+#if TELEMETRIA
+    v_.store(v, std::memory_order_relaxed);
+#endif
+  }
+  int32_t valor() const { return v_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<int32_t> v_{0};
+};
+
+class Histograma : public Metrica {
+public:
+  template <size_t N>
+  Histograma(Registro& r, const char* nombre, const uint32_t (&limites)[N])
+    : Metrica(r, nombre, HISTOGRAMA), limites_(limites), nLim_(N < MAX_CUBETAS ? N : MAX_CUBETAS - 1) {}
+
+  void registrar(uint32_t v) {
+#if TELEMETRIA
+    uint8_t i = 0;
+    while (i < nLim_ && v > limites_[i]) i++;
+    cuentas_[i].fetch_add(1, std::memory_order_relaxed);
+    suma_.fetch_add(v, std::memory_order_relaxed);     // da la vuelta a los 2^32: usar diferencias
+    uint32_t m = max_.load(std::memory_order_relaxed);
+    while (v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+#endif
+  }
+
+  uint8_t  limites() const { return nLim_; }
+  uint32_t limite(uint8_t i) const { return limites_[i]; }
+  uint32_t cuenta(uint8_t i) const { return cuentas_[i].load(std::memory_order_relaxed); }   // i == limites(): +Inf
+  uint32_t suma() const { return suma_.load(std::memory_order_relaxed); }
+  uint32_t maximo() const { return max_.load(std::memory_order_relaxed); }
+  uint32_t n() const {
+    uint32_t t = 0;
+    for (uint8_t i = 0; i <= nLim_; i++) t += cuenta(i);
+    return t;
+  }
+
+private:
+  const uint32_t*       limites_;
+  uint8_t               nLim_;
+  std::atomic<uint32_t> cuentas_[MAX_CUBETAS] = {};
+  std::atomic<uint32_t> suma_{0};
+  std::atomic<uint32_t> max_{0};
+};
+
+// Mide el bloque en us y lo registra al salir del scope
+class Cronometro {
+public:
+  explicit Cronometro(Histograma& h) : h_(h) {
+#if TELEMETRIA
+    t0_ = ahoraUs();
+#endif
+  }
+  ~Cronometro() {
+#if TELEMETRIA
+    h_.registrar(ahoraUs() - t0_);
+#endif
+  }
+
+private:
+  Histograma& h_;
+  uint32_t    t0_ = 0;
+};
+
+// snprintf encadenado: si algo no entra, el resto se ignora
+struct Escritor {
+  char*  buf;
+  size_t max;
+  size_t len;
+  bool   ok;
+
+  void operator()(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    if (!ok) return;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + len, max - len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= max - len) ok = false;
+    else len += n;
+  }
+};
+
+// {"device_id":..,"uptime_s":..,"contadores":{..},"medidores":{..},
+//  "histogramas":{"x":{"limites":[..],"cuentas":[..,+Inf],"suma":..,"n":..,"max":..}}}
+inline size_t Registro::json(char* buf, size_t max, const char* deviceId, uint32_t uptimeS) const {
+  Escritor pon = { buf, max, 0, max > 0 };
+  static const char* const SECCION[] = { "contadores", "medidores", "histogramas" };
+
+  pon("{\"device_id\":\"%s\",\"uptime_s\":%lu", deviceId, (unsigned long)uptimeS);
+  for (uint8_t t = Metrica::CONTADOR; t <= Metrica::HISTOGRAMA; t++) {
+    pon(",\"%s\":{", SECCION[t]);
+    bool primera = true;
+    for (uint8_t i = 0; i < n_; i++) {
+      const Metrica* m = metricas_[i];
+      if (m->tipo() != t) continue;
+      pon("%s\"%s\":", primera ? "" : ",", m->nombre());
+      primera = false;
+      if (t == Metrica::CONTADOR) {
+        pon("%lu", (unsigned long)static_cast<const Contador*>(m)->valor());
+      } else if (t == Metrica::MEDIDOR) {
+        pon("%ld", (long)static_cast<const Medidor*>(m)->valor());
+      } else {
+        const Histograma* h = static_cast<const Histograma*>(m);
+        pon("{\"limites\":[");
+        for (uint8_t k = 0; k < h->limites(); k++) pon("%s%lu", k ? "," : "", (unsigned long)h->limite(k));
+        pon("],\"cuentas\":[");
+        uint32_t total = 0;
+        for (uint8_t k = 0; k <= h->limites(); k++) {
+          uint32_t c = h->cuenta(k);
+          total += c;
+          pon("%s%lu", k ? "," : "", (unsigned long)c);
+        }
+        pon("],\"suma\":%lu,\"n\":%lu,\"max\":%lu}", (unsigned long)h->suma(), (unsigned long)total,
+            (unsigned long)h->maximo());
+      }
+    }
+    pon("}");
+  }
+  pon("}");
+  return pon.ok ? pon.len : 0;
+}
+
+#ifdef ARDUINO
+
+// ====== Envío periódico al server ======
+// Tarea propia (core 0, baja prioridad): cada 'periodoMs' manda la foto
+// por POST JSON a /admin/metrics/<id>. El server guarda la última de
+// cada device; los totales son acumulados desde el boot.
+class EnvioTelemetria {
+public:
+  static const size_t JSON_LEN = 3072;
+
+  struct Stats {
+    uint32_t enviados;
+    uint32_t errores;
+    uint32_t recortados;     // la foto no entró en JSON_LEN
+  };
+
+  explicit EnvioTelemetria(Registro& r) : reg_(r) {}
+
+  bool begin(const char* baseUrl, const char* deviceId, uint32_t periodoMs = 30000, uint8_t core = 0) {
+#if TELEMETRIA
+    deviceId_ = deviceId;
+    periodoMs_ = periodoMs;
+    snprintf(url_, sizeof(url_), "%s/admin/metrics/%s", baseUrl, deviceId);
+    return xTaskCreatePinnedToCore(tareaThunk, "telemetria", 4096, this, 1, nullptr, core) == pdPASS;
+#else
+    return true;
+#endif
+  }
+
+  Stats stats() const { return stats_; }
+
+private:
+  static void tareaThunk(void* p) { ((EnvioTelemetria*)p)->tarea(); }
+
+  void tarea() {
+    TickType_t ultimo = xTaskGetTickCount();
+    for (;;) {
+      vTaskDelayUntil(&ultimo, pdMS_TO_TICKS(periodoMs_));
+      if (WiFi.status() != WL_CONNECTED) continue;
+      size_t n = reg_.json(json_, sizeof(json_), deviceId_, millis() / 1000);
+      if (!n) { stats_.recortados++; continue; }
+      HTTPClient http;
+      http.setTimeout(5000);
+      if (!http.begin(url_)) { stats_.errores++; continue; }
+      http.addHeader("Content-Type", "application/json");
+      int code = http.POST((uint8_t*)json_, n);
+      http.end();
+      if (code >= 200 && code < 300) stats_.enviados++;
+      else stats_.errores++;
+    }
+  }
+
+  Registro&   reg_;
+  const char* deviceId_ = "";
+  uint32_t    periodoMs_ = 30000;
+  char        url_[160];
+  char        json_[JSON_LEN];
+  Stats       stats_ = {};
+};
+
+#endif  // ARDUINO
+
+}  // namespace telemetria